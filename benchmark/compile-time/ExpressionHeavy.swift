@@ -0,0 +1,95 @@
+//===--- ExpressionHeavy.swift --------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time benchmark corpus: expression-type-checker-heavy code.
+// Mixed-literal arithmetic, collection literals, closures with inferred
+// parameter and result types, and operator chains.  Every expression here
+// must stay within the type checker's complexity limits; the point is to
+// measure the solver on code it can solve, not to time its failure paths.
+
+func mixedArithmetic(_ x: Double, _ n: Int) -> Double {
+  let a = x * 2 + 1.5 * x - 3 / x + Double(n) * 0.25
+  let b = (a + 1) * (a - 1) / (a * a + 1) + a.squareRoot()
+  let c = b < 0 ? -b + 0.5 : b * 1.25 - 0.5
+  let d = max(min(c, a), b) + min(max(a, b), c)
+  return (a + b + c + d) / 4
+}
+
+func collectionLiterals() -> Int {
+  let pairs = [(1, "one"), (2, "two"), (3, "three"), (4, "four"),
+               (5, "five"), (6, "six"), (7, "seven"), (8, "eight")]
+  let table = ["one": 1, "two": 2, "three": 3, "four": 4,
+               "five": 5, "six": 6, "seven": 7, "eight": 8]
+  let nested = [[1, 2, 3], [4, 5, 6], [7, 8, 9], [10, 11, 12]]
+  let total = pairs.reduce(0) { $0 + $1.0 }
+    + table.values.reduce(0, +)
+    + nested.joined().reduce(0, +)
+  return total
+}
+
+func closureInference(_ values: [Int]) -> [String] {
+  return values
+    .map { $0 * 2 + 1 }
+    .filter { $0 % 3 != 0 }
+    .map { value in "\(value): \(value * value)" }
+    .sorted { $0.count < $1.count }
+}
+
+func ternaryChains(_ score: Int) -> String {
+  let grade = score >= 90 ? "A" : score >= 80 ? "B" : score >= 70 ? "C"
+    : score >= 60 ? "D" : "F"
+  let sign = score > 95 ? "+" : score % 10 < 3 && score >= 60 ? "-" : ""
+  return grade + sign
+}
+
+func interpolationHeavy(_ name: String, _ count: Int, _ ratio: Double) -> String {
+  let header = "name=\(name) count=\(count) ratio=\(ratio)"
+  let detail = "half=\(count / 2) squared=\(count * count) " +
+    "scaled=\(ratio * Double(count)) mixed=\(Double(count) + ratio * 2 - 1)"
+  let footer = "[\(name.uppercased()):\(count > 0 ? "+" : "-")\(abs(count))]"
+  return "\(header)\n\(detail)\n\(footer)"
+}
+
+func optionalChains(_ values: [Int?]) -> Int {
+  let firstEven = values.flatMap { $0 }.first { $0 % 2 == 0 }
+  let sum = values.reduce(0) { $0 + ($1 ?? 0) }
+  return (firstEven ?? 0) + sum + (values.first.flatMap { $0 } ?? -1)
+}
+
+func tupleShuffles(_ x: Int, _ y: Int) -> (sum: Int, product: Int, mixed: Double) {
+  let pair = (x + y, x * y)
+  let swapped = (pair.1, pair.0)
+  let mixed = Double(swapped.0) / Double(swapped.1 == 0 ? 1 : swapped.1)
+  return (sum: pair.0 + swapped.1, product: pair.1 + swapped.0, mixed: mixed)
+}
+
+func rangeExpressions(_ n: Int) -> Int {
+  let squares = (1...n).map { $0 * $0 }
+  let evens = (0..<n).filter { $0 % 2 == 0 }
+  let windows = zip(squares, evens).map { $0 + $1 }
+  return windows.reduce(0, +) + squares.dropFirst().reduce(0, +)
+    - evens.dropLast().reduce(0, +)
+}
+
+func comparisonChains(_ a: Int, _ b: Int, _ c: Int) -> Bool {
+  let ordered = a < b && b < c || a > b && b > c
+  let bounded = (a >= 0 && a <= 100) && (b >= 0 && b <= 100)
+  let special = a + b == c || b + c == a || a + c == b
+  return ordered && bounded || special && !ordered
+}
+
+func numericConversions(_ i8: Int8, _ u16: UInt16, _ f: Float) -> Double {
+  let widened = Int(i8) + Int(u16) + Int(f.rounded())
+  let narrowedBack = Double(widened) * Double(f) + Double(i8) / 2.0
+  let bits = Double(u16 & 0xFF) + Double(UInt8(truncatingIfNeeded: widened))
+  return narrowedBack + bits - Double(widened % 7)
+}
@@ -0,0 +1,149 @@
+//===--- GenericsHeavy.swift ----------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time benchmark corpus: generic-signature-heavy code.  Protocol
+// hierarchies with associated types, constrained extensions, conditional
+// conformances, and deeply nested generic instantiations exercise the
+// generic signature builder and specializer rather than the expression
+// type checker.
+
+protocol Producer {
+  associatedtype Output
+  func produce() -> Output
+}
+
+protocol Consumer {
+  associatedtype Input
+  mutating func consume(_ input: Input)
+}
+
+protocol Transformer: Producer, Consumer {
+  associatedtype Input
+  associatedtype Output
+  func transform(_ input: Input) -> Output
+}
+
+struct Identity<T>: Transformer {
+  var last: T
+  func produce() -> T { return last }
+  mutating func consume(_ input: T) { last = input }
+  func transform(_ input: T) -> T { return input }
+}
+
+struct Compose<First: Transformer, Second: Transformer>: Transformer
+    where First.Output == Second.Input {
+  var first: First
+  var second: Second
+
+  func produce() -> Second.Output { return second.produce() }
+  mutating func consume(_ input: First.Input) { first.consume(input) }
+  func transform(_ input: First.Input) -> Second.Output {
+    return second.transform(first.transform(input))
+  }
+}
+
+struct Mapped<Base: Transformer, Output>: Transformer {
+  var base: Base
+  var body: (Base.Output) -> Output
+
+  func produce() -> Output { return body(base.produce()) }
+  mutating func consume(_ input: Base.Input) { base.consume(input) }
+  func transform(_ input: Base.Input) -> Output {
+    return body(base.transform(input))
+  }
+}
+
+extension Transformer where Output: Comparable {
+  func transformedMax(_ lhs: Input, _ rhs: Input) -> Output {
+    let left = transform(lhs)
+    let right = transform(rhs)
+    return left < right ? right : left
+  }
+}
+
+extension Transformer where Output == Input {
+  func iterated(_ input: Input, times: Int) -> Output {
+    var value = input
+    for _ in 0..<times {
+      value = transform(value)
+    }
+    return value
+  }
+}
+
+struct Pair<First, Second> {
+  var first: First
+  var second: Second
+}
+
+extension Pair: Equatable where First: Equatable, Second: Equatable {
+  static func == (lhs: Pair, rhs: Pair) -> Bool {
+    return lhs.first == rhs.first && lhs.second == rhs.second
+  }
+}
+
+extension Pair: Hashable where First: Hashable, Second: Hashable {
+  var hashValue: Int {
+    return first.hashValue ^ (second.hashValue &* 16777619)
+  }
+}
+
+func chain<T: Transformer, U: Transformer>(_ t: T, _ u: U) -> Compose<T, U>
+    where T.Output == U.Input {
+  return Compose(first: t, second: u)
+}
+
+func deeplyNested() -> Int {
+  let doubler = Mapped(base: Identity(last: 0)) { $0 * 2 }
+  let incrementer = Mapped(base: Identity(last: 0)) { $0 + 1 }
+  let stage2 = chain(doubler, incrementer)
+  let stage4 = chain(stage2, stage2)
+  let stage8 = chain(stage4, stage4)
+  let stage16 = chain(stage8, stage8)
+  return stage16.transform(1)
+}
+
+func instantiateAcrossTypes() -> String {
+  let ints = Identity(last: 42)
+  let strings = Mapped(base: ints) { "\($0)" }
+  let counts = Mapped(base: strings) { $0.count }
+  let booleans = Mapped(base: counts) { $0 % 2 == 0 }
+  let descriptions = Mapped(base: booleans) { $0 ? "even" : "odd" }
+  return descriptions.transform(7)
+}
+
+func pairEquality() -> Bool {
+  let nested = Pair(first: Pair(first: 1, second: "a"),
+                    second: Pair(first: true, second: 2.0))
+  let other = Pair(first: Pair(first: 1, second: "a"),
+                   second: Pair(first: true, second: 2.0))
+  let outer = Pair(first: nested, second: other)
+  return nested == other && outer.first == outer.second
+}
+
+func constrainedAlgorithms<S: Sequence>(_ values: S) -> [S.Element]
+    where S.Element: Comparable & Hashable {
+  var seen = Set<S.Element>()
+  var unique: [S.Element] = []
+  for value in values where !seen.contains(value) {
+    seen.insert(value)
+    unique.append(value)
+  }
+  return unique.sorted()
+}
+
+func useConstrainedAlgorithms() -> Int {
+  let fromInts = constrainedAlgorithms([3, 1, 4, 1, 5, 9, 2, 6])
+  let fromStrings = constrainedAlgorithms(["b", "a", "c", "a"])
+  let fromDoubles = constrainedAlgorithms([2.0, 1.0, 2.0])
+  return fromInts.count + fromStrings.count + fromDoubles.count
+}
@@ -0,0 +1,241 @@
+//===--- LargeClass.swift -------------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time benchmark corpus: one large class in the style of generated
+// model code.  Many stored properties, a wide memberwise-style initializer,
+// computed properties, observers, nested types, and method-heavy
+// extensions stress name lookup, vtable layout, and SILGen rather than
+// expression type checking.
+
+final class DeviceRecord {
+  enum PowerState {
+    case off
+    case sleeping
+    case awake(brightness: Double)
+  }
+
+  struct Revision {
+    var major: Int
+    var minor: Int
+    var patch: Int
+  }
+
+  var identifier: String
+  var displayName: String
+  var manufacturer: String
+  var modelNumber: String
+  var serialNumber: String
+  var firmwareRevision: Revision
+  var hardwareRevision: Revision
+  var isPaired: Bool
+  var isReachable: Bool
+  var powerState: PowerState
+  var batteryLevel: Double
+  var signalStrength: Double
+  var lastSeenTimestamp: Double
+  var pairedTimestamp: Double
+  var uptimeSeconds: Int
+  var errorCount: Int
+  var warningCount: Int
+  var packetsSent: Int
+  var packetsReceived: Int
+  var packetsDropped: Int
+  var bytesSent: Int
+  var bytesReceived: Int
+  var retransmissions: Int
+  var latencyMilliseconds: Double
+  var temperatureCelsius: Double
+  var tags: [String]
+  var attributes: [String: String]
+  var childIdentifiers: [String]
+
+  var notificationCount: Int = 0 {
+    didSet {
+      if notificationCount > 1000 {
+        warningCount += 1
+      }
+    }
+  }
+
+  init(identifier: String, displayName: String, manufacturer: String,
+       modelNumber: String, serialNumber: String,
+       firmwareRevision: Revision, hardwareRevision: Revision,
+       isPaired: Bool, isReachable: Bool, powerState: PowerState,
+       batteryLevel: Double, signalStrength: Double,
+       lastSeenTimestamp: Double, pairedTimestamp: Double,
+       uptimeSeconds: Int, errorCount: Int, warningCount: Int,
+       packetsSent: Int, packetsReceived: Int, packetsDropped: Int,
+       bytesSent: Int, bytesReceived: Int, retransmissions: Int,
+       latencyMilliseconds: Double, temperatureCelsius: Double,
+       tags: [String], attributes: [String: String],
+       childIdentifiers: [String]) {
+    self.identifier = identifier
+    self.displayName = displayName
+    self.manufacturer = manufacturer
+    self.modelNumber = modelNumber
+    self.serialNumber = serialNumber
+    self.firmwareRevision = firmwareRevision
+    self.hardwareRevision = hardwareRevision
+    self.isPaired = isPaired
+    self.isReachable = isReachable
+    self.powerState = powerState
+    self.batteryLevel = batteryLevel
+    self.signalStrength = signalStrength
+    self.lastSeenTimestamp = lastSeenTimestamp
+    self.pairedTimestamp = pairedTimestamp
+    self.uptimeSeconds = uptimeSeconds
+    self.errorCount = errorCount
+    self.warningCount = warningCount
+    self.packetsSent = packetsSent
+    self.packetsReceived = packetsReceived
+    self.packetsDropped = packetsDropped
+    self.bytesSent = bytesSent
+    self.bytesReceived = bytesReceived
+    self.retransmissions = retransmissions
+    self.latencyMilliseconds = latencyMilliseconds
+    self.temperatureCelsius = temperatureCelsius
+    self.tags = tags
+    self.attributes = attributes
+    self.childIdentifiers = childIdentifiers
+  }
+
+  convenience init(identifier: String) {
+    self.init(identifier: identifier, displayName: identifier,
+              manufacturer: "", modelNumber: "", serialNumber: "",
+              firmwareRevision: Revision(major: 0, minor: 0, patch: 0),
+              hardwareRevision: Revision(major: 0, minor: 0, patch: 0),
+              isPaired: false, isReachable: false, powerState: .off,
+              batteryLevel: 0, signalStrength: 0, lastSeenTimestamp: 0,
+              pairedTimestamp: 0, uptimeSeconds: 0, errorCount: 0,
+              warningCount: 0, packetsSent: 0, packetsReceived: 0,
+              packetsDropped: 0, bytesSent: 0, bytesReceived: 0,
+              retransmissions: 0, latencyMilliseconds: 0,
+              temperatureCelsius: 0, tags: [], attributes: [:],
+              childIdentifiers: [])
+  }
+
+  var isHealthy: Bool {
+    return isReachable && errorCount == 0 && batteryLevel > 0.2
+  }
+
+  var dropRate: Double {
+    let total = packetsSent + packetsReceived
+    return total == 0 ? 0 : Double(packetsDropped) / Double(total)
+  }
+
+  var throughputBytes: Int {
+    return bytesSent + bytesReceived
+  }
+
+  var firmwareString: String {
+    let r = firmwareRevision
+    return "\(r.major).\(r.minor).\(r.patch)"
+  }
+
+  func markSeen(at timestamp: Double) {
+    lastSeenTimestamp = timestamp
+    isReachable = true
+  }
+
+  func markUnreachable() {
+    isReachable = false
+    powerState = .off
+  }
+
+  func recordError() {
+    errorCount += 1
+  }
+
+  func recordWarning() {
+    warningCount += 1
+  }
+
+  func recordTraffic(sent: Int, received: Int, dropped: Int) {
+    packetsSent += sent
+    packetsReceived += received
+    packetsDropped += dropped
+  }
+
+  func recordBytes(sent: Int, received: Int) {
+    bytesSent += sent
+    bytesReceived += received
+  }
+
+  func addTag(_ tag: String) {
+    if !tags.contains(tag) {
+      tags.append(tag)
+    }
+  }
+
+  func removeTag(_ tag: String) {
+    if let index = tags.index(of: tag) {
+      tags.remove(at: index)
+    }
+  }
+
+  func setAttribute(_ value: String, forKey key: String) {
+    attributes[key] = value
+  }
+
+  func attribute(forKey key: String) -> String? {
+    return attributes[key]
+  }
+
+  func addChild(_ identifier: String) {
+    childIdentifiers.append(identifier)
+  }
+
+  func resetCounters() {
+    errorCount = 0
+    warningCount = 0
+    packetsSent = 0
+    packetsReceived = 0
+    packetsDropped = 0
+    bytesSent = 0
+    bytesReceived = 0
+    retransmissions = 0
+    notificationCount = 0
+  }
+}
+
+extension DeviceRecord {
+  func summary() -> String {
+    return "\(displayName) [\(identifier)] fw=\(firmwareString) " +
+      "battery=\(batteryLevel) reachable=\(isReachable)"
+  }
+
+  func detailedSummary() -> String {
+    return summary() + " traffic=\(throughputBytes)B drop=\(dropRate) " +
+      "errors=\(errorCount) warnings=\(warningCount)"
+  }
+
+  func matches(query: String) -> Bool {
+    return identifier.contains(query) || displayName.contains(query)
+      || manufacturer.contains(query) || tags.contains(query)
+  }
+}
+
+extension DeviceRecord: CustomStringConvertible {
+  var description: String {
+    return summary()
+  }
+}
+
+extension DeviceRecord: Hashable {
+  var hashValue: Int {
+    return identifier.hashValue
+  }
+
+  static func == (lhs: DeviceRecord, rhs: DeviceRecord) -> Bool {
+    return lhs.identifier == rhs.identifier
+  }
+}
@@ -0,0 +1,57 @@
+//===--- FloatingPointPrinting.swift --------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// This test measures the performance of converting floating-point values
+// to their round-trip textual representations, which exercises the
+// runtime's shortest round-trip formatter.
+
+import TestsUtils
+
+public let FloatingPointPrinting = [
+  BenchmarkInfo(
+    name: "FloatingPointPrinting_Float_description",
+    runFunction: run_FloatingPointPrinting_Float_description,
+    tags: [.validation, .api, .runtime, .String]),
+  BenchmarkInfo(
+    name: "FloatingPointPrinting_Double_description",
+    runFunction: run_FloatingPointPrinting_Double_description,
+    tags: [.validation, .api, .runtime, .String]),
+]
+
+// Generate descriptions for a variety of magnitudes, exercising the
+// fixed-notation, scientific-notation, and subnormal paths.
+
+@inline(never)
+public func run_FloatingPointPrinting_Float_description(_ N: Int) {
+  let count = 100_000
+  var length = 0
+  for _ in 0..<N {
+    for i in 0..<count {
+      let f = Float(bitPattern: UInt32(truncatingIfNeeded: i &* 88_888_888 &+ 1))
+      length += f.debugDescription.count
+    }
+  }
+  blackHole(length)
+}
+
+@inline(never)
+public func run_FloatingPointPrinting_Double_description(_ N: Int) {
+  let count = 100_000
+  var length = 0
+  for _ in 0..<N {
+    for i in 0..<count {
+      let d = Double(bitPattern: UInt64(truncatingIfNeeded: i &* 8_888_888_888_888_888 &+ 1))
+      length += d.debugDescription.count
+    }
+  }
+  blackHole(length)
+}
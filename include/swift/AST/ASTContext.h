@@ -19,7 +19,9 @@
 
 #include "llvm/Support/DataTypes.h"
 #include "swift/AST/ClangModuleLoader.h"
+#include "swift/AST/Evaluator.h"
 #include "swift/AST/Identifier.h"
+#include "swift/AST/ProtocolConformanceRef.h"
 #include "swift/AST/SearchPathOptions.h"
 #include "swift/AST/SubstitutionList.h"
 #include "swift/AST/Type.h"
@@ -213,6 +215,9 @@ public:
   /// Diags - The diagnostics engine.
   DiagnosticEngine &Diags;
 
+  /// The request-evaluator that is used to process various requests.
+  Evaluator evaluator;
+
   /// The set of top-level modules we have loaded.
   /// This map is used for iteration, therefore it's a MapVector and not a
   /// DenseMap.
@@ -871,10 +876,90 @@ public:
                                                      CanGenericSignature sig);
 
   /// Retrieve or create the canonical generic environment of a canonical
-  /// generic signature builder.
+  /// generic signature.
   GenericEnvironment *getOrCreateCanonicalGenericEnvironment(
-                                       GenericSignatureBuilder *builder,
-                                       GenericSignature *sig);
+                                       CanGenericSignature sig);
+
+  /// Retrieve the cached result of a module conformance lookup for the
+  /// given type and protocol, if one has been recorded.
+  ///
+  /// The outer optional indicates whether a cache entry exists; the inner
+  /// optional is the recorded lookup result, which may itself be empty for
+  /// a cached negative result.
+  Optional<Optional<ProtocolConformanceRef>>
+  getCachedConformanceLookup(ModuleDecl *mod, Type type,
+                             ProtocolDecl *protocol);
+
+  /// Record the result of a module conformance lookup, including a
+  /// negative result, so that later queries can be answered without
+  /// searching.
+  void recordConformanceLookup(ModuleDecl *mod, Type type,
+                               ProtocolDecl *protocol,
+                               Optional<ProtocolConformanceRef> conformance);
+
+  /// Retrieve the cached results of a top-level module name lookup, if one
+  /// has been recorded for the same query signature. \p queryKind packs the
+  /// aspects of the query that affect its results beyond the name itself;
+  /// see namelookup::lookupInModule.
+  ///
+  /// The returned array points into the cache and must be consumed before
+  /// another lookup is recorded.
+  Optional<ArrayRef<ValueDecl *>>
+  getCachedModuleLookup(ModuleDecl *mod, DeclName name,
+                        const DeclContext *moduleScopeContext,
+                        unsigned queryKind);
+
+  /// Record the results of a top-level module name lookup so that repeated
+  /// queries can be answered without walking the import graph again.
+  void recordModuleLookup(ModuleDecl *mod, DeclName name,
+                          const DeclContext *moduleScopeContext,
+                          unsigned queryKind, ArrayRef<ValueDecl *> decls);
+
+  /// Invalidate all memoized module lookup results. Called when a file's set
+  /// of imports changes, which can make more declarations visible without
+  /// loading a new module (and so without bumping the generation).
+  void invalidateModuleLookupCache();
+
+  /// A memoized qualified-lookup result. Alongside the declarations found,
+  /// the entry remembers what a cache hit has to replay for the benefit of
+  /// the referenced-name tracker: the nominal types whose members were
+  /// consulted, and whether the walk reached into AnyObject dynamic lookup.
+  struct QualifiedLookupCacheEntry {
+    unsigned Generation;
+    unsigned Epoch;
+    std::vector<ValueDecl *> Decls;
+    std::vector<NominalTypeDecl *> VisitedNominals;
+    bool UsedDynamicLookup;
+  };
+
+  /// Retrieve the memoized result of a qualified lookup, if a valid one has
+  /// been recorded for the same query signature. \p queryKind packs the
+  /// lookup options and anything else that affects the results beyond the
+  /// base type and name; see DeclContext::lookupQualified.
+  const QualifiedLookupCacheEntry *
+  getCachedQualifiedLookup(const DeclContext *dc, Type type, DeclName member,
+                           unsigned queryKind);
+
+  /// Record the result of a qualified lookup for later reuse, returning the
+  /// entry to be filled in.
+  QualifiedLookupCacheEntry &cacheQualifiedLookup(const DeclContext *dc,
+                                                  Type type, DeclName member,
+                                                  unsigned queryKind);
+
+  /// Invalidate all memoized qualified-lookup results; called when a member
+  /// or extension is added to a nominal type anywhere in the context.
+  void invalidateQualifiedLookupCache();
+
+  /// Retrieve the memoized USR for the given declaration, if one has been
+  /// recorded. \p accessorKind distinguishes the USRs of a storage
+  /// declaration's pseudo-accessors from the USR of the declaration itself.
+  Optional<StringRef> getCachedUSR(const ValueDecl *decl,
+                                   unsigned accessorKind = 0);
+
+  /// Record the USR computed for the given declaration, returning a copy
+  /// that lives as long as the context.
+  StringRef recordUSR(const ValueDecl *decl, unsigned accessorKind,
+                      StringRef USR);
 
   /// Retrieve a generic signature with a single unconstrained type parameter,
   /// like `<T>`.
@@ -897,6 +982,14 @@ public:
     return LangOpts.isSwiftVersionAtLeast(major);
   }
 
+  /// Retrieve the memoized mangled name recorded for this declaration under
+  /// \p Key, if any. \p Key disambiguates the mangling parameters; see
+  /// Mangle::ASTMangler for the encoding.
+  Optional<StringRef> getMangledName(const Decl *D, unsigned Key);
+
+  /// Memoize the mangled name for this declaration under \p Key.
+  void setMangledName(const Decl *D, unsigned Key, StringRef Name);
+
 private:
   friend Decl;
   Optional<RawComment> getRawComment(const Decl *D);
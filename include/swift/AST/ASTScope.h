@@ -184,6 +184,14 @@ class ASTScope {
       ///
       /// This accommodates the expansion of source files.
       mutable unsigned nextElement;
+
+      /// The result of the most recent innermost-scope query against this
+      /// tree.
+      ///
+      /// Queries tend to cluster around a few source locations, so the
+      /// previous result is used as the starting point for the next search
+      /// rather than descending from the root again.
+      mutable const ASTScope *lastInnermostScope;
     } sourceFile;
 
     /// A type declaration, for \c kind == ASTScopeKind::TypeDecl.
@@ -333,6 +341,7 @@ class ASTScope {
       : ASTScope(ASTScopeKind::SourceFile, nullptr) {
     this->sourceFile.file = sourceFile;
     this->sourceFile.nextElement = nextElement;
+    this->sourceFile.lastInnermostScope = nullptr;
   }
 
   /// Constructor that initializes a preexpanded node.
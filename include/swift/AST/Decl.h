@@ -2825,6 +2825,11 @@ class NominalTypeDecl : public GenericTypeDecl, public IterableDeclContext {
   /// so that it can also be added to the lookup table (if needed).
   void addedMember(Decl *member);
 
+  /// Note that we have bound an extension to the nominal type, so that the
+  /// lookup table no longer considers itself complete for names it has
+  /// already populated from the lazy member loaders.
+  void addedExtension(ExtensionDecl *ext);
+
   /// \brief A lookup table used to find the protocol conformances of
   /// a given nominal type.
   mutable ConformanceLookupTable *ConformanceTable = nullptr;
@@ -281,7 +281,14 @@ namespace swift {
   };
   
   /// Diagnostic - This is a specific instance of a diagnostic along with all of
-  /// the DiagnosticArguments that it requires. 
+  /// the DiagnosticArguments that it requires.
+  ///
+  /// The arguments are deliberately kept in their semantic form (a Type is
+  /// stored as a Type, and so on): rendering them to text -- including type
+  /// printing, which is not cheap -- happens in formatDiagnosticText, driven
+  /// by whichever consumer actually displays the diagnostic.  Suppressed or
+  /// dropped diagnostics must never pay for formatting, so do not render
+  /// arguments eagerly when constructing one of these.
   class Diagnostic {
   public:
     typedef DiagnosticInfo::FixIt FixIt;
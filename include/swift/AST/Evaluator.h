@@ -0,0 +1,298 @@
+//===--- Evaluator.h - Request Evaluator ------------------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the Evaluator class, which evaluates and caches
+//  requests, and the AnyRequest class, a type-erased request used for the
+//  evaluator's bookkeeping.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_AST_EVALUATOR_H
+#define SWIFT_AST_EVALUATOR_H
+
+#include "swift/Basic/AnyValue.h"
+#include "swift/Basic/Defer.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/TypeName.h"
+#include "llvm/Support/raw_ostream.h"
+#include <memory>
+#include <type_traits>
+
+namespace llvm {
+template<typename T> struct DenseMapInfo;
+}
+
+namespace swift {
+
+class DiagnosticEngine;
+class Evaluator;
+
+namespace detail {
+
+/// Provides a unique address for each request type, so type-erased requests
+/// can be compared and hashed without RTTI.
+template<typename Request>
+struct RequestTypeID {
+  static const char ID;
+};
+
+template<typename Request>
+const char RequestTypeID<Request>::ID = 0;
+
+} // end namespace detail
+
+/// A type-erased request, used for the evaluator's cycle detection and
+/// request cache.
+class AnyRequest {
+  friend struct llvm::DenseMapInfo<AnyRequest>;
+
+  /// Whether this instance stores a request or is one of the special
+  /// values used as DenseMap keys.
+  enum class StorageKind : uint8_t {
+    Normal,
+    Empty,
+    Tombstone,
+  } storageKind = StorageKind::Normal;
+
+  /// Abstract base class used to hold the specific request kind.
+  class HolderBase {
+  public:
+    /// The unique identifier of the stored request's type.
+    const void * const typeID;
+
+  protected:
+    explicit HolderBase(const void *typeID) : typeID(typeID) { }
+
+  public:
+    HolderBase(const HolderBase &) = delete;
+    HolderBase &operator=(const HolderBase &) = delete;
+    virtual ~HolderBase();
+
+    /// Compute the hash of the stored request.
+    virtual llvm::hash_code hash() const = 0;
+
+    /// Compare the stored request against another; the caller guarantees
+    /// that the type identifiers match.
+    virtual bool equals(const HolderBase &other) const = 0;
+
+    /// Diagnose a cycle detected at the stored request.
+    virtual void diagnoseCycle(DiagnosticEngine &diags) const = 0;
+
+    /// Note that the stored request is part of a cycle.
+    virtual void noteCycleStep(DiagnosticEngine &diags) const = 0;
+
+    /// Print the stored request for debugging purposes.
+    virtual void print(llvm::raw_ostream &out) const = 0;
+  };
+
+  /// Holds a request of a specific kind.
+  template<typename Request>
+  class Holder final : public HolderBase {
+  public:
+    const Request request;
+
+    Holder(const Request &request)
+      : HolderBase(&detail::RequestTypeID<Request>::ID), request(request) { }
+
+    llvm::hash_code hash() const override {
+      return llvm::hash_combine(typeID, hash_value(request));
+    }
+
+    bool equals(const HolderBase &other) const override {
+      assert(typeID == other.typeID && "caller should have checked the type");
+      return request == static_cast<const Holder<Request> &>(other).request;
+    }
+
+    void diagnoseCycle(DiagnosticEngine &diags) const override {
+      request.diagnoseCycle(diags);
+    }
+
+    void noteCycleStep(DiagnosticEngine &diags) const override {
+      request.noteCycleStep(diags);
+    }
+
+    void print(llvm::raw_ostream &out) const override {
+      out << llvm::getTypeName<Request>();
+    }
+  };
+
+  /// The stored request; shared so that the same underlying storage can
+  /// serve both the active-request stack and the cache key.
+  std::shared_ptr<HolderBase> stored;
+
+  explicit AnyRequest(StorageKind storageKind) : storageKind(storageKind) { }
+
+public:
+  AnyRequest(const AnyRequest &) = default;
+  AnyRequest &operator=(const AnyRequest &) = default;
+  AnyRequest(AnyRequest &&) = default;
+  AnyRequest &operator=(AnyRequest &&) = default;
+
+  /// Construct a new instance with the given request.
+  template<typename Request>
+  explicit AnyRequest(const Request &request)
+    : stored(new Holder<Request>(request)) { }
+
+  /// Diagnose a cycle detected for this request.
+  void diagnoseCycle(DiagnosticEngine &diags) const {
+    stored->diagnoseCycle(diags);
+  }
+
+  /// Note that this request is part of a cycle.
+  void noteCycleStep(DiagnosticEngine &diags) const {
+    stored->noteCycleStep(diags);
+  }
+
+  /// Print this request for debugging purposes.
+  void print(llvm::raw_ostream &out) const {
+    stored->print(out);
+  }
+
+  friend bool operator==(const AnyRequest &lhs, const AnyRequest &rhs) {
+    if (lhs.storageKind != rhs.storageKind)
+      return false;
+    if (lhs.storageKind != StorageKind::Normal)
+      return true;
+    if (lhs.stored.get() == rhs.stored.get())
+      return true;
+    if (lhs.stored->typeID != rhs.stored->typeID)
+      return false;
+    return lhs.stored->equals(*rhs.stored);
+  }
+
+  friend bool operator!=(const AnyRequest &lhs, const AnyRequest &rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend llvm::hash_code hash_value(const AnyRequest &request) {
+    if (request.storageKind != StorageKind::Normal)
+      return llvm::hash_value(static_cast<uint8_t>(request.storageKind));
+
+    return request.stored->hash();
+  }
+};
+
+/// Evaluates a given request, with all of the memoization and cycle
+/// detection that the request's type asks for.
+///
+/// A request is a value type describing a single question to ask of the
+/// AST, e.g., "what is the superclass of this class?". The request type
+/// provides:
+///
+///   - An \c OutputType for the result of the computation,
+///   - \c operator()(Evaluator &) to perform the computation,
+///   - \c operator== and \c hash_value, so requests can be uniqued,
+///   - \c isEverCached and \c hasExternalCache, describing whether and
+///     where results are memoized, and
+///   - \c diagnoseCycle / \c noteCycleStep / \c breakCycle, describing
+///     how to recover when the request depends on its own result.
+///
+/// The \c SimpleRequest CRTP base class provides most of this boilerplate;
+/// see SimpleRequest.h.
+class Evaluator {
+  /// The diagnostics engine through which evaluation cycles are reported.
+  DiagnosticEngine &diags;
+
+  /// The stack of requests currently being evaluated, used to detect
+  /// cyclic dependencies.
+  llvm::SetVector<AnyRequest> activeRequests;
+
+  /// A cache of the results of requests whose types opt in to caching
+  /// within the evaluator.
+  llvm::DenseMap<AnyRequest, AnyValue> cache;
+
+public:
+  explicit Evaluator(DiagnosticEngine &diags) : diags(diags) { }
+
+  /// Evaluate the given request, returning its (possibly cached) result.
+  template<typename Request>
+  typename Request::OutputType operator()(const Request &request) {
+    // If this request is already being evaluated, we have a cyclic
+    // dependency; diagnose it and let the request produce a fallback
+    // result.
+    AnyRequest anyRequest(request);
+    if (!activeRequests.insert(anyRequest)) {
+      diagnoseCycle(anyRequest);
+      return request.breakCycle();
+    }
+
+    SWIFT_DEFER { activeRequests.pop_back(); };
+
+    // Requests that are never cached are simply evaluated.
+    if (!Request::isEverCached)
+      return request(*this);
+
+    return getResultCached(request, std::move(anyRequest));
+  }
+
+private:
+  /// Diagnose a cycle detected while evaluating the given request.
+  void diagnoseCycle(const AnyRequest &request);
+
+  /// Evaluate a request whose result is cached externally, e.g., in a
+  /// mutable data structure within the AST.
+  template<typename Request,
+           typename std::enable_if<Request::hasExternalCache>::type
+             * = nullptr>
+  typename Request::OutputType getResultCached(const Request &request,
+                                               AnyRequest &&anyRequest) {
+    if (auto cached = request.getCachedResult())
+      return *cached;
+
+    auto result = request(*this);
+    request.cacheResult(result);
+    return result;
+  }
+
+  /// Evaluate a request whose result is cached within the evaluator.
+  template<typename Request,
+           typename std::enable_if<!Request::hasExternalCache>::type
+             * = nullptr>
+  typename Request::OutputType getResultCached(const Request &request,
+                                               AnyRequest &&anyRequest) {
+    auto known = cache.find(anyRequest);
+    if (known != cache.end())
+      return known->second.template castTo<typename Request::OutputType>();
+
+    auto result = request(*this);
+    cache.insert({std::move(anyRequest), AnyValue(result)});
+    return result;
+  }
+};
+
+} // end namespace swift
+
+namespace llvm {
+
+template<>
+struct DenseMapInfo<swift::AnyRequest> {
+  using AnyRequest = swift::AnyRequest;
+
+  static inline AnyRequest getEmptyKey() {
+    return AnyRequest(AnyRequest::StorageKind::Empty);
+  }
+  static inline AnyRequest getTombstoneKey() {
+    return AnyRequest(AnyRequest::StorageKind::Tombstone);
+  }
+  static unsigned getHashValue(const AnyRequest &request) {
+    return hash_value(request);
+  }
+  static bool isEqual(const AnyRequest &lhs, const AnyRequest &rhs) {
+    return lhs == rhs;
+  }
+};
+
+} // end namespace llvm
+
+#endif // SWIFT_AST_EVALUATOR_H
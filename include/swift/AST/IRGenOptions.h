@@ -61,6 +61,17 @@ enum class IRGenEmbedMode : unsigned {
   EmbedBitcode
 };
 
+enum class IRGenLLVMLTOKind : unsigned {
+  None,
+
+  /// Emit LLVM bitcode with a ThinLTO module summary into the object file;
+  /// the linker's thin-link phase drives per-module backend compilation.
+  Thin,
+
+  /// Emit plain LLVM bitcode into the object file for monolithic LTO.
+  Full
+};
+
 /// The set of options supported by IR generation.
 class IRGenOptions {
 public:
@@ -139,6 +150,10 @@ public:
   /// Whether we should embed the bitcode file.
   IRGenEmbedMode EmbedMode : 2;
 
+  /// The link-time optimization mode: whether object files carry LLVM
+  /// bitcode for the linker's LTO backends instead of machine code.
+  IRGenLLVMLTOKind LLVMLTOKind : 2;
+
   /// Add names to LLVM values.
   unsigned HasValueNamesSetting : 1;
   unsigned ValueNames : 1;
@@ -179,7 +194,8 @@ public:
         DisableLLVMOptzns(false), DisableLLVMARCOpts(false),
         DisableLLVMSLPVectorizer(false), DisableFPElim(true), Playground(false),
         EmitStackPromotionChecks(false), PrintInlineTree(false),
-        EmbedMode(IRGenEmbedMode::None), HasValueNamesSetting(false),
+        EmbedMode(IRGenEmbedMode::None),
+        LLVMLTOKind(IRGenLLVMLTOKind::None), HasValueNamesSetting(false),
         ValueNames(false), EnableReflectionMetadata(true),
         EnableReflectionNames(true), UseIncrementalLLVMCodeGen(true),
         UseSwiftCall(false), GenerateProfile(false), CmdArgs(),
@@ -191,6 +207,7 @@ public:
     unsigned Hash = (unsigned)OptMode;
     Hash = (Hash << 1) | DisableLLVMOptzns;
     Hash = (Hash << 1) | DisableLLVMARCOpts;
+    Hash = (Hash << 2) | (unsigned)LLVMLTOKind;
     return Hash;
   }
 
@@ -0,0 +1,131 @@
+//===--- SimpleRequest.h - Simple Request Instances -------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the SimpleRequest class template, which makes it
+//  easier to define new request kinds for the evaluator.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_AST_SIMPLEREQUEST_H
+#define SWIFT_AST_SIMPLEREQUEST_H
+
+#include "swift/AST/Evaluator.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/STLExtras.h"
+#include <tuple>
+
+namespace swift {
+
+class DiagnosticEngine;
+
+/// Describes how the result of a particular request will be cached.
+enum class CacheKind {
+  /// The result for a particular request should never be cached.
+  Uncached,
+  /// The result for a particular request should be cached within the
+  /// evaluator itself.
+  Cached,
+  /// The result of a particular request will be cached via some separate
+  /// mechanism, such as a mutable data structure in the AST.
+  SeparatelyCached,
+};
+
+/// CRTP base class that describes a request operation that takes values
+/// with the given input types (\c Inputs...) and produces an output of
+/// the given type.
+///
+/// \tparam Derived The final, derived class type for the request.
+/// \tparam Caching Describes how the output value is cached, if at all.
+/// \tparam Output The type of the result produced by evaluating this request.
+/// \tparam Inputs The types of the inputs to this request, which are
+/// provided to the constructor and used to compare requests for equality
+/// and compute their hashes.
+///
+/// The \c Derived class needs to implement the operation that computes the
+/// result from the input values:
+/// \code
+///   Output evaluate(Evaluator &evaluator, Inputs...) const;
+/// \endcode
+///
+/// It also describes how a cyclic dependency on this request is handled,
+/// by producing the fallback result and emitting the diagnostics:
+/// \code
+///   Output breakCycle() const;
+///   void diagnoseCycle(DiagnosticEngine &diags) const;
+///   void noteCycleStep(DiagnosticEngine &diags) const;
+/// \endcode
+///
+/// A request that opts for \c CacheKind::SeparatelyCached must additionally
+/// implement the operations that query and update its external cache:
+/// \code
+///   Optional<Output> getCachedResult() const;
+///   void cacheResult(Output value) const;
+/// \endcode
+template<typename Derived, CacheKind Caching, typename Output,
+         typename ...Inputs>
+class SimpleRequest {
+  std::tuple<Inputs...> storage;
+
+  const Derived &asDerived() const {
+    return *static_cast<const Derived *>(this);
+  }
+
+  template<size_t ...Indices>
+  Output callDerived(Evaluator &evaluator,
+                     llvm::index_sequence<Indices...>) const {
+    return asDerived().evaluate(evaluator, std::get<Indices>(storage)...);
+  }
+
+  template<size_t ...Indices>
+  static llvm::hash_code
+  hashStorage(const std::tuple<Inputs...> &storage,
+              llvm::index_sequence<Indices...>) {
+    return llvm::hash_combine(std::get<Indices>(storage)...);
+  }
+
+protected:
+  /// Retrieve the \c Index-th input value.
+  template<unsigned Index>
+  const typename std::tuple_element<Index, std::tuple<Inputs...>>::type &
+  getValue() const {
+    return std::get<Index>(storage);
+  }
+
+public:
+  using OutputType = Output;
+
+  static const bool isEverCached = (Caching != CacheKind::Uncached);
+  static const bool hasExternalCache = (Caching == CacheKind::SeparatelyCached);
+
+  explicit SimpleRequest(const Inputs & ...inputs) : storage(inputs...) { }
+
+  /// Evaluate this request using the given evaluator.
+  OutputType operator()(Evaluator &evaluator) const {
+    return callDerived(evaluator, llvm::index_sequence_for<Inputs...>());
+  }
+
+  friend bool operator==(const SimpleRequest &lhs, const SimpleRequest &rhs) {
+    return lhs.storage == rhs.storage;
+  }
+
+  friend bool operator!=(const SimpleRequest &lhs, const SimpleRequest &rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend llvm::hash_code hash_value(const SimpleRequest &request) {
+    return hashStorage(request.storage, llvm::index_sequence_for<Inputs...>());
+  }
+};
+
+} // end namespace swift
+
+#endif // SWIFT_AST_SIMPLEREQUEST_H
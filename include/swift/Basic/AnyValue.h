@@ -0,0 +1,74 @@
+//===--- AnyValue.h - Any Value Existential ---------------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the AnyValue class, which is used to store a
+//  value of any type.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_BASIC_ANYVALUE_H
+#define SWIFT_BASIC_ANYVALUE_H
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace swift {
+
+/// Stores a value of any type, which must be copy-constructible.
+///
+/// This is essentially a simplified \c std::any, which is not available
+/// until C++17.
+class AnyValue {
+  /// Abstract base class used to hold on to a value.
+  class HolderBase {
+  public:
+    HolderBase() = default;
+    HolderBase(const HolderBase &) = delete;
+    HolderBase &operator=(const HolderBase &) = delete;
+    virtual ~HolderBase() = default;
+  };
+
+  /// Holds a value of a specific type.
+  template<typename T>
+  class Holder final : public HolderBase {
+  public:
+    const T value;
+
+    Holder(T &&value) : value(std::move(value)) { }
+    Holder(const T &value) : value(value) { }
+  };
+
+  /// The stored value.
+  std::unique_ptr<HolderBase> stored;
+
+public:
+  /// Construct a new instance with the given value.
+  template<typename T>
+  AnyValue(T &&value)
+    : stored(new Holder<typename std::decay<T>::type>(
+               std::forward<T>(value))) { }
+
+  AnyValue(AnyValue &&other) = default;
+  AnyValue &operator=(AnyValue &&other) = default;
+
+  /// Cast to a specific (known) type; it is the caller's responsibility
+  /// to ensure that the stored value has this type.
+  template<typename T>
+  const T &castTo() const {
+    return static_cast<const Holder<T> *>(stored.get())->value;
+  }
+};
+
+} // end namespace swift
+
+#endif // SWIFT_BASIC_ANYVALUE_H
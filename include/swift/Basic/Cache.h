@@ -128,6 +128,27 @@ protected:
   /// Invokes \c remove on all keys.
   void removeAll();
 
+  /// Sets an upper bound on the total cost of the entries in the cache.
+  ///
+  /// \param Limit Maximum total cost; zero means unlimited.
+  ///
+  /// When an insertion pushes the total cost past the limit, the least
+  /// recently used entries are evicted (with the same callbacks as
+  /// \c remove()) until the cache fits again.  The most recently used
+  /// entry is never evicted, even if its cost alone exceeds the limit.
+  ///
+  /// Implementations that size themselves in response to memory pressure
+  /// (such as libcache on Darwin) are allowed to ignore the limit.
+  void setCostLimit(size_t Limit);
+
+  /// Sets an upper bound on the number of entries in the cache.
+  ///
+  /// \param Limit Maximum number of entries; zero means unlimited.
+  ///
+  /// Behaves like \c setCostLimit() with a count budget instead of a cost
+  /// budget.
+  void setEntryLimit(size_t Limit);
+
   /// Destroys cache.
   void destroy();
 };
@@ -192,6 +213,19 @@ public:
     removeAll();
   }
 
+  /// Limit the total cost of the cached values (as reported by the
+  /// \c CacheValueCostInfo trait); least recently used entries are evicted
+  /// to stay within the budget.  Zero means unlimited.
+  void setCostLimit(size_t Limit) {
+    CacheImpl::setCostLimit(Limit);
+  }
+
+  /// Limit the number of cached entries; least recently used entries are
+  /// evicted to stay within the budget.  Zero means unlimited.
+  void setEntryLimit(size_t Limit) {
+    CacheImpl::setEntryLimit(Limit);
+  }
+
 private:
   static uintptr_t keyHash(void *Key, void *UserData) {
     return KeyInfoT::getHashValue(*static_cast<KeyT*>(Key));
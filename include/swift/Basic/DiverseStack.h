@@ -17,6 +17,12 @@
 /// be trivially movable, meaning that it has a trivial move
 /// constructor and a trivial destructor.
 ///
+/// Storage is a single contiguous buffer and growing it relocates the
+/// entries; that is part of the contract, which is why objects must be
+/// trivially movable, why stable_iterator is an offset rather than a
+/// pointer, and why clients must not hold raw pointers to entries across
+/// a push.  Iteration, in exchange, is a linear walk over one buffer.
+///
 //===----------------------------------------------------------------------===//
 
 #ifndef SWIFT_BASIC_DIVERSESTACK_H
@@ -24,6 +30,7 @@
 
 #include "swift/Basic/Malloc.h"
 #include "llvm/Support/PointerLikeTypeTraits.h"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <utility>
@@ -65,6 +72,10 @@ public:
   /// The beginning of the allocation.
   char *Allocated;
 
+  /// The largest size, in bytes, the stack has reached, for clients that
+  /// want to report a high-water mark.
+  std::size_t HighWaterMark;
+
   bool isAllocatedInline() const {
     return (Allocated == reinterpret_cast<const char *>(this + 1));
   }
@@ -77,6 +88,7 @@ public:
   void initialize(char *end) {
     Begin = End = end;
     Allocated = reinterpret_cast<char*>(this + 1);
+    HighWaterMark = 0;
   }
   void copyFrom(const DiverseStackBase &other) {
     // Ensure that we're large enough to store all the data.
@@ -91,9 +103,12 @@ public:
     } else {
       pushNewStorageSlow(needed);
     }
+    HighWaterMark = std::max(HighWaterMark, std::size_t(End - Begin));
   }
   void pushNewStorageSlow(std::size_t needed);
 
+  std::size_t getHighWaterMark() const { return HighWaterMark; }
+
   /// A stable iterator is the equivalent of an index into the stack.
   /// It's an iterator that stays stable across modification of the
   /// stack.
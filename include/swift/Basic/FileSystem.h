@@ -13,10 +13,27 @@
 #ifndef SWIFT_BASIC_FILESYSTEM_H
 #define SWIFT_BASIC_FILESYSTEM_H
 
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Twine.h"
 #include <system_error>
 
+namespace llvm {
+  class raw_pwrite_stream;
+}
+
 namespace swift {
+  /// Invokes \p action with a stream writing to a uniquely named temporary
+  /// file, then atomically renames the temporary file to \p outputPath.
+  ///
+  /// If a file already exists at \p outputPath with the same contents, it is
+  /// left untouched and its modification time is preserved, so that build
+  /// systems watching the output do not see a spurious change. Readers of
+  /// \p outputPath never observe a partially written file. An \p outputPath
+  /// of "-" writes to stdout without any of this machinery.
+  std::error_code atomicallyWritingToFile(
+      llvm::StringRef outputPath,
+      llvm::function_ref<void(llvm::raw_pwrite_stream &)> action);
+
   /// Moves a file from \p source to \p destination, unless there is already
   /// a file at \p destination that contains the same data as \p source.
   ///
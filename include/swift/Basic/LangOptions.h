@@ -208,6 +208,10 @@ namespace swift {
     /// Should we use \c ASTScope-based resolution for unqualified name lookup?
     bool EnableASTScopeLookup = false;
 
+    /// Run the lexer on a producer thread ahead of the parser.
+    /// Experimental; see \c PipelinedLexer.
+    bool EnablePipelinedLexing = false;
+
     /// Whether to use the import as member inference system
     ///
     /// When importing a global, try to infer whether we can import it as a
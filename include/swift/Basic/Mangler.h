@@ -130,6 +130,7 @@ protected:
 
 #ifndef NDEBUG
   void recordOpStatImpl(StringRef op, size_t OldPos);
+  void recordCacheStatImpl(bool Hit);
 #endif
 
   void recordOpStat(StringRef op, size_t OldPos) {
@@ -138,6 +139,14 @@ protected:
 #endif
   }
 
+  /// Record a hit or miss of a mangled name cache in the mangling
+  /// statistics.
+  void recordCacheStat(bool Hit) {
+#ifndef NDEBUG
+    recordCacheStatImpl(Hit);
+#endif
+  }
+
   void appendOperator(StringRef op) {
     size_t OldPos = Storage.size();
     Buffer << op;
@@ -110,6 +110,12 @@ public:
     return OwnedString(Data, Length, StringOwnership::Copied);
   }
 
+  /// Returns true if the string owns heap memory that its destructor must
+  /// release.
+  bool isOwned() const {
+    return Ownership == StringOwnership::Copied;
+  }
+
   /// Returns the length of the string in bytes.
   size_t size() const {
     return Length;
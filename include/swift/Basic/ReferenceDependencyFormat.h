@@ -0,0 +1,64 @@
+//===--- ReferenceDependencyFormat.h - swiftdeps binary format --*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Constants shared by the frontend's reference-dependency (swiftdeps) writer
+// and the driver's reader for the compact binary encoding. The layout is,
+// with all integers little-endian:
+//
+//   'D' 'E' 'P' 'S'  <uint32 version>
+//   <uint32 string count> (<uint32 length> <bytes>)*
+//   (<uint8 section> <uint32 entry count> <entries>)*
+//
+// Entries are indices into the string table. Provides sections use one index
+// per entry; depends sections append a one-byte cascading flag; member
+// sections use two indices (mangled context, member name) in place of one.
+// The interface-hash section has a single entry and no flag.
+//
+// The YAML encoding remains supported for debugging; readers distinguish the
+// two by the magic number.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_BASIC_REFERENCEDEPENDENCYFORMAT_H
+#define SWIFT_BASIC_REFERENCEDEPENDENCYFORMAT_H
+
+#include <cstdint>
+
+namespace swift {
+namespace reference_dependencies {
+
+/// The first four bytes of a binary swiftdeps file.
+const char BinaryMagic[] = {'D', 'E', 'P', 'S'};
+
+/// Bumped whenever the encoding changes incompatibly. Readers must treat an
+/// unknown version as a malformed file.
+const uint32_t BinaryVersion = 1;
+
+/// The section codes of the binary encoding. These parallel the keys of the
+/// YAML encoding and must not be renumbered.
+enum class BinarySection : uint8_t {
+  ProvidesTopLevel = 0,
+  ProvidesNominal = 1,
+  ProvidesMember = 2,
+  ProvidesDynamicLookup = 3,
+  DependsTopLevel = 4,
+  DependsNominal = 5,
+  DependsMember = 6,
+  DependsDynamicLookup = 7,
+  DependsExternal = 8,
+  InterfaceHash = 9
+};
+
+} // end namespace reference_dependencies
+} // end namespace swift
+
+#endif
@@ -14,10 +14,12 @@
 #define SWIFT_BASIC_SOURCEMANAGER_H
 
 #include "swift/Basic/SourceLoc.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/SourceMgr.h"
 #include <map>
+#include <vector>
 
 namespace swift {
 
@@ -42,6 +44,20 @@ class SourceManager {
   std::map<const char *, VirtualFile> VirtualFiles;
   mutable std::pair<const char *, const VirtualFile*> CachedVFile = {nullptr, nullptr};
 
+  /// Per-buffer index of line start offsets, built lazily on the first
+  /// line/column query for a buffer. Avoids rescanning the buffer on every
+  /// query the way llvm::SourceMgr does.
+  mutable llvm::DenseMap<unsigned, std::vector<unsigned>> LineStartOffsets;
+
+  /// Return the (1-based) line and column for \p Loc using the line-offset
+  /// index. \p BufferID may be 0, in which case it is looked up.
+  std::pair<unsigned, unsigned> findLineAndColumn(SourceLoc Loc,
+                                                  unsigned BufferID) const;
+
+  /// Return the offsets of all line starts in \p BufferID, building the
+  /// index on first use.
+  ArrayRef<unsigned> getLineStartOffsets(unsigned BufferID) const;
+
 public:
   llvm::SourceMgr &getLLVMSourceMgr() {
     return LLVMSourceMgr;
@@ -183,9 +199,9 @@ public:
   getLineAndColumn(SourceLoc Loc, unsigned BufferID = 0) const {
     assert(Loc.isValid());
     int LineOffset = getLineOffset(Loc);
-    int l, c;
-    std::tie(l, c) = LLVMSourceMgr.getLineAndColumn(Loc.Value, BufferID);
-    assert(LineOffset+l > 0 && "bogus line offset");
+    unsigned l, c;
+    std::tie(l, c) = findLineAndColumn(Loc, BufferID);
+    assert(LineOffset+int(l) > 0 && "bogus line offset");
     return { LineOffset + l, c };
   }
 
@@ -196,7 +212,7 @@ public:
   /// This does not respect #line directives.
   unsigned getLineNumber(SourceLoc Loc, unsigned BufferID = 0) const {
     assert(Loc.isValid());
-    return LLVMSourceMgr.FindLineNumber(Loc.Value, BufferID);
+    return findLineAndColumn(Loc, BufferID).first;
   }
 
   StringRef getEntireTextForBuffer(unsigned BufferID) const;
@@ -18,6 +18,9 @@
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/Timer.h"
 
+#include <chrono>
+#include <functional>
+
 #define SWIFT_FUNC_STAT                                                 \
   do {                                                                  \
     static llvm::Statistic FStat =                                      \
@@ -91,6 +94,16 @@ public:
     virtual ~TraceFormatter();
   };
 
+  // A lighter-weight phase event used by -trace-chrome-events: just a
+  // monotonic timestamp and the (statically-allocated) phase name, with no
+  // counter reads on the hot path.  Cheap enough to leave on everywhere.
+  struct ChromeTraceEvent
+  {
+    uint64_t TimeUSec;
+    bool IsEntry;
+    StringRef EventName;
+  };
+
   struct FrontendStatsEvent
   {
     uint64_t TimeUSec;
@@ -110,6 +123,12 @@ public:
   // active at all. Reduces redundant machinery.
   class RecursionSafeTimers;
 
+  // Samples the current size in bytes of some memory arena that lives in a
+  // layer above lib/Basic (the ASTContext, a SILModule's bump allocator).
+  // Samplers are polled at every FrontendStatsTracer phase boundary, along
+  // with process-wide malloc usage, and feed per-phase high-water marks.
+  using MemoryCounterSampler = std::function<int64_t()>;
+
   // We also keep a few banks of optional hierarchical profilers for times and
   // statistics, activated with -profile-stats-events and
   // -profile-stats-entities, which are part way between the detail level of the
@@ -123,9 +142,14 @@ private:
   int currentProcessExitStatus;
   SmallString<128> StatsFilename;
   SmallString<128> TraceFilename;
+  SmallString<128> ChromeTraceFilename;
   SmallString<128> ProfileDirname;
   llvm::TimeRecord StartedTime;
 
+  // Time of construction on the monotonic clock; the base for the
+  // timestamps in ChromeTraceEvents.
+  std::chrono::time_point<std::chrono::steady_clock> ChromeTraceStartedAt;
+
   // This is unique_ptr because NamedRegionTimer is non-copy-constructable.
   std::unique_ptr<llvm::NamedRegionTimer> Timer;
 
@@ -135,6 +159,9 @@ private:
   Optional<AlwaysOnFrontendCounters> FrontendCounters;
   Optional<AlwaysOnFrontendCounters> LastTracedFrontendCounters;
   Optional<std::vector<FrontendStatsEvent>> FrontendStatsEvents;
+  Optional<std::vector<ChromeTraceEvent>> ChromeTraceEvents;
+  std::vector<std::pair<int64_t AlwaysOnFrontendCounters::*,
+                        MemoryCounterSampler>> MemorySamplers;
 
   // These are unique_ptr so we can use incomplete types here.
   std::unique_ptr<RecursionSafeTimers> RecursiveTimers;
@@ -151,7 +178,8 @@ private:
                        clang::SourceManager *CSM,
                        bool TraceEvents,
                        bool ProfileEvents,
-                       bool ProfileEntities);
+                       bool ProfileEntities,
+                       bool ChromeTrace);
 public:
   UnifiedStatsReporter(StringRef ProgramName,
                        StringRef ModuleName,
@@ -164,11 +192,27 @@ public:
                        clang::SourceManager *CSM=nullptr,
                        bool TraceEvents=false,
                        bool ProfileEvents=false,
-                       bool ProfileEntities=false);
+                       bool ProfileEntities=false,
+                       bool ChromeTrace=false);
   ~UnifiedStatsReporter();
 
+  /// Make a name safe for use in stats keys and filenames: any character
+  /// other than an alphanumeric or '.' becomes '_'.  Exposed so the driver
+  /// can match the per-job stats files written by frontend jobs.
+  static std::string cleanName(StringRef Name);
+
   AlwaysOnDriverCounters &getDriverCounters();
   AlwaysOnFrontendCounters &getFrontendCounters();
+
+  /// Install \p Sampler to be polled at each FrontendStatsTracer phase
+  /// boundary, recording its high-water mark in the always-on counter
+  /// designated by \p Counter. The sampler must stay valid until it is
+  /// removed: callers whose arena dies before the reporter (per-primary
+  /// SILModules) must pair this with removeMemorySampler.
+  void registerMemorySampler(int64_t AlwaysOnFrontendCounters::*Counter,
+                             MemoryCounterSampler Sampler);
+  void removeMemorySampler(int64_t AlwaysOnFrontendCounters::*Counter);
+
   void noteCurrentProcessExitStatus(int);
   void saveAnyFrontendStatsEvents(FrontendStatsTracer const &T, bool IsEntry);
 };
@@ -21,6 +21,13 @@ namespace unicode {
 
 StringRef extractFirstExtendedGraphemeCluster(StringRef S);
 
+/// Returns the length of the longest prefix of \p S in which every byte is
+/// trivially a single-scalar extended grapheme cluster: ASCII other than CR,
+/// not followed by a non-ASCII (potentially combining) character. Callers
+/// that walk a string cluster by cluster can consume such a prefix one byte
+/// at a time without consulting the break tables.
+size_t getTrivialSingleScalarClusterPrefixLength(StringRef S);
+
 static inline bool isSingleExtendedGraphemeCluster(StringRef S) {
   StringRef First = extractFirstExtendedGraphemeCluster(S);
   if (First.empty())
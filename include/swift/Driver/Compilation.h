@@ -140,6 +140,14 @@ private:
   /// If unknown, this will be some time in the past.
   llvm::sys::TimePoint<> LastBuildTime = llvm::sys::TimePoint<>::min();
 
+  /// How long each input took to compile during the last build, as read
+  /// from the build record.
+  ///
+  /// Used to hand long-running compilations to the task queue first, so
+  /// that they don't serialize the tail of the build. Inputs without an
+  /// entry have never been timed and get no special treatment.
+  llvm::StringMap<std::chrono::nanoseconds> PreviousBuildDurations;
+
   /// The number of commands which this compilation should attempt to run in
   /// parallel.
   unsigned NumberOfParallelCommands;
@@ -167,6 +175,12 @@ private:
   /// Provides a randomization seed to batch-mode partitioning, for debugging.
   unsigned BatchSeed;
 
+  /// An upper limit on the number of jobs combined into any one batch.
+  ///
+  /// When absent, batchable jobs are divided evenly among the parallel
+  /// tasks, no matter how large the resulting batches are.
+  Optional<unsigned> BatchSizeLimit;
+
   /// True if temporary files should not be deleted.
   bool SaveTemps;
 
@@ -210,6 +224,7 @@ public:
               bool EnableIncrementalBuild = false,
               bool EnableBatchMode = false,
               unsigned BatchSeed = 0,
+              Optional<unsigned> BatchSizeLimit = None,
               bool SkipTaskExecution = false,
               bool SaveTemps = false,
               bool ShowDriverTimeCompilation = false,
@@ -296,6 +311,11 @@ public:
     LastBuildTime = time;
   }
 
+  void setPreviousBuildDurations(
+      llvm::StringMap<std::chrono::nanoseconds> durations) {
+    PreviousBuildDurations = std::move(durations);
+  }
+
   /// Requests the path to a file containing all input source files. This can
   /// be shared across jobs.
   ///
@@ -159,6 +159,10 @@ private:
   /// Provides a randomization seed to batch-mode partitioning, for debugging.
   unsigned DriverBatchSeed = 0;
 
+  /// An upper limit on the number of jobs combined into any one batch,
+  /// overriding the default even division among parallel tasks.
+  Optional<unsigned> DriverBatchSizeLimit = None;
+
 public:
   Driver(StringRef DriverExecutable, StringRef Name,
          ArrayRef<const char *> Args, DiagnosticEngine &Diags);
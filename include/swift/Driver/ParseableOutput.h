@@ -21,6 +21,8 @@
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/TaskQueue.h"
 
+#include <string>
+
 namespace swift {
 namespace driver {
 
@@ -30,12 +32,20 @@ namespace parseable_output {
 
 using swift::sys::ProcessId;
 
+/// \brief A single frontend phase timing (in wall seconds), recovered from
+/// the UnifiedStatsReporter output of a finished job.
+struct PhaseTiming {
+  std::string Phase;
+  double WallSeconds;
+};
+
 /// \brief Emits a "began" message to the given stream.
 void emitBeganMessage(raw_ostream &os, const Job &Cmd, ProcessId Pid);
 
 /// \brief Emits a "finished" message to the given stream.
 void emitFinishedMessage(raw_ostream &os, const Job &Cmd, ProcessId Pid,
-                         int ExitStatus, StringRef Output);
+                         int ExitStatus, StringRef Output,
+                         ArrayRef<PhaseTiming> PhaseTimings = {});
 
 /// \brief Emits a "signalled" message to the given stream.
 void emitSignalledMessage(raw_ostream &os, const Job &Cmd, ProcessId Pid,
@@ -475,6 +475,25 @@ public:
   /// \brief Returns true if there was an error during setup.
   bool setup(const CompilerInvocation &Invocation);
 
+  /// Prepare this instance to run another compilation with a new
+  /// invocation, preserving the ASTContext -- and with it the stdlib, any
+  /// other loaded modules, the ClangImporter's state, and the identifier
+  /// table -- from the previous run.
+  ///
+  /// The new invocation must agree with the previous one on the language,
+  /// search path, and Clang importer options: the ASTContext and module
+  /// loaders configured from those options are kept as-is. The main module
+  /// and all other per-compilation state are discarded and rebuilt from
+  /// the new invocation's inputs. If the new main module has the same name
+  /// as the previous one, lookups through the context find the new module;
+  /// the previous module's declarations remain valid but unreachable.
+  ///
+  /// Not supported for invocations with a code completion point, nor for
+  /// performParseOnly(), which expects a fresh context.
+  ///
+  /// \returns true if there was an error during setup.
+  bool setupForReuse(const CompilerInvocation &Invocation);
+
 private:
   void setUpLLVMArguments();
   void setUpDiagnosticOptions();
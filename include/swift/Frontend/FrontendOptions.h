@@ -103,6 +103,7 @@ public:
     Typecheck,         ///< Parse and type-check only
     DumpParse,         ///< Parse only and dump AST
     DumpInterfaceHash, ///< Parse and dump the interface token hash.
+    ScanImports,       ///< Lex only and emit the imported module names
     EmitSyntax,        ///< Parse and dump Syntax tree as JSON
     DumpAST,           ///< Parse, type-check, and dump AST
     PrintAST,          ///< Parse, type-check, and pretty-print AST
@@ -171,15 +172,34 @@ public:
   /// entity.
   bool ProfileEntities = false;
 
+  /// Emit phase begin/end events in Chrome trace-event format to a file in
+  /// StatsOutputDir.  Unlike TraceStats this records no counters, only
+  /// timestamps, and is cheap enough to enable fleet-wide.
+  bool ChromeTraceEvents = false;
+
   /// If true, serialization encodes an extra lookup table for use in module-
   /// merging when emitting partial modules (the per-file modules in a non-WMO
   /// build).
   bool EnableSerializationNestedTypeLookupTable = true;
 
+  /// Emit reference-dependency (swiftdeps) files in the compact binary
+  /// format instead of YAML.
+  ///
+  /// \sa swift/Basic/ReferenceDependencyFormat.h
+  bool EnableBinaryReferenceDependencies = false;
+
   /// Indicates whether or not an import statement can pick up a Swift source
   /// file (as opposed to a module file).
   bool EnableSourceImport = false;
 
+  /// Skip parsing and type checking of function bodies that cannot be
+  /// required by a downstream module (everything except @_transparent,
+  /// @_inlineable, and @inline(__always) bodies).
+  ///
+  /// Only sound for module-emission-only jobs, which never generate code for
+  /// the skipped bodies.
+  bool SkipNonInlinableFunctionBodies = false;
+
   /// Indicates whether we are compiling for testing.
   ///
   /// \see ModuleDecl::isTestingEnabled
@@ -234,6 +254,10 @@ public:
   /// variables by name when we print it out. This eases diffing of SIL files.
   bool EmitSortedSIL = false;
 
+  /// When emitting the Syntax tree, use the compact binary format instead of
+  /// JSON.
+  bool EmitSyntaxBinaryFormat = false;
+
   /// The different modes for validating TBD against the LLVM IR.
   enum class TBDValidationMode {
     None,           ///< Do no validation.
@@ -295,6 +319,10 @@ private:
 public:
   static bool doesActionProduceOutput(ActionType);
   static bool doesActionProduceTextualOutput(ActionType);
+
+  /// \return true if the action reaches LLVM code generation (or the JIT)
+  /// and therefore needs the LLVM targets registered before it runs.
+  static bool doesActionRequireLLVM(ActionType);
   static bool needsProperModuleName(ActionType);
   static const char *suffixForPrincipalOutputFileForAction(ActionType);
 };
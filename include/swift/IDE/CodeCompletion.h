@@ -24,6 +24,10 @@
 #include <string>
 #include <vector>
 
+namespace llvm {
+class MemoryBuffer;
+}
+
 namespace swift {
 class CodeCompletionCallbacksFactory;
 class Decl;
@@ -779,6 +783,11 @@ struct CodeCompletionResultSink {
   /// other sinks.
   std::vector<AllocatorPtr> ForeignAllocators;
 
+  /// Buffers of on-disk completion cache files whose bytes are referenced
+  /// directly by results in this sink. Shared into the target sink when the
+  /// results are, so the strings outlive cache eviction.
+  std::vector<std::shared_ptr<llvm::MemoryBuffer>> SourceBuffers;
+
   std::vector<CodeCompletionResult *> Results;
 
   /// A single-element cache for module names stored in Allocator, keyed by a
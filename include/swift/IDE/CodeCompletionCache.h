@@ -55,6 +55,11 @@ public:
 
   struct Value : public llvm::ThreadSafeRefCountedBase<Value> {
     llvm::sys::TimePoint<> ModuleModificationTime;
+
+    /// The sink holding the results; for results deserialized from disk, it
+    /// also shares ownership of the cache file's buffer, whose bytes the
+    /// result strings reference directly (\see
+    /// CodeCompletionResultSink::SourceBuffers).
     CodeCompletionResultSink Sink;
   };
   using ValueRefCntPtr = llvm::IntrusiveRefCntPtr<Value>;
@@ -14,6 +14,7 @@
 #define SWIFT_MARKUP_MARKUP_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/raw_ostream.h"
 #include "swift/Basic/SourceLoc.h"
@@ -22,6 +23,8 @@
 
 namespace swift {
 
+class Decl;
+class DocComment;
 struct RawComment;
 
 namespace markup {
@@ -31,6 +34,10 @@ class LineList;
 class MarkupContext final {
   llvm::BumpPtrAllocator Allocator;
 
+  /// Doc comments already parsed through this context, so that repeated
+  /// requests for the same declaration do not re-run the markup parser.
+  llvm::DenseMap<const Decl *, DocComment *> ParsedComments;
+
 public:
   void *allocate(unsigned long Bytes, unsigned Alignment) {
     return Allocator.Allocate(Bytes, Alignment);
@@ -58,10 +65,29 @@ public:
   }
 
   LineList getLineList(swift::RawComment RC);
+
+  /// Return the memoized doc comment for \p D, or null if none was recorded.
+  DocComment *getParsedComment(const Decl *D) const {
+    return ParsedComments.lookup(D);
+  }
+
+  /// Record the parsed doc comment for \p D.
+  void setParsedComment(const Decl *D, DocComment *DC) {
+    ParsedComments[D] = DC;
+  }
 };
 
 Document *parseDocument(MarkupContext &MC, LineList &LL);
 
+/// Parse only the first contiguous run of non-blank lines of \p LL and
+/// return the paragraph it forms, if it forms one.
+///
+/// This yields the same paragraph a full \c parseDocument followed by brief
+/// extraction would: a blank line always ends the leading block, and the
+/// text after it cannot change the leading block's structure. It avoids
+/// building markup AST nodes for the remainder of the comment.
+Paragraph *parseBriefParagraph(MarkupContext &MC, LineList &LL);
+
 } // namespace markup
 } // namespace swift
 
@@ -13,6 +13,7 @@
 #ifndef SWIFT_PARSE_DELAYED_PARSING_CALLBACKS_H
 #define SWIFT_PARSE_DELAYED_PARSING_CALLBACKS_H
 
+#include "swift/AST/Attr.h"
 #include "swift/Basic/SourceLoc.h"
 #include "swift/Basic/SourceManager.h"
 #include "swift/Parse/Parser.h"
@@ -44,8 +45,37 @@ class AlwaysDelayedCallbacks : public DelayedParsingCallbacks {
   }
 };
 
+/// \brief Callbacks that skip every function body that cannot be required by
+/// a downstream module.
+///
+/// Used by module-emission-only frontend jobs: a body is parsed only if its
+/// attributes mean it must be serialized (@_transparent, @_inlineable, or
+/// @inline(__always)). Everything else is recorded as an unparsed body range
+/// and never revisited, exactly as non-primary files are treated today.
+class SkipNonInlinableDelayedCallbacks : public DelayedParsingCallbacks {
+  bool shouldDelayFunctionBodyParsing(Parser &TheParser,
+                                      AbstractFunctionDecl *AFD,
+                                      const DeclAttributes &Attrs,
+                                      SourceRange BodyRange) override {
+    if (Attrs.hasAttribute<TransparentAttr>() ||
+        Attrs.hasAttribute<InlineableAttr>())
+      return false;
+    if (auto *InlineA = Attrs.getAttribute<InlineAttr>())
+      if (InlineA->getKind() == InlineKind::Always)
+        return false;
+    return true;
+  }
+};
+
 /// \brief Implementation of callbacks that guide the parser in delayed
 /// parsing for code completion.
+///
+/// Only the body that contains the code completion point is delayed; every
+/// other body is recorded as an unparsed range and skipped outright, so a
+/// completion request never parses or type-checks function bodies that are
+/// unrelated to the completion point. The delayed body is re-parsed on the
+/// second pass and checked up to the completion point only (see
+/// CodeCompletionCallbacksImpl::typecheckContext).
 class CodeCompleteDelayedCallbacks : public DelayedParsingCallbacks {
   SourceLoc CodeCompleteLoc;
 public:
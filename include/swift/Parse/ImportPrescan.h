@@ -0,0 +1,61 @@
+//===--- ImportPrescan.h - Lexer-based import discovery ---------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Discovers the import declarations of a source buffer by lexing
+/// it, without parsing or building an AST.  Intended for build systems
+/// that need per-file dependencies before scheduling compilation.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_PARSE_IMPORTPRESCAN_H
+#define SWIFT_PARSE_IMPORTPRESCAN_H
+
+#include "swift/Basic/LLVM.h"
+#include "swift/Basic/SourceLoc.h"
+
+#include <string>
+
+namespace swift {
+
+class LangOptions;
+class SourceManager;
+
+/// \brief A single import declaration found by prescanImports.
+struct PrescannedImport {
+  /// The dotted import path as written, without any import-kind keyword:
+  /// "UIKit", "Foo.Bar", or "Swift.min" for "import func Swift.min".
+  std::string Path;
+
+  /// The location of the 'import' keyword.
+  SourceLoc Loc;
+
+  /// The top-level module name: the first component of the path.
+  StringRef moduleName() const {
+    return StringRef(Path).split('.').first;
+  }
+};
+
+/// \brief Collect the imports of a source buffer by lexing it.
+///
+/// Conditional compilation blocks are handled conservatively: imports in
+/// every #if branch are reported, over-approximating the true dependency
+/// set.  Any token soup that is not an import declaration is skipped, so
+/// the scan never fails; files that do not parse simply yield the imports
+/// that are recognizable.
+void prescanImports(const SourceManager &SM, unsigned BufferID,
+                    const LangOptions &LangOpts,
+                    SmallVectorImpl<PrescannedImport> &Imports);
+
+} // end namespace swift
+
+#endif // SWIFT_PARSE_IMPORTPRESCAN_H
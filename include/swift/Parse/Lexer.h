@@ -109,7 +109,13 @@ class Lexer {
   /// @}
 
   Token NextToken;
-  
+
+  /// The number of diagnostics dropped because no DiagnosticEngine was
+  /// attached. PipelinedLexer runs the producer thread with diagnostics
+  /// detached and uses changes in this count to decide which tokens need to
+  /// be re-lexed for diagnostics on the consumer thread.
+  unsigned NumSuppressedDiagnostics = 0;
+
   /// \brief This is true if we're lexing a .sil file instead of a .swift
   /// file.  This enables the 'sil' keyword.
   const bool InSILMode;
@@ -137,6 +143,10 @@ class Lexer {
   Lexer(const Lexer&) = delete;
   void operator=(const Lexer&) = delete;
 
+  /// PipelinedLexer detaches the diagnostic engine while its producer thread
+  /// owns this lexer and re-lexes flagged tokens on the consumer thread.
+  friend class PipelinedLexer;
+
   /// The principal constructor used by public constructors below.
   /// Don't use this constructor for other purposes, it does not initialize
   /// everything.
@@ -27,6 +27,7 @@
 #include "swift/AST/Stmt.h"
 #include "swift/Basic/OptionSet.h"
 #include "swift/Parse/Lexer.h"
+#include "swift/Parse/PipelinedLexer.h"
 #include "swift/Parse/LocalContext.h"
 #include "swift/Parse/PersistentParserState.h"
 #include "swift/Parse/Token.h"
@@ -114,6 +115,10 @@ public:
   DiagnosticEngine &Diags;
   SourceFile &SF;
   Lexer *L;
+  /// Non-null when the lexer runs on a producer thread ahead of the parser;
+  /// all mutating lexer access must go through it. \see LangOptions::
+  /// EnablePipelinedLexing.
+  std::unique_ptr<PipelinedLexer> PipelinedLex;
   SILParserTUStateBase *SIL; // Non-null when parsing a .sil file.
   PersistentParserState *State;
   std::unique_ptr<PersistentParserState> OwnedState;
@@ -377,7 +382,10 @@ public:
   }
 
   void restoreParserPosition(ParserPosition PP, bool enableDiagnostics = false) {
-    L->restoreState(PP.LS, enableDiagnostics);
+    if (PipelinedLex)
+      PipelinedLex->restoreState(PP.LS, enableDiagnostics);
+    else
+      L->restoreState(PP.LS, enableDiagnostics);
 
     // We might be at tok::eof now, so ensure that consumeToken() does not
     // assert about lexing past eof.
@@ -390,7 +398,10 @@ public:
   void backtrackToPosition(ParserPosition PP) {
     assert(PP.isValid());
 
-    L->backtrackToState(PP.LS);
+    if (PipelinedLex)
+      PipelinedLex->backtrackToState(PP.LS);
+    else
+      L->backtrackToState(PP.LS);
 
     // We might be at tok::eof now, so ensure that consumeToken() does not
     // assert about lexing past eof.
@@ -0,0 +1,139 @@
+//===--- PipelinedLexer.h - Background lexing ahead of the parser -*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_PARSE_PIPELINEDLEXER_H
+#define SWIFT_PARSE_PIPELINEDLEXER_H
+
+#include "swift/Parse/Lexer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace swift {
+
+/// \brief Runs a Lexer on a producer thread, keeping a bounded ring of tokens
+/// lexed ahead of the consumer.
+///
+/// The consumer-side interface mirrors the subset of Lexer the parser uses to
+/// advance and backtrack; restoring a lexer state discards the prefetched
+/// tokens and repositions the underlying lexer. All access to the wrapped
+/// Lexer is funneled through this class, so the parser must not call mutating
+/// Lexer methods directly while a PipelinedLexer is attached.
+///
+/// The producer runs with the lexer's DiagnosticEngine detached: the engine
+/// is not thread-safe, and emitting from the producer would surface lexer
+/// diagnostics up to a ring's worth of tokens ahead of the parse position.
+/// Tokens for which the lexer dropped a diagnostic are flagged in the ring
+/// and re-lexed with the engine attached when the consumer takes them, so
+/// diagnostics are emitted on the consumer thread, in source order, when the
+/// parser reaches the token they belong to.
+///
+/// The pipelined mode is gated behind an experimental flag and disabled for
+/// code completion, which relies on cutting the lexer off mid-buffer.
+class PipelinedLexer {
+  struct LexedToken {
+    Token Tok;
+    syntax::Trivia LeadingTrivia;
+    syntax::Trivia TrailingTrivia;
+    /// True if the producer dropped a diagnostic while scanning this token;
+    /// the consumer re-lexes the token with the engine attached before
+    /// handing it out.
+    bool HadSuppressedDiagnostic = false;
+  };
+
+  Lexer &L;
+
+  /// The diagnostic engine detached from the lexer while the producer owns
+  /// it. Suppressed diagnostics are replayed through it on the consumer
+  /// thread; reattached to the lexer on destruction.
+  DiagnosticEngine *Diags;
+
+  std::mutex Mutex;
+  std::condition_variable RingNotEmpty;
+  std::condition_variable RingNotFull;
+
+  /// Tokens lexed ahead of the consumer, oldest first.
+  std::deque<LexedToken> Ring;
+
+  /// The last token the producer lexed; repeated once the buffer is
+  /// exhausted, matching Lexer's behavior at eof.
+  LexedToken LastLexed;
+
+  /// Stable storage for the token returned by peekNextToken.
+  Token PeekSlot;
+
+  /// The lexer's suppressed-diagnostic count as of the last lex; a change
+  /// means the token the lexer is now positioned on had a diagnostic.
+  unsigned NumSuppressedSeen = 0;
+
+  /// Set when the most recent lex dropped a diagnostic; flags the next token
+  /// pushed into the ring.
+  bool PendingDiagnostic = false;
+
+  /// End of the replayed region. Tokens at or before this location already
+  /// had their diagnostics emitted; they are not replayed again when the
+  /// parser re-consumes them after backtracking.
+  SourceLoc MaxReplayedLoc;
+
+  /// The last token handed out by lex(). The re-lex for a flagged token
+  /// starts from its end, so diagnostics in the intervening trivia are
+  /// replayed as well.
+  Token PrevConsumedTok;
+
+  /// True once the producer has lexed eof for the current lexer state.
+  bool ReachedEOF = false;
+
+  /// Set by the destructor to shut the producer down.
+  bool Stopping = false;
+
+  enum : size_t {
+    /// How far ahead of the consumer the producer may run.
+    MaxRingSize = 512,
+    /// How many tokens the producer lexes per lock acquisition.
+    BatchSize = 32
+  };
+
+  std::thread Producer;
+
+  void producerLoop();
+
+  /// Re-lex \p LT with the diagnostic engine attached, emitting the
+  /// diagnostics the producer suppressed for it. Must be called with \c
+  /// Mutex held; does nothing for tokens already replayed once.
+  void replaySuppressedDiagnostics(const LexedToken &LT);
+
+public:
+  explicit PipelinedLexer(Lexer &L);
+  ~PipelinedLexer();
+
+  PipelinedLexer(const PipelinedLexer &) = delete;
+  PipelinedLexer &operator=(const PipelinedLexer &) = delete;
+
+  /// Pop the next token, blocking until the producer has lexed one.
+  void lex(Token &Result, syntax::Trivia &LeadingTriviaResult,
+           syntax::Trivia &TrailingTriviaResult);
+
+  /// Return the next token without consuming it.
+  const Token &peekNextToken();
+
+  /// Discard all prefetched tokens and restore the underlying lexer state.
+  void restoreState(Lexer::State S, bool enableDiagnostics = false);
+
+  /// Discard all prefetched tokens and backtrack the underlying lexer.
+  void backtrackToState(Lexer::State S);
+};
+
+} // end namespace swift
+
+#endif // SWIFT_PARSE_PIPELINEDLEXER_H
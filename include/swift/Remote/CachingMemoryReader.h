@@ -0,0 +1,153 @@
+//===--- CachingMemoryReader.h - Page-cached remote memory ------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file declares a MemoryReader which wraps another reader and caches
+//  remote memory in page-sized chunks.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_REMOTE_CACHINGMEMORYREADER_H
+#define SWIFT_REMOTE_CACHINGMEMORYREADER_H
+
+#include "swift/Remote/MemoryReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace swift {
+namespace remote {
+
+/// A MemoryReader which reads the remote process at page granularity
+/// through an underlying reader and serves subsequent reads from a local
+/// cache.
+///
+/// MetadataReader issues many small, heavily clustered reads: walking a
+/// metadata graph touches the same class metadata, field descriptors and
+/// mangled name strings over and over, and for an out-of-process reader
+/// each read is a full debugger round trip. Rounding reads up to pages
+/// collapses those clusters into one remote read per page.
+///
+/// Cached pages are never revalidated, so the cache is only sound while
+/// the remote process cannot run. Clients must call clearCache() whenever
+/// it is allowed to make progress.
+class CachingMemoryReader final : public MemoryReader {
+public:
+  /// The granularity of remote reads and of the cache, matching the most
+  /// common hardware page size. Memory protection is page-granular on the
+  /// remote side as well, so a whole-page read succeeds whenever any byte
+  /// of the page is readable.
+  static constexpr uint64_t PageSize = 4096;
+
+private:
+  std::shared_ptr<MemoryReader> Impl;
+  std::unordered_map<uint64_t, std::unique_ptr<uint8_t[]>> Pages;
+
+  /// Return the cached contents of the page starting at \p pageStart,
+  /// reading it from the remote process if necessary, or null if the page
+  /// could not be read.
+  const uint8_t *getPage(uint64_t pageStart) {
+    auto known = Pages.find(pageStart);
+    if (known != Pages.end())
+      return known->second.get();
+
+    std::unique_ptr<uint8_t[]> page(new uint8_t[PageSize]);
+    if (!Impl->readBytes(RemoteAddress(pageStart), page.get(), PageSize))
+      return nullptr;
+
+    auto inserted = Pages.emplace(pageStart, std::move(page));
+    return inserted.first->second.get();
+  }
+
+public:
+  explicit CachingMemoryReader(std::shared_ptr<MemoryReader> impl)
+      : Impl(std::move(impl)) {}
+
+  uint8_t getPointerSize() override {
+    return Impl->getPointerSize();
+  }
+
+  uint8_t getSizeSize() override {
+    return Impl->getSizeSize();
+  }
+
+  RemoteAddress getSymbolAddress(const std::string &name) override {
+    return Impl->getSymbolAddress(name);
+  }
+
+  bool readString(RemoteAddress address, std::string &dest) override {
+    return Impl->readString(address, dest);
+  }
+
+  bool readBytes(RemoteAddress address, uint8_t *dest,
+                 uint64_t size) override {
+    uint64_t addr = address.getAddressData();
+    while (size > 0) {
+      uint64_t pageStart = addr & ~(PageSize - 1);
+      uint64_t offset = addr - pageStart;
+      uint64_t chunk = std::min(size, PageSize - offset);
+      if (auto *page = getPage(pageStart)) {
+        memcpy(dest, page + offset, chunk);
+      } else if (!Impl->readBytes(RemoteAddress(addr), dest, chunk)) {
+        // The whole-page read can fail even though the requested bytes are
+        // readable if the remote page size is larger than ours; retry the
+        // exact range uncached before giving up.
+        return false;
+      }
+      addr += chunk;
+      dest += chunk;
+      size -= chunk;
+    }
+    return true;
+  }
+
+  /// Pull the pages covering the given remote range into the cache with a
+  /// single read from the underlying reader.
+  ///
+  /// Clients which know they are about to walk a contiguous structure
+  /// (such as a reflection section or a run of field descriptors) can use
+  /// this to pay for one round trip up front instead of one per page.
+  ///
+  /// Returns false if the range could not be read; the cache is unchanged
+  /// in that case.
+  bool prefetch(RemoteAddress address, uint64_t size) {
+    uint64_t first = address.getAddressData() & ~(PageSize - 1);
+    uint64_t last =
+        (address.getAddressData() + size + PageSize - 1) & ~(PageSize - 1);
+    uint64_t total = last - first;
+
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[total]);
+    if (!Impl->readBytes(RemoteAddress(first), buffer.get(), total))
+      return false;
+
+    for (uint64_t pageStart = first; pageStart < last;
+         pageStart += PageSize) {
+      if (Pages.count(pageStart))
+        continue;
+      std::unique_ptr<uint8_t[]> page(new uint8_t[PageSize]);
+      memcpy(page.get(), buffer.get() + (pageStart - first), PageSize);
+      Pages.emplace(pageStart, std::move(page));
+    }
+    return true;
+  }
+
+  /// Discard all cached pages. Must be called whenever the remote process
+  /// is allowed to run, since any cached memory may have changed.
+  void clearCache() {
+    Pages.clear();
+  }
+};
+
+} // end namespace remote
+} // end namespace swift
+
+#endif // SWIFT_REMOTE_CACHINGMEMORYREADER_H
@@ -211,6 +211,15 @@ public:
   /// Given a heap object, resolve its heap metadata.
   Result<remote::RemoteAddress>
   getHeapMetadataForObject(remote::RemoteAddress address);
+
+  /// Discard all memoized results of previous queries.
+  ///
+  /// Successful metadata and descriptor lookups are cached on this context
+  /// because their results cannot change while the remote process is
+  /// suspended.  Clients must call this whenever the remote process is
+  /// allowed to run again, since the addresses involved may be deallocated
+  /// or reused.
+  void clearCaches();
 };
 
 } // end namespace remoteAST
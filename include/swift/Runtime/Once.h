@@ -32,6 +32,14 @@ typedef long swift_once_t;
 // On Cygwin, std::once_flag can not be used because it is larger than the
 // platform word.
 typedef uintptr_t swift_once_t;
+
+#elif defined(__linux__)
+
+// On Linux, swift_once is implemented directly on futexes.  The predicate
+// is a word that starts at zero and holds -1 once initialization is
+// complete; the compiler emits an inline check for the -1 state on targets
+// where a plain load suffices (see SwiftTargetInfo.OnceDonePredicateValue).
+typedef intptr_t swift_once_t;
 #else
 
 // On other platforms swift_once_t is std::once_flag
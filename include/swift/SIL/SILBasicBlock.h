@@ -60,9 +60,17 @@ private:
 
   SILBasicBlock(SILFunction *F, SILBasicBlock *afterBB = nullptr);
 
+  /// Used by the ilist to destroy a block which was erased from its
+  /// function and return its memory to the module for reuse.
+  static void deleteNode(SILBasicBlock *BB);
+
 public:
   ~SILBasicBlock();
 
+  /// Custom version of 'new' which reuses the memory of erased basic blocks
+  /// before carving new memory out of the module's allocator.
+  void *operator new(size_t Bytes, SILModule &M);
+
   /// Gets the ID (= index in the function's block list) of the block.
   ///
   /// Returns -1 if the block is not contained in a function.
@@ -416,7 +424,7 @@ private:
   using block_iterator = simple_ilist<SILBasicBlock>::iterator;
 
 public:
-  static void deleteNode(SILBasicBlock *BB) { BB->~SILBasicBlock(); }
+  static void deleteNode(SILBasicBlock *BB) { SILBasicBlock::deleteNode(BB); }
 
   void transferNodesFromList(ilist_traits<SILBasicBlock> &SrcTraits,
                              block_iterator First, block_iterator Last);
@@ -131,6 +131,11 @@ private:
   /// Allocator that manages the memory of all the pieces of the SILModule.
   mutable llvm::BumpPtrAllocator BPA;
 
+  /// The memory of basic blocks which were erased from their function.
+  /// It is reused when new basic blocks are allocated, so that CFG
+  /// transformations don't monotonically grow the module's allocator.
+  llvm::SmallVector<void *, 4> FreeBlocks;
+
   /// The swift Module associated with this SILModule.
   ModuleDecl *TheSwiftModule;
 
@@ -673,6 +678,10 @@ public:
   /// Allocate memory using the module's internal allocator.
   void *allocate(unsigned Size, unsigned Align) const;
 
+  /// The number of bytes currently held by the module's allocator; sampled
+  /// by the stats reporter's per-phase memory tracking.
+  size_t getTotalMemory() const { return BPA.getTotalMemory(); }
+
   template <typename T> T *allocate(unsigned Count) const {
     return static_cast<T *>(allocate(sizeof(T) * Count, alignof(T)));
   }
@@ -695,6 +704,14 @@ public:
   /// Deallocate memory of an instruction.
   void deallocateInst(SILInstruction *I);
 
+  /// Allocate memory for a basic block, reusing the memory of an erased
+  /// basic block if one is available.
+  void *allocateBlock(unsigned Size, unsigned Align);
+
+  /// Reclaim the memory of an erased basic block for reuse by a
+  /// subsequently created block. The block must already be destructed.
+  void deallocateBlock(SILBasicBlock *BB);
+
   /// \brief Looks up the llvm intrinsic ID and type for the builtin function.
   ///
   /// \returns Returns llvm::Intrinsic::not_intrinsic if the function is not an
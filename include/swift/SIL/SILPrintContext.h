@@ -56,6 +56,11 @@ protected:
 
   llvm::DenseMap<const SILDebugScope *, unsigned> ScopeToIDMap;
 
+  /// Textual renderings of types, shared by all functions printed with this
+  /// context. SIL prints the same types over and over, and rendering them
+  /// through the AST printer dominates printing time for large modules.
+  llvm::DenseMap<CanType, std::string> TypeStrings;
+
   /// Dump more information in the SIL output.
   bool Verbose;
   
@@ -98,6 +103,12 @@ public:
 
   SILPrintContext::ID getID(const SILNode *node);
 
+  /// Returns the cache of rendered type strings. Only usable by printers
+  /// whose print options don't change how types are rendered.
+  llvm::DenseMap<CanType, std::string> &getTypeStringCache() {
+    return TypeStrings;
+  }
+
   /// Returns true if the \p Scope has and ID assigned.
   bool hasScopeID(const SILDebugScope *Scope) const {
     return ScopeToIDMap.count(Scope) != 0;
@@ -232,6 +232,14 @@ public:
   /// (see comment in DebugUtils.h).
   inline bool hasOneUse() const;
 
+  /// Returns true if this value has exactly \p N uses. Only walks at most
+  /// N + 1 entries of the use list, unlike counting all uses.
+  inline bool hasNUses(unsigned N) const;
+
+  /// Returns true if this value has \p N uses or more. Only walks at most
+  /// \p N entries of the use list, unlike counting all uses.
+  inline bool hasNUsesOrMore(unsigned N) const;
+
   /// Returns .some(single user) if this value has a single user. Returns .none
   /// otherwise.
   inline Operand *getSingleUse() const;
@@ -491,6 +499,18 @@ inline bool ValueBase::hasOneUse() const {
   if (I == E) return false;
   return ++I == E;
 }
+inline bool ValueBase::hasNUses(unsigned N) const {
+  auto I = use_begin(), E = use_end();
+  for (; N > 0; --N, ++I)
+    if (I == E) return false;
+  return I == E;
+}
+inline bool ValueBase::hasNUsesOrMore(unsigned N) const {
+  auto I = use_begin(), E = use_end();
+  for (; N > 0; --N, ++I)
+    if (I == E) return false;
+  return true;
+}
 inline Operand *ValueBase::getSingleUse() const {
   auto I = use_begin(), E = use_end();
 
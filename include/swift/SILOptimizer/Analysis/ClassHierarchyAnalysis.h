@@ -66,22 +66,29 @@ public:
   /// Returns a list of the known direct subclasses of a class \p C in
   /// the current module.
   const ClassList &getDirectSubClasses(ClassDecl *C) {
-    return DirectSubclassesCache[C];
+    // Note: don't use operator[] here. It would insert empty entries for
+    // leaf classes, which makes hasKnownDirectSubclasses report them as
+    // subclassed after the first query.
+    auto It = DirectSubclassesCache.find(C);
+    return It != DirectSubclassesCache.end() ? It->second : EmptyClassList;
   }
 
   /// Returns a list of the known indirect subclasses of a class \p C in
   /// the current module.
   const ClassList &getIndirectSubClasses(ClassDecl *C) {
-    if (!IndirectSubclassesCache.count(C)) {
-      // Lazy initialization
-      auto &K = IndirectSubclassesCache[C];
-      getIndirectSubClasses(C, K);
-    }
-    return IndirectSubclassesCache[C];
+    auto It = IndirectSubclassesCache.find(C);
+    if (It != IndirectSubclassesCache.end())
+      return It->second;
+    // Lazy initialization
+    auto &K = IndirectSubclassesCache[C];
+    getIndirectSubClasses(C, K);
+    return K;
   }
 
   const NominalTypeList &getProtocolImplementations(ProtocolDecl *P) {
-    return ProtocolImplementationsCache[P];
+    auto It = ProtocolImplementationsCache.find(P);
+    return It != ProtocolImplementationsCache.end() ? It->second
+                                                    : EmptyNominalTypeList;
   }
 
   /// Returns true if the class is inherited by another class in this module.
@@ -92,8 +99,8 @@ public:
   /// Returns true if the class is indirectly inherited by another class
   /// in this module.
   bool hasKnownIndirectSubclasses(ClassDecl *C) {
-    return IndirectSubclassesCache.count(C) &&
-           IndirectSubclassesCache[C].size() > 0;
+    auto It = IndirectSubclassesCache.find(C);
+    return It != IndirectSubclassesCache.end() && !It->second.empty();
   }
 
   /// Returns true if the protocol is implemented by any class in this module.
@@ -117,6 +124,11 @@ private:
 
   /// A cache that maps a protocol to all of its known implementations.
   ProtocolImplementations ProtocolImplementationsCache;
+
+  /// The lists returned for classes without known subclasses and for
+  /// protocols without known implementations.
+  const ClassList EmptyClassList;
+  const NominalTypeList EmptyNominalTypeList;
 };
 
 }
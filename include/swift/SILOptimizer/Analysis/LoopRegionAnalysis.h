@@ -1083,6 +1083,15 @@ public:
     return new LoopRegionFunctionInfo(F, POA->get(F), SLA->get(F));
   }
 
+  /// Invalidation is all-or-nothing at function granularity: any
+  /// branch-affecting change throws away the whole region tree even when it
+  /// touched a single loop. Recomputing only the enclosing regions would
+  /// first need a block-granular invalidation channel in SILAnalysis (passes
+  /// currently report only an InvalidationKind per function) and incremental
+  /// variants of SILLoopInfo and PostOrderFunctionInfo, since region IDs are
+  /// function-level RPO numbers and subregion structure mirrors the loop
+  /// tree. Until those exist, the FunctionAnalysisBase cache keeps this
+  /// tolerable: the rebuild is deferred to the next get() for that function.
   virtual bool shouldInvalidate(SILAnalysis::InvalidationKind K) override {
     return K & InvalidationKind::Branches;
   }
@@ -60,13 +60,17 @@ public:
     if (!value)
       return;
 
-    // Check the cache. If we don't find it, there is nothing to do.
-    auto Iter = RCCache.find(SILValue(value));
-    if (Iter == RCCache.end())
-      return;
-
-    // Then erase Iter from the cache.
-    RCCache.erase(Iter);
+    // Erase the cache entry keyed by the deleted value, if there is one.
+    RCCache.erase(SILValue(value));
+
+    // The deleted value may also be the cached root of other values, e.g.
+    // when the operand of a deleted cast is deleted right after it. Drop
+    // those entries as well so the cache never hands out a dangling root.
+    for (auto Iter = RCCache.begin(), End = RCCache.end(); Iter != End;) {
+      auto Cur = Iter++;
+      if (Cur->second == SILValue(value))
+        RCCache.erase(Cur);
+    }
   }
 
 private:
@@ -111,8 +115,12 @@ public:
     return new RCIdentityFunctionInfo(DA);
   }
 
+  /// Cached roots are derived by looking through instructions and block
+  /// arguments only, so they survive changes that merely affect the call
+  /// graph. Individual deleted values are handled eagerly by the delete
+  /// notifications above, independent of pass boundaries.
   virtual bool shouldInvalidate(SILAnalysis::InvalidationKind K) override {
-    return true;
+    return K & InvalidationKind::BranchesAndInstructions;
   }
 
  };
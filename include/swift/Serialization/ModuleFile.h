@@ -68,6 +68,11 @@ class ModuleFile
   llvm::BitstreamCursor SILIndexCursor;
   llvm::BitstreamCursor DeclMemberTablesCursor;
 
+  /// The cursor used to lazily read the index block.
+  ///
+  /// Only valid while \c HasLazyIndexBlock is set.
+  llvm::BitstreamCursor IndexCursor;
+
   /// The name of the module.
   StringRef Name;
   friend StringRef getNameOfModule(const ModuleFile *);
@@ -92,6 +97,18 @@ class ModuleFile
   /// modules, which are assumed to contain canonical SIL for an entire module.
   bool IsSIB = false;
 
+  /// Whether the index block has been saved in \c IndexCursor but not
+  /// actually read yet.
+  ///
+  /// \sa readIndexBlockIfNeeded()
+  bool HasLazyIndexBlock = false;
+
+  /// Whether the module documentation sidecar is present but has not been
+  /// read yet.
+  ///
+  /// \sa readModuleDocIfNeeded()
+  bool HasLazyModuleDoc = false;
+
   /// RAII class to be used when deserializing an entity.
   class DeserializingEntityRAII {
     ModuleFile &MF;
@@ -358,9 +375,14 @@ private:
   std::unique_ptr<SerializedDeclTable> ClassMembersForDynamicLookup;
   std::unique_ptr<SerializedDeclTable> OperatorMethodDecls;
   std::unique_ptr<SerializedExtensionTable> ExtensionDecls;
+  class DeclInterfaceHashTableInfo;
+  using SerializedDeclInterfaceHashTable =
+      llvm::OnDiskIterableChainedHashTable<DeclInterfaceHashTableInfo>;
+
   std::unique_ptr<SerializedLocalDeclTable> LocalTypeDecls;
   std::unique_ptr<SerializedNestedTypeDeclsTable> NestedTypeDecls;
   std::unique_ptr<SerializedDeclMemberNamesTable> DeclMemberNames;
+  std::unique_ptr<SerializedDeclInterfaceHashTable> DeclInterfaceHashes;
 
   llvm::DenseMap<uint32_t,
            std::unique_ptr<SerializedDeclMembersTable>> DeclMembersTables;
@@ -503,6 +525,11 @@ private:
   std::unique_ptr<SerializedDeclMemberNamesTable>
   readDeclMemberNamesTable(ArrayRef<uint64_t> fields, StringRef blobData);
 
+  /// Read an on-disk decl interface hash table stored in
+  /// index_block::DeclInterfaceHashesLayout format.
+  std::unique_ptr<SerializedDeclInterfaceHashTable>
+  readDeclInterfaceHashTable(ArrayRef<uint64_t> fields, StringRef blobData);
+
   /// Read an on-disk local decl-members hash table stored in
   /// index_block::DeclMembersLayout format.
   std::unique_ptr<SerializedDeclMembersTable>
@@ -518,6 +545,27 @@ private:
   /// Returns false if there was an error.
   bool readIndexBlock(llvm::BitstreamCursor &cursor);
 
+  /// Walks over the index block without setting up any of its tables,
+  /// picking out just the entry-point record, which is consulted as soon as
+  /// the module is wired into the AST.
+  ///
+  /// Returns false if there was an error.
+  bool skimIndexBlock(llvm::BitstreamCursor &cursor);
+
+  /// Reads the index block from \c IndexCursor if it hasn't been read yet.
+  ///
+  /// Most of the tables in the index block go unused when a module is merely
+  /// imported, so setting them up is deferred until a client first looks
+  /// into the module.
+  void readIndexBlockIfNeeded();
+
+  /// Reads the module documentation sidecar if it is present and has not
+  /// been read yet.
+  ///
+  /// The sidecar is strictly advisory, so a malformed one simply results in
+  /// no comments or group information being available.
+  void readModuleDocIfNeeded();
+
   /// Read an on-disk decl hash table stored in
   /// \c comment_block::DeclCommentListLayout format.
   std::unique_ptr<SerializedDeclCommentTable>
@@ -643,6 +691,16 @@ public:
   /// the given type.
   TypeDecl *lookupNestedType(Identifier name, const NominalTypeDecl *parent);
 
+  /// Returns the serialized interface hash of the top-level decl with the
+  /// given mangled name, if the module records one.
+  Optional<StringRef> getDeclInterfaceHash(StringRef MangledName);
+
+  /// Collects the mangled names of top-level decls whose interface hash
+  /// differs between this module file and \p other, including decls that
+  /// are only recorded in one of the two.
+  void collectDeclsWithChangedInterfaces(ModuleFile &other,
+                                         SmallVectorImpl<StringRef> &changed);
+
   /// Searches the module's operators for one with the given name and fixity.
   ///
   /// If none is found, returns null.
@@ -713,6 +771,15 @@ public:
   /// Adds all top-level decls to the given vector.
   void getTopLevelDecls(SmallVectorImpl<Decl*> &Results);
 
+  /// Materializes every decl in this module, in the order their records
+  /// appear in the file.
+  ///
+  /// Clients that know upfront they will touch everything (debuggers,
+  /// module dumpers) can call this to replace the seek-heavy access pattern
+  /// the lookup tables would otherwise impose with one forward sweep over
+  /// the decl block.
+  void preloadAllDecls();
+
   /// Adds all local type decls to the given vector.
   void getLocalTypeDecls(SmallVectorImpl<TypeDecl*> &Results);
 
@@ -754,15 +821,15 @@ public:
   GenericEnvironment *loadGenericEnvironment(const DeclContext *decl,
                                              uint64_t contextData) override;
 
-  Optional<StringRef> getGroupNameById(unsigned Id) const;
-  Optional<StringRef> getSourceFileNameById(unsigned Id) const;
-  Optional<StringRef> getGroupNameForDecl(const Decl *D) const;
-  Optional<StringRef> getSourceFileNameForDecl(const Decl *D) const;
-  Optional<unsigned> getSourceOrderForDecl(const Decl *D) const;
-  void collectAllGroups(std::vector<StringRef> &Names) const;
-  Optional<CommentInfo> getCommentForDecl(const Decl *D) const;
-  Optional<CommentInfo> getCommentForDeclByUSR(StringRef USR) const;
-  Optional<StringRef> getGroupNameByUSR(StringRef USR) const;
+  Optional<StringRef> getGroupNameById(unsigned Id);
+  Optional<StringRef> getSourceFileNameById(unsigned Id);
+  Optional<StringRef> getGroupNameForDecl(const Decl *D);
+  Optional<StringRef> getSourceFileNameForDecl(const Decl *D);
+  Optional<unsigned> getSourceOrderForDecl(const Decl *D);
+  void collectAllGroups(std::vector<StringRef> &Names);
+  Optional<CommentInfo> getCommentForDecl(const Decl *D);
+  Optional<CommentInfo> getCommentForDeclByUSR(StringRef USR);
+  Optional<StringRef> getGroupNameByUSR(StringRef USR);
 
   Identifier getDiscriminatorForPrivateValue(const ValueDecl *D);
 
@@ -55,15 +55,17 @@ const uint16_t VERSION_MAJOR = 0;
 /// describe what change you made. The content of this comment isn't important;
 /// it just ensures a conflict if two people change the module format.
 /// Don't worry about adhering to the 80-column limit for this line.
-const uint16_t VERSION_MINOR = 402; // Last change: effects(releasenone)
+const uint16_t VERSION_MINOR = 404; // Last change: compact identifier and ID encoding
 
-using DeclIDField = BCFixed<31>;
+// Most IDs a record refers to are small, so they are stored as variable-width
+// integers: only the rare reference to a late entity pays for its magnitude.
+using DeclIDField = BCVBR<6>;
 
 // TypeID must be the same as DeclID because it is stored in the same way.
 using TypeID = DeclID;
 using TypeIDField = DeclIDField;
 
-using TypeIDWithBitField = BCFixed<32>;
+using TypeIDWithBitField = BCVBR<6>;
 
 // IdentifierID must be the same as DeclID because it is stored in the same way.
 using IdentifierID = DeclID;
@@ -1580,7 +1582,11 @@ namespace index_block {
     DECL_MEMBER_NAMES,
 
     GENERIC_SIGNATURE_OFFSETS,
-    LastRecordKind = GENERIC_SIGNATURE_OFFSETS,
+
+    /// The interface hashes of the module's top-level decls, which let
+    /// clients tell whether a decl they depend on actually changed.
+    DECL_INTERFACE_HASHES,
+    LastRecordKind = DECL_INTERFACE_HASHES,
   };
   
   constexpr const unsigned RecordIDFieldWidth = 5;
@@ -1632,6 +1638,12 @@ namespace index_block {
     ENTRY_POINT,
     DeclIDField  // the ID of the main class; 0 if there was a main source file
   >;
+
+  using DeclInterfaceHashesLayout = BCRecordLayout<
+    DECL_INTERFACE_HASHES, // record ID
+    BCVBR<16>,  // table offset within the blob (see below)
+    BCBlob  // map from mangled decl names to interface hashes
+  >;
 }
 
 /// \sa DECL_MEMBER_TABLES_BLOCK_ID
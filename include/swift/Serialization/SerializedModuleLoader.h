@@ -173,6 +173,10 @@ public:
 
   virtual void getTopLevelDecls(SmallVectorImpl<Decl*> &results) const override;
 
+  /// Materializes every decl in this file in one forward sweep over the
+  /// module, for clients that know upfront they will touch everything.
+  void preloadAllDecls() const;
+
   virtual void
   getLocalTypeDecls(SmallVectorImpl<TypeDecl*> &results) const override;
 
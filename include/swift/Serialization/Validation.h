@@ -139,9 +139,14 @@ public:
 /// \param[out] extendedInfo If present, will be populated with additional
 /// compilation options serialized into the AST at build time that may be
 /// necessary to load it properly.
+/// \param requiresModuleSize If true, scan to the end of the module so that
+/// the returned \c bytes field is filled in. Everything the compatibility
+/// check needs lives in the control block at the front of the file, so by
+/// default validation stops there and never touches the rest of the module.
 ValidationInfo
 validateSerializedAST(StringRef data,
-                      ExtendedValidationInfo *extendedInfo = nullptr);
+                      ExtendedValidationInfo *extendedInfo = nullptr,
+                      bool requiresModuleSize = false);
 
 } // end namespace serialization
 } // end namespace swift
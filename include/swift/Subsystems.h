@@ -28,6 +28,7 @@
 #include "llvm/Support/Mutex.h"
 
 #include <memory>
+#include <system_error>
 
 namespace llvm {
   class GlobalVariable;
@@ -133,6 +134,28 @@ namespace swift {
                               bool TokenizeInterpolatedString = true,
                               ArrayRef<Token> SplitTokens = ArrayRef<Token>());
 
+  /// \brief Incrementally update a token stream after an edit, re-lexing only
+  /// the damaged region.
+  ///
+  /// \param OldTokens a stream previously produced by \c tokenize (without
+  ///                  interpolated-string splitting) for \p OldBufferID.
+  /// \param EditOffset the byte offset of the edit in the old buffer.
+  /// \param OldLength the number of bytes the edit replaced.
+  /// \param NewLength the number of bytes the edit inserted.
+  ///
+  /// Re-lexes from just before the edit until the token stream realigns with
+  /// the unchanged suffix of \p OldTokens, then splices the remaining old
+  /// tokens back in, pointing at \p NewBufferID at adjusted offsets. Both
+  /// buffers must be registered with \p SM.
+  std::vector<Token> relexAfterEdit(const LangOptions &LangOpts,
+                                    const SourceManager &SM,
+                                    unsigned OldBufferID, unsigned NewBufferID,
+                                    ArrayRef<Token> OldTokens,
+                                    unsigned EditOffset, unsigned OldLength,
+                                    unsigned NewLength,
+                                    DiagnosticEngine *Diags = nullptr,
+                                    bool KeepComments = true);
+
   /// Once parsing is complete, this walks the AST to resolve imports, record
   /// operators, and do other top-level validation.
   ///
@@ -250,6 +273,30 @@ namespace swift {
   void serialize(ModuleOrSourceFile DC, const SerializationOptions &options,
                  const SILModule *M = nullptr);
 
+  /// Serializes a module or single source file to in-memory buffers instead
+  /// of the output files named in \p options.
+  ///
+  /// The AST and SIL are only inspected while this function runs. Writing the
+  /// buffers out afterwards with \c writeSerializedBuffer needs no compiler
+  /// state at all, so it can be overlapped with later stages of the
+  /// compilation.
+  void serializeToBuffers(ModuleOrSourceFile DC,
+                          const SerializationOptions &options,
+                          std::unique_ptr<llvm::MemoryBuffer> *moduleBuffer,
+                          std::unique_ptr<llvm::MemoryBuffer> *moduleDocBuffer,
+                          const SILModule *M = nullptr);
+
+  /// Writes a buffer produced by \c serializeToBuffers to \p outputPath,
+  /// leaving the existing file untouched if the contents are unchanged.
+  ///
+  /// Unlike \c serialize, this performs only file I/O, so it is safe to call
+  /// from a thread other than the one that owns the ASTContext. On failure,
+  /// \p problematicPath names the path to report when diagnosing the returned
+  /// error code.
+  std::error_code writeSerializedBuffer(StringRef outputPath,
+                                        const llvm::MemoryBuffer &buffer,
+                                        std::string &problematicPath);
+
   /// Get the CPU, subtarget feature options, and triple to use when emitting code.
   std::tuple<llvm::TargetOptions, std::string, std::vector<std::string>,
              std::string>
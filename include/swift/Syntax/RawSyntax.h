@@ -20,6 +20,12 @@
 // be shared for expressions like 1 + 1 + 1 + 1 - you don't need 7 syntax nodes
 // to express that at this layer.
 //
+// Each node is a single tail-allocated slab: the child pointers of a layout
+// node, or the text and trivia pieces of a token node, live inline after the
+// node header (see the llvm::TrailingObjects base). Constructing a node is
+// therefore one allocation, and walking a node's children touches contiguous
+// memory. Do not add out-of-line owned storage to this class.
+//
 // These are internal implementation ONLY - do not expose anything involving
 // RawSyntax publicly. Clients of lib/Syntax should not be aware that they
 // exist.
@@ -284,6 +290,10 @@ public:
     return llvm::ThreadSafeRefCountedBase<RawSyntax>::Retain();
   }
 
+  /// Returns true if this node's memory is managed by a \c SyntaxArena
+  /// rather than by reference counting.
+  bool isManualMemory() const { return bool(Bits.ManualMemory); }
+
   /// \name Factory methods.
   /// @{
   
@@ -0,0 +1,87 @@
+//===--- SyntaxBinarySerialization.h - Binary Syntax Serialization -*- C++ -*-//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This file provides a compact binary serialization of RawSyntax trees, as an
+// alternative to the JSON form in SyntaxSerialization.h for consumers that
+// care about payload size and decode speed.
+//
+// The wire format is, in order:
+//
+//   magic:   the four bytes 'S' 'S' 'Y' 'N'
+//   version: uint32, little-endian; this file describes version 1
+//   root:    one node
+//
+// All other integers are unsigned LEB128. A node is:
+//
+//   node := <payload-size> <payload>
+//
+// where <payload-size> is the byte length of <payload>, so a reader can skip
+// a subtree it does not care about. A payload of size zero denotes a null
+// child in a layout (an absent optional element); real nodes always have a
+// non-empty payload. A non-null payload is:
+//
+//   payload := <syntax-kind> <presence> <token-or-layout-body>
+//
+// <syntax-kind> is the numeric value of the node's SyntaxKind and <presence>
+// a single byte, 1 for Present and 0 for Missing. If the kind is Token, the
+// body is:
+//
+//   <token-kind> <text:string> <num-leading> <leading:trivia...>
+//   <num-trailing> <trailing:trivia...>
+//
+// otherwise it is:
+//
+//   <num-children> <children:node...>
+//
+// Strings and trivia pieces are interned in order of first appearance. A
+// string is:
+//
+//   string := 0 <length> <bytes>   -- first occurrence; assigned the next
+//                                     1-based index
+//          := <index>              -- reference to an earlier occurrence
+//
+// and a trivia piece is:
+//
+//   trivia := 0 <trivia-kind> <count> <text:string>  -- first occurrence;
+//                                                       assigned the next
+//                                                       1-based index
+//          := <index>                                -- earlier occurrence
+//
+// For trivia kinds made of a repeated character (spaces, newlines, ...)
+// <count> carries the repeat count and <text> is empty; for textual trivia
+// (comments, garbage text) <count> is one and <text> carries the bytes.
+//
+// The numeric values of SyntaxKind, tok, and TriviaKind are those of the
+// enums generated from the gyb syntax definitions; producer and consumer
+// must be generated from the same definitions, which is also what the JSON
+// form requires of its enum case names.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SYNTAX_SERIALIZATION_SYNTAXBINARYSERIALIZATION_H
+#define SWIFT_SYNTAX_SERIALIZATION_SYNTAXBINARYSERIALIZATION_H
+
+#include "swift/Syntax/RawSyntax.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace swift {
+namespace syntax {
+
+/// Serialize the syntax tree rooted at \p Root to \p OS in the binary format
+/// described in this file's header comment.
+void serializeRawSyntaxAsBinary(const RC<RawSyntax> &Root,
+                                llvm::raw_ostream &OS);
+
+} // end namespace syntax
+} // end namespace swift
+
+#endif // SWIFT_SYNTAX_SERIALIZATION_SYNTAXBINARYSERIALIZATION_H
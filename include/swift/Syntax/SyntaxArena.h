@@ -36,7 +36,13 @@ public:
 
   llvm::BumpPtrAllocator &getAllocator() const;
   void *Allocate(size_t size, size_t alignment);
-  void *AllocateRawSyntax(size_t size, size_t alignment);
+
+  /// Allocate memory for a RawSyntax node. If \p NeedsDestruction is false
+  /// the node's destructor is known to be a no-op and the arena does not
+  /// track the allocation for destruction, which keeps fully arena-owned
+  /// trees free of any per-node bookkeeping.
+  void *AllocateRawSyntax(size_t size, size_t alignment,
+                          bool NeedsDestruction = true);
 };
 
 } // namespace syntax
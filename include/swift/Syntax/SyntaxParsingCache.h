@@ -0,0 +1,95 @@
+//===--- SyntaxParsingCache.h - Incremental syntax parsing lookup -*- C++ -*-=//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SYNTAX_SYNTAXPARSINGCACHE_H
+#define SWIFT_SYNTAX_SYNTAXPARSINGCACHE_H
+
+#include "swift/Syntax/Syntax.h"
+#include "llvm/ADT/Optional.h"
+#include <vector>
+
+namespace swift {
+namespace syntax {
+
+/// A single textual replacement: the bytes in the half-open range
+/// [Start, End) of the pre-edit buffer were replaced by \c ReplacementLength
+/// new bytes.
+struct SourceEdit {
+  /// The byte offset in the pre-edit buffer at which the edit starts.
+  size_t Start;
+
+  /// The byte offset in the pre-edit buffer at which the edit ends
+  /// (exclusive).
+  size_t End;
+
+  /// The number of bytes the replaced range was substituted with.
+  size_t ReplacementLength;
+
+  /// The number of bytes the edit replaced.
+  size_t originalLength() const { return End - Start; }
+
+  /// Check if the characters replaced by this edit fall into the given range
+  /// or are directly adjacent to it.
+  bool intersectsOrTouchesRange(size_t RangeStart, size_t RangeEnd) const {
+    return End >= RangeStart && Start <= RangeEnd;
+  }
+};
+
+/// Reuses nodes of a syntax tree built by a previous parse of the same file.
+///
+/// Because syntax nodes are immutable and hold no absolute positions, a
+/// subtree that lies entirely outside every edited region can be taken over
+/// into the new tree by identity; only the nodes on the path from the root to
+/// each edit need to be rebuilt. Clients record the edits made since the old
+/// tree was built with \c addEdit, and then ask via \c lookUp whether the node
+/// starting at a given position in the post-edit buffer can be reused.
+class SyntaxParsingCache {
+  /// The tree produced by the previous parse.
+  Syntax OldTree;
+
+  /// The edits that were made since \c OldTree was built, in source order.
+  /// Edits must not overlap.
+  std::vector<SourceEdit> Edits;
+
+public:
+  explicit SyntaxParsingCache(Syntax OldTree) : OldTree(OldTree) {}
+
+  /// Record an edit that replaced the bytes in the pre-edit range
+  /// [Start, End) with \p ReplacementLength new bytes.
+  void addEdit(size_t Start, size_t End, size_t ReplacementLength) {
+    assert((Edits.empty() || Edits.back().End <= Start) &&
+           "edits must be added in source order and must not overlap");
+    Edits.push_back({Start, End, ReplacementLength});
+  }
+
+  /// Look up a node of the given \p Kind that starts at \p NewPosition in the
+  /// post-edit buffer and whose source range was not affected by any of the
+  /// recorded edits. Returns the node from the old tree if one exists; the
+  /// caller may splice it into the new tree unchanged.
+  llvm::Optional<Syntax> lookUp(size_t NewPosition, SyntaxKind Kind) const;
+
+private:
+  llvm::Optional<Syntax> lookUpFrom(const Syntax &Node, size_t NodeStart,
+                                    size_t Position, SyntaxKind Kind) const;
+
+  bool nodeCanBeReused(const Syntax &Node, size_t NodeStart, size_t Position,
+                       SyntaxKind Kind) const;
+
+  /// Map a position in the post-edit buffer back to the corresponding
+  /// position in the buffer the old tree was built from.
+  size_t translateToPreEditPosition(size_t PostEditPosition) const;
+};
+
+} // end namespace syntax
+} // end namespace swift
+
+#endif // SWIFT_SYNTAX_SYNTAXPARSINGCACHE_H
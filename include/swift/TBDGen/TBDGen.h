@@ -12,9 +12,13 @@
 #ifndef SWIFT_IRGEN_TBDGEN_H
 #define SWIFT_IRGEN_TBDGEN_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 
+#include <string>
+#include <vector>
+
 namespace llvm {
 class raw_ostream;
 }
@@ -23,13 +27,26 @@ namespace swift {
 class FileUnit;
 class ModuleDecl;
 
+/// An in-process cache of the public symbols contributed by each file of a
+/// module, enumerated with whole-module linkage. A frontend job that both
+/// emits a TBD file and validates it against the IR otherwise walks every
+/// file's decls twice; the AST no longer changes between the two, so the
+/// second walk can reuse the first. Reusing symbol sets across frontend
+/// invocations (keyed on each file's interface hash) additionally needs the
+/// sets to be persisted somewhere the next job can read them back, which
+/// does not exist yet; until then this only deduplicates work within a job.
+struct TBDSymbolCache {
+  llvm::DenseMap<FileUnit *, std::vector<std::string>> PerFileSymbols;
+};
+
 void enumeratePublicSymbols(FileUnit *module, llvm::StringSet<> &symbols,
                             bool hasMultipleIGMs);
 void enumeratePublicSymbols(ModuleDecl *module, llvm::StringSet<> &symbols,
-                            bool hasMultipleIGMs);
+                            bool hasMultipleIGMs,
+                            TBDSymbolCache *cache = nullptr);
 
 void writeTBDFile(ModuleDecl *M, llvm::raw_ostream &os, bool hasMultipleIGMs,
-                  llvm::StringRef installName);
+                  llvm::StringRef installName, TBDSymbolCache *cache = nullptr);
 
 } // end namespace swift
 
@@ -44,11 +44,15 @@
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Lex/Preprocessor.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/MutexGuard.h"
 #include <algorithm>
 #include <memory>
 
@@ -115,7 +119,18 @@ struct ASTContext::Implementation {
   /// The last resolver.
   LazyResolver *Resolver = nullptr;
 
-  llvm::StringMap<char, llvm::BumpPtrAllocator&> IdentifierTable;
+  /// The identifier uniquing table is sharded by string hash so that
+  /// multiple threads can intern identifiers without serializing on a
+  /// single lock. Each shard owns its allocator; identifier text lives as
+  /// long as the ASTContext either way.
+  struct IdentifierTableShard {
+    llvm::sys::Mutex Mutex;
+    llvm::BumpPtrAllocator Allocator;
+    llvm::StringMap<char, llvm::BumpPtrAllocator &> Table;
+    IdentifierTableShard() : Table(Allocator) {}
+  };
+  enum { NumIdentifierShards = 16 };
+  IdentifierTableShard IdentifierTableShards[NumIdentifierShards];
 
   /// The declaration of Swift.AssignmentPrecedence.
   PrecedenceGroupDecl *AssignmentPrecedence = nullptr;
@@ -227,6 +242,10 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
   /// \brief Map from Swift declarations to brief comments.
   llvm::DenseMap<const Decl *, StringRef> BriefComments;
 
+  /// \brief Map from Swift declarations and mangling parameters to mangled
+  /// names.
+  llvm::DenseMap<std::pair<const Decl *, unsigned>, StringRef> MangledNames;
+
   /// \brief Map from local declarations to their discriminators.
   /// Missing entries implicitly have value 0.
   llvm::DenseMap<const ValueDecl *, unsigned> LocalDiscriminators;
@@ -260,10 +279,62 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
 
   /// Canonical generic environments for canonical generic signatures.
   ///
-  /// The keys are the generic signature builders in \c GenericSignatureBuilders.
-  llvm::DenseMap<GenericSignatureBuilder *, GenericEnvironment *>
+  /// Keyed by the canonical signature itself, so that looking up an
+  /// environment which already exists doesn't force the corresponding
+  /// generic signature builder into existence.
+  llvm::DenseMap<GenericSignature *, GenericEnvironment *>
     CanonicalGenericEnvironments;
   
+  /// Memoized results of ModuleDecl::lookupConformance, including negative
+  /// results. Negative entries are tagged with the generation at which they
+  /// were computed, since loading another module can introduce conformances
+  /// that were not previously visible. Guarded by ConformanceLookupCacheMutex
+  /// so that lookups can safely run concurrently.
+  struct ConformanceLookupCacheEntry {
+    Optional<ProtocolConformanceRef> Conformance;
+    unsigned Generation;
+  };
+  llvm::sys::Mutex ConformanceLookupCacheMutex;
+  llvm::DenseMap<std::pair<TypeBase *,
+                           std::pair<ProtocolDecl *, ModuleDecl *>>,
+                 ConformanceLookupCacheEntry> ConformanceLookupCache;
+
+  /// Memoized results of top-level module name lookups. Entries are tagged
+  /// with both the context generation, since loading another module can make
+  /// more declarations visible, and the module-lookup epoch, which is bumped
+  /// whenever a file's set of imports changes within a generation (e.g. a
+  /// REPL 'import' of an already-loaded module).
+  struct ModuleLookupCacheEntry {
+    unsigned Generation;
+    unsigned Epoch;
+    std::vector<ValueDecl *> Decls;
+  };
+  llvm::DenseMap<std::pair<ModuleDecl *,
+                           std::pair<void *, /*DeclName opaque*/
+                                     std::pair<const DeclContext *, unsigned>>>,
+                 ModuleLookupCacheEntry> ModuleLookupCache;
+
+  /// The current module-lookup epoch; see ModuleLookupCache.
+  unsigned ModuleLookupEpoch = 0;
+
+  /// Memoized results of qualified lookups. Entries are tagged with both
+  /// the context generation and the qualified-lookup epoch, which is bumped
+  /// whenever a member or extension is added to any nominal type, so a hit
+  /// is only valid while the type hierarchies it walked are unchanged.
+  llvm::DenseMap<std::pair<const DeclContext *,
+                           std::pair<TypeBase *,
+                                     std::pair<void *, /*DeclName opaque*/
+                                               unsigned>>>,
+                 ASTContext::QualifiedLookupCacheEntry> QualifiedLookupCache;
+
+  /// The current qualified-lookup epoch; see QualifiedLookupCache.
+  unsigned QualifiedLookupEpoch = 0;
+
+  /// Memoized USRs, keyed by declaration and accessor kind. A declaration's
+  /// USR never changes once it can be computed, so entries are never
+  /// invalidated.
+  llvm::DenseMap<std::pair<const ValueDecl *, unsigned>, StringRef> USRs;
+
   /// The single-parameter generic signature with no constraints, <T>.
   CanGenericSignature SingleGenericParameterSignature;
 
@@ -370,6 +441,27 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
   /// \brief The permanent arena.
   Arena Permanent;
 
+  /// The hottest permanent-arena type uniquing tables are sharded by key
+  /// hash, with one mutex and one node allocator per shard, so that the
+  /// most common type constructions can proceed from several threads
+  /// without funneling through a global lock. Each shard owns the memory
+  /// of the nodes it uniques, so creating a type never touches the
+  /// context's main allocator. Types whose recursive properties place
+  /// them in the constraint solver arena never take this path; that
+  /// arena is strictly confined to the thread running the solver and
+  /// stays lock-free.
+  struct TypeUniquingShard {
+    llvm::sys::Mutex Mutex;
+    llvm::BumpPtrAllocator Allocator;
+    llvm::FoldingSet<TupleType> TupleTypes;
+    llvm::FoldingSet<BoundGenericType> BoundGenericTypes;
+    llvm::DenseMap<std::pair<Type, std::pair<Type, unsigned>>, FunctionType *>
+      FunctionTypes;
+    llvm::DenseMap<uintptr_t, ReferenceStorageType *> ReferenceStorageTypes;
+  };
+  enum { NumTypeUniquingShards = 8 };
+  TypeUniquingShard TypeUniquingShards[NumTypeUniquingShards];
+
   /// Temporary arena used for a constraint solver.
   struct ConstraintSolverArena : public Arena {
     /// The allocator used for all allocations within this arena.
@@ -404,8 +496,7 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
   syntax::SyntaxArena TheSyntaxArena;
 };
 
-ASTContext::Implementation::Implementation()
- : IdentifierTable(Allocator) {}
+ASTContext::Implementation::Implementation() {}
 ASTContext::Implementation::~Implementation() {
   for (auto &cleanup : Cleanups)
     cleanup();
@@ -437,6 +528,7 @@ ASTContext::ASTContext(LangOptions &langOpts, SearchPathOptions &SearchPathOpts,
     SearchPathOpts(SearchPathOpts),
     SourceMgr(SourceMgr),
     Diags(Diags),
+    evaluator(Diags),
     TheBuiltinModule(createBuiltinModule(*this)),
     StdlibModuleName(getIdentifier(STDLIB_NAME)),
     SwiftShimsModuleName(getIdentifier(SWIFT_SHIMS_NAME)),
@@ -527,7 +619,10 @@ Identifier ASTContext::getIdentifier(StringRef Str) const {
   if (Str.data() == nullptr)
     return Identifier(nullptr);
 
-  auto I = Impl.IdentifierTable.insert(std::make_pair(Str, char())).first;
+  auto &Shard = Impl.IdentifierTableShards[
+      llvm::hash_value(Str) % Implementation::NumIdentifierShards];
+  llvm::MutexGuard Guard(Shard.Mutex);
+  auto I = Shard.Table.insert(std::make_pair(Str, char())).first;
   return Identifier(I->getKeyData());
 }
 
@@ -1550,17 +1645,121 @@ GenericSignatureBuilder *ASTContext::getOrCreateGenericSignatureBuilder(
 }
 
 GenericEnvironment *ASTContext::getOrCreateCanonicalGenericEnvironment(
-                                              GenericSignatureBuilder *builder,
-                                              GenericSignature *sig) {
-  auto known = Impl.CanonicalGenericEnvironments.find(builder);
+                                                      CanGenericSignature sig) {
+  auto known = Impl.CanonicalGenericEnvironments.find(sig);
   if (known != Impl.CanonicalGenericEnvironments.end())
     return known->second;
 
+  // Creating the environment forces the canonical generic signature
+  // builder into existence; the environment resolves its archetypes
+  // against that builder lazily.
   auto env = sig->createGenericEnvironment();
-  Impl.CanonicalGenericEnvironments[builder] = env;
+  Impl.CanonicalGenericEnvironments[sig] = env;
   return env;
 }
 
+Optional<Optional<ProtocolConformanceRef>>
+ASTContext::getCachedConformanceLookup(ModuleDecl *mod, Type type,
+                                       ProtocolDecl *protocol) {
+  llvm::MutexGuard guard(Impl.ConformanceLookupCacheMutex);
+  auto known = Impl.ConformanceLookupCache.find(
+      {type.getPointer(), {protocol, mod}});
+  if (known == Impl.ConformanceLookupCache.end())
+    return None;
+
+  // A negative result is only valid until another module is loaded.
+  if (!known->second.Conformance &&
+      known->second.Generation != CurrentGeneration)
+    return None;
+
+  return known->second.Conformance;
+}
+
+void ASTContext::recordConformanceLookup(
+    ModuleDecl *mod, Type type, ProtocolDecl *protocol,
+    Optional<ProtocolConformanceRef> conformance) {
+  llvm::MutexGuard guard(Impl.ConformanceLookupCacheMutex);
+  auto &entry = Impl.ConformanceLookupCache[
+      {type.getPointer(), {protocol, mod}}];
+  entry.Conformance = conformance;
+  entry.Generation = CurrentGeneration;
+}
+
+Optional<ArrayRef<ValueDecl *>>
+ASTContext::getCachedModuleLookup(ModuleDecl *mod, DeclName name,
+                                  const DeclContext *moduleScopeContext,
+                                  unsigned queryKind) {
+  auto known = Impl.ModuleLookupCache.find(
+      {mod, {name.getOpaqueValue(), {moduleScopeContext, queryKind}}});
+  if (known == Impl.ModuleLookupCache.end() ||
+      known->second.Generation != CurrentGeneration ||
+      known->second.Epoch != Impl.ModuleLookupEpoch)
+    return None;
+
+  return llvm::makeArrayRef(known->second.Decls);
+}
+
+void ASTContext::recordModuleLookup(ModuleDecl *mod, DeclName name,
+                                    const DeclContext *moduleScopeContext,
+                                    unsigned queryKind,
+                                    ArrayRef<ValueDecl *> decls) {
+  auto &entry = Impl.ModuleLookupCache[
+      {mod, {name.getOpaqueValue(), {moduleScopeContext, queryKind}}}];
+  entry.Generation = CurrentGeneration;
+  entry.Epoch = Impl.ModuleLookupEpoch;
+  entry.Decls.assign(decls.begin(), decls.end());
+}
+
+void ASTContext::invalidateModuleLookupCache() {
+  ++Impl.ModuleLookupEpoch;
+}
+
+const ASTContext::QualifiedLookupCacheEntry *
+ASTContext::getCachedQualifiedLookup(const DeclContext *dc, Type type,
+                                     DeclName member, unsigned queryKind) {
+  auto known = Impl.QualifiedLookupCache.find(
+      {dc, {type.getPointer(), {member.getOpaqueValue(), queryKind}}});
+  if (known == Impl.QualifiedLookupCache.end() ||
+      known->second.Generation != CurrentGeneration ||
+      known->second.Epoch != Impl.QualifiedLookupEpoch)
+    return nullptr;
+
+  return &known->second;
+}
+
+ASTContext::QualifiedLookupCacheEntry &
+ASTContext::cacheQualifiedLookup(const DeclContext *dc, Type type,
+                                 DeclName member, unsigned queryKind) {
+  auto &entry = Impl.QualifiedLookupCache[
+      {dc, {type.getPointer(), {member.getOpaqueValue(), queryKind}}}];
+  entry.Generation = CurrentGeneration;
+  entry.Epoch = Impl.QualifiedLookupEpoch;
+  entry.Decls.clear();
+  entry.VisitedNominals.clear();
+  entry.UsedDynamicLookup = false;
+  return entry;
+}
+
+void ASTContext::invalidateQualifiedLookupCache() {
+  ++Impl.QualifiedLookupEpoch;
+}
+
+Optional<StringRef> ASTContext::getCachedUSR(const ValueDecl *decl,
+                                             unsigned accessorKind) {
+  auto known = Impl.USRs.find({decl, accessorKind});
+  if (known == Impl.USRs.end())
+    return None;
+
+  return known->second;
+}
+
+StringRef ASTContext::recordUSR(const ValueDecl *decl, unsigned accessorKind,
+                                StringRef USR) {
+  auto &entry = Impl.USRs[{decl, accessorKind}];
+  entry = AllocateCopy(USR);
+  return entry;
+}
+
 /// Minimize the set of overridden associated types, eliminating any
 /// associated types that are overridden by other associated types.
 static void minimizeOverriddenAssociatedTypes(
@@ -1775,6 +1974,18 @@ void ASTContext::setBriefComment(const Decl *D, StringRef Comment) {
   Impl.BriefComments[D] = Comment;
 }
 
+Optional<StringRef> ASTContext::getMangledName(const Decl *D, unsigned Key) {
+  auto Known = Impl.MangledNames.find({D, Key});
+  if (Known == Impl.MangledNames.end())
+    return None;
+
+  return Known->second;
+}
+
+void ASTContext::setMangledName(const Decl *D, unsigned Key, StringRef Name) {
+  Impl.MangledNames[{D, Key}] = AllocateCopy(Name);
+}
+
 unsigned ValueDecl::getLocalDiscriminator() const {
   assert(getDeclContext()->isLocalContext());
   auto &discriminators = getASTContext().Impl.LocalDiscriminators;
@@ -2051,6 +2262,9 @@ size_t ASTContext::getTotalMemory() const {
     Impl.OpenedExistentialArchetypes.getMemorySize() +
     Impl.Permanent.getTotalMemory();
 
+    for (auto &shard : Impl.TypeUniquingShards)
+      Size += shard.Allocator.getTotalMemory();
+
     Size += getSolverMemory();
 
     return Size;
@@ -2993,15 +3207,10 @@ Type TupleType::get(ArrayRef<TupleTypeElt> Fields, const ASTContext &C) {
 
   auto arena = getArena(properties);
 
-  void *InsertPos = nullptr;
   // Check to see if we've already seen this tuple before.
   llvm::FoldingSetNodeID ID;
   TupleType::Profile(ID, Fields);
 
-  if (TupleType *TT
-        = C.Impl.getArena(arena).TupleTypes.FindNodeOrInsertPos(ID,InsertPos))
-    return TT;
-
   bool IsCanonical = true;   // All canonical elts means this is canonical.
   for (const TupleTypeElt &Elt : Fields) {
     if (Elt.getType().isNull() || !Elt.getType()->isCanonical()) {
@@ -3011,9 +3220,30 @@ Type TupleType::get(ArrayRef<TupleTypeElt> Fields, const ASTContext &C) {
   }
 
   // TupleType will copy the fields list into ASTContext owned memory.
-  void *mem = C.Allocate(sizeof(TupleType) +
-                         sizeof(TupleTypeElt) * Fields.size(),
-                         alignof(TupleType), arena);
+  size_t size = sizeof(TupleType) + sizeof(TupleTypeElt) * Fields.size();
+
+  // Permanent-arena tuples unique through the sharded concurrent tables.
+  if (arena == AllocationArena::Permanent) {
+    auto &shard = C.Impl.TypeUniquingShards[
+        ID.ComputeHash() % Implementation::NumTypeUniquingShards];
+    llvm::MutexGuard guard(shard.Mutex);
+    void *InsertPos = nullptr;
+    if (TupleType *TT = shard.TupleTypes.FindNodeOrInsertPos(ID, InsertPos))
+      return TT;
+
+    void *mem = shard.Allocator.Allocate(size, alignof(TupleType));
+    auto New = new (mem) TupleType(Fields, IsCanonical ? &C : nullptr,
+                                   properties, hasInOut);
+    shard.TupleTypes.InsertNode(New, InsertPos);
+    return New;
+  }
+
+  void *InsertPos = nullptr;
+  if (TupleType *TT
+        = C.Impl.getArena(arena).TupleTypes.FindNodeOrInsertPos(ID,InsertPos))
+    return TT;
+
+  void *mem = C.Allocate(size, alignof(TupleType), arena);
   auto New = new (mem) TupleType(Fields, IsCanonical ? &C : nullptr, properties,
                                  hasInOut);
   C.Impl.getArena(arena).TupleTypes.InsertNode(New, InsertPos);
@@ -3196,12 +3426,6 @@ BoundGenericType *BoundGenericType::get(NominalTypeDecl *TheDecl,
 
   auto arena = getArena(properties);
 
-  void *InsertPos = nullptr;
-  if (BoundGenericType *BGT =
-        C.Impl.getArena(arena).BoundGenericTypes.FindNodeOrInsertPos(ID,
-                                                                     InsertPos))
-    return BGT;
-
   bool IsCanonical = !Parent || Parent->isCanonical();
   if (IsCanonical) {
     for (Type Arg : GenericArgs) {
@@ -3212,25 +3436,60 @@ BoundGenericType *BoundGenericType::get(NominalTypeDecl *TheDecl,
     }
   }
 
-  BoundGenericType *newType;
-  if (auto theClass = dyn_cast<ClassDecl>(TheDecl)) {
-    auto sz = BoundGenericClassType::totalSizeToAlloc<Type>(GenericArgs.size());
-    auto mem = C.Allocate(sz, alignof(BoundGenericClassType), arena);
-    newType = new (mem) BoundGenericClassType(
-        theClass, Parent, GenericArgs, IsCanonical ? &C : nullptr, properties);
-  } else if (auto theStruct = dyn_cast<StructDecl>(TheDecl)) {
-    auto sz =BoundGenericStructType::totalSizeToAlloc<Type>(GenericArgs.size());
-    auto mem = C.Allocate(sz, alignof(BoundGenericStructType), arena);
-    newType = new (mem) BoundGenericStructType(
-        theStruct, Parent, GenericArgs, IsCanonical ? &C : nullptr, properties);
-  } else if (auto theEnum = dyn_cast<EnumDecl>(TheDecl)) {
-    auto sz = BoundGenericEnumType::totalSizeToAlloc<Type>(GenericArgs.size());
-    auto mem = C.Allocate(sz, alignof(BoundGenericEnumType), arena);
-    newType = new (mem) BoundGenericEnumType(
-        theEnum, Parent, GenericArgs, IsCanonical ? &C : nullptr, properties);
-  } else {
+  auto create = [&](llvm::function_ref<void *(size_t, unsigned)> allocate)
+      -> BoundGenericType * {
+    if (auto theClass = dyn_cast<ClassDecl>(TheDecl)) {
+      auto sz =
+          BoundGenericClassType::totalSizeToAlloc<Type>(GenericArgs.size());
+      auto mem = allocate(sz, alignof(BoundGenericClassType));
+      return new (mem) BoundGenericClassType(
+          theClass, Parent, GenericArgs, IsCanonical ? &C : nullptr,
+          properties);
+    }
+    if (auto theStruct = dyn_cast<StructDecl>(TheDecl)) {
+      auto sz =
+          BoundGenericStructType::totalSizeToAlloc<Type>(GenericArgs.size());
+      auto mem = allocate(sz, alignof(BoundGenericStructType));
+      return new (mem) BoundGenericStructType(
+          theStruct, Parent, GenericArgs, IsCanonical ? &C : nullptr,
+          properties);
+    }
+    if (auto theEnum = dyn_cast<EnumDecl>(TheDecl)) {
+      auto sz = BoundGenericEnumType::totalSizeToAlloc<Type>(GenericArgs.size());
+      auto mem = allocate(sz, alignof(BoundGenericEnumType));
+      return new (mem) BoundGenericEnumType(
+          theEnum, Parent, GenericArgs, IsCanonical ? &C : nullptr, properties);
+    }
     llvm_unreachable("Unhandled NominalTypeDecl");
+  };
+
+  // Permanent-arena bound generics unique through the sharded concurrent
+  // tables.
+  if (arena == AllocationArena::Permanent) {
+    auto &shard = C.Impl.TypeUniquingShards[
+        ID.ComputeHash() % Implementation::NumTypeUniquingShards];
+    llvm::MutexGuard guard(shard.Mutex);
+    void *InsertPos = nullptr;
+    if (BoundGenericType *BGT =
+          shard.BoundGenericTypes.FindNodeOrInsertPos(ID, InsertPos))
+      return BGT;
+
+    auto newType = create([&](size_t sz, unsigned align) {
+      return shard.Allocator.Allocate(sz, align);
+    });
+    shard.BoundGenericTypes.InsertNode(newType, InsertPos);
+    return newType;
   }
+
+  void *InsertPos = nullptr;
+  if (BoundGenericType *BGT =
+        C.Impl.getArena(arena).BoundGenericTypes.FindNodeOrInsertPos(ID,
+                                                                     InsertPos))
+    return BGT;
+
+  auto newType = create([&](size_t sz, unsigned align) {
+    return C.Allocate(sz, align, arena);
+  });
   C.Impl.getArena(arena).BoundGenericTypes.InsertNode(newType, InsertPos);
 
   return newType;
@@ -3386,26 +3645,55 @@ ReferenceStorageType *ReferenceStorageType::get(Type T,
   auto arena = getArena(properties);
 
   auto key = uintptr_t(T.getPointer()) | unsigned(ownership);
-  auto &entry = C.Impl.getArena(arena).ReferenceStorageTypes[key];
-  if (entry) return entry;
 
+  auto create = [&](llvm::function_ref<void *(size_t, unsigned)> allocate)
+      -> ReferenceStorageType * {
+    switch (ownership) {
+    case ReferenceOwnership::Strong:
+      llvm_unreachable("not possible");
+    case ReferenceOwnership::Unowned: {
+      auto mem = allocate(sizeof(UnownedStorageType),
+                          alignof(UnownedStorageType));
+      return new (mem) UnownedStorageType(
+          T, T->isCanonical() ? &C : nullptr, properties);
+    }
+    case ReferenceOwnership::Weak: {
+      assert(T->getOptionalObjectType() &&
+             "object of weak storage type is not optional");
+      auto mem = allocate(sizeof(WeakStorageType), alignof(WeakStorageType));
+      return new (mem)
+          WeakStorageType(T, T->isCanonical() ? &C : nullptr, properties);
+    }
+    case ReferenceOwnership::Unmanaged: {
+      auto mem = allocate(sizeof(UnmanagedStorageType),
+                          alignof(UnmanagedStorageType));
+      return new (mem) UnmanagedStorageType(
+          T, T->isCanonical() ? &C : nullptr, properties);
+    }
+    }
+    llvm_unreachable("bad ownership");
+  };
 
-  switch (ownership) {
-  case ReferenceOwnership::Strong:
-    llvm_unreachable("not possible");
-  case ReferenceOwnership::Unowned:
-    return entry = new (C, arena) UnownedStorageType(
-               T, T->isCanonical() ? &C : nullptr, properties);
-  case ReferenceOwnership::Weak:
-    assert(T->getOptionalObjectType() &&
-           "object of weak storage type is not optional");
-    return entry = new (C, arena)
-               WeakStorageType(T, T->isCanonical() ? &C : nullptr, properties);
-  case ReferenceOwnership::Unmanaged:
-    return entry = new (C, arena) UnmanagedStorageType(
-               T, T->isCanonical() ? &C : nullptr, properties);
+  // Permanent-arena storage types unique through the sharded concurrent
+  // tables.
+  if (arena == AllocationArena::Permanent) {
+    auto &shard = C.Impl.TypeUniquingShards[
+        llvm::hash_value(key) % Implementation::NumTypeUniquingShards];
+    llvm::MutexGuard guard(shard.Mutex);
+    auto &entry = shard.ReferenceStorageTypes[key];
+    if (entry) return entry;
+
+    return entry = create([&](size_t sz, unsigned align) {
+      return shard.Allocator.Allocate(sz, align);
+    });
   }
-  llvm_unreachable("bad ownership");
+
+  auto &entry = C.Impl.getArena(arena).ReferenceStorageTypes[key];
+  if (entry) return entry;
+
+  return entry = create([&](size_t sz, unsigned align) {
+    return C.Allocate(sz, align, arena);
+  });
 }
 
 AnyMetatypeType::AnyMetatypeType(TypeKind kind, const ASTContext *C,
@@ -3606,15 +3894,34 @@ FunctionType *FunctionType::get(Type input, Type result,
 
   const ASTContext &C = input->getASTContext();
 
+  // Permanent-arena function types unique through the sharded concurrent
+  // tables.
+  if (arena == AllocationArena::Permanent) {
+    auto &shard = C.Impl.TypeUniquingShards[
+        llvm::hash_combine(input.getPointer(), result.getPointer(), attrKey) %
+        Implementation::NumTypeUniquingShards];
+    llvm::MutexGuard guard(shard.Mutex);
+    FunctionType *&Entry = shard.FunctionTypes[{input, {result, attrKey} }];
+    if (Entry) return Entry;
+
+    SmallVector<AnyFunctionType::Param, 4> params;
+    AnyFunctionType::decomposeInput(input, params);
+    void *mem = shard.Allocator.Allocate(
+        sizeof(FunctionType) + sizeof(AnyFunctionType::Param) * params.size(),
+        alignof(FunctionType));
+    return Entry = new (mem) FunctionType(params, input, result,
+                                          properties, info);
+  }
+
   FunctionType *&Entry
     = C.Impl.getArena(arena).FunctionTypes[{input, {result, attrKey} }];
   if (Entry) return Entry;
-  
+
   SmallVector<AnyFunctionType::Param, 4> params;
   AnyFunctionType::decomposeInput(input, params);
   void *mem = C.Allocate(sizeof(FunctionType) +
                            sizeof(AnyFunctionType::Param) * params.size(),
-                         alignof(FunctionType));
+                         alignof(FunctionType), arena);
   return Entry = new (mem) FunctionType(params, input, result,
                                         properties, info);
 }
@@ -97,14 +97,39 @@ std::string ASTMangler::mangleClosureEntity(const AbstractClosureExpr *closure,
   return finalize();
 }
 
+/// Cache keys for the mangled names memoized on the ASTContext. Bit 0
+/// distinguishes the cached entry points so the same declaration can be
+/// cached under both, bit 1 holds the mangler's DWARFMangling mode, and the
+/// remaining bits carry the entry point's parameters.
+static unsigned entityManglingCacheKey(bool DWARFMangling, bool isCurried,
+                                       ASTMangler::SymbolKind SKind) {
+  return (unsigned(SKind) << 3) | (unsigned(isCurried) << 2) |
+         (unsigned(DWARFMangling) << 1) | 0;
+}
+static unsigned nominalTypeManglingCacheKey(bool DWARFMangling) {
+  return (unsigned(DWARFMangling) << 1) | 1;
+}
+
 std::string ASTMangler::mangleEntity(const ValueDecl *decl, bool isCurried,
                                      SymbolKind SKind) {
+  // IRGen, TBDGen, reflection and debug info all mangle the same entities;
+  // memoize the result on the ASTContext.
+  auto &Ctx = decl->getASTContext();
+  unsigned Key = entityManglingCacheKey(DWARFMangling, isCurried, SKind);
+  if (auto Cached = Ctx.getMangledName(decl, Key)) {
+    recordCacheStat(/*Hit=*/true);
+    return Cached->str();
+  }
+  recordCacheStat(/*Hit=*/false);
+
   beginMangling();
   appendEntity(decl);
   if (isCurried)
     appendOperator("Tc");
   appendSymbolKind(SKind);
-  return finalize();
+  std::string result = finalize();
+  Ctx.setMangledName(decl, Key, result);
+  return result;
 }
 
 std::string ASTMangler::mangleDestructorEntity(const DestructorDecl *decl,
@@ -177,9 +202,19 @@ std::string ASTMangler::mangleInitializerEntity(const VarDecl *var,
 }
 
 std::string ASTMangler::mangleNominalType(const NominalTypeDecl *decl) {
+  auto &Ctx = decl->getASTContext();
+  unsigned Key = nominalTypeManglingCacheKey(DWARFMangling);
+  if (auto Cached = Ctx.getMangledName(decl, Key)) {
+    recordCacheStat(/*Hit=*/true);
+    return Cached->str();
+  }
+  recordCacheStat(/*Hit=*/false);
+
   beginMangling();
   appendAnyGenericType(decl);
-  return finalize();
+  std::string result = finalize();
+  Ctx.setMangledName(decl, Key, result);
+  return result;
 }
 
 std::string ASTMangler::mangleVTableThunk(const FuncDecl *Base,
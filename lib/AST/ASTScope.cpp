@@ -1622,9 +1622,17 @@ const ASTScope *ASTScope::findInnermostEnclosingScope(SourceLoc loc) const {
   ASTContext &ctx = getASTContext();
   SourceManager &sourceMgr = ctx.SourceMgr;
 
+  // Cursor info and code completion tend to query the same region of a file
+  // repeatedly, so resume from the result of the previous query rather than
+  // descending from the root each time. The search below re-verifies
+  // containment, so a stale starting point only costs the walk back up.
+  auto sourceFileScope = getSourceFileScope();
+  const ASTScope *searchNode = this;
+  if (auto lastScope = sourceFileScope->sourceFile.lastInnermostScope)
+    searchNode = lastScope;
+
   // Search up the tree to find the nearest parent that contains this source
   // location.
-  const ASTScope *searchNode = this;
   while (!sourceMgr.rangeContainsTokenLoc(searchNode->getSourceRange(), loc))
     searchNode = searchNode->getParent();
 
@@ -1658,6 +1666,7 @@ const ASTScope *ASTScope::findInnermostEnclosingScope(SourceLoc loc) const {
 
     // Otherwise, our current search node is the best we could find.
     assert(sourceMgr.rangeContainsTokenLoc(searchNode->getSourceRange(), loc));
+    sourceFileScope->sourceFile.lastInnermostScope = searchNode;
     return searchNode;
   };
 }
@@ -2479,7 +2479,9 @@ ExtensionRange NominalTypeDecl::getExtensions() {
 void NominalTypeDecl::addExtension(ExtensionDecl *extension) {
   assert(!extension->NextExtension.getInt() && "Already added extension");
   extension->NextExtension.setInt(true);
-  
+  addedExtension(extension);
+
+
   // First extension; set both first and last.
   if (!FirstExtension) {
     FirstExtension = extension;
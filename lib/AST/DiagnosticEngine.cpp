@@ -678,6 +678,10 @@ void DiagnosticEngine::emitTentativeDiagnostics() {
 }
 
 void DiagnosticEngine::emitDiagnostic(const Diagnostic &diagnostic) {
+  // Determine the behavior before doing anything else: everything below
+  // this check, and all argument formatting (which lives downstream in
+  // formatDiagnosticText), must be skipped for ignored diagnostics so
+  // that -suppress-warnings builds never pay for rendering them.
   auto behavior = state.determineBehavior(diagnostic.getID());
   if (behavior == DiagnosticState::Behavior::Ignore)
     return;
@@ -338,6 +338,9 @@ Optional<DocComment *>
 swift::getSingleDocComment(swift::markup::MarkupContext &MC, const Decl *D) {
   PrettyStackTraceDecl StackTrace("parsing comment for", D);
 
+  if (auto *Cached = MC.getParsedComment(D))
+    return Cached;
+
   auto RC = D->getRawComment();
   if (RC.isEmpty())
     return None;
@@ -345,7 +348,9 @@ swift::getSingleDocComment(swift::markup::MarkupContext &MC, const Decl *D) {
   swift::markup::LineList LL = MC.getLineList(RC);
   auto *Doc = swift::markup::parseDocument(MC, LL);
   auto Parts = extractCommentParts(MC, Doc);
-  return new (MC) DocComment(D, Doc, Parts);
+  auto *DC = new (MC) DocComment(D, Doc, Parts);
+  MC.setParsedComment(D, DC);
+  return DC;
 }
 
 static Optional<DocComment *>
@@ -0,0 +1,38 @@
+//===--- Evaluator.cpp - Request Evaluator Implementation -----------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the Evaluator class, which evaluates and caches
+//  requests.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/AST/Evaluator.h"
+
+#include "swift/AST/DiagnosticEngine.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/ErrorHandling.h"
+
+using namespace swift;
+
+AnyRequest::HolderBase::~HolderBase() { }
+
+void Evaluator::diagnoseCycle(const AnyRequest &request) {
+  request.diagnoseCycle(diags);
+  for (const auto &step : llvm::reverse(activeRequests)) {
+    if (step == request)
+      return;
+
+    step.noteCycleStep(diags);
+  }
+
+  llvm_unreachable("Diagnosed a cycle that was not on the active stack");
+}
@@ -882,11 +882,9 @@ CanType GenericSignature::getCanonicalTypeInContext(Type type) {
 }
 
 GenericEnvironment *CanGenericSignature::getGenericEnvironment() const {
-  // generic signature builders are stored on the ASTContext.
+  // Canonical generic environments are cached on the ASTContext.
   auto &ctx = getGenericParams()[0]->getASTContext();
-  return ctx.getOrCreateCanonicalGenericEnvironment(
-           ctx.getOrCreateGenericSignatureBuilder(*this),
-           *this);
+  return ctx.getOrCreateCanonicalGenericEnvironment(*this);
 }
 
 /// Remove all of the associated type declarations from the given type
@@ -34,6 +34,7 @@
 #include "swift/AST/ProtocolConformance.h"
 #include "swift/Basic/Compiler.h"
 #include "swift/Basic/SourceManager.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/Parse/Token.h"
 #include "swift/Syntax/SyntaxNodes.h"
 #include "clang/Basic/Module.h"
@@ -546,9 +547,12 @@ void ModuleDecl::getDisplayDecls(SmallVectorImpl<Decl*> &Results) const {
   FORWARD(getDisplayDecls, (Results));
 }
 
-Optional<ProtocolConformanceRef>
-ModuleDecl::lookupConformance(Type type, ProtocolDecl *protocol) {
-  ASTContext &ctx = getASTContext();
+/// Perform a conformance lookup without consulting the AST context's
+/// memo table.
+static Optional<ProtocolConformanceRef>
+lookupConformanceUncached(ModuleDecl *mod, Type type,
+                          ProtocolDecl *protocol) {
+  ASTContext &ctx = mod->getASTContext();
 
   // A dynamic Self type conforms to whatever its underlying type
   // conforms to.
@@ -566,7 +570,7 @@ ModuleDecl::lookupConformance(Type type, ProtocolDecl *protocol) {
     // able to be resolved by a substitution that makes the archetype
     // concrete.
     if (auto super = archetype->getSuperclass()) {
-      if (auto inheritedConformance = lookupConformance(super, protocol)) {
+      if (auto inheritedConformance = mod->lookupConformance(super, protocol)) {
         return ProtocolConformanceRef(
                  ctx.getInheritedConformance(
                    type,
@@ -606,7 +610,7 @@ ModuleDecl::lookupConformance(Type type, ProtocolDecl *protocol) {
     // If the existential is class-constrained, the class might conform
     // concretely.
     if (layout.superclass) {
-      if (auto result = lookupConformance(layout.superclass, protocol))
+      if (auto result = mod->lookupConformance(layout.superclass, protocol))
         return result;
     }
 
@@ -639,7 +643,7 @@ ModuleDecl::lookupConformance(Type type, ProtocolDecl *protocol) {
 
   // Find the (unspecialized) conformance.
   SmallVector<ProtocolConformance *, 2> conformances;
-  if (!nominal->lookupConformance(this, protocol, conformances))
+  if (!nominal->lookupConformance(mod, protocol, conformances))
     return None;
 
   // FIXME: Ambiguity resolution.
@@ -659,7 +663,7 @@ ModuleDecl::lookupConformance(Type type, ProtocolDecl *protocol) {
     auto superclassTy = type->getSuperclassForDecl(conformingClass);
 
     // Compute the conformance for the inherited type.
-    auto inheritedConformance = lookupConformance(superclassTy, protocol);
+    auto inheritedConformance = mod->lookupConformance(superclassTy, protocol);
     assert(inheritedConformance &&
            "We already found the inherited conformance");
 
@@ -680,7 +684,7 @@ ModuleDecl::lookupConformance(Type type, ProtocolDecl *protocol) {
     if (!explicitConformanceType->isEqual(type)) {
       // Gather the substitutions we need to map the generic conformance to
       // the specialized conformance.
-      auto subMap = type->getContextSubstitutionMap(this, explicitConformanceDC);
+      auto subMap = type->getContextSubstitutionMap(mod, explicitConformanceDC);
 
       // Create the specialized conformance entry.
       auto result = ctx.getSpecializedConformance(type, conformance, subMap);
@@ -692,6 +696,37 @@ ModuleDecl::lookupConformance(Type type, ProtocolDecl *protocol) {
   return ProtocolConformanceRef(conformance);
 }
 
+Optional<ProtocolConformanceRef>
+ModuleDecl::lookupConformance(Type type, ProtocolDecl *protocol) {
+  ASTContext &ctx = getASTContext();
+
+  // Type variables are allocated in the constraint solver's arena and are
+  // recycled between expressions, so they cannot be used as cache keys.
+  // Their conformances are trivial anyway, as are those of the
+  // UnresolvedType placeholder.
+  if (type->hasTypeVariable() || type->hasUnresolvedType())
+    return lookupConformanceUncached(this, type, protocol);
+
+  if (auto cached = ctx.getCachedConformanceLookup(this, type, protocol)) {
+    if (ctx.Stats)
+      ctx.Stats->getFrontendCounters().NumConformanceLookupCacheHits++;
+    return *cached;
+  }
+
+  if (ctx.Stats)
+    ctx.Stats->getFrontendCounters().NumConformanceLookupCacheMisses++;
+
+  auto result = lookupConformanceUncached(this, type, protocol);
+
+  // Don't record a negative result while the protocol's requirement
+  // signature is still being validated; the existential self-conformance
+  // checks bail out early in that state and would poison the cache.
+  if (result || protocol->hasValidSignature())
+    ctx.recordConformanceLookup(this, type, protocol, result);
+
+  return result;
+}
+
 namespace {
   template <typename T>
   using OperatorMap = SourceFile::OperatorMap<T>;
@@ -1266,6 +1301,9 @@ void SourceFile::addImports(
   assert(iter == newBuf.end());
 
   Imports = newBuf;
+
+  // Module lookups memoized before these imports existed are stale.
+  ctx.invalidateModuleLookupCache();
 }
 
 bool SourceFile::hasTestableImport(const swift::ModuleDecl *module) const {
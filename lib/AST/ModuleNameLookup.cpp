@@ -263,9 +263,34 @@ void namelookup::lookupInModule(ModuleDecl *startModule,
                                 const DeclContext *moduleScopeContext,
                                 ArrayRef<ModuleDecl::ImportedModule> extraImports) {
   assert(moduleScopeContext && moduleScopeContext->isModuleScopeContext());
+  auto &ctx = startModule->getASTContext();
+
+  // Results for an unscoped query are memoized on the AST context so that
+  // repeated lookups of the same name don't walk the import graph again.
+  // Everything that can change the answer beyond the name itself is packed
+  // into the cache key: the kind of lookup, the requested resolution, and
+  // whether decl signatures can be resolved while filtering overloads. The
+  // extra imports themselves need not be part of the key: they are a
+  // function of the module-scope context, which is, and entries recorded
+  // before any file's import set changed are invalidated wholesale through
+  // the module-lookup epoch (see SourceFile::addImports).
+  bool canCache = topAccessPath.empty();
+  unsigned queryKind = unsigned(lookupKind) |
+                       (unsigned(resolutionKind) << 1) |
+                       (unsigned(typeResolver != nullptr) << 3) |
+                       (unsigned(!extraImports.empty()) << 4);
+  if (canCache) {
+    if (auto cached = ctx.getCachedModuleLookup(startModule, name,
+                                                moduleScopeContext,
+                                                queryKind)) {
+      decls.append(cached->begin(), cached->end());
+      return;
+    }
+  }
+
+  size_t initialCount = decls.size();
   ModuleLookupCache cache;
-  bool respectAccessControl = startModule->getASTContext().LangOpts
-                                .EnableAccessControl;
+  bool respectAccessControl = ctx.LangOpts.EnableAccessControl;
   ::lookupInModule<CanTypeSet>(startModule, topAccessPath, decls,
                                resolutionKind, /*canReturnEarly=*/true,
                                typeResolver, cache, moduleScopeContext,
@@ -275,6 +300,10 @@ void namelookup::lookupInModule(ModuleDecl *startModule,
       module->lookupValue(path, name, lookupKind, localDecls);
     }
   );
+
+  if (canCache)
+    ctx.recordModuleLookup(startModule, name, moduleScopeContext, queryKind,
+                           llvm::makeArrayRef(decls).slice(initialCount));
 }
 
 void namelookup::lookupVisibleDeclsInModule(
@@ -28,6 +28,7 @@
 #include "swift/Basic/SourceManager.h"
 #include "swift/Basic/STLExtras.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
@@ -995,6 +996,13 @@ class swift::MemberLookupTable {
   /// Lookup table mapping names to the set of declarations with that name.
   LookupTable Lookup;
 
+  /// The set of base names for which the table has already been populated
+  /// from all of the lazy member loaders: the nominal type itself and its
+  /// current extensions. Lookups of these names -- including names with no
+  /// members at all -- can be answered from the table without consulting
+  /// the loaders again.
+  llvm::DenseSet<DeclBaseName> LazilyCompleteNames;
+
 public:
   /// Create a new member lookup table.
   explicit MemberLookupTable(ASTContext &ctx);
@@ -1024,6 +1032,25 @@ public:
     return Lookup.find(name);
   }
 
+  /// Whether the table has already been populated from the lazy member
+  /// loaders for the given base name.
+  bool isLazilyComplete(DeclBaseName name) const {
+    return LazilyCompleteNames.count(name);
+  }
+
+  /// Note that the table has been populated from the lazy member loaders
+  /// for the given base name.
+  void markLazilyComplete(DeclBaseName name) {
+    LazilyCompleteNames.insert(name);
+  }
+
+  /// Invalidate the set of lazily-complete names; called when a new
+  /// extension is bound to the nominal type, since its members were not
+  /// considered when the names were populated.
+  void clearLazilyCompleteCache() {
+    LazilyCompleteNames.clear();
+  }
+
   // \brief Mark all Decls in this table as not-resident in a table, drop
   // references to them. Should only be called when this was not fully-populated
   // from an IterableDeclContext.
@@ -1037,6 +1064,7 @@ public:
       }
     }
     Lookup.clear();
+    LazilyCompleteNames.clear();
   }
 
   // Only allow allocation of member lookup tables using the allocator in
@@ -1159,6 +1187,20 @@ void NominalTypeDecl::addedMember(Decl *member) {
   if (LookupTable.getPointer()) {
     LookupTable.getPointer()->addMember(member);
   }
+
+  // Qualified lookups memoized before this member existed are stale.
+  getASTContext().invalidateQualifiedLookupCache();
+}
+
+void NominalTypeDecl::addedExtension(ExtensionDecl *ext) {
+  // The new extension's members were not considered when names were marked
+  // lazily complete in the lookup table; make sure the extension is
+  // consulted on the next lookup of each name.
+  if (LookupTable.getPointer())
+    LookupTable.getPointer()->clearLazilyCompleteCache();
+
+  // Qualified lookups memoized before this extension was bound are stale.
+  getASTContext().invalidateQualifiedLookupCache();
 }
 
 void ExtensionDecl::addedMember(Decl *member) {
@@ -1176,6 +1218,9 @@ void ExtensionDecl::addedMember(Decl *member) {
 
       nominal->LookupTable.getPointer()->addMember(member);
     }
+
+    // Qualified lookups memoized before this member existed are stale.
+    nominal->getASTContext().invalidateQualifiedLookupCache();
   }
 }
 
@@ -1427,6 +1472,12 @@ TinyPtrVector<ValueDecl *> NominalTypeDecl::lookupDirect(
     if (!useNamedLazyMemberLoading || i > 0)
       break;
 
+    // If the loaders have already been consulted for this name, a table miss
+    // is authoritative: there are no members with this name, and re-querying
+    // the loaders would just repeat the (possibly on-disk) search.
+    if (LookupTable.getPointer()->isLazilyComplete(name.getBaseName()))
+      break;
+
     // If we get here, we had a cache-miss and _are_ using
     // NamedLazyMemberLoading. Try to populate a _single_ entry in the
     // MemberLookupTable from both this nominal and all of its extensions, and
@@ -1438,6 +1489,11 @@ TinyPtrVector<ValueDecl *> NominalTypeDecl::lookupDirect(
         populateLookupTableEntryFromExtensions(ctx, Table, this, name,
                                                ignoreNewExtensions)) {
       useNamedLazyMemberLoading = false;
+    } else if (!ignoreNewExtensions) {
+      // Every current loader has now answered for this name; remember that
+      // so that repeated lookups -- including misses -- stay cheap. Binding
+      // a new extension invalidates this.
+      Table.markLazilyComplete(name.getBaseName());
     }
   }
 
@@ -1649,6 +1705,40 @@ bool DeclContext::lookupQualified(Type type,
   if (!ctx.LangOpts.EnableAccessControl)
     options |= NL_IgnoreAccessControl;
 
+  // Dot-expression-heavy code repeats identical qualified lookups
+  // constantly, and the constraint solver replays them once per overload
+  // attempt, so the hierarchy walk below is memoized on the AST context.
+  // Types involving type variables live in the solver's arena and cannot
+  // be used as cache keys.
+  bool canCache = !type->hasTypeVariable() && !type->hasUnresolvedType();
+  unsigned queryKind = (unsigned(options) << 1) |
+                       unsigned(typeResolver != nullptr);
+  if (canCache) {
+    if (auto *cached = ctx.getCachedQualifiedLookup(this, type, member,
+                                                    queryKind)) {
+      // Replay what the walk would have told the referenced-name tracker.
+      if (auto sourceFile = dyn_cast<SourceFile>(getModuleScopeContext())) {
+        if (auto *tracker = sourceFile->getReferencedNameTracker()) {
+          if (auto maybeCascading = checkLookupCascading()) {
+            bool cascades = maybeCascading.getValue();
+            for (auto nominal : cached->VisitedNominals)
+              tracker->addUsedMember({nominal, member.getBaseName()},
+                                     cascades);
+            if (cached->UsedDynamicLookup)
+              tracker->addDynamicLookupName(member.getBaseName(), cascades);
+          }
+        }
+      }
+
+      decls.append(cached->Decls.begin(), cached->Decls.end());
+      return !decls.empty();
+    }
+  }
+
+  // The nominal types whose members the walk consults, in visitation order,
+  // for replay on a cache hit.
+  SmallVector<NominalTypeDecl *, 4> visitedForCache;
+
   // The set of nominal type declarations we should (and have) visited.
   SmallVector<NominalTypeDecl *, 4> stack;
   llvm::SmallPtrSet<NominalTypeDecl *, 4> visited;
@@ -1748,6 +1838,9 @@ bool DeclContext::lookupQualified(Type type,
     auto current = stack.back();
     stack.pop_back();
 
+    if (canCache)
+      visitedForCache.push_back(current);
+
     if (tracker)
       tracker->addUsedMember({current, member.getBaseName()},isLookupCascading);
 
@@ -1877,6 +1970,16 @@ bool DeclContext::lookupQualified(Type type,
   if (auto *debugClient = M->getDebugClient())
     filterForDiscriminator(decls, debugClient);
 
+  // Memoize the final results, including a miss: a negative result
+  // otherwise triggers the full walk again on every repeated query.
+  if (canCache) {
+    auto &entry = ctx.cacheQualifiedLookup(this, type, member, queryKind);
+    entry.Decls.assign(decls.begin(), decls.end());
+    entry.VisitedNominals.assign(visitedForCache.begin(),
+                                 visitedForCache.end());
+    entry.UsedDynamicLookup = wantLookupInAllClasses;
+  }
+
   // We're done. Report success/failure.
   return !decls.empty();
 }
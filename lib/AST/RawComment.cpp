@@ -214,17 +214,14 @@ static StringRef extractBriefComment(ASTContext &Context, RawComment RC,
     return StringRef();
 
   swift::markup::MarkupContext MC;
-  auto DC = getCascadingDocComment(MC, D);
-  if (!DC.hasValue())
-    return StringRef();
-
-  auto Brief = DC.getValue()->getBrief();
-  if (!Brief.hasValue())
+  swift::markup::LineList LL = MC.getLineList(RC);
+  auto *Brief = swift::markup::parseBriefParagraph(MC, LL);
+  if (!Brief)
     return StringRef();
 
   SmallString<256> BriefStr("");
   llvm::raw_svector_ostream OS(BriefStr);
-  swift::markup::printInlinesUnder(Brief.getValue(), OS);
+  swift::markup::printInlinesUnder(Brief, OS);
   if (OS.str().empty())
     return StringRef();
 
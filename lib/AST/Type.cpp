@@ -30,7 +30,9 @@
 #include "swift/AST/SubstitutionMap.h"
 #include "swift/AST/TypeLoc.h"
 #include "swift/AST/TypeRepr.h"
+#include "swift/Basic/Statistic.h"
 #include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/STLExtras.h"
@@ -2986,10 +2988,21 @@ static Type substGenericFunctionType(GenericFunctionType *genericFnType,
                                   fnType->getResult(), fnType->getExtInfo());
 }
 
+/// Memoizes the replacements computed for the archetypes and dependent
+/// member types encountered while substituting a single type.
+///
+/// The same archetype commonly occurs many times within one generic-heavy
+/// type, and resolving it can involve conformance lookups and type witness
+/// projections. The cache only lives for a single top-level substitution;
+/// substitutions are supplied as opaque callbacks, so there is no identity
+/// on which a cross-query cache could be keyed.
+using TypeSubstitutionCache = llvm::SmallDenseMap<TypeBase *, Type, 8>;
+
 static Type substType(Type derivedType,
                       TypeSubstitutionFn substitutions,
                       LookupConformanceFn lookupConformances,
-                      SubstOptions options) {
+                      SubstOptions options,
+                      TypeSubstitutionCache &substCache) {
   // Handle substitutions into generic function types.
   if (auto genericFnType = derivedType->getAs<GenericFunctionType>()) {
     return substGenericFunctionType(genericFnType, substitutions,
@@ -3001,6 +3014,8 @@ static Type substType(Type derivedType,
       !derivedType->hasTypeParameter())
     return derivedType;
 
+  auto *stats = derivedType->getASTContext().Stats;
+
   return derivedType.transformRec([&](TypeBase *type) -> Optional<Type> {
     // FIXME: Add SIL versions of mapTypeIntoContext() and
     // mapTypeOutOfContext() and use them appropriately
@@ -3009,6 +3024,12 @@ static Type substType(Type derivedType,
            "should not be doing AST type-substitution on a lowered SIL type;"
            "use SILType::subst");
 
+    // Concrete types have nothing to substitute; skip the traversal of
+    // their children entirely.
+    if (!type->hasArchetype() && !type->hasTypeParameter() &&
+        !isa<SILBoxType>(type))
+      return Type(type);
+
     // Special-case handle SILBoxTypes; we want to structurally substitute the
     // substitutions.
     if (auto boxTy = dyn_cast<SILBoxType>(type)) {
@@ -3036,65 +3057,100 @@ static Type substType(Type derivedType,
     // For dependent member types, we may need to look up the member if the
     // base is resolved to a non-dependent type.
     if (auto depMemTy = dyn_cast<DependentMemberType>(type)) {
-      auto newBase = substType(depMemTy->getBase(),
-                               substitutions, lookupConformances, options);
-      if (!newBase)
-        return Type();
-      
-      return getMemberForBaseType(lookupConformances,
-                                  depMemTy->getBase(), newBase,
-                                  depMemTy->getAssocType(),
-                                  depMemTy->getName(), options);
+      auto knownSubst = substCache.find(type);
+      if (knownSubst != substCache.end()) {
+        if (stats)
+          stats->getFrontendCounters().NumTypeSubstitutionCacheHits++;
+        return knownSubst->second;
+      }
+      if (stats)
+        stats->getFrontendCounters().NumTypeSubstitutionCacheMisses++;
+
+      Type result = [&]() -> Type {
+        auto newBase = substType(depMemTy->getBase(), substitutions,
+                                 lookupConformances, options, substCache);
+        if (!newBase)
+          return Type();
+
+        return getMemberForBaseType(lookupConformances,
+                                    depMemTy->getBase(), newBase,
+                                    depMemTy->getAssocType(),
+                                    depMemTy->getName(), options);
+      }();
+      substCache.insert({type, result});
+      return result;
     }
-    
+
     auto substOrig = dyn_cast<SubstitutableType>(type);
     if (!substOrig)
       return None;
 
-    // If we have a substitution for this type, use it.
-    if (auto known = substitutions(substOrig))
-      return known;
-
-    // If we failed to substitute a generic type parameter, give up.
-    if (isa<GenericTypeParamType>(substOrig)) {
-      if (options.contains(SubstFlags::UseErrorType))
-        return ErrorType::get(type);
-      return Type();
+    auto knownSubst = substCache.find(type);
+    if (knownSubst != substCache.end()) {
+      if (stats)
+        stats->getFrontendCounters().NumTypeSubstitutionCacheHits++;
+      return knownSubst->second;
     }
+    if (stats)
+      stats->getFrontendCounters().NumTypeSubstitutionCacheMisses++;
+
+    Type result = [&]() -> Type {
+      // If we have a substitution for this type, use it.
+      if (auto known = substitutions(substOrig))
+        return known;
+
+      // If we failed to substitute a generic type parameter, give up.
+      if (isa<GenericTypeParamType>(substOrig)) {
+        if (options.contains(SubstFlags::UseErrorType))
+          return ErrorType::get(type);
+        return Type();
+      }
 
-    auto archetype = cast<ArchetypeType>(substOrig);
+      auto archetype = cast<ArchetypeType>(substOrig);
 
-    // Opened existentials cannot be substituted in this manner,
-    // but if they appear in the original type this is not an
-    // error.
-    if (archetype->isOpenedExistential())
-      return Type(type);
+      // Opened existentials cannot be substituted in this manner,
+      // but if they appear in the original type this is not an
+      // error.
+      if (archetype->isOpenedExistential())
+        return Type(type);
 
-    // For archetypes, we can substitute the parent (if present).
-    auto parent = archetype->getParent();
-    if (!parent) {
-      if (options.contains(SubstFlags::UseErrorType))
-        return ErrorType::get(type);
-      return Type();
-    }
+      // For archetypes, we can substitute the parent (if present).
+      auto parent = archetype->getParent();
+      if (!parent) {
+        if (options.contains(SubstFlags::UseErrorType))
+          return ErrorType::get(type);
+        return Type();
+      }
 
-    // Substitute into the parent type.
-    Type substParent = substType(parent, substitutions,
-                                 lookupConformances, options);
+      // Substitute into the parent type.
+      Type substParent = substType(parent, substitutions,
+                                   lookupConformances, options, substCache);
 
-    // If the parent didn't change, we won't change.
-    if (substParent.getPointer() == parent)
-      return Type(type);
+      // If the parent didn't change, we won't change.
+      if (substParent.getPointer() == parent)
+        return Type(type);
 
-    // Get the associated type reference from a child archetype.
-    AssociatedTypeDecl *assocType = archetype->getAssocType();
+      // Get the associated type reference from a child archetype.
+      AssociatedTypeDecl *assocType = archetype->getAssocType();
 
-    return getMemberForBaseType(lookupConformances, parent, substParent,
-                                assocType, archetype->getName(),
-                                options);
+      return getMemberForBaseType(lookupConformances, parent, substParent,
+                                  assocType, archetype->getName(),
+                                  options);
+    }();
+    substCache.insert({type, result});
+    return result;
   });
 }
 
+static Type substType(Type derivedType,
+                      TypeSubstitutionFn substitutions,
+                      LookupConformanceFn lookupConformances,
+                      SubstOptions options) {
+  TypeSubstitutionCache substCache;
+  return substType(derivedType, substitutions, lookupConformances, options,
+                   substCache);
+}
+
 Type Type::subst(const SubstitutionMap &substitutions,
                  SubstOptions options) const {
   return substType(*this,
@@ -164,7 +164,7 @@ static bool shouldUseObjCUSR(const Decl *D) {
   return false;
 }
 
-bool ide::printDeclUSR(const ValueDecl *D, raw_ostream &OS) {
+static bool printDeclUSRUncached(const ValueDecl *D, raw_ostream &OS) {
   if (!D->hasName() && !isa<ParamDecl>(D) && !isa<AccessorDecl>(D))
     return true; // Ignore.
   if (D->getModuleContext()->isBuiltinModule())
@@ -243,8 +243,28 @@ bool ide::printDeclUSR(const ValueDecl *D, raw_ostream &OS) {
   return false;
 }
 
-bool ide::printAccessorUSR(const AbstractStorageDecl *D, AccessorKind AccKind,
-                           llvm::raw_ostream &OS) {
+bool ide::printDeclUSR(const ValueDecl *D, raw_ostream &OS) {
+  // USRs are stable and expensive to mangle; memoize them on the context.
+  // Failures are not memoized, since a declaration that is skipped for
+  // lacking an interface type may become printable once it gets one.
+  auto &Ctx = D->getASTContext();
+  if (auto Cached = Ctx.getCachedUSR(D)) {
+    OS << *Cached;
+    return false;
+  }
+
+  llvm::SmallString<128> Buf;
+  llvm::raw_svector_ostream BufOS(Buf);
+  if (printDeclUSRUncached(D, BufOS))
+    return true;
+
+  OS << Ctx.recordUSR(D, /*accessorKind=*/0, Buf.str());
+  return false;
+}
+
+static bool printAccessorUSRUncached(const AbstractStorageDecl *D,
+                                     AccessorKind AccKind,
+                                     llvm::raw_ostream &OS) {
   // AccKind should always be either IsGetter or IsSetter here, based
   // on whether a reference is a mutating or non-mutating use.  USRs
   // aren't supposed to reflect implementation differences like stored
@@ -271,6 +291,26 @@ bool ide::printAccessorUSR(const AbstractStorageDecl *D, AccessorKind AccKind,
   return false;
 }
 
+bool ide::printAccessorUSR(const AbstractStorageDecl *D, AccessorKind AccKind,
+                           llvm::raw_ostream &OS) {
+  // Memoized like printDeclUSR; accessor kinds are offset by one so they
+  // do not collide with the USR of the storage declaration itself.
+  auto &Ctx = D->getASTContext();
+  unsigned Key = unsigned(AccKind) + 1;
+  if (auto Cached = Ctx.getCachedUSR(D, Key)) {
+    OS << *Cached;
+    return false;
+  }
+
+  llvm::SmallString<128> Buf;
+  llvm::raw_svector_ostream BufOS(Buf);
+  if (printAccessorUSRUncached(D, AccKind, BufOS))
+    return true;
+
+  OS << Ctx.recordUSR(D, Key, Buf.str());
+  return false;
+}
+
 bool ide::printExtensionUSR(const ExtensionDecl *ED, raw_ostream &OS) {
   if (ED->getExtendedType().isNull())
     return true;
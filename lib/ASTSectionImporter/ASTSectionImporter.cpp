@@ -32,7 +32,8 @@ bool swift::parseASTSection(SerializedModuleLoader *SML, StringRef buf,
   // An AST section consists of one or more AST modules, optionally with
   // headers. Iterate over all AST modules.
   while (!buf.empty()) {
-    auto info = serialization::validateSerializedAST(buf);
+    auto info = serialization::validateSerializedAST(
+        buf, /*extendedInfo=*/nullptr, /*requiresModuleSize=*/true);
 
     assert(info.name.size() < (2 << 10) && "name failed sanity check");
 
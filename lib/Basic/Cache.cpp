@@ -14,12 +14,14 @@
 #include "Darwin/Cache-Mac.cpp"
 #else
 
-//  This file implements a default caching implementation that never evicts
-//  its entries.
+//  This file implements a default caching implementation.  Entries are kept
+//  in least-recently-used order and evicted once a cost or entry budget is
+//  exceeded; without a budget the cache grows without bound.
 
 #include "swift/Basic/Cache.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Mutex.h"
+#include <list>
 
 using namespace swift::sys;
 using llvm::StringRef;
@@ -33,10 +35,22 @@ struct DefaultCacheKey {
   DefaultCacheKey(void *Key, CacheImpl::CallBacks *CBs) : Key(Key), CBs(CBs) {}
 };
 
+struct DefaultCacheEntry {
+  void *Value = nullptr;
+  size_t Cost = 0;
+  /// Position of this entry's key in DefaultCache::LRUOrder.
+  std::list<DefaultCacheKey>::iterator LRUPos;
+};
+
 struct DefaultCache {
   llvm::sys::Mutex Mux;
   CacheImpl::CallBacks CBs;
-  llvm::DenseMap<DefaultCacheKey, void *> Entries;
+  llvm::DenseMap<DefaultCacheKey, DefaultCacheEntry> Entries;
+  /// Keys of the entries ordered from most to least recently used.
+  std::list<DefaultCacheKey> LRUOrder;
+  size_t TotalCost = 0;
+  size_t CostLimit = 0;  ///< Zero means unlimited.
+  size_t EntryLimit = 0; ///< Zero means unlimited.
 
   explicit DefaultCache(CacheImpl::CallBacks CBs) : CBs(std::move(CBs)) { }
 };
@@ -67,6 +81,34 @@ template<> struct DenseMapInfo<DefaultCacheKey> {
 };
 } // namespace llvm
 
+/// Removes the given entry, invoking the key destroy and value release
+/// callbacks.  The caller must hold the cache's lock.
+static void
+removeEntry(DefaultCache &DCache,
+            llvm::DenseMap<DefaultCacheKey, DefaultCacheEntry>::iterator Entry) {
+  DCache.TotalCost -= Entry->second.Cost;
+  DCache.LRUOrder.erase(Entry->second.LRUPos);
+  DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
+  DCache.CBs.valueReleaseCB(Entry->second.Value, nullptr);
+  DCache.Entries.erase(Entry);
+}
+
+/// Evicts least recently used entries until the cache fits its budgets.
+/// The most recently used entry is never evicted.  The caller must hold
+/// the cache's lock.
+static void evictToFitLimits(DefaultCache &DCache) {
+  auto isOverBudget = [&] {
+    return (DCache.CostLimit && DCache.TotalCost > DCache.CostLimit) ||
+           (DCache.EntryLimit && DCache.Entries.size() > DCache.EntryLimit);
+  };
+  while (isOverBudget() && DCache.LRUOrder.size() > 1) {
+    auto Entry = DCache.Entries.find(DCache.LRUOrder.back());
+    assert(Entry != DCache.Entries.end() &&
+           "LRU list out of sync with the entry map");
+    removeEntry(DCache, Entry);
+  }
+}
+
 CacheImpl::ImplTy CacheImpl::create(StringRef Name, const CallBacks &CBs) {
   return new DefaultCache(CBs);
 }
@@ -78,15 +120,16 @@ void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
   DefaultCacheKey CKey(Key, &DCache.CBs);
   auto Entry = DCache.Entries.find(CKey);
   if (Entry != DCache.Entries.end()) {
-    if (Entry->second == Value)
+    if (Entry->second.Value == Value)
       return;
-    DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry->second, nullptr);
-    DCache.Entries.erase(Entry);
+    removeEntry(DCache, Entry);
   }
 
   DCache.CBs.valueRetainCB(Value, nullptr);
-  DCache.Entries[CKey] = Value;
+  DCache.LRUOrder.push_front(CKey);
+  DCache.Entries[CKey] = { Value, Cost, DCache.LRUOrder.begin() };
+  DCache.TotalCost += Cost;
+  evictToFitLimits(DCache);
 
   // FIXME: Not thread-safe! It should avoid deleting the value until
   // 'releaseValue is called on it.
@@ -99,9 +142,11 @@ bool CacheImpl::getAndRetain(const void *Key, void **Value_out) {
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
   auto Entry = DCache.Entries.find(CKey);
   if (Entry != DCache.Entries.end()) {
+    DCache.LRUOrder.splice(DCache.LRUOrder.begin(), DCache.LRUOrder,
+                           Entry->second.LRUPos);
     // FIXME: Not thread-safe! It should avoid deleting the value until
     // 'releaseValue is called on it.
-    *Value_out = Entry->second;
+    *Value_out = Entry->second.Value;
     return true;
   }
   return false;
@@ -118,9 +163,7 @@ bool CacheImpl::remove(const void *Key) {
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
   auto Entry = DCache.Entries.find(CKey);
   if (Entry != DCache.Entries.end()) {
-    DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry->second, nullptr);
-    DCache.Entries.erase(Entry);
+    removeEntry(DCache, Entry);
     return true;
   }
   return false;
@@ -130,11 +173,29 @@ void CacheImpl::removeAll() {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
   llvm::sys::ScopedLock L(DCache.Mux);
 
-  for (auto Entry : DCache.Entries) {
+  for (auto &Entry : DCache.Entries) {
     DCache.CBs.keyDestroyCB(Entry.first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry.second, nullptr);
+    DCache.CBs.valueReleaseCB(Entry.second.Value, nullptr);
   }
   DCache.Entries.clear();
+  DCache.LRUOrder.clear();
+  DCache.TotalCost = 0;
+}
+
+void CacheImpl::setCostLimit(size_t Limit) {
+  DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
+  llvm::sys::ScopedLock L(DCache.Mux);
+
+  DCache.CostLimit = Limit;
+  evictToFitLimits(DCache);
+}
+
+void CacheImpl::setEntryLimit(size_t Limit) {
+  DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
+  llvm::sys::ScopedLock L(DCache.Mux);
+
+  DCache.EntryLimit = Limit;
+  evictToFitLimits(DCache);
 }
 
 void CacheImpl::destroy() {
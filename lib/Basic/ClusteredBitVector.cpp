@@ -22,15 +22,23 @@
 using namespace swift;
 
 ClusteredBitVector ClusteredBitVector::fromAPInt(const llvm::APInt &bits) {
-  // This is not a very efficient algorithm.
   ClusteredBitVector result;
-  for (unsigned i = 0, e = bits.getBitWidth(); i != e; ++i) {
-    if (bits[i]) {
-      result.appendSetBits(1);
-    } else {
-      result.appendClearBits(1);
-    }
+  if (bits.getBitWidth() == 0)
+    return result;
+
+  // An all-zero value can stay in the inline-and-all-clear representation.
+  if (bits.isNullValue()) {
+    result.appendClearBits(bits.getBitWidth());
+    return result;
   }
+
+  // Otherwise, copy the value in whole chunks.  APInt's word layout
+  // matches the chunk layout, including the guarantee that the unused
+  // high bits of the last word are zero.
+  static_assert(llvm::APInt::APINT_BITS_PER_WORD == ChunkSizeInBits,
+                "expected APInt word layout to match chunk layout");
+  result.reserve(bits.getBitWidth());
+  result.appendReserved(bits.getBitWidth(), bits.getRawData());
   return result;
 }
 
@@ -123,21 +131,53 @@ void ClusteredBitVector::appendConstantBitsReserved(size_t numBits,
   assert(numBits > 0);
 
   ChunkType pattern = (addOnes ? ~ChunkType(0) : ChunkType(0));
-  appendReserved(numBits, [=](size_t numBitsWanted) -> ChunkType {
-    return (pattern >> (ChunkSizeInBits - numBitsWanted));
-  });
+
+  auto offset = LengthInBits % ChunkSizeInBits;
+  ChunkType *nextChunk = &getChunksPtr()[LengthInBits / ChunkSizeInBits];
+  LengthInBits += numBits;
+
+  // Fill in the rest of the current chunk, if it's partial.
+  // The extra bits in it are guaranteed to be zero.
+  if (offset) {
+    auto claimedBits = std::min(numBits, size_t(ChunkSizeInBits - offset));
+    *nextChunk++ |= ((pattern >> (ChunkSizeInBits - claimedBits)) << offset);
+    numBits -= claimedBits;
+    if (numBits == 0) return;
+  }
+
+  // Fill in whole chunks.
+  auto wholeChunks = numBits / ChunkSizeInBits;
+  if (wholeChunks) {
+    memset(nextChunk, addOnes ? 0xFF : 0, wholeChunks * sizeof(ChunkType));
+    nextChunk += wholeChunks;
+    numBits %= ChunkSizeInBits;
+  }
+
+  // Fill in a final partial chunk, keeping its extra bits zero.
+  if (numBits)
+    *nextChunk = (pattern >> (ChunkSizeInBits - numBits));
 }
 
 void ClusteredBitVector::appendReserved(size_t numBits,
                                         const ChunkType *nextChunk) {
-  // This is easy if we're not currently at an offset.
-  // (Note that this special case generator relies on the exact
-  // implementation of the main appendReserved routine.)
+  // This is easy if we're not currently at an offset: copy whole
+  // chunks directly, then mask the tail to keep the invariant that
+  // the extra bits in the last chunk are zero.
   auto offset = LengthInBits % ChunkSizeInBits;
   if (!offset) {
-    appendReserved(numBits, [&](size_t numBitsWanted) -> ChunkType {
-      return *nextChunk++;
-    });
+    assert(LengthInBits + numBits <= getCapacityInBits());
+    assert(numBits > 0);
+
+    ChunkType *destChunk = &getChunksPtr()[LengthInBits / ChunkSizeInBits];
+    LengthInBits += numBits;
+
+    auto wholeChunks = numBits / ChunkSizeInBits;
+    memcpy(destChunk, nextChunk, wholeChunks * sizeof(ChunkType));
+
+    if (auto tailBits = numBits % ChunkSizeInBits) {
+      destChunk[wholeChunks] =
+        nextChunk[wholeChunks] & ((ChunkType(1) << tailBits) - 1);
+    }
     return;
   }
 
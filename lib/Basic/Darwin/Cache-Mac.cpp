@@ -65,6 +65,16 @@ void CacheImpl::removeAll() {
   cache_remove_all(static_cast<cache_t*>(Impl));
 }
 
+void CacheImpl::setCostLimit(size_t Limit) {
+  // libcache sizes itself in response to memory pressure; explicit budgets
+  // are ignored.
+}
+
+void CacheImpl::setEntryLimit(size_t Limit) {
+  // libcache sizes itself in response to memory pressure; explicit budgets
+  // are ignored.
+}
+
 void CacheImpl::destroy() {
   cache_destroy(static_cast<cache_t*>(Impl));
 }
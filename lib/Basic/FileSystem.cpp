@@ -11,11 +11,54 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/Basic/FileSystem.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace swift;
 
+std::error_code swift::atomicallyWritingToFile(
+    llvm::StringRef outputPath,
+    llvm::function_ref<void(llvm::raw_pwrite_stream &)> action) {
+  namespace fs = llvm::sys::fs;
+
+  if (outputPath == "-") {
+    action(llvm::outs());
+    return std::error_code();
+  }
+
+  // Create the temporary file alongside the output so that the rename below
+  // never crosses a file system boundary.
+  int tmpFD;
+  llvm::SmallString<128> tmpPath;
+  if (std::error_code error =
+          fs::createUniqueFile(outputPath + "-%%%%%%%%.tmp", tmpFD, tmpPath))
+    return error;
+  llvm::sys::RemoveFileOnSignal(tmpPath);
+
+  std::error_code error;
+  {
+    llvm::raw_fd_ostream out(tmpFD, /*shouldClose=*/true);
+    action(out);
+    out.flush();
+    if (out.has_error()) {
+      error = out.error();
+      out.clear_error();
+    }
+  }
+
+  // moveFileIfDifferent leaves an identical destination untouched and cleans
+  // up the temporary; otherwise it renames the temporary into place.
+  if (!error)
+    error = moveFileIfDifferent(tmpPath, outputPath);
+  if (error)
+    (void)fs::remove(tmpPath);
+  llvm::sys::DontRemoveFileOnSignal(tmpPath);
+  return error;
+}
+
 namespace {
   class OpenFileRAII {
     static const int INVALID_FD = -1;
@@ -44,6 +44,8 @@ static int totalOldSize = 0;
 static int totalNewSize = 0;
 static int mergedSubsts = 0;
 static int numLargeSubsts = 0;
+static int mangledNameCacheHits = 0;
+static int mangledNameCacheMisses = 0;
 
 struct OpStatEntry {
   OpStatEntry() : num(0), size(0) { }
@@ -64,6 +66,15 @@ void Mangler::recordOpStatImpl(StringRef op, size_t OldPos) {
   }
 }
 
+void Mangler::recordCacheStatImpl(bool Hit) {
+  if (PrintSwiftManglingStats) {
+    if (Hit)
+      mangledNameCacheHits++;
+    else
+      mangledNameCacheMisses++;
+  }
+}
+
 #endif // NDEBUG
 
 void Mangle::printManglingStats() {
@@ -107,6 +118,15 @@ void Mangle::printManglingStats() {
   }
   llvm::outs() << "  merged substitutions: " << mergedSubsts << "\n"
                   "  large substitutions: " << numLargeSubsts << "\n";
+
+  int numCacheQueries = mangledNameCacheHits + mangledNameCacheMisses;
+  if (numCacheQueries != 0) {
+    llvm::outs() << "Mangled name cache:\n"
+                    "  hits:   " << mangledNameCacheHits << "\n"
+                    "  misses: " << mangledNameCacheMisses << "\n"
+                    "  hit rate: "
+                 << (mangledNameCacheHits * 100 / numCacheQueries) << "%\n";
+  }
 #endif
 }
 
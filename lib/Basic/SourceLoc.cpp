@@ -16,8 +16,30 @@
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
+
+#if defined(__APPLE__) || defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 using namespace swift;
 
+/// Hint the kernel to read the whole buffer ahead of first touch. Sources
+/// are often memory-mapped, and faulting them in a page at a time is
+/// expensive when they live on a network filesystem.
+static void prefetchBuffer(const llvm::MemoryBuffer &Buffer) {
+#if defined(__APPLE__) || defined(__linux__)
+  const uintptr_t PageSize = static_cast<uintptr_t>(::getpagesize());
+  auto Start = reinterpret_cast<uintptr_t>(Buffer.getBufferStart());
+  uintptr_t AlignedStart = Start & ~(PageSize - 1);
+  size_t Size = Buffer.getBufferSize() + (Start - AlignedStart);
+  if (Size >= PageSize)
+    (void)::madvise(reinterpret_cast<void *>(AlignedStart), Size,
+                    MADV_WILLNEED);
+#endif
+}
+
 void SourceManager::verifyAllBuffers() const {
   llvm::PrettyStackTraceString backtrace{
     "Checking that all source buffers are still valid"
@@ -42,6 +64,7 @@ SourceLoc SourceManager::getCodeCompletionLoc() const {
 unsigned
 SourceManager::addNewSourceBuffer(std::unique_ptr<llvm::MemoryBuffer> Buffer) {
   assert(Buffer);
+  prefetchBuffer(*Buffer);
   StringRef BufIdentifier = Buffer->getBufferIdentifier();
   auto ID = LLVMSourceMgr.AddNewSourceBuffer(std::move(Buffer), llvm::SMLoc());
   BufIdentIDMap[BufIdentifier] = ID;
@@ -159,6 +182,33 @@ unsigned SourceManager::getLocOffsetInBuffer(SourceLoc Loc,
   return Loc.Value.getPointer() - Buffer->getBuffer().begin();
 }
 
+ArrayRef<unsigned> SourceManager::getLineStartOffsets(unsigned BufferID) const {
+  auto &LineStarts = LineStartOffsets[BufferID];
+  if (LineStarts.empty()) {
+    StringRef Buffer = getEntireTextForBuffer(BufferID);
+    // Line 1 starts at offset 0; line N+1 after the Nth newline.
+    LineStarts.push_back(0);
+    for (size_t Pos = Buffer.find('\n'); Pos != StringRef::npos;
+         Pos = Buffer.find('\n', Pos + 1))
+      LineStarts.push_back(Pos + 1);
+  }
+  return LineStarts;
+}
+
+std::pair<unsigned, unsigned>
+SourceManager::findLineAndColumn(SourceLoc Loc, unsigned BufferID) const {
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Loc);
+  auto LineStarts = getLineStartOffsets(BufferID);
+  unsigned Offset = getLocOffsetInBuffer(Loc, BufferID);
+  auto NextLine =
+      std::upper_bound(LineStarts.begin(), LineStarts.end(), Offset);
+  assert(NextLine != LineStarts.begin() && "no line contains the offset?");
+  unsigned Line = NextLine - LineStarts.begin();
+  unsigned Column = Offset - *(NextLine - 1) + 1;
+  return { Line, Column };
+}
+
 unsigned SourceManager::getByteDistance(SourceLoc Start, SourceLoc End) const {
   assert(Start.isValid() && "start location should be valid");
   assert(End.isValid() && "end location should be valid");
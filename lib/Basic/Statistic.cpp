@@ -25,12 +25,16 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 #include <chrono>
 #include <limits>
 
 #ifdef HAVE_SYS_TIME_H
 #include <sys/time.h>
 #endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
 #ifdef HAVE_SYS_RESOURCE_H
 #include <sys/resource.h>
 #endif
@@ -84,6 +88,12 @@ makeTraceFileName(StringRef ProgramName,
   return makeFileName("trace", ProgramName, AuxName, "csv");
 }
 
+static std::string
+makeChromeTraceFileName(StringRef ProgramName,
+                        StringRef AuxName) {
+  return makeFileName("trace", ProgramName, AuxName, "trace.json");
+}
+
 static std::string
 makeProfileDirName(StringRef ProgramName,
                    StringRef AuxName) {
@@ -96,8 +106,20 @@ makeProfileDirName(StringRef ProgramName,
 // exact filename, so we go with a crude approximation. Furthermore, to avoid
 // parse ambiguities when "demangling" counters and filenames we exclude hyphens
 // and slashes.
-static std::string
-cleanName(StringRef n) {
+// Chrome's trace viewer groups events by process; emitting the real process
+// id means per-job trace files dropped in a shared -stats-output-dir can be
+// merged into one build-wide trace without the jobs colliding.
+static int64_t
+getTraceProcessId() {
+#ifdef HAVE_UNISTD_H
+  return int64_t(::getpid());
+#else
+  return 0;
+#endif
+}
+
+std::string
+UnifiedStatsReporter::cleanName(StringRef n) {
   std::string tmp;
   for (auto c : n) {
     if (('a' <= c && c <= 'z') ||
@@ -131,11 +153,11 @@ auxName(StringRef ModuleName,
   if (!OptType.empty() && OptType.front() == '-') {
     OptType = OptType.substr(1);
   }
-  return (cleanName(ModuleName)
-          + "-" + cleanName(InputName)
-          + "-" + cleanName(TripleName)
-          + "-" + cleanName(OutputType)
-          + "-" + cleanName(OptType));
+  return (UnifiedStatsReporter::cleanName(ModuleName)
+          + "-" + UnifiedStatsReporter::cleanName(InputName)
+          + "-" + UnifiedStatsReporter::cleanName(TripleName)
+          + "-" + UnifiedStatsReporter::cleanName(OutputType)
+          + "-" + UnifiedStatsReporter::cleanName(OptType));
 }
 
 class UnifiedStatsReporter::RecursionSafeTimers {
@@ -308,7 +330,8 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                            clang::SourceManager *CSM,
                                            bool TraceEvents,
                                            bool ProfileEvents,
-                                           bool ProfileEntities)
+                                           bool ProfileEntities,
+                                           bool ChromeTrace)
   : UnifiedStatsReporter(ProgramName,
                          auxName(ModuleName,
                                  InputName,
@@ -317,7 +340,8 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                  OptType),
                          Directory,
                          SM, CSM,
-                         TraceEvents, ProfileEvents, ProfileEntities)
+                         TraceEvents, ProfileEvents, ProfileEntities,
+                         ChromeTrace)
 {
 }
 
@@ -328,11 +352,13 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                            clang::SourceManager *CSM,
                                            bool TraceEvents,
                                            bool ProfileEvents,
-                                           bool ProfileEntities)
+                                           bool ProfileEntities,
+                                           bool ChromeTrace)
   : currentProcessExitStatusSet(false),
     currentProcessExitStatus(EXIT_FAILURE),
     StatsFilename(Directory),
     TraceFilename(Directory),
+    ChromeTraceFilename(Directory),
     ProfileDirname(Directory),
     StartedTime(llvm::TimeRecord::getCurrentTime()),
     Timer(make_unique<NamedRegionTimer>(AuxName,
@@ -344,6 +370,8 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
 {
   path::append(StatsFilename, makeStatsFileName(ProgramName, AuxName));
   path::append(TraceFilename, makeTraceFileName(ProgramName, AuxName));
+  path::append(ChromeTraceFilename,
+               makeChromeTraceFileName(ProgramName, AuxName));
   path::append(ProfileDirname, makeProfileDirName(ProgramName, AuxName));
   EnableStatistics(/*PrintOnExit=*/false);
   SharedTimer::enableCompilationTimers();
@@ -351,6 +379,10 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
     LastTracedFrontendCounters.emplace();
   if (TraceEvents)
     FrontendStatsEvents.emplace();
+  if (ChromeTrace) {
+    ChromeTraceStartedAt = std::chrono::steady_clock::now();
+    ChromeTraceEvents.emplace();
+  }
   if (ProfileEvents)
     EventProfilers = make_unique<StatsProfilers>();
   if (ProfileEntities)
@@ -373,6 +405,23 @@ UnifiedStatsReporter::getFrontendCounters()
   return *FrontendCounters;
 }
 
+void
+UnifiedStatsReporter::registerMemorySampler(
+    int64_t AlwaysOnFrontendCounters::*Counter,
+    MemoryCounterSampler Sampler) {
+  removeMemorySampler(Counter);
+  MemorySamplers.emplace_back(Counter, std::move(Sampler));
+}
+
+void
+UnifiedStatsReporter::removeMemorySampler(
+    int64_t AlwaysOnFrontendCounters::*Counter) {
+  MemorySamplers.erase(
+      std::remove_if(MemorySamplers.begin(), MemorySamplers.end(),
+                     [Counter](const auto &S) { return S.first == Counter; }),
+      MemorySamplers.end());
+}
+
 void
 UnifiedStatsReporter::noteCurrentProcessExitStatus(int status) {
   assert(!currentProcessExitStatusSet);
@@ -533,6 +582,30 @@ UnifiedStatsReporter::saveAnyFrontendStatsEvents(
     RecursiveTimers->endTimer(T.EventName);
   }
 
+  // Update the always-on memory high-water marks. Phase boundaries are the
+  // only points we sample at: frequent enough that growth is attributable to
+  // a phase in the traces and profiles below, infrequent enough to keep the
+  // sampling cost down.
+  {
+    auto &C = getFrontendCounters();
+    C.MaxMallocUsage = std::max(C.MaxMallocUsage,
+                                int64_t(Process::GetMallocUsage()));
+    for (auto const &S : MemorySamplers)
+      C.*(S.first) = std::max(C.*(S.first), S.second());
+  }
+
+  // The chrome trace only needs a monotonic timestamp and the (static)
+  // event name: no counter reads, no formatting.  This is the whole hot
+  // path of -trace-chrome-events, and it is cheap enough to leave enabled
+  // on production builds.
+  if (ChromeTraceEvents) {
+    auto Elapsed = std::chrono::steady_clock::now() - ChromeTraceStartedAt;
+    auto USec = uint64_t(
+        std::chrono::duration_cast<std::chrono::microseconds>(Elapsed)
+            .count());
+    ChromeTraceEvents->push_back({USec, IsEntry, T.EventName});
+  }
+
   // If we don't have a saved entry to form deltas against in the trace buffer
   // or profilers, we're not tracing or profiling: return early.
   if (!LastTracedFrontendCounters)
@@ -698,6 +771,32 @@ UnifiedStatsReporter::~UnifiedStatsReporter()
     }
   }
 
+  if (ChromeTraceEvents) {
+    std::error_code EC;
+    raw_fd_ostream tstream(ChromeTraceFilename, EC, fs::F_Append | fs::F_Text);
+    if (EC) {
+      llvm::errs() << "Error opening -trace-chrome-events file '"
+                   << ChromeTraceFilename << "' for writing\n";
+      return;
+    }
+    // The JSON array flavor of Chrome's trace-event format:
+    // https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    auto Pid = getTraceProcessId();
+    tstream << '[';
+    const char *delim = "\n";
+    for (auto const &E : *ChromeTraceEvents) {
+      tstream << delim
+              << "{\"name\": \"" << E.EventName << "\""
+              << ", \"cat\": \"swift\""
+              << ", \"ph\": \"" << (E.IsEntry ? 'B' : 'E') << "\""
+              << ", \"ts\": " << E.TimeUSec
+              << ", \"pid\": " << Pid
+              << ", \"tid\": 0}";
+      delim = ",\n";
+    }
+    tstream << "\n]\n";
+  }
+
   if (EventProfilers || EntityProfilers) {
     std::error_code EC = llvm::sys::fs::create_directories(ProfileDirname);
     if (EC) {
@@ -14,6 +14,8 @@
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/ConvertUTF.h"
 
+#include <cstring>
+
 using namespace swift;
 
 // HACK: Allow support for many newer emoji by overriding behavior of ZWJ and
@@ -30,12 +32,53 @@ static inline bool graphemeBreakOverride(llvm::UTF32 lhs, llvm::UTF32 rhs) {
   return lhs == 0x200D || (rhs >= 0x1F3FB && rhs <= 0x1F3FF);
 }
 
+/// Returns true if all 8 bytes of \p Word are ASCII and none of them is CR.
+static inline bool isTrivialClusterWord(uint64_t Word) {
+  const uint64_t HighBits = 0x8080808080808080ULL;
+  const uint64_t LowBits = 0x0101010101010101ULL;
+  // Any byte >= 0x80 sets its high bit in Word directly; a CR byte is
+  // detected with the usual SWAR zero-byte test.
+  uint64_t XorCR = Word ^ (0x0D * LowBits);
+  uint64_t HasCR = (XorCR - LowBits) & ~XorCR & HighBits;
+  return ((Word & HighBits) | HasCR) == 0;
+}
+
+size_t swift::unicode::getTrivialSingleScalarClusterPrefixLength(StringRef S) {
+  size_t i = 0;
+  // Classify word-sized chunks first; this is the whole string for the
+  // common all-ASCII case.
+  while (i + 8 <= S.size()) {
+    uint64_t Word;
+    memcpy(&Word, S.data() + i, 8);
+    if (!isTrivialClusterWord(Word))
+      break;
+    i += 8;
+  }
+  while (i < S.size() && (unsigned char)S[i] < 0x80 && S[i] != '\r')
+    ++i;
+  // The last ASCII byte before a non-ASCII character may be extended by a
+  // combining character; leave it to the full algorithm.
+  if (i > 0 && i < S.size())
+    --i;
+  return i;
+}
+
 StringRef swift::unicode::extractFirstExtendedGraphemeCluster(StringRef S) {
   // Extended grapheme cluster segmentation algorithm as described in Unicode
   // Standard Annex #29.
   if (S.empty())
     return StringRef();
 
+  // Fast path: an ASCII character followed by another ASCII character (or
+  // nothing) is a cluster on its own, except for CR+LF, which is the only
+  // all-ASCII multi-byte cluster.
+  unsigned char First = S[0];
+  if (First < 0x80 && (S.size() == 1 || (unsigned char)S[1] < 0x80)) {
+    if (First == '\r' && S.size() > 1 && S[1] == '\n')
+      return S.slice(0, 2);
+    return S.slice(0, 1);
+  }
+
   const llvm::UTF8 *SourceStart =
     reinterpret_cast<const llvm::UTF8 *>(S.data());
 
@@ -113,6 +156,10 @@ unsigned swift::unicode::extractFirstUnicodeScalar(StringRef S) {
 }
 
 uint64_t swift::unicode::getUTF16Length(StringRef Str) {
+  // An all-ASCII string is its own UTF-16 length; skip the transcode.
+  if (getTrivialSingleScalarClusterPrefixLength(Str) == Str.size())
+    return Str.size();
+
   uint64_t Length;
   // Transcode the string to UTF-16 to get its length.
   SmallVector<llvm::UTF16, 128> buffer(Str.size() + 1); // +1 for ending nulls.
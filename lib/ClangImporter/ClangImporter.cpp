@@ -59,7 +59,9 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/CrashRecoveryContext.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include <algorithm>
 #include <memory>
@@ -810,6 +812,21 @@ ClangImporter::getPCHFilename(const ClangImporterOptions &ImporterOptions,
 
   SmallString<256> PCHBasename { llvm::sys::path::filename(BridgingHeader) };
   llvm::sys::path::replace_extension(PCHBasename, "");
+  // Key the artifact on the header's contents as well as the compilation
+  // options, so that a shared output directory keeps one artifact per
+  // distinct version of the header. Switching between branches then
+  // alternates between existing cache entries instead of repeatedly
+  // rebuilding a single one.
+  if (auto headerBuffer = llvm::MemoryBuffer::getFile(BridgingHeader)) {
+    llvm::MD5 hash;
+    hash.update((*headerBuffer)->getBuffer());
+    llvm::MD5::MD5Result hashBuf;
+    hash.final(hashBuf);
+    SmallString<32> contentHash;
+    llvm::MD5::stringifyResult(hashBuf, contentHash);
+    PCHBasename.append("-content_");
+    PCHBasename.append(contentHash);
+  }
   PCHBasename.append("-swift_");
   PCHBasename.append(SwiftPCHHash);
   PCHBasename.append("-clang_");
@@ -3385,25 +3402,12 @@ ClangImporter::Implementation::loadNamedMembers(
   auto *nominal = DC->getAsNominalTypeOrNominalTypeExtensionContext();
   auto effectiveClangContext = getEffectiveClangContext(nominal);
 
-  // FIXME: The legacy of mirroring protocol members rears its ugly head,
-  // and as a result we have to bail on any @interface or @category that
-  // has a declared protocol conformance.
-  if (auto *ID = dyn_cast<clang::ObjCInterfaceDecl>(CD)) {
-    if (ID->protocol_begin() != ID->protocol_end())
-      return None;
-  }
-  if (auto *CCD = dyn_cast<clang::ObjCCategoryDecl>(CD)) {
-    if (CCD->protocol_begin() != CCD->protocol_end())
-      return None;
-  }
-
-  // Also bail out if there are any global-as-member mappings for this type; we
+  // Bail out if there are any global-as-member mappings for this type; we
   // can support some of them lazily but the full set of idioms seems
   // prohibitively complex (also they're not stored in by-name lookup, for
   // reasons unclear).
   if (forEachLookupTable([&](SwiftLookupTable &table) -> bool {
-        return (table.lookupGlobalsAsMembers(
-                  effectiveClangContext).size() > 0);
+        return table.hasGlobalsAsMembers(effectiveClangContext);
       }))
     return None;
 
@@ -3453,6 +3457,22 @@ ClangImporter::Implementation::loadNamedMembers(
       }
     }
   }
+
+  // Mirror members of the protocols to which this container conforms,
+  // restricted to the requested name so that a conformance check only
+  // imports the requirements it actually asks about.
+  SmallVector<Decl *, 4> mirroredMembers;
+  importMirroredProtocolMembers(cast<clang::ObjCContainerDecl>(CD), D, DC, N,
+                                mirroredMembers);
+  for (auto *TD : mirroredMembers) {
+    if (auto *V = dyn_cast<ValueDecl>(TD)) {
+      // Skip ValueDecls if they import under different names.
+      if (V->getBaseName() == N) {
+        Members.push_back(V);
+      }
+    }
+  }
+
   return Members;
 }
 
@@ -4263,6 +4263,7 @@ namespace {
     void importMirroredProtocolMembers(const clang::ObjCContainerDecl *decl,
                                        DeclContext *dc,
                                        ArrayRef<ProtocolDecl *> protocols,
+                                       Optional<DeclBaseName> name,
                                        SmallVectorImpl<Decl *> &members,
                                        ASTContext &Ctx);
 
@@ -6739,25 +6740,12 @@ void SwiftDeclConverter::addObjCProtocolConformances(
 
   Impl.recordImportedProtocols(decl, protocols);
 
-  // Synthesize trivial conformances for each of the protocols.
-  SmallVector<ProtocolConformance *, 4> conformances;
-
+  // Don't build the conformance objects yet; a decl can be imported just for
+  // a type reference without anyone ever asking about its conformances. They
+  // are synthesized in loadAllConformances() on first request.
   auto dc = decl->getInnermostDeclContext();
-  auto &ctx = Impl.SwiftContext;
-  for (unsigned i = 0, n = protocols.size(); i != n; ++i) {
-    // FIXME: Build a superclass conformance if the superclass
-    // conforms.
-    auto conformance = ctx.getConformance(dc->getDeclaredInterfaceType(),
-                                          protocols[i], SourceLoc(), dc,
-                                          ProtocolConformanceState::Incomplete);
-    conformance->setLazyLoader(&Impl, /*context*/0);
-    conformance->setState(ProtocolConformanceState::Complete);
-    conformances.push_back(conformance);
-  }
-
-  // Set the conformances.
-  // FIXME: This could be lazier.
-  unsigned id = Impl.allocateDelayedConformance(std::move(conformances));
+  unsigned id = Impl.allocateDelayedConformance(
+      dc, SmallVector<ProtocolDecl *, 4>(protocols.begin(), protocols.end()));
   if (auto nominal = dyn_cast<NominalTypeDecl>(decl)) {
     nominal->setConformanceLoader(&Impl, id);
   } else {
@@ -6828,8 +6816,8 @@ Optional<GenericParamList *> SwiftDeclConverter::importObjCGenericParams(
 
 void SwiftDeclConverter::importMirroredProtocolMembers(
     const clang::ObjCContainerDecl *decl, DeclContext *dc,
-    ArrayRef<ProtocolDecl *> protocols, SmallVectorImpl<Decl *> &members,
-    ASTContext &Ctx) {
+    ArrayRef<ProtocolDecl *> protocols, Optional<DeclBaseName> name,
+    SmallVectorImpl<Decl *> &members, ASTContext &Ctx) {
   assert(dc);
   const clang::ObjCInterfaceDecl *interfaceDecl = nullptr;
   const ClangModuleUnit *declModule;
@@ -6873,16 +6861,16 @@ void SwiftDeclConverter::importMirroredProtocolMembers(
 
     const auto &languageVersion =
         Impl.SwiftContext.LangOpts.EffectiveLanguageVersion;
-    for (auto member : proto->getMembers()) {
+    auto importProtocolRequirement = [&](Decl *member) {
       // Skip compatibility stubs; there's no reason to mirror them.
       if (member->getAttrs().isUnavailableInSwiftVersion(languageVersion))
-        continue;
+        return;
 
       if (auto prop = dyn_cast<VarDecl>(member)) {
         auto objcProp =
             dyn_cast_or_null<clang::ObjCPropertyDecl>(prop->getClangDecl());
         if (!objcProp)
-          continue;
+          return;
 
         // We can't import a property if there's already a method with this
         // name. (This also covers other properties with that same name.)
@@ -6890,7 +6878,7 @@ void SwiftDeclConverter::importMirroredProtocolMembers(
         // not already there.
         clang::Selector sel = objcProp->getGetterName();
         if (interfaceDecl->getInstanceMethod(sel))
-          continue;
+          return;
 
         bool inNearbyCategory =
             std::any_of(interfaceDecl->visible_categories_begin(),
@@ -6907,7 +6895,7 @@ void SwiftDeclConverter::importMirroredProtocolMembers(
                           return category->getInstanceMethod(sel);
                         });
         if (inNearbyCategory)
-          continue;
+          return;
 
         if (auto imported =
                 Impl.importMirroredDecl(objcProp, dc, getVersion(), proto)) {
@@ -6916,24 +6904,34 @@ void SwiftDeclConverter::importMirroredProtocolMembers(
           // metatype.
         }
 
-        continue;
+        return;
       }
 
       auto afd = dyn_cast<AbstractFunctionDecl>(member);
       if (!afd)
-        continue;
+        return;
 
       if (isa<AccessorDecl>(afd))
-        continue;
+        return;
 
       auto objcMethod =
           dyn_cast_or_null<clang::ObjCMethodDecl>(member->getClangDecl());
       if (!objcMethod)
-        continue;
+        return;
 
       // For now, just remember that we saw this method.
       methodsByName[objcMethod->getSelector()]
         .push_back(MirroredMethodEntry{objcMethod, proto});
+    };
+
+    if (name) {
+      // If we're only interested in a particular name, try that name
+      // directly rather than walking all of the protocol's members.
+      for (auto *member : proto->lookupDirect(*name))
+        importProtocolRequirement(member);
+    } else {
+      for (auto *member : proto->getMembers())
+        importProtocolRequirement(member);
     }
   }
 
@@ -8563,14 +8561,41 @@ void ClangImporter::Implementation::collectMembersToAdd(
   // Import mirrored declarations for protocols to which this category
   // or extension conforms.
   // FIXME: This is supposed to be a short-term hack.
+  converter.importMirroredProtocolMembers(objcContainer, DC, protos,
+                                          /*name=*/None, members,
+                                          SwiftContext);
+}
+
+void ClangImporter::Implementation::importMirroredProtocolMembers(
+    const clang::ObjCContainerDecl *objcContainer, Decl *D, DeclContext *DC,
+    llvm::Optional<DeclBaseName> name, SmallVectorImpl<Decl *> &members) {
+  if (auto *clangClass = dyn_cast<clang::ObjCInterfaceDecl>(objcContainer))
+    objcContainer = clangClass->getDefinition();
+
+  SwiftDeclConverter converter(*this, CurrentVersion);
   converter.importMirroredProtocolMembers(objcContainer, DC,
-                                          protos, members, SwiftContext);
+                                          getImportedProtocols(D), name,
+                                          members, SwiftContext);
 }
 
 void ClangImporter::Implementation::loadAllConformances(
        const Decl *D, uint64_t contextData,
        SmallVectorImpl<ProtocolConformance *> &Conformances) {
-  Conformances = takeDelayedConformance(contextData);
+  auto delayed = takeDelayedConformance(contextData);
+  DeclContext *dc = delayed.first;
+
+  // Synthesize trivial conformances for each of the protocols.
+  auto &ctx = SwiftContext;
+  for (auto *proto : delayed.second) {
+    // FIXME: Build a superclass conformance if the superclass
+    // conforms.
+    auto conformance = ctx.getConformance(dc->getDeclaredInterfaceType(),
+                                          proto, SourceLoc(), dc,
+                                          ProtocolConformanceState::Incomplete);
+    conformance->setLazyLoader(this, /*context*/0);
+    conformance->setState(ProtocolConformanceState::Complete);
+    Conformances.push_back(conformance);
+  }
 }
 
 Optional<MappedTypeNameKind>
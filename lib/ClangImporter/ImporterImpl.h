@@ -562,10 +562,15 @@ private:
 
   unsigned NumCurrentImportingEntities = 0;
 
-  /// Mapping from delayed conformance IDs to the set of delayed
-  /// protocol conformances.
-  llvm::DenseMap<unsigned, SmallVector<ProtocolConformance *, 4>>
-    DelayedConformances;
+  /// Mapping from delayed conformance IDs to the declaration context and
+  /// protocols from which the conformances will be built.
+  ///
+  /// The conformance objects themselves are not created until they are
+  /// requested; an imported class that is only ever mentioned as a type
+  /// never needs them.
+  using DelayedConformanceInfo =
+      std::pair<DeclContext *, SmallVector<ProtocolDecl *, 4>>;
+  llvm::DenseMap<unsigned, DelayedConformanceInfo> DelayedConformances;
 
   /// The next delayed conformance ID to use with \c DelayedConformances.
   unsigned NextDelayedConformanceID = 0;
@@ -1192,20 +1197,19 @@ public:
     return hasBegunTypeChecking() && !getTypeResolver();
   }
 
-  /// Allocate a new delayed conformance ID with the given set of
-  /// conformances.
+  /// Allocate a new delayed conformance ID for conformances of \p dc to the
+  /// given protocols.
   unsigned allocateDelayedConformance(
-             SmallVector<ProtocolConformance *, 4> &&conformances) {
+             DeclContext *dc, SmallVector<ProtocolDecl *, 4> &&protocols) {
     unsigned id = NextDelayedConformanceID++;
-    DelayedConformances[id] = std::move(conformances);
+    DelayedConformances[id] = {dc, std::move(protocols)};
     return id;
   }
 
-  /// Take the delayed conformances associated with the given id.
-  SmallVector<ProtocolConformance *, 4> takeDelayedConformance(unsigned id) {
+  /// Take the delayed conformance information associated with the given id.
+  DelayedConformanceInfo takeDelayedConformance(unsigned id) {
     auto conformances = DelayedConformances.find(id);
-    SmallVector<ProtocolConformance *, 4> result
-      = std::move(conformances->second);
+    DelayedConformanceInfo result = std::move(conformances->second);
     DelayedConformances.erase(conformances);
     return result;
   }
@@ -1237,6 +1241,18 @@ public:
     return result;
   }
 
+  /// Retrieve the imported protocols for the given declaration without
+  /// consuming them, leaving them available for full member loading.
+  SmallVector<ProtocolDecl *, 4> getImportedProtocols(const Decl *decl) {
+    SmallVector<ProtocolDecl *, 4> result;
+
+    auto known = ImportedProtocols.find(decl);
+    if (known != ImportedProtocols.end())
+      result = known->second;
+
+    return result;
+  }
+
   virtual void
   loadAllMembers(Decl *D, uint64_t unused) override;
 
@@ -1253,6 +1269,13 @@ private:
                            SmallVectorImpl<Decl *> &members);
   void insertMembersAndAlternates(const clang::NamedDecl *nd,
                                   SmallVectorImpl<Decl *> &members);
+
+  /// Import members of the protocols to which the given container
+  /// conforms, mirroring them into the container. If \p name is given,
+  /// only members with that base name are imported.
+  void importMirroredProtocolMembers(
+      const clang::ObjCContainerDecl *objcContainer, Decl *D, DeclContext *DC,
+      llvm::Optional<DeclBaseName> name, SmallVectorImpl<Decl *> &members);
   void loadAllMembersIntoExtension(Decl *D, uint64_t extra);
 
   /// Imports \p decl under \p nameVersion with the name \p newName, and adds
@@ -517,6 +517,28 @@ auto SwiftLookupTable::findOrCreate(SerializedSwiftName baseName)
   return known;
 }
 
+auto SwiftLookupTable::findOrCreateGlobalsAsMembers(StoredContext context)
+    -> llvm::DenseMap<StoredContext, SmallVector<uint64_t, 2>>::iterator {
+  // Find entries for this context.
+  auto known = GlobalsAsMembers.find(context);
+
+  // If we found something, we're done.
+  if (known != GlobalsAsMembers.end()) return known;
+
+  // If there's no reader, we've found all there is to find.
+  if (!Reader) return known;
+
+  // Lookup this context in the module extension file.
+  SmallVector<uint64_t, 2> results;
+  (void)Reader->lookupGlobalsAsMembers(context, results);
+
+  // Add an entry to the table so we don't look again.
+  known = GlobalsAsMembers.insert({ std::move(context),
+                                    std::move(results) }).first;
+
+  return known;
+}
+
 SmallVector<SwiftLookupTable::SingleEntry, 4>
 SwiftLookupTable::lookup(SerializedSwiftName baseName,
                          llvm::Optional<StoredContext> searchContext) {
@@ -546,22 +568,9 @@ SmallVector<SwiftLookupTable::SingleEntry, 4>
 SwiftLookupTable::lookupGlobalsAsMembers(StoredContext context) {
   SmallVector<SwiftLookupTable::SingleEntry, 4> result;
 
-  // Find entries for this base name.
-  auto known = GlobalsAsMembers.find(context);
-
-  // If we didn't find anything...
-  if (known == GlobalsAsMembers.end()) {
-    // If there's no reader, we've found all there is to find.
-    if (!Reader) return result;
-
-    // Lookup this base name in the module extension file.
-    SmallVector<uint64_t, 2> results;
-    (void)Reader->lookupGlobalsAsMembers(context, results);
-
-    // Add an entry to the table so we don't look again.
-    known = GlobalsAsMembers.insert({ std::move(context),
-                                      std::move(results) }).first;
-  }
+  // Find entries for this context.
+  auto known = findOrCreateGlobalsAsMembers(context);
+  if (known == GlobalsAsMembers.end()) return result;
 
   // Map each of the results.
   for (auto &entry : known->second) {
@@ -582,6 +591,18 @@ SwiftLookupTable::lookupGlobalsAsMembers(EffectiveClangContext context) {
   return lookupGlobalsAsMembers(*storedContext);
 }
 
+bool SwiftLookupTable::hasGlobalsAsMembers(EffectiveClangContext context) {
+  // Translate context.
+  if (!context) return false;
+
+  Optional<StoredContext> storedContext = translateContext(context);
+  if (!storedContext) return false;
+
+  // Check for entries, without mapping them to declarations.
+  auto known = findOrCreateGlobalsAsMembers(*storedContext);
+  return known != GlobalsAsMembers.end() && !known->second.empty();
+}
+
 SmallVector<SwiftLookupTable::SingleEntry, 4>
 SwiftLookupTable::allGlobalsAsMembers() {
   // If we have a reader, deserialize all of the globals-as-members data.
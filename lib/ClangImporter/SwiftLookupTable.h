@@ -408,6 +408,10 @@ private:
   llvm::DenseMap<SerializedSwiftName, SmallVector<FullTableEntry, 2>>::iterator
   findOrCreate(SerializedSwiftName baseName);
 
+  /// Find or create the globals-as-members entry for the given context.
+  llvm::DenseMap<StoredContext, SmallVector<uint64_t, 2>>::iterator
+  findOrCreateGlobalsAsMembers(StoredContext context);
+
   /// Add the given entry to the list of entries, if it's not already
   /// present.
   ///
@@ -502,6 +506,11 @@ public:
   SmallVector<SingleEntry, 4>
   lookupGlobalsAsMembers(EffectiveClangContext context);
 
+  /// Determine whether the given context has any globals that will be
+  /// imported as members, without mapping the stored entries to
+  /// declarations.
+  bool hasGlobalsAsMembers(EffectiveClangContext context);
+
   /// Retrieve the set of global declarations that are going to be
   /// imported as members.
   SmallVector<SingleEntry, 4> allGlobalsAsMembers();
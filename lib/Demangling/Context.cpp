@@ -46,8 +46,77 @@ NodePointer Context::demangleTypeAsNode(llvm::StringRef MangledName) {
   return D->demangleType(MangledName);
 }
 
+/// Demangle the flat global-function shape
+/// <prefix> <module-identifier> <identifier> 'yyF' straight into \p Result,
+/// without building a node tree. Such symbols dominate bulk demangling
+/// workloads like profiler symbolization. Returns false if the symbol does
+/// not have exactly that shape or the options would change how it prints;
+/// the caller then takes the regular tree-building path.
+static bool demangleSimpleSymbol(llvm::StringRef MangledName,
+                                 const DemangleOptions &Options,
+                                 std::string &Result) {
+  // The fast path renders the default printing of this shape only.
+  if (!Options.QualifyEntities || !Options.DisplayModuleNames ||
+      !Options.DisplayEntityTypes || !Options.ShowFunctionArgumentTypes)
+    return false;
+
+  int PrefixLength = getManglingPrefixLength(MangledName);
+  if (PrefixLength == 0)
+    return false;
+  llvm::StringRef Text = MangledName.drop_front(PrefixLength);
+
+  // Parse a plain length-prefixed ASCII identifier. Anything else - punycode
+  // (leading '0'), substitutions, operators - falls back to the demangler.
+  auto parseIdentifier = [&Text]() -> llvm::StringRef {
+    if (Text.empty() || Text[0] < '1' || Text[0] > '9')
+      return llvm::StringRef();
+    size_t Length = 0, NumDigits = 0;
+    while (NumDigits < Text.size() && Text[NumDigits] >= '0' &&
+           Text[NumDigits] <= '9') {
+      Length = Length * 10 + (Text[NumDigits] - '0');
+      if (Length > Text.size())
+        return llvm::StringRef();
+      ++NumDigits;
+    }
+    llvm::StringRef Ident = Text.substr(NumDigits, Length);
+    if (Ident.size() != Length)
+      return llvm::StringRef();
+    for (char C : Ident) {
+      if (!((C >= 'a' && C <= 'z') || (C >= 'A' && C <= 'Z') ||
+            (C >= '0' && C <= '9') || C == '_'))
+        return llvm::StringRef();
+    }
+    if (Ident[0] >= '0' && Ident[0] <= '9')
+      return llvm::StringRef();
+    Text = Text.drop_front(NumDigits + Length);
+    return Ident;
+  };
+
+  llvm::StringRef Module = parseIdentifier();
+  // Compiler-reserved modules (__C, __lldb_expr_...) print specially.
+  if (Module.empty() || Module.startswith("__"))
+    return false;
+  llvm::StringRef Name = parseIdentifier();
+  if (Name.empty())
+    return false;
+  // '() -> ()', uncurried, no generics, no specialization suffix.
+  if (Text != "yyF")
+    return false;
+
+  Result.reserve(Module.size() + Name.size() + 9);
+  Result += Module;
+  Result += '.';
+  Result += Name;
+  Result += "() -> ()";
+  return true;
+}
+
 std::string Context::demangleSymbolAsString(llvm::StringRef MangledName,
                                             const DemangleOptions &Options) {
+  std::string streamed;
+  if (demangleSimpleSymbol(MangledName, Options, streamed))
+    return streamed;
+
   NodePointer root = demangleSymbolAsNode(MangledName);
   if (!root) return MangledName.str();
 
@@ -166,20 +235,49 @@ bool Context::hasSwiftCallingConvention(llvm::StringRef MangledName) {
 // Public utility functions     //
 //////////////////////////////////
 
+// The standalone utility functions share a per-thread Context, so that bulk
+// demangling through them (and through entry points built on them, like
+// swift_demangle) reuses the NodeFactory's slabs instead of mallocing and
+// freeing them on every call. Context::clear() keeps the largest slab, so a
+// thread converges to a steady state with no allocator traffic per symbol.
+// Platforms whose compiler lacks C++ thread_local fall back to a context per
+// call.
+#if !defined(__clang__) || __has_feature(cxx_thread_local)
+#define SWIFT_DEMANGLE_USE_THREADLOCAL_CONTEXT 1
+#else
+#define SWIFT_DEMANGLE_USE_THREADLOCAL_CONTEXT 0
+#endif
+
 std::string demangleSymbolAsString(const char *MangledName,
                                    size_t MangledNameLength,
                                    const DemangleOptions &Options) {
+#if SWIFT_DEMANGLE_USE_THREADLOCAL_CONTEXT
+  static thread_local Context Ctx;
+  std::string Result = Ctx.demangleSymbolAsString(
+      StringRef(MangledName, MangledNameLength), Options);
+  Ctx.clear();
+  return Result;
+#else
   Context Ctx;
   return Ctx.demangleSymbolAsString(StringRef(MangledName, MangledNameLength),
                                     Options);
+#endif
 }
 
 std::string demangleTypeAsString(const char *MangledName,
                                  size_t MangledNameLength,
                                  const DemangleOptions &Options) {
+#if SWIFT_DEMANGLE_USE_THREADLOCAL_CONTEXT
+  static thread_local Context Ctx;
+  std::string Result = Ctx.demangleTypeAsString(
+      StringRef(MangledName, MangledNameLength), Options);
+  Ctx.clear();
+  return Result;
+#else
   Context Ctx;
   return Ctx.demangleTypeAsString(StringRef(MangledName, MangledNameLength),
                                   Options);
+#endif
 }
 
 } // namespace Demangle
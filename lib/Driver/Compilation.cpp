@@ -25,16 +25,19 @@
 #include "swift/Driver/Job.h"
 #include "swift/Driver/ParseableOutput.h"
 #include "swift/Driver/ToolChain.h"
+#include "swift/Option/Options.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Option/Arg.h"
 #include "llvm/Option/ArgList.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/Timer.h"
@@ -44,6 +47,7 @@
 
 // Batch-mode has a sub-mode for testing that randomizes batch partitions,
 // by user-provided seed. That is the only thing randomized here.
+#include <cstdlib>
 #include <random>
 
 using namespace swift;
@@ -102,6 +106,7 @@ Compilation::Compilation(DiagnosticEngine &Diags,
                          bool EnableIncrementalBuild,
                          bool EnableBatchMode,
                          unsigned BatchSeed,
+                         Optional<unsigned> BatchSizeLimit,
                          bool SkipTaskExecution,
                          bool SaveTemps,
                          bool ShowDriverTimeCompilation,
@@ -118,6 +123,7 @@ Compilation::Compilation(DiagnosticEngine &Diags,
     EnableIncrementalBuild(EnableIncrementalBuild),
     EnableBatchMode(EnableBatchMode),
     BatchSeed(BatchSeed),
+    BatchSizeLimit(BatchSizeLimit),
     SaveTemps(SaveTemps),
     ShowDriverTimeCompilation(ShowDriverTimeCompilation),
     Stats(std::move(StatsReporter)) {
@@ -171,6 +177,11 @@ namespace driver {
     /// Only intended for source files.
     llvm::SmallDenseMap<const Job *, bool, 16> UnfinishedCommands;
 
+    /// Stats files (in -stats-output-dir) already attributed to a finished
+    /// job, so concurrently-finishing jobs aren't credited with each
+    /// other's phase timings.
+    llvm::StringSet<> ConsumedStatsFiles;
+
     /// Jobs that incremental-mode has decided it can skip.
     CommandSet DeferredCommands;
 
@@ -201,6 +212,15 @@ namespace driver {
     llvm::SmallDenseMap<const Job *, std::unique_ptr<llvm::Timer>, 16>
     DriverTimers;
 
+    /// When each task began, so that a finished task can be attributed a
+    /// wall-clock duration.
+    llvm::SmallDenseMap<const Job *, llvm::sys::TimePoint<>, 16> JobBeganTimes;
+
+    /// Wall-clock compile time for each input compiled during this build,
+    /// destined for the compilation record so the next build can schedule
+    /// long-running inputs first.
+    llvm::StringMap<std::chrono::nanoseconds> MeasuredInputDurations;
+
     void noteBuilding(const Job *cmd, StringRef reason) {
       if (!Comp.ShowIncrementalBuildDecisions)
         return;
@@ -293,12 +313,150 @@ namespace driver {
       }
     }
 
+    /// Try to recover per-phase frontend timings for a finished \p Cmd from
+    /// the stats directory, if the build was run with -stats-output-dir
+    /// (which the driver forwards to every frontend job).  The name of each
+    /// stats file embeds the cleaned name of the job's primary input, which
+    /// is enough to attribute files to jobs even when several finish at
+    /// once; failure to attribute just means the finished message carries
+    /// no timings.
+    SmallVector<parseable_output::PhaseTiming, 8>
+    loadPhaseTimings(const Job *Cmd) {
+      SmallVector<parseable_output::PhaseTiming, 8> Timings;
+      StringRef StatsDir =
+          Comp.getArgs().getLastArgValue(options::OPT_stats_output_dir);
+      if (StatsDir.empty() || !isa<CompileJobAction>(&Cmd->getSource()))
+        return Timings;
+
+      StringRef InputName = "all";
+      for (const Action *A : Cmd->getSource().getInputs()) {
+        if (auto *IA = dyn_cast<InputAction>(A)) {
+          InputName = llvm::sys::path::filename(IA->getInputArg().getValue());
+          break;
+        }
+      }
+      std::string Marker =
+          "-" + UnifiedStatsReporter::cleanName(InputName) + "-";
+
+      std::string MatchedPath;
+      std::error_code EC;
+      for (llvm::sys::fs::directory_iterator I(StatsDir, EC), E;
+           I != E && !EC; I.increment(EC)) {
+        StringRef Name = llvm::sys::path::filename(I->path());
+        if (!Name.startswith("stats-") || !Name.endswith(".json") ||
+            !Name.contains("-swift-frontend-") || !Name.contains(Marker))
+          continue;
+        if (ConsumedStatsFiles.count(I->path()))
+          continue;
+        // The filename starts with a microsecond timestamp, so the
+        // lexicographically largest unconsumed match is the newest.
+        if (I->path() > MatchedPath)
+          MatchedPath = I->path();
+      }
+      if (MatchedPath.empty())
+        return Timings;
+      ConsumedStatsFiles.insert(MatchedPath);
+
+      auto Buffer = llvm::MemoryBuffer::getFile(MatchedPath);
+      if (!Buffer)
+        return Timings;
+
+      // Pull out the "time.swift.<phase>.wall" entries: these are the
+      // shared compilation-phase timers (Parsing, Type checking, SILGen,
+      // SIL optimization, IRGen, LLVM pipeline, ...).  The file is
+      // machine-written with one key per line, so a line scan suffices.
+      const StringRef Prefix = "\"time.swift.";
+      const StringRef Suffix = ".wall";
+      StringRef Rest = Buffer.get()->getBuffer();
+      while (!Rest.empty()) {
+        StringRef Line;
+        std::tie(Line, Rest) = Rest.split('\n');
+        size_t KeyBegin = Line.find(Prefix);
+        if (KeyBegin == StringRef::npos)
+          continue;
+        StringRef Key = Line.substr(KeyBegin + 1);
+        size_t KeyEnd = Key.find('"');
+        if (KeyEnd == StringRef::npos)
+          continue;
+        Key = Key.substr(0, KeyEnd);
+        if (!Key.endswith(Suffix))
+          continue;
+        SmallString<32> ValueText(
+            Line.substr(KeyBegin + KeyEnd + 2).ltrim("\": ").rtrim(", "));
+        parseable_output::PhaseTiming Timing;
+        Timing.Phase = Key.drop_front(Prefix.size() - 1)
+                          .drop_back(Suffix.size()).str();
+        Timing.WallSeconds = std::strtod(ValueText.c_str(), nullptr);
+        Timings.push_back(Timing);
+      }
+      return Timings;
+    }
+
+    /// Record the duration of each input of \p Cmd as \p elapsed. A
+    /// BatchJob's time is split evenly among its constituents; the batch runs
+    /// them in a single process, so that is the best estimate available.
+    void recordJobDuration(const Job *Cmd, std::chrono::nanoseconds elapsed) {
+      if (BatchJobs.count(Cmd) != 0) {
+        auto *B = static_cast<const BatchJob *>(Cmd);
+        auto Constituents = B->getCombinedJobs();
+        if (Constituents.empty())
+          return;
+        auto Share = elapsed / Constituents.size();
+        for (const Job *J : Constituents)
+          recordDurationForInputs(J, Share);
+        return;
+      }
+      recordDurationForInputs(Cmd, elapsed);
+    }
+
+    void recordDurationForInputs(const Job *Cmd,
+                                 std::chrono::nanoseconds elapsed) {
+      for (const Action *A : Cmd->getSource().getInputs()) {
+        if (auto *IA = dyn_cast<InputAction>(A))
+          MeasuredInputDurations[IA->getInputArg().getValue()] = elapsed;
+      }
+    }
+
+    /// Estimate how long \p Cmd will take to run, from the recorded
+    /// durations of its inputs in the previous build. Inputs without a
+    /// recorded time contribute nothing, so never-measured jobs sort last.
+    std::chrono::nanoseconds getEstimatedJobDuration(const Job *Cmd) const {
+      std::chrono::nanoseconds Estimate{0};
+      if (BatchJobs.count(Cmd) != 0) {
+        auto *B = static_cast<const BatchJob *>(Cmd);
+        for (const Job *J : B->getCombinedJobs())
+          Estimate += getEstimatedJobDuration(J);
+        return Estimate;
+      }
+      for (const Action *A : Cmd->getSource().getInputs()) {
+        if (auto *IA = dyn_cast<InputAction>(A))
+          Estimate +=
+              Comp.PreviousBuildDurations.lookup(IA->getInputArg().getValue());
+      }
+      return Estimate;
+    }
+
+    /// Order \p Cmds longest-estimated-first, so that long-running
+    /// compilations start early rather than serializing the tail of the
+    /// build. No-op when the previous build record carried no timings.
+    void sortJobsByEstimatedDuration(std::vector<const Job *> &Cmds) const {
+      if (Comp.PreviousBuildDurations.empty())
+        return;
+      std::stable_sort(Cmds.begin(), Cmds.end(),
+                       [this](const Job *A, const Job *B) {
+                         return getEstimatedJobDuration(A) >
+                                getEstimatedJobDuration(B);
+                       });
+    }
+
     /// Callback which will be called immediately after a task has started. This
     /// callback may be used to provide output indicating that the task began.
     void taskBegan(ProcessId Pid, void *Context) {
       // TODO: properly handle task began.
       const Job *BeganCmd = (const Job *)Context;
 
+      JobBeganTimes[BeganCmd] = std::chrono::system_clock::now();
+
       if (Comp.ShowDriverTimeCompilation) {
         llvm::SmallString<128> TimerName;
         llvm::raw_svector_ostream OS(TimerName);
@@ -460,6 +618,13 @@ namespace driver {
           DriverTimers[FinishedCmd]->stopTimer();
         }
 
+        auto BeganIter = JobBeganTimes.find(FinishedCmd);
+        if (BeganIter != JobBeganTimes.end()) {
+          recordJobDuration(FinishedCmd, std::chrono::system_clock::now() -
+                                             BeganIter->second);
+          JobBeganTimes.erase(BeganIter);
+        }
+
         switch (Comp.Level) {
         case OutputLevel::PrintJobs:
           // Only print the jobs, not the outputs
@@ -474,7 +639,8 @@ namespace driver {
         case OutputLevel::Parseable:
           // Parseable output was requested.
           parseable_output::emitFinishedMessage(llvm::errs(), *FinishedCmd, Pid,
-                                                ReturnCode, Output);
+                                                ReturnCode, Output,
+                                                loadPhaseTimings(FinishedCmd));
           break;
         }
       }
@@ -810,20 +976,36 @@ namespace driver {
       return false;
     }
 
+    /// Choose the number of batch partitions: at least one per parallel
+    /// task, and enough that no partition exceeds the requested size limit,
+    /// when one was given.
+    size_t pickNumberOfPartitions() const {
+      size_t NumPartitions = Comp.NumberOfParallelCommands;
+      if (Comp.BatchSizeLimit) {
+        size_t Limit = *Comp.BatchSizeLimit;
+        size_t NumJobs = PendingExecution.size();
+        NumPartitions = std::max(NumPartitions,
+                                 (NumJobs + Limit - 1) / Limit);
+      }
+      return NumPartitions;
+    }
+
     /// Select jobs that are batch-combinable from \c PendingExecution, combine
     /// them together into \p BatchJob instances (also inserted into \p
     /// BatchJobs), and enqueue all \c PendingExecution jobs (whether batched or
     /// not) into the \c TaskQueue for execution.
     void formBatchJobsAndAddPendingJobsToTaskQueue() {
 
-      // If batch mode is not enabled, just transfer the set of pending jobs to
-      // the task queue, as-is.
+      // If batch mode is not enabled, transfer the set of pending jobs to
+      // the task queue, longest-running first when we have timings.
       if (!Comp.getBatchModeEnabled()) {
-        transferJobsToTaskQueue(PendingExecution, "standard");
+        std::vector<const Job *> Pending = PendingExecution.takeVector();
+        sortJobsByEstimatedDuration(Pending);
+        transferJobsToTaskQueue(Pending, "standard");
         return;
       }
 
-      size_t NumPartitions = Comp.NumberOfParallelCommands;
+      size_t NumPartitions = pickNumberOfPartitions();
       CommandSetVector Batchable, NonBatchable;
       std::vector<const Job *> Batches;
       do {
@@ -851,9 +1033,13 @@ namespace driver {
       for (const Job *Cmd : Batches)
         BatchJobs.insert(Cmd);
 
-      // Enqueue the resulting jobs, batched and non-batched alike.
+      // Enqueue the resulting jobs, batched and non-batched alike,
+      // longest-running first when we have timings.
+      std::vector<const Job *> NonBatch = NonBatchable.takeVector();
+      sortJobsByEstimatedDuration(Batches);
+      sortJobsByEstimatedDuration(NonBatch);
       transferJobsToTaskQueue(Batches, "batch");
-      transferJobsToTaskQueue(NonBatchable, "non-batch");
+      transferJobsToTaskQueue(NonBatch, "non-batch");
     }
 
     void runTaskQueueToCompletion() {
@@ -990,6 +1176,15 @@ namespace driver {
                            });
     }
 
+    /// Collect the per-input compile times measured during this build,
+    /// carrying forward recorded times for inputs that did not need to be
+    /// recompiled.
+    llvm::StringMap<std::chrono::nanoseconds> takeInputDurations() {
+      for (const auto &entry : Comp.PreviousBuildDurations)
+        MeasuredInputDurations.insert({entry.getKey(), entry.getValue()});
+      return std::move(MeasuredInputDurations);
+    }
+
     int getResult() {
       if (Result == 0)
         Result = Comp.Diags.hadAnyError();
@@ -1034,9 +1229,10 @@ static void checkForOutOfDateInputs(DiagnosticEngine &diags,
   }
 }
 
-static void writeCompilationRecord(StringRef path, StringRef argsHash,
-                                   llvm::sys::TimePoint<> buildTime,
-                                   const InputInfoMap &inputs) {
+static void writeCompilationRecord(
+    StringRef path, StringRef argsHash, llvm::sys::TimePoint<> buildTime,
+    const InputInfoMap &inputs,
+    const llvm::StringMap<std::chrono::nanoseconds> &inputDurations) {
   // Before writing to the dependencies file path, preserve any previous file
   // that may have been there. No error handling -- this is just a nicety, it
   // doesn't matter if it fails.
@@ -1086,6 +1282,21 @@ static void writeCompilationRecord(StringRef path, StringRef argsHash,
     writeTimeValue(out, entry.second.previousModTime);
     out << "\n";
   }
+
+  if (inputDurations.empty())
+    return;
+
+  // Iterate over the sorted inputs rather than the map itself so that the
+  // emitted durations are in a deterministic order.
+  out << compilation_record::getName(TopLevelKey::InputDurations) << ":\n";
+  for (auto &entry : inputs) {
+    auto known = inputDurations.find(entry.first->getValue());
+    if (known == inputDurations.end())
+      continue;
+    out << "  \"" << llvm::yaml::escape(entry.first->getValue()) << "\": ";
+    writeTimeValue(out, llvm::sys::TimePoint<>(known->getValue()));
+    out << "\n";
+  }
 }
 
 static bool writeFilelistIfNecessary(const Job *job, DiagnosticEngine &diags) {
@@ -1150,7 +1361,7 @@ int Compilation::performJobsImpl(bool &abnormalExit) {
     State.populateInputInfoMap(InputInfo);
     checkForOutOfDateInputs(Diags, InputInfo);
     writeCompilationRecord(CompilationRecordPath, ArgsHash, BuildStartTime,
-                           InputInfo);
+                           InputInfo, State.takeInputDurations());
   }
 
   abnormalExit = State.hadAnyAbnormalExit();
@@ -34,6 +34,10 @@ enum class TopLevelKey {
   /// The key for the list of inputs to the compilation that produced the
   /// compilation record.
   Inputs,
+  /// The key for the map of per-input compile times from the build that
+  /// produced the compilation record. Used to schedule long-running inputs
+  /// first; drivers that predate this key simply ignore it.
+  InputDurations,
 };
 
 /// \returns A string representation of the given key.
@@ -43,6 +47,7 @@ inline static StringRef getName(TopLevelKey Key) {
   case TopLevelKey::Options: return "options";
   case TopLevelKey::BuildTime: return "build_time";
   case TopLevelKey::Inputs: return "inputs";
+  case TopLevelKey::InputDurations: return "input_durations";
   }
 
   // Work around MSVC warning: not all control paths return a value
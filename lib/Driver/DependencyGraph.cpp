@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "swift/Basic/ReferenceDependencyFormat.h"
 #include "swift/Basic/Statistic.h"
 #include "swift/Driver/DependencyGraph.h"
 #include "swift/Demangling/Demangle.h"
@@ -51,6 +52,192 @@ using DependencyKind = DependencyGraphImpl::DependencyKind;
 using DependencyCallbackTy = LoadResult(StringRef, DependencyKind, bool);
 using InterfaceHashCallbackTy = LoadResult(StringRef);
 
+// After an entry, we know more about the node as a whole.
+// Update the "result" variable in the enclosing parser.
+// This is a macro rather than a lambda because it contains a return.
+#define UPDATE_RESULT(update) switch (update) {\
+    case LoadResult::HadError: \
+      return LoadResult::HadError; \
+    case LoadResult::UpToDate: \
+      break; \
+    case LoadResult::AffectsDownstream: \
+      result = LoadResult::AffectsDownstream; \
+      break; \
+    } \
+
+namespace {
+/// A bounds-checked cursor over the little-endian binary swiftdeps encoding
+/// described in swift/Basic/ReferenceDependencyFormat.h.
+class BinaryDepsReader {
+  StringRef data;
+  size_t pos = 0;
+
+public:
+  explicit BinaryDepsReader(StringRef data) : data(data) {}
+
+  bool readByte(uint8_t &value) {
+    if (data.size() - pos < 1)
+      return false;
+    value = uint8_t(data[pos++]);
+    return true;
+  }
+
+  bool readUInt32(uint32_t &value) {
+    if (data.size() - pos < 4)
+      return false;
+    value = uint32_t(uint8_t(data[pos])) |
+            uint32_t(uint8_t(data[pos + 1])) << 8 |
+            uint32_t(uint8_t(data[pos + 2])) << 16 |
+            uint32_t(uint8_t(data[pos + 3])) << 24;
+    pos += 4;
+    return true;
+  }
+
+  bool readBytes(size_t count, StringRef &bytes) {
+    if (data.size() - pos < count)
+      return false;
+    bytes = data.substr(pos, count);
+    pos += count;
+    return true;
+  }
+
+  bool atEnd() const { return pos == data.size(); }
+};
+} // end anonymous namespace
+
+static LoadResult parseBinaryDependencyFile(
+    llvm::MemoryBuffer &buffer,
+    llvm::function_ref<DependencyCallbackTy> providesCallback,
+    llvm::function_ref<DependencyCallbackTy> dependsCallback,
+    llvm::function_ref<InterfaceHashCallbackTy> interfaceHashCallback) {
+  using namespace reference_dependencies;
+
+  BinaryDepsReader reader(buffer.getBuffer());
+
+  StringRef magic;
+  uint32_t version;
+  if (!reader.readBytes(sizeof(BinaryMagic), magic) ||
+      !reader.readUInt32(version) || version != BinaryVersion)
+    return LoadResult::HadError;
+
+  // Read the string table. The StringRefs point into the buffer, which
+  // outlives this parse; the callbacks copy what they keep.
+  uint32_t stringCount;
+  if (!reader.readUInt32(stringCount))
+    return LoadResult::HadError;
+  std::vector<StringRef> strings;
+  for (uint32_t i = 0; i != stringCount; ++i) {
+    uint32_t length;
+    StringRef bytes;
+    if (!reader.readUInt32(length) || !reader.readBytes(length, bytes))
+      return LoadResult::HadError;
+    strings.push_back(bytes);
+  }
+
+  auto readString = [&reader, &strings](StringRef &value) -> bool {
+    uint32_t index;
+    if (!reader.readUInt32(index) || index >= strings.size())
+      return false;
+    value = strings[index];
+    return true;
+  };
+
+  LoadResult result = LoadResult::UpToDate;
+
+  while (!reader.atEnd()) {
+    uint8_t rawSection;
+    uint32_t entryCount;
+    if (!reader.readByte(rawSection) || !reader.readUInt32(entryCount))
+      return LoadResult::HadError;
+
+    auto section = BinarySection(rawSection);
+
+    if (section == BinarySection::InterfaceHash) {
+      StringRef hash;
+      if (entryCount != 1 || !readString(hash))
+        return LoadResult::HadError;
+      UPDATE_RESULT(interfaceHashCallback(hash));
+      continue;
+    }
+
+    DependencyKind kind;
+    bool isDepends = false;
+    bool isMember = false;
+    bool hasCascadingFlag = false;
+    switch (section) {
+    case BinarySection::ProvidesTopLevel:
+      kind = DependencyKind::TopLevelName;
+      break;
+    case BinarySection::ProvidesNominal:
+      kind = DependencyKind::NominalType;
+      break;
+    case BinarySection::ProvidesMember:
+      kind = DependencyKind::NominalTypeMember;
+      isMember = true;
+      break;
+    case BinarySection::ProvidesDynamicLookup:
+      kind = DependencyKind::DynamicLookupName;
+      break;
+    case BinarySection::DependsTopLevel:
+      kind = DependencyKind::TopLevelName;
+      isDepends = hasCascadingFlag = true;
+      break;
+    case BinarySection::DependsNominal:
+      kind = DependencyKind::NominalType;
+      isDepends = hasCascadingFlag = true;
+      break;
+    case BinarySection::DependsMember:
+      kind = DependencyKind::NominalTypeMember;
+      isDepends = hasCascadingFlag = isMember = true;
+      break;
+    case BinarySection::DependsDynamicLookup:
+      kind = DependencyKind::DynamicLookupName;
+      isDepends = hasCascadingFlag = true;
+      break;
+    case BinarySection::DependsExternal:
+      kind = DependencyKind::ExternalFile;
+      isDepends = true;
+      break;
+    default:
+      // InterfaceHash is handled above; anything else is an unknown section
+      // code, so the file is malformed.
+      return LoadResult::HadError;
+    }
+
+    auto &callback = isDepends ? dependsCallback : providesCallback;
+
+    for (uint32_t i = 0; i != entryCount; ++i) {
+      // Smash member pairs together with a NUL the same way the YAML parser
+      // does, so that both encodings populate identical graphs.
+      SmallString<64> appended;
+      StringRef name;
+      if (isMember) {
+        StringRef base, member;
+        if (!readString(base) || !readString(member))
+          return LoadResult::HadError;
+        appended += base;
+        appended.push_back('\0');
+        appended += member;
+        name = appended.str();
+      } else if (!readString(name)) {
+        return LoadResult::HadError;
+      }
+
+      bool isCascading = true;
+      if (hasCascadingFlag) {
+        uint8_t flag;
+        if (!reader.readByte(flag))
+          return LoadResult::HadError;
+        isCascading = flag != 0;
+      }
+
+      UPDATE_RESULT(callback(name, kind, isCascading));
+    }
+  }
+
+  return result;
+}
+
 static LoadResult
 parseDependencyFile(llvm::MemoryBuffer &buffer,
                     llvm::function_ref<DependencyCallbackTy> providesCallback,
@@ -58,7 +245,14 @@ parseDependencyFile(llvm::MemoryBuffer &buffer,
                     llvm::function_ref<InterfaceHashCallbackTy> interfaceHashCallback) {
   namespace yaml = llvm::yaml;
 
-  // FIXME: Switch to a format other than YAML.
+  // Dispatch on the magic number: swiftdeps files come in the compact binary
+  // encoding or in YAML (the default, and the debugging format).
+  if (buffer.getBuffer().startswith(
+          StringRef(reference_dependencies::BinaryMagic,
+                    sizeof(reference_dependencies::BinaryMagic))))
+    return parseBinaryDependencyFile(buffer, providesCallback,
+                                     dependsCallback, interfaceHashCallback);
+
   llvm::SourceMgr SM;
   yaml::Stream stream(buffer.getMemBufferRef(), SM);
   auto I = stream.begin();
@@ -75,19 +269,6 @@ parseDependencyFile(llvm::MemoryBuffer &buffer,
   LoadResult result = LoadResult::UpToDate;
   SmallString<64> scratch;
 
-  // After an entry, we know more about the node as a whole.
-  // Update the "result" variable above.
-  // This is a macro rather than a lambda because it contains a return.
-#define UPDATE_RESULT(update) switch (update) {\
-    case LoadResult::HadError: \
-      return LoadResult::HadError; \
-    case LoadResult::UpToDate: \
-      break; \
-    case LoadResult::AffectsDownstream: \
-      result = LoadResult::AffectsDownstream; \
-      break; \
-    } \
-
   // FIXME: LLVM's YAML support does incremental parsing in such a way that
   // for-range loops break.
   for (auto i = topLevelMap->begin(), e = topLevelMap->end(); i != e; ++i) {
@@ -412,7 +593,7 @@ void DependencyGraphImpl::MarkTracerImpl::countStatsForNodeMarking(
       D.DriverDepCascadingNominal++;
     if (Kind & DependencyKind::NominalTypeMember)
       D.DriverDepCascadingMember++;
-    if (Kind & DependencyKind::NominalTypeMember)
+    if (Kind & DependencyKind::ExternalFile)
       D.DriverDepCascadingExternal++;
   } else {
     if (Kind & DependencyKind::TopLevelName)
@@ -423,7 +604,7 @@ void DependencyGraphImpl::MarkTracerImpl::countStatsForNodeMarking(
       D.DriverDepNominal++;
     if (Kind & DependencyKind::NominalTypeMember)
       D.DriverDepMember++;
-    if (Kind & DependencyKind::NominalTypeMember)
+    if (Kind & DependencyKind::ExternalFile)
       D.DriverDepExternal++;
   }
 }
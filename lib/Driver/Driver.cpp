@@ -282,10 +282,11 @@ static bool failedToReadOutOfDateMap(bool ShowIncrementalBuildDecisions,
   return true;
 }
 
-static bool populateOutOfDateMap(InputInfoMap &map, StringRef argsHashStr,
-                                 const InputFileList &inputs,
-                                 StringRef buildRecordPath,
-                                 bool ShowIncrementalBuildDecisions) {
+static bool populateOutOfDateMap(
+    InputInfoMap &map,
+    llvm::StringMap<std::chrono::nanoseconds> &inputDurations,
+    StringRef argsHashStr, const InputFileList &inputs,
+    StringRef buildRecordPath, bool ShowIncrementalBuildDecisions) {
   // Treat a missing file as "no previous build".
   auto buffer = llvm::MemoryBuffer::getFile(buildRecordPath);
   if (!buffer)
@@ -427,6 +428,31 @@ static bool populateOutOfDateMap(InputInfoMap &map, StringRef argsHashStr,
         auto inputName = key->getValue(scratch);
         previousInputs[inputName] = { *previousBuildState, timeValue };
       }
+
+    } else if (keyStr ==
+               compilation_record::getName(TopLevelKey::InputDurations)) {
+      auto *durationMap = dyn_cast<yaml::MappingNode>(i->getValue());
+      if (!durationMap) {
+        auto reason = ("Malformed value for key '" + keyStr + "'.")
+          .toStringRef(scratch);
+        return failedToReadOutOfDateMap(ShowIncrementalBuildDecisions,
+                                        buildRecordPath, reason);
+      }
+
+      // FIXME: LLVM's YAML support does incremental parsing in such a way that
+      // for-range loops break.
+      for (auto i = durationMap->begin(), e = durationMap->end(); i != e; ++i) {
+        auto *key = dyn_cast<yaml::ScalarNode>(i->getKey());
+        if (!key)
+          return true;
+
+        llvm::sys::TimePoint<> timeValue;
+        if (readTimeValue(i->getValue(), timeValue))
+          return true;
+
+        auto inputName = key->getValue(scratch);
+        inputDurations[inputName] = timeValue.time_since_epoch();
+      }
     }
   }
 
@@ -531,6 +557,16 @@ Driver::buildCompilation(const ToolChain &TC,
                      A->getAsString(*ArgList), A->getValue());
     }
   }
+  if (const Arg *A =
+          ArgList->getLastArg(options::OPT_driver_batch_size_limit)) {
+    unsigned Limit = 0;
+    if (StringRef(A->getValue()).getAsInteger(10, Limit) || Limit == 0) {
+      Diags.diagnose(SourceLoc(), diag::error_invalid_arg_value,
+                     A->getAsString(*ArgList), A->getValue());
+    } else {
+      DriverBatchSizeLimit = Limit;
+    }
+  }
 
   bool Incremental = ArgList->hasArg(options::OPT_incremental);
   if (ArgList->hasArg(options::OPT_whole_module_optimization)) {
@@ -639,6 +675,7 @@ Driver::buildCompilation(const ToolChain &TC,
   computeArgsHash(ArgsHash, *TranslatedArgList);
 
   InputInfoMap outOfDateMap;
+  llvm::StringMap<std::chrono::nanoseconds> inputDurations;
   bool rebuildEverything = true;
   if (Incremental) {
     if (!OFM) {
@@ -661,8 +698,8 @@ Driver::buildCompilation(const ToolChain &TC,
         rebuildEverything = true;
 
       } else {
-        if (populateOutOfDateMap(outOfDateMap, ArgsHash, Inputs,
-                                 buildRecordPath,
+        if (populateOutOfDateMap(outOfDateMap, inputDurations, ArgsHash,
+                                 Inputs, buildRecordPath,
                                  ShowIncrementalBuildDecisions)) {
           // FIXME: Distinguish errors from "file removed", which is benign.
         } else {
@@ -704,6 +741,7 @@ Driver::buildCompilation(const ToolChain &TC,
                                                  Incremental,
                                                  BatchMode,
                                                  DriverBatchSeed,
+                                                 DriverBatchSizeLimit,
                                                  DriverSkipExecution,
                                                  SaveTemps,
                                                  ShowDriverTimeCompilation,
@@ -751,6 +789,8 @@ Driver::buildCompilation(const ToolChain &TC,
       auto buildEntry = outOfDateMap.find(nullptr);
       if (buildEntry != outOfDateMap.end())
         C->setLastBuildTime(buildEntry->second.previousModTime);
+
+      C->setPreviousBuildDurations(std::move(inputDurations));
     }
   }
 
@@ -16,6 +16,7 @@
 #include "swift/Driver/Action.h"
 #include "swift/Driver/Job.h"
 #include "swift/Driver/Types.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/Option/Arg.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -61,6 +62,14 @@ namespace json {
     }
   };
 
+  template<>
+  struct ObjectTraits<parseable_output::PhaseTiming> {
+    static void mapping(Output &out, parseable_output::PhaseTiming &value) {
+      out.mapRequired("phase", value.Phase);
+      out.mapRequired("wall", value.WallSeconds);
+    }
+  };
+
   template<typename T, unsigned N>
   struct ArrayTraits<SmallVector<T, N>> {
     static size_t size(Output &out, SmallVector<T, N> &seq) {
@@ -186,15 +195,19 @@ public:
 
 class FinishedMessage : public TaskOutputMessage {
   int ExitStatus;
+  SmallVector<parseable_output::PhaseTiming, 8> PhaseTimings;
 public:
   FinishedMessage(const Job &Cmd, ProcessId Pid, StringRef Output,
-                  int ExitStatus) : TaskOutputMessage("finished", Cmd, Pid,
-                                                      Output),
-                                    ExitStatus(ExitStatus) {}
+                  int ExitStatus,
+                  ArrayRef<parseable_output::PhaseTiming> PhaseTimings)
+      : TaskOutputMessage("finished", Cmd, Pid, Output),
+        ExitStatus(ExitStatus),
+        PhaseTimings(PhaseTimings.begin(), PhaseTimings.end()) {}
 
   void provideMapping(swift::json::Output &out) override {
     TaskOutputMessage::provideMapping(out);
     out.mapRequired("exit-status", ExitStatus);
+    out.mapOptional("phase-timings", PhaseTimings);
   }
 };
 
@@ -236,13 +249,15 @@ struct ObjectTraits<Message> {
 } // namespace swift
 
 static void emitMessage(raw_ostream &os, Message &msg) {
-  std::string JSONString;
-  llvm::raw_string_ostream BufferStream(JSONString);
+  // The message has to be buffered: the protocol prints its byte length
+  // before the message itself.  Use in-place storage so typical messages
+  // never touch the heap.
+  SmallString<256> Buffer;
+  llvm::raw_svector_ostream BufferStream(Buffer);
   json::Output yout(BufferStream);
   yout << msg;
-  BufferStream.flush();
-  os << JSONString.length() << '\n';
-  os << JSONString << '\n';
+  os << Buffer.size() << '\n';
+  os << Buffer << '\n';
 }
 
 void parseable_output::emitBeganMessage(raw_ostream &os,
@@ -253,8 +268,9 @@ void parseable_output::emitBeganMessage(raw_ostream &os,
 
 void parseable_output::emitFinishedMessage(raw_ostream &os,
                                            const Job &Cmd, ProcessId Pid,
-                                           int ExitStatus, StringRef Output) {
-  FinishedMessage msg(Cmd, Pid, Output, ExitStatus);
+                                           int ExitStatus, StringRef Output,
+                                           ArrayRef<PhaseTiming> PhaseTimings) {
+  FinishedMessage msg(Cmd, Pid, Output, ExitStatus, PhaseTimings);
   emitMessage(os, msg);
 }
 
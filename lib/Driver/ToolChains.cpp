@@ -163,6 +163,7 @@ static void addCommonFrontendArgs(const ToolChain &TC,
   inputArgs.AddLastArg(arguments, options::OPT_enable_testing);
   inputArgs.AddLastArg(arguments, options::OPT_g_Group);
   inputArgs.AddLastArg(arguments, options::OPT_import_underlying_module);
+  inputArgs.AddLastArg(arguments, options::OPT_lto);
   inputArgs.AddLastArg(arguments, options::OPT_module_cache_path);
   inputArgs.AddLastArg(arguments, options::OPT_module_link_name);
   inputArgs.AddLastArg(arguments, options::OPT_nostdimport);
@@ -1618,6 +1619,16 @@ toolchains::GenericUnix::constructInvocation(const LinkJobAction &job,
     Arguments.push_back("-pie");
   }
 
+  // When the objects carry LLVM bitcode, clang must engage its LTO support
+  // (and the linker's LLVM plugin) to compile them during the link.
+  if (const Arg *A = context.Args.getLastArg(options::OPT_lto)) {
+    StringRef mode(A->getValue());
+    if (mode == "llvm-thin")
+      Arguments.push_back("-flto=thin");
+    else if (mode == "llvm-full")
+      Arguments.push_back("-flto=full");
+  }
+
   std::string Target = getTargetForLinker();
   if (!Target.empty()) {
     Arguments.push_back("-target");
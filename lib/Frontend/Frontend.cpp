@@ -164,6 +164,47 @@ bool CompilerInstance::setup(const CompilerInvocation &Invok) {
   return setUpInputs();
 }
 
+bool CompilerInstance::setupForReuse(const CompilerInvocation &Invok) {
+  assert(Context && "no previous compilation to reuse; call setup() instead");
+  assert(!Invok.getCodeCompletionPoint().first &&
+         "cannot reuse an instance for code completion");
+
+  // The ASTContext refers into the stored invocation's language and search
+  // path options, so assigning the invocation in place updates the context's
+  // view of them. The caller guarantees that the options the context and
+  // module loaders were shaped by have not changed.
+  Invocation = Invok;
+
+  setUpLLVMArguments();
+  setUpDiagnosticOptions();
+
+  if (Invocation.getFrontendOptions().InputsAndOutputs.hasModuleDocOutputPath())
+    Invocation.getLangOptions().AttachCommentsToDecls = true;
+  if (!Invocation.getFrontendOptions().IndexStorePath.empty()) {
+    Invocation.getLangOptions().AttachCommentsToDecls = true;
+  }
+
+  assert(Lexer::isIdentifier(Invocation.getModuleName()));
+
+  if (isInSILMode())
+    Invocation.getLangOptions().EnableAccessControl = false;
+
+  // Discard the per-compilation state, keeping the context and with it the
+  // loaded modules, the identifier table, and the Clang importer. The next
+  // call to getMainModule() builds the new invocation's main module; it
+  // shadows the previous one in the context if the names collide.
+  TheSILModule.reset();
+  MainModule = nullptr;
+  MainBufferID = NO_SUCH_BUFFER;
+  InputSourceCodeBufferIDs.clear();
+  PartialModules.clear();
+  PrimaryBufferIDs.clear();
+  PrimarySourceFiles.clear();
+  Diagnostics.resetHadAnyError();
+
+  return setUpInputs();
+}
+
 void CompilerInstance::setUpLLVMArguments() {
   // Honor -Xllvm.
   if (!Invocation.getFrontendOptions().LLVMArgs.empty()) {
@@ -556,6 +597,8 @@ CompilerInstance::computeDelayedParsingCallback(bool isPrimary) {
   if (Invocation.isCodeCompletion())
     return llvm::make_unique<CodeCompleteDelayedCallbacks>(
         SourceMgr.getCodeCompletionLoc());
+  if (Invocation.getFrontendOptions().SkipNonInlinableFunctionBodies)
+    return llvm::make_unique<SkipNonInlinableDelayedCallbacks>();
   if (!isPrimary)
     return llvm::make_unique<AlwaysDelayedCallbacks>();
   return nullptr;
@@ -36,6 +36,7 @@ bool FrontendOptions::needsProperModuleName(ActionType action) {
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::DumpInterfaceHash:
+  case ActionType::ScanImports:
   case ActionType::PrintAST:
   case ActionType::DumpScopeMaps:
   case ActionType::DumpTypeRefinementContexts:
@@ -70,6 +71,7 @@ bool FrontendOptions::isActionImmediate(ActionType action) {
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::DumpInterfaceHash:
+  case ActionType::ScanImports:
   case ActionType::PrintAST:
   case ActionType::DumpScopeMaps:
   case ActionType::DumpTypeRefinementContexts:
@@ -100,6 +102,7 @@ bool FrontendOptions::shouldActionOnlyParse(ActionType action) {
   case FrontendOptions::ActionType::DumpParse:
   case FrontendOptions::ActionType::EmitSyntax:
   case FrontendOptions::ActionType::DumpInterfaceHash:
+  case FrontendOptions::ActionType::ScanImports:
   case FrontendOptions::ActionType::EmitImportedModules:
     return true;
   default:
@@ -137,6 +140,7 @@ FrontendOptions::suffixForPrincipalOutputFileForAction(ActionType action) {
   case ActionType::Typecheck:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::ScanImports:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -186,6 +190,7 @@ bool FrontendOptions::canActionEmitDependencies(ActionType action) {
   case ActionType::NoneAction:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::ScanImports:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -217,6 +222,7 @@ bool FrontendOptions::canActionEmitObjCHeader(ActionType action) {
   case ActionType::NoneAction:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::ScanImports:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -249,6 +255,7 @@ bool FrontendOptions::canActionEmitLoadedModuleTrace(ActionType action) {
   case ActionType::Parse:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::ScanImports:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -281,6 +288,7 @@ bool FrontendOptions::canActionEmitModule(ActionType action) {
   case ActionType::Typecheck:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::ScanImports:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -317,6 +325,7 @@ bool FrontendOptions::doesActionProduceOutput(ActionType action) {
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::DumpInterfaceHash:
+  case ActionType::ScanImports:
   case ActionType::PrintAST:
   case ActionType::DumpScopeMaps:
   case ActionType::DumpTypeRefinementContexts:
@@ -360,6 +369,7 @@ bool FrontendOptions::doesActionProduceTextualOutput(ActionType action) {
   case ActionType::Typecheck:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::ScanImports:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -374,6 +384,40 @@ bool FrontendOptions::doesActionProduceTextualOutput(ActionType action) {
   }
 }
 
+bool FrontendOptions::doesActionRequireLLVM(ActionType action) {
+  switch (action) {
+  case ActionType::NoneAction:
+  case ActionType::Parse:
+  case ActionType::Typecheck:
+  case ActionType::DumpParse:
+  case ActionType::DumpInterfaceHash:
+  case ActionType::ScanImports:
+  case ActionType::EmitSyntax:
+  case ActionType::DumpAST:
+  case ActionType::PrintAST:
+  case ActionType::DumpScopeMaps:
+  case ActionType::DumpTypeRefinementContexts:
+  case ActionType::EmitImportedModules:
+  case ActionType::EmitSILGen:
+  case ActionType::EmitSIL:
+  case ActionType::EmitSIBGen:
+  case ActionType::EmitSIB:
+  case ActionType::EmitModuleOnly:
+  case ActionType::MergeModules:
+    return false;
+
+  case ActionType::EmitPCH:
+  case ActionType::Immediate:
+  case ActionType::REPL:
+  case ActionType::EmitAssembly:
+  case ActionType::EmitIR:
+  case ActionType::EmitBC:
+  case ActionType::EmitObject:
+    return true;
+  }
+  llvm_unreachable("Unknown ActionType");
+}
+
 const PrimarySpecificPaths &
 FrontendOptions::getPrimarySpecificPathsForAtMostOnePrimary() const {
   return InputsAndOutputs.getPrimarySpecificPathsForAtMostOnePrimary();
@@ -35,6 +35,7 @@
 #include "swift/AST/ASTMangler.h"
 #include "swift/AST/ReferencedNameTracker.h"
 #include "swift/AST/TypeRefinementContext.h"
+#include "swift/Basic/Defer.h"
 #include "swift/Basic/Dwarf.h"
 #include "swift/Basic/Edit.h"
 #include "swift/Basic/FileSystem.h"
@@ -58,12 +59,11 @@
 #include "swift/Serialization/SerializationOptions.h"
 #include "swift/Serialization/SerializedModuleLoader.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/Syntax/Serialization/SyntaxBinarySerialization.h"
 #include "swift/Syntax/Serialization/SyntaxSerialization.h"
 #include "swift/Syntax/SyntaxNodes.h"
+#include "swift/TBDGen/TBDGen.h"
 
-// FIXME: We're just using CompilerInstance::createOutputFile.
-// This API should be sunk down to LLVM.
-#include "clang/Frontend/CompilerInstance.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/APINotes/Types.h"
 
@@ -83,6 +83,7 @@
 
 #include <deque>
 #include <memory>
+#include <thread>
 #include <unordered_set>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
@@ -279,7 +280,8 @@ getFileOutputStream(StringRef OutputFilename, ASTContext &Ctx) {
 
 /// Writes the Syntax tree to the given file
 static bool emitSyntax(SourceFile *SF, LangOptions &LangOpts,
-                       SourceManager &SM, StringRef OutputFilename) {
+                       SourceManager &SM, StringRef OutputFilename,
+                       bool BinaryFormat) {
   auto bufferID = SF->getBufferID();
   assert(bufferID && "frontend should have a buffer ID "
          "for the main source file");
@@ -287,8 +289,13 @@ static bool emitSyntax(SourceFile *SF, LangOptions &LangOpts,
   auto os = getFileOutputStream(OutputFilename, SF->getASTContext());
   if (!os) return true;
 
-  json::Output jsonOut(*os);
   auto Root = SF->getSyntaxRoot().getRaw();
+  if (BinaryFormat) {
+    syntax::serializeRawSyntaxAsBinary(Root, *os);
+    return false;
+  }
+
+  json::Output jsonOut(*os);
   jsonOut << *Root;
   *os << "\n";
   return false;
@@ -313,38 +320,16 @@ static bool writeSIL(SILModule &SM, const PrimarySpecificPaths &PSPs,
 
 static bool printAsObjCIfNeeded(StringRef outputPath, ModuleDecl *M,
                                 StringRef bridgingHeader, bool moduleIsPublic) {
-  using namespace llvm::sys;
-
   if (outputPath.empty())
     return false;
 
-  clang::CompilerInstance Clang;
-
-  std::string tmpFilePath;
-  std::error_code EC;
-  std::unique_ptr<llvm::raw_pwrite_stream> out =
-    Clang.createOutputFile(outputPath, EC,
-                           /*Binary=*/false,
-                           /*RemoveFileOnSignal=*/true,
-                           /*BaseInput=*/"",
-                           path::extension(outputPath),
-                           /*UseTemporary=*/true,
-                           /*CreateMissingDirectories=*/false,
-                           /*ResultPathName=*/nullptr,
-                           &tmpFilePath);
-
-  if (!out) {
-    M->getASTContext().Diags.diagnose(SourceLoc(), diag::error_opening_output,
-                                      tmpFilePath, EC.message());
-    return true;
-  }
-
   auto requiredAccess = moduleIsPublic ? AccessLevel::Public
                                        : AccessLevel::Internal;
-  bool hadError = printAsObjC(*out, M, bridgingHeader, requiredAccess);
-  out->flush();
-
-  EC = swift::moveFileIfDifferent(tmpFilePath, outputPath);
+  bool hadError = false;
+  std::error_code EC = swift::atomicallyWritingToFile(
+      outputPath, [&](llvm::raw_pwrite_stream &out) {
+        hadError = printAsObjC(out, M, bridgingHeader, requiredAccess);
+      });
   if (EC) {
     M->getASTContext().Diags.diagnose(SourceLoc(), diag::error_opening_output,
                                       outputPath, EC.message());
@@ -482,6 +467,7 @@ static void countStatsPostSema(UnifiedStatsReporter &Stats,
   C.NumLoadedModules = AST.LoadedModules.size();
   C.NumImportedExternalDefinitions = AST.ExternalDefinitions.size();
   C.NumASTBytesAllocated = AST.getAllocator().getBytesAllocated();
+  C.NumASTContextBytes = AST.getTotalMemory();
 
   if (auto *D = Instance.getDependencyTracker()) {
     C.NumDependencies = D->getDependencies().size();
@@ -726,7 +712,8 @@ static Optional<bool> dumpASTIfNeeded(CompilerInvocation &Invocation,
   case FrontendOptions::ActionType::EmitSyntax:
     emitSyntax(getPrimaryOrMainSourceFile(Invocation, Instance),
                Invocation.getLangOptions(), Instance.getSourceMgr(),
-               opts.InputsAndOutputs.getSingleOutputFilename());
+               opts.InputsAndOutputs.getSingleOutputFilename(),
+               opts.EmitSyntaxBinaryFormat);
     break;
 
   case FrontendOptions::ActionType::DumpParse:
@@ -757,12 +744,15 @@ static void emitReferenceDependenciesForAllPrimaryInputsIfNeeded(
     if (!referenceDependenciesFilePath.empty())
       (void)emitReferenceDependencies(Instance.getASTContext().Diags, SF,
                                       *Instance.getDependencyTracker(),
-                                      referenceDependenciesFilePath);
+                                      referenceDependenciesFilePath,
+                                      Invocation.getFrontendOptions()
+                                          .EnableBinaryReferenceDependencies);
   }
 }
 
 static bool writeTBDIfNeeded(CompilerInvocation &Invocation,
-                             CompilerInstance &Instance) {
+                             CompilerInstance &Instance,
+                             TBDSymbolCache &TBDCache) {
   if (!Invocation.getFrontendOptions().InputsAndOutputs.hasTBDPath())
     return false;
 
@@ -776,7 +766,7 @@ static bool writeTBDIfNeeded(CompilerInvocation &Invocation,
 
   return writeTBD(Instance.getMainModule(),
                   Invocation.getSILOptions().hasMultipleIGMs(), TBDPath,
-                  installName);
+                  installName, &TBDCache);
 }
 
 static std::deque<PostSILGenInputs>
@@ -853,8 +843,8 @@ static bool performCompileStepsPostSILGen(
     CompilerInstance &Instance, CompilerInvocation &Invocation,
     std::unique_ptr<SILModule> SM, bool astGuaranteedToCorrespondToSIL,
     ModuleOrSourceFile MSF, const PrimarySpecificPaths &PSPs,
-    bool moduleIsPublic, int &ReturnValue, FrontendObserver *observer,
-    UnifiedStatsReporter *Stats);
+    bool moduleIsPublic, TBDSymbolCache &TBDCache, int &ReturnValue,
+    FrontendObserver *observer, UnifiedStatsReporter *Stats);
 
 /// Performs the compile requested by the user.
 /// \param Instance Will be reset after performIRGeneration when the verifier
@@ -879,6 +869,11 @@ static bool performCompile(CompilerInstance &Instance,
   if (Action == FrontendOptions::ActionType::EmitPCH)
     return precompileBridgingHeader(Invocation, Instance);
 
+  // A lexer-only prescan of the inputs for their imports; neither parsing
+  // nor module loading happens, so this must come before performSema.
+  if (Action == FrontendOptions::ActionType::ScanImports)
+    return emitPrescannedImports(Instance, opts);
+
   if (Invocation.getInputKind() == InputFileKind::IFK_LLVM_IR)
     return compileLLVMIR(Invocation, Instance, Stats);
 
@@ -955,7 +950,11 @@ static bool performCompile(CompilerInstance &Instance,
     return hadPrintAsObjCError || hadEmitIndexDataError || Context.hadError();
   }
 
-  if (writeTBDIfNeeded(Invocation, Instance))
+  // Emitting a TBD file and validating it against the IR both enumerate the
+  // module's public symbols; share the per-file results between the two.
+  TBDSymbolCache TBDCache;
+
+  if (writeTBDIfNeeded(Invocation, Instance, TBDCache))
     return true;
 
   assert(Action >= FrontendOptions::ActionType::EmitSILGen &&
@@ -971,7 +970,7 @@ static bool performCompile(CompilerInstance &Instance,
                                       PSGI.ASTGuaranteedToCorrespondToSIL,
                                       PSGI.ModuleOrPrimarySourceFile,
                                       PSGI.PSPs,
-                                      moduleIsPublic,
+                                      moduleIsPublic, TBDCache,
                                       ReturnValue, observer, Stats))
       return true;
   }
@@ -1044,6 +1043,18 @@ computeSerializationOptions(const CompilerInvocation &Invocation,
 
 /// Perform SIL optimization passes if optimizations haven't been disabled.
 /// These may change across compiler versions.
+///
+/// The pipeline runs to completion before IRGen sees the module, so peak
+/// memory includes fully optimized SIL and the growing LLVM IR side by side.
+/// Streaming functions into IRGen as they retire from the function-pass
+/// pipeline would overlap the phases and free SIL early, but the pipeline
+/// offers no per-function completion point to hook: module passes (dead
+/// function elimination, GlobalOpt, cross-module serialization) run between
+/// and after the function-pass rounds and may delete or rewrite functions
+/// that already looked final, and IRGen itself starts from whole-module
+/// state (vtables, witness tables, and lazily emitted definitions reached
+/// from other functions). Overlap is only sound after the last pass that can
+/// touch another function's body, which today is the end of the pipeline.
 static void performSILOptimizations(CompilerInvocation &Invocation,
                                     SILModule *SM) {
   SharedTimer timer("SIL optimization");
@@ -1136,7 +1147,8 @@ static bool processCommandLineAndRunImmediately(CompilerInvocation &Invocation,
 static bool validateTBDIfNeeded(CompilerInvocation &Invocation,
                                 ModuleOrSourceFile MSF,
                                 bool astGuaranteedToCorrespondToSIL,
-                                llvm::Module &IRModule) {
+                                llvm::Module &IRModule,
+                                TBDSymbolCache &TBDCache) {
   if (!astGuaranteedToCorrespondToSIL ||
       !inputFileKindCanHaveTBDValidated(Invocation.getInputKind()))
     return false;
@@ -1152,10 +1164,13 @@ static bool validateTBDIfNeeded(CompilerInvocation &Invocation,
   }
   const auto hasMultipleIGMs = Invocation.getSILOptions().hasMultipleIGMs();
   const bool allSymbols = mode == FrontendOptions::TBDValidationMode::All;
+  // Only whole-module enumerations can use the symbol cache; single-file
+  // enumeration uses different linkage rules.
   return MSF.is<SourceFile *>() ? validateTBD(MSF.get<SourceFile *>(), IRModule,
                                               hasMultipleIGMs, allSymbols)
                                 : validateTBD(MSF.get<ModuleDecl *>(), IRModule,
-                                              hasMultipleIGMs, allSymbols);
+                                              hasMultipleIGMs, allSymbols,
+                                              &TBDCache);
 }
 
 static bool generateCode(CompilerInvocation &Invocation,
@@ -1188,12 +1203,71 @@ static bool generateCode(CompilerInvocation &Invocation,
                      EffectiveLanguageVersion, OutputFilename, Stats);
 }
 
+namespace {
+
+/// Writes a serialized module and its doc file to disk on a background
+/// thread, overlapping the file I/O with the rest of the compilation.
+///
+/// The Serializer copies everything it needs out of the AST and SIL while
+/// building the buffers, so writing them out touches no compiler state. The
+/// destructor joins the thread and diagnoses any failures, making sure the
+/// files are on disk before the frontend finishes.
+class BackgroundModuleWriter {
+  struct Output {
+    std::string OutputPath;
+    std::unique_ptr<llvm::MemoryBuffer> Buffer;
+    std::string ProblematicPath;
+    std::error_code EC;
+  };
+
+  DiagnosticEngine &Diags;
+  SmallVector<Output, 2> Outputs;
+  std::thread Thread;
+
+public:
+  explicit BackgroundModuleWriter(DiagnosticEngine &diags) : Diags(diags) {}
+
+  BackgroundModuleWriter(const BackgroundModuleWriter &) = delete;
+  BackgroundModuleWriter &operator=(const BackgroundModuleWriter &) = delete;
+
+  /// Starts writing the given buffers. Must only be called once.
+  void beginWriting(StringRef moduleOutputPath,
+                    std::unique_ptr<llvm::MemoryBuffer> moduleBuffer,
+                    StringRef moduleDocOutputPath,
+                    std::unique_ptr<llvm::MemoryBuffer> moduleDocBuffer) {
+    assert(!Thread.joinable() && "already writing");
+    if (moduleBuffer)
+      Outputs.push_back({moduleOutputPath, std::move(moduleBuffer), {}, {}});
+    if (moduleDocBuffer)
+      Outputs.push_back({moduleDocOutputPath, std::move(moduleDocBuffer),
+                         {}, {}});
+    Thread = std::thread([this] {
+      for (Output &output : Outputs)
+        output.EC = writeSerializedBuffer(output.OutputPath, *output.Buffer,
+                                          output.ProblematicPath);
+    });
+  }
+
+  ~BackgroundModuleWriter() {
+    if (!Thread.joinable())
+      return;
+    Thread.join();
+    for (const Output &output : Outputs) {
+      if (output.EC)
+        Diags.diagnose(SourceLoc(), diag::error_opening_output,
+                       output.ProblematicPath, output.EC.message());
+    }
+  }
+};
+
+} // end anonymous namespace
+
 static bool performCompileStepsPostSILGen(
     CompilerInstance &Instance, CompilerInvocation &Invocation,
     std::unique_ptr<SILModule> SM, bool astGuaranteedToCorrespondToSIL,
     ModuleOrSourceFile MSF, const PrimarySpecificPaths &PSPs,
-    bool moduleIsPublic, int &ReturnValue, FrontendObserver *observer,
-    UnifiedStatsReporter *Stats) {
+    bool moduleIsPublic, TBDSymbolCache &TBDCache, int &ReturnValue,
+    FrontendObserver *observer, UnifiedStatsReporter *Stats) {
 
   FrontendOptions opts = Invocation.getFrontendOptions();
   FrontendOptions::ActionType Action = opts.RequestedAction;
@@ -1204,9 +1278,25 @@ static bool performCompileStepsPostSILGen(
   if (observer)
     observer->performedSILGeneration(*SM);
 
-  if (Stats)
+  if (Stats) {
     countStatsPostSILGen(*Stats, *SM);
 
+    // Sample the SIL module's allocator at phase boundaries while it is
+    // alive. When a stats reporter exists, the module survives this whole
+    // function (generateCode only frees it early in stats-free builds),
+    // but it does die with this frame in multi-primary compilations, so
+    // stop sampling before the next primary's tracers fire.
+    SILModule *SILMod = SM.get();
+    Stats->registerMemorySampler(
+        &UnifiedStatsReporter::AlwaysOnFrontendCounters::MaxSILModuleBytes,
+        [SILMod] { return int64_t(SILMod->getTotalMemory()); });
+  }
+  SWIFT_DEFER {
+    if (Stats)
+      Stats->removeMemorySampler(
+          &UnifiedStatsReporter::AlwaysOnFrontendCounters::MaxSILModuleBytes);
+  };
+
   // We've been told to emit SIL after SILGen, so write it now.
   if (Action == FrontendOptions::ActionType::EmitSILGen) {
     linkAllIfNeeded(Invocation, SM.get());
@@ -1240,6 +1330,8 @@ static bool performCompileStepsPostSILGen(
   // after high-level optimizations or after all optimizations are
   // done, depending on the compiler setting.
 
+  BackgroundModuleWriter backgroundWriter(Instance.getDiags());
+
   auto SerializeSILModuleAction = [&]() {
     const SupplementaryOutputPaths &outs = PSPs.SupplementaryOutputs;
     if (outs.ModuleOutputPath.empty())
@@ -1247,7 +1339,22 @@ static bool performCompileStepsPostSILGen(
 
     SerializationOptions serializationOpts =
         computeSerializationOptions(Invocation, outs, moduleIsPublic);
-    serialize(MSF, serializationOpts, SM.get());
+
+    // When IRGen follows in this job, snapshot the module into memory and
+    // let a background thread do the file I/O; the write overlaps with IRGen
+    // and joins before this function returns. Jobs that stop at the module
+    // outputs have nothing to overlap with, so they write directly.
+    if (Action >= FrontendOptions::ActionType::Immediate) {
+      std::unique_ptr<llvm::MemoryBuffer> moduleBuffer, moduleDocBuffer;
+      serializeToBuffers(MSF, serializationOpts, &moduleBuffer,
+                         &moduleDocBuffer, SM.get());
+      backgroundWriter.beginWriting(outs.ModuleOutputPath,
+                                    std::move(moduleBuffer),
+                                    outs.ModuleDocOutputPath,
+                                    std::move(moduleDocBuffer));
+    } else {
+      serialize(MSF, serializationOpts, SM.get());
+    }
   };
 
   // Set the serialization action, so that the SIL module
@@ -1343,7 +1450,7 @@ static bool performCompileStepsPostSILGen(
     return HadError;
 
   if (validateTBDIfNeeded(Invocation, MSF, astGuaranteedToCorrespondToSIL,
-                          *IRModule))
+                          *IRModule, TBDCache))
     return true;
 
   return generateCode(Invocation, Instance, OutputFilename, IRModule.get(),
@@ -1497,6 +1604,7 @@ computeStatsReporter(const CompilerInvocation &Invocation, CompilerInstance *Ins
   auto Trace = Invocation.getFrontendOptions().TraceStats;
   auto ProfileEvents = Invocation.getFrontendOptions().ProfileEvents;
   auto ProfileEntities = Invocation.getFrontendOptions().ProfileEntities;
+  auto ChromeTrace = Invocation.getFrontendOptions().ChromeTraceEvents;
   SourceManager *SM = &Instance->getSourceMgr();
   clang::SourceManager *CSM = nullptr;
   if (auto *clangImporter = static_cast<ClangImporter *>(
@@ -1506,7 +1614,7 @@ computeStatsReporter(const CompilerInvocation &Invocation, CompilerInstance *Ins
   return llvm::make_unique<UnifiedStatsReporter>(
       "swift-frontend", FEOpts.ModuleName, InputName, TripleName, OutputType,
       OptType, StatsOutputDir, SM, CSM, Trace,
-      ProfileEvents, ProfileEntities);
+      ProfileEvents, ProfileEntities, ChromeTrace);
 }
 
 /// Creates a diagnostic consumer that handles serializing diagnostics, based on
@@ -1556,8 +1664,6 @@ createSerializedDiagnosticConsumerIfNeeded(
 int swift::performFrontend(ArrayRef<const char *> Args,
                            const char *Argv0, void *MainAddr,
                            FrontendObserver *observer) {
-  INITIALIZE_LLVM();
-
   PrintingDiagnosticConsumer PDC;
 
   // Hopefully we won't trigger any LLVM-level fatal errors, but if we do try
@@ -1630,6 +1736,15 @@ int swift::performFrontend(ArrayRef<const char *> Args,
     return finishDiagProcessing(1);
   }
 
+  // Now that the requested action is known, register LLVM's targets only for
+  // the jobs that will reach code generation. Registering every target,
+  // assembly printer, and disassembler costs tens of milliseconds of fixed
+  // startup, which is pure overhead for the parse- and typecheck-only jobs
+  // that dominate incremental debug builds.
+  if (FrontendOptions::doesActionRequireLLVM(
+          Invocation.getFrontendOptions().RequestedAction))
+    INITIALIZE_LLVM();
+
   // Setting DWARF Version depend on platform
   IRGenOptions &IRGenOpts = Invocation.getIRGenOptions();
   IRGenOpts.DWARFVersion = swift::DWARFVersion;
@@ -1718,7 +1833,16 @@ int swift::performFrontend(ArrayRef<const char *> Args,
     // Install stats-reporter somewhere visible for subsystems that
     // need to bump counters as they work, rather than measure
     // accumulated work on completion (mostly: TypeChecker).
-    Instance->getASTContext().Stats = StatsReporter.get();
+    ASTContext &Ctx = Instance->getASTContext();
+    Ctx.Stats = StatsReporter.get();
+
+    // Sample the AST context's arenas at phase boundaries, so peak-memory
+    // growth is attributable to a phase. The context outlives the reporter
+    // whenever a reporter exists (generateCode only frees it early in
+    // stats-free builds).
+    StatsReporter->registerMemorySampler(
+        &UnifiedStatsReporter::AlwaysOnFrontendCounters::MaxASTContextBytes,
+        [&Ctx] { return int64_t(Ctx.getTotalMemory()); });
   }
 
   // The compiler instance has been configured; notify our observer.
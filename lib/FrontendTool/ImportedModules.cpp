@@ -19,10 +19,13 @@
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/STLExtras.h"
 #include "swift/ClangImporter/ClangImporter.h"
+#include "swift/Frontend/Frontend.h"
 #include "swift/Frontend/FrontendOptions.h"
+#include "swift/Parse/ImportPrescan.h"
 #include "clang/Basic/Module.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/FileSystem.h"
 
 using namespace swift;
@@ -113,3 +116,37 @@ bool swift::emitImportedModules(ASTContext &Context, ModuleDecl *mainModule,
 
   return false;
 }
+
+bool swift::emitPrescannedImports(CompilerInstance &Instance,
+                                  const FrontendOptions &opts) {
+  ASTContext &Context = Instance.getASTContext();
+
+  std::string path = opts.InputsAndOutputs.getSingleOutputFilename();
+  std::error_code EC;
+  llvm::raw_fd_ostream out(path, EC, llvm::sys::fs::F_None);
+
+  if (out.has_error() || EC) {
+    Context.Diags.diagnose(SourceLoc(), diag::error_opening_output, path,
+                           EC.message());
+    out.clear_error();
+    return true;
+  }
+
+  // Unlike emitImportedModules, this never sees the bridging header or the
+  // underlying Clang module: those require the importer, and the point of
+  // the scan is to finish before any module is loaded.
+  llvm::StringSet<> seen;
+  for (unsigned bufferID : Instance.getInputBufferIDs()) {
+    SmallVector<PrescannedImport, 16> imports;
+    prescanImports(Instance.getSourceMgr(), bufferID, Context.LangOpts,
+                   imports);
+    for (const auto &import : imports) {
+      // Only the top-level name is needed (i.e. A in A.B.C).
+      StringRef name = import.moduleName();
+      if (seen.insert(name).second)
+        out << name << "\n";
+    }
+  }
+
+  return false;
+}
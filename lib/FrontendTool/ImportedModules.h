@@ -16,12 +16,18 @@
 namespace swift {
 
 class ASTContext;
+class CompilerInstance;
 class FrontendOptions;
 class ModuleDecl;
 
 /// Emit the names of the modules imported by \c mainModule.
 bool emitImportedModules(ASTContext &Context, ModuleDecl *mainModule,
                          const FrontendOptions &opts);
+
+/// Emit the names of the modules imported by the instance's inputs, found
+/// by lexing alone (-scan-imports); no parsing or module loading occurs.
+bool emitPrescannedImports(CompilerInstance &Instance,
+                           const FrontendOptions &opts);
 } // end namespace swift
 
 #endif
@@ -22,6 +22,7 @@
 #include "swift/AST/NameLookup.h"
 #include "swift/AST/ReferencedNameTracker.h"
 #include "swift/AST/Types.h"
+#include "swift/Basic/ReferenceDependencyFormat.h"
 #include "swift/Frontend/FrontendOptions.h"
 #include "swift/Basic/LLVM.h"
 #include "llvm/ADT/MapVector.h"
@@ -32,6 +33,31 @@
 
 using namespace swift;
 
+namespace {
+/// The complete contents of one swiftdeps file, collected in emission order
+/// so that the YAML and binary writers can share a single AST traversal.
+struct CollectedDependencies {
+  std::vector<std::string> providesTopLevel;
+  std::vector<std::string> providesNominal;
+  /// Pairs of (mangled context, member name). An empty member name stands
+  /// for "some non-private member of the context".
+  std::vector<std::pair<std::string, std::string>> providesMember;
+  /// Only emitted when ObjC interop is enabled.
+  bool hasDynamicLookup = false;
+  std::vector<std::string> providesDynamicLookup;
+
+  /// For the depends entries, the bool is the cascading flag; false is
+  /// rendered as the "!private" tag in YAML.
+  std::vector<std::pair<std::string, bool>> dependsTopLevel;
+  std::vector<std::tuple<std::string, std::string, bool>> dependsMember;
+  std::vector<std::pair<std::string, bool>> dependsNominal;
+  std::vector<std::pair<std::string, bool>> dependsDynamicLookup;
+  std::vector<std::string> dependsExternal;
+
+  std::string interfaceHash;
+};
+} // end anonymous namespace
+
 static void findNominalsAndOperators(
     llvm::MapVector<const NominalTypeDecl *, bool> &foundNominals,
     llvm::SmallVectorImpl<const FuncDecl *> &foundOperators,
@@ -123,37 +149,14 @@ swift::reversePathSortedFilenames(const ArrayRef<std::string> elts) {
   return tmp;
 }
 
-bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
-                                      DependencyTracker &depTracker,
-                                      StringRef outputPath) {
-  assert(SF && "Cannot emit reference dependencies without a SourceFile");
-  
-  // Before writing to the dependencies file path, preserve any previous file
-  // that may have been there. No error handling -- this is just a nicety, it
-  // doesn't matter if it fails.
-  llvm::sys::fs::rename(outputPath, outputPath + "~");
-
-  std::error_code EC;
-  llvm::raw_fd_ostream out(outputPath, EC, llvm::sys::fs::F_None);
-
-  if (out.has_error() || EC) {
-    diags.diagnose(SourceLoc(), diag::error_opening_output, outputPath,
-                   EC.message());
-    out.clear_error();
-    return true;
-  }
-
-  auto escape = [](DeclBaseName name) -> std::string {
-    return llvm::yaml::escape(name.userFacingName());
-  };
-
-  out << "### Swift dependencies file v0 ###\n";
-
+/// Collect the contents of the swiftdeps file for \p SF into \p deps.
+static void collectReferenceDependencies(SourceFile *SF,
+                                         DependencyTracker &depTracker,
+                                         CollectedDependencies &deps) {
   llvm::MapVector<const NominalTypeDecl *, bool> extendedNominals;
   llvm::SmallVector<const FuncDecl *, 8> memberOperatorDecls;
   llvm::SmallVector<const ExtensionDecl *, 8> extensionsWithJustMembers;
 
-  out << "provides-top-level:\n";
   for (const Decl *D : SF->Decls) {
     switch (D->getKind()) {
     case DeclKind::Module:
@@ -195,11 +198,13 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
     case DeclKind::InfixOperator:
     case DeclKind::PrefixOperator:
     case DeclKind::PostfixOperator:
-      out << "- \"" << escape(cast<OperatorDecl>(D)->getName()) << "\"\n";
+      deps.providesTopLevel.push_back(
+          cast<OperatorDecl>(D)->getName().userFacingName());
       break;
 
     case DeclKind::PrecedenceGroup:
-      out << "- \"" << escape(cast<PrecedenceGroupDecl>(D)->getName()) << "\"\n";
+      deps.providesTopLevel.push_back(
+          cast<PrecedenceGroupDecl>(D)->getName().userFacingName());
       break;
 
     case DeclKind::Enum:
@@ -213,7 +218,7 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
           NTD->getFormalAccess() <= AccessLevel::FilePrivate) {
         break;
       }
-      out << "- \"" << escape(NTD->getName()) << "\"\n";
+      deps.providesTopLevel.push_back(NTD->getName().userFacingName());
       extendedNominals[NTD] |= true;
       findNominalsAndOperators(extendedNominals, memberOperatorDecls,
                                NTD->getMembers());
@@ -231,7 +236,7 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
           VD->getFormalAccess() <= AccessLevel::FilePrivate) {
         break;
       }
-      out << "- \"" << escape(VD->getBaseName()) << "\"\n";
+      deps.providesTopLevel.push_back(VD->getBaseName().userFacingName());
       break;
     }
 
@@ -258,23 +263,17 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
 
   // This is also part of "provides-top-level".
   for (auto *operatorFunction : memberOperatorDecls)
-    out << "- \"" << escape(operatorFunction->getName()) << "\"\n";
+    deps.providesTopLevel.push_back(
+        operatorFunction->getName().userFacingName());
 
-  out << "provides-nominal:\n";
   for (auto entry : extendedNominals) {
     if (!entry.second)
       continue;
-    out << "- \"";
-    out << mangleTypeAsContext(entry.first);
-    out << "\"\n";
+    deps.providesNominal.push_back(mangleTypeAsContext(entry.first));
   }
 
-  out << "provides-member:\n";
-  for (auto entry : extendedNominals) {
-    out << "- [\"";
-    out << mangleTypeAsContext(entry.first);
-    out << "\", \"\"]\n";
-  }
+  for (auto entry : extendedNominals)
+    deps.providesMember.push_back({mangleTypeAsContext(entry.first), ""});
 
   // This is also part of "provides-member".
   for (auto *ED : extensionsWithJustMembers) {
@@ -287,16 +286,17 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
           VD->getFormalAccess() <= AccessLevel::FilePrivate) {
         continue;
       }
-      out << "- [\"" << mangledName << "\", \""
-          << escape(VD->getBaseName()) << "\"]\n";
+      deps.providesMember.push_back(
+          {mangledName, VD->getBaseName().userFacingName()});
     }
   }
 
   if (SF->getASTContext().LangOpts.EnableObjCInterop) {
+    deps.hasDynamicLookup = true;
+
     // FIXME: This requires a traversal of the whole file to compute.
     // We should (a) see if there's a cheaper way to keep it up to date,
     // and/or (b) see if we can fast-path cases where there's no ObjC involved.
-    out << "provides-dynamic-lookup:\n";
     class NameCollector : public VisibleDeclConsumer {
     private:
       SmallVector<DeclBaseName, 16> names;
@@ -316,9 +316,8 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
     };
     NameCollector collector;
     SF->lookupClassMembers({}, collector);
-    for (DeclBaseName name : collector.getNames()) {
-      out << "- \"" << escape(name) << "\"\n";
-    }
+    for (DeclBaseName name : collector.getNames())
+      deps.providesDynamicLookup.push_back(name.userFacingName());
   }
 
   auto sortedByName =
@@ -336,16 +335,12 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
   const ReferencedNameTracker *const tracker = SF->getReferencedNameTracker();
   assert(tracker && "Cannot emit reference dependencies without a tracker");
 
-  out << "depends-top-level:\n";
   for (auto &entry : sortedByName(tracker->getTopLevelNames())) {
     assert(!entry.first.empty());
-    out << "- ";
-    if (!entry.second)
-      out << "!private ";
-    out << "\"" << escape(entry.first) << "\"\n";
+    deps.dependsTopLevel.push_back(
+        {entry.first.userFacingName(), entry.second});
   }
 
-  out << "depends-member:\n";
   auto &memberLookupTable = tracker->getUsedMembers();
   using TableEntryTy = std::pair<ReferencedNameTracker::MemberPair, bool>;
   std::vector<TableEntryTy> sortedMembers{
@@ -372,18 +367,14 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
         entry.first.first->getFormalAccess() <= AccessLevel::FilePrivate)
       continue;
 
-    out << "- ";
-    if (!entry.second)
-      out << "!private ";
-    out << "[\"";
-    out << mangleTypeAsContext(entry.first.first);
-    out << "\", \"";
-    if (!entry.first.second.empty())
-      out << escape(entry.first.second);
-    out << "\"]\n";
+    deps.dependsMember.push_back(
+        std::make_tuple(mangleTypeAsContext(entry.first.first),
+                        entry.first.second.empty()
+                            ? std::string()
+                            : entry.first.second.userFacingName(),
+                        entry.second));
   }
 
-  out << "depends-nominal:\n";
   for (auto i = sortedMembers.begin(), e = sortedMembers.end(); i != e; ++i) {
     bool isCascading = i->second;
     while (i+1 != e && i[0].first.first == i[1].first.first) {
@@ -395,17 +386,79 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
         i->first.first->getFormalAccess() <= AccessLevel::FilePrivate)
       continue;
 
+    deps.dependsNominal.push_back(
+        {mangleTypeAsContext(i->first.first), isCascading});
+  }
+
+  for (auto &entry : sortedByName(tracker->getDynamicLookupNames())) {
+    assert(!entry.first.empty());
+    deps.dependsDynamicLookup.push_back(
+        {entry.first.userFacingName(), entry.second});
+  }
+
+  deps.dependsExternal =
+      reversePathSortedFilenames(depTracker.getDependencies());
+
+  llvm::SmallString<32> interfaceHash;
+  SF->getInterfaceHash(interfaceHash);
+  deps.interfaceHash = interfaceHash.str();
+}
+
+static void emitDependenciesAsYAML(const CollectedDependencies &deps,
+                                   llvm::raw_ostream &out) {
+  auto escape = [](StringRef name) -> std::string {
+    return llvm::yaml::escape(name);
+  };
+
+  out << "### Swift dependencies file v0 ###\n";
+
+  out << "provides-top-level:\n";
+  for (auto &name : deps.providesTopLevel)
+    out << "- \"" << escape(name) << "\"\n";
+
+  out << "provides-nominal:\n";
+  for (auto &mangled : deps.providesNominal)
+    out << "- \"" << mangled << "\"\n";
+
+  out << "provides-member:\n";
+  for (auto &entry : deps.providesMember) {
+    out << "- [\"" << entry.first << "\", \"" << escape(entry.second)
+        << "\"]\n";
+  }
+
+  if (deps.hasDynamicLookup) {
+    out << "provides-dynamic-lookup:\n";
+    for (auto &name : deps.providesDynamicLookup)
+      out << "- \"" << escape(name) << "\"\n";
+  }
+
+  out << "depends-top-level:\n";
+  for (auto &entry : deps.dependsTopLevel) {
     out << "- ";
-    if (!isCascading)
+    if (!entry.second)
       out << "!private ";
-    out << "\"";
-    out <<  mangleTypeAsContext(i->first.first);
-    out << "\"\n";
+    out << "\"" << escape(entry.first) << "\"\n";
+  }
+
+  out << "depends-member:\n";
+  for (auto &entry : deps.dependsMember) {
+    out << "- ";
+    if (!std::get<2>(entry))
+      out << "!private ";
+    out << "[\"" << std::get<0>(entry) << "\", \""
+        << escape(std::get<1>(entry)) << "\"]\n";
+  }
+
+  out << "depends-nominal:\n";
+  for (auto &entry : deps.dependsNominal) {
+    out << "- ";
+    if (!entry.second)
+      out << "!private ";
+    out << "\"" << entry.first << "\"\n";
   }
 
   out << "depends-dynamic-lookup:\n";
-  for (auto &entry : sortedByName(tracker->getDynamicLookupNames())) {
-    assert(!entry.first.empty());
+  for (auto &entry : deps.dependsDynamicLookup) {
     out << "- ";
     if (!entry.second)
       out << "!private ";
@@ -413,13 +466,151 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
   }
 
   out << "depends-external:\n";
-  for (auto &entry : reversePathSortedFilenames(depTracker.getDependencies())) {
-    out << "- \"" << llvm::yaml::escape(entry) << "\"\n";
+  for (auto &entry : deps.dependsExternal)
+    out << "- \"" << escape(entry) << "\"\n";
+
+  out << "interface-hash: \"" << deps.interfaceHash << "\"\n";
+}
+
+static void writeUInt32(llvm::raw_ostream &out, uint32_t value) {
+  char bytes[4] = {char(value), char(value >> 8), char(value >> 16),
+                   char(value >> 24)};
+  out.write(bytes, 4);
+}
+
+static void emitDependenciesAsBinary(const CollectedDependencies &deps,
+                                     llvm::raw_ostream &out) {
+  using namespace reference_dependencies;
+
+  // Intern every name, in emission order, assigning dense indices. The
+  // StringRef keys point into \p deps, which outlives the table.
+  llvm::MapVector<StringRef, uint32_t> strings;
+  auto intern = [&strings](StringRef name) -> uint32_t {
+    return strings.insert(std::make_pair(name, uint32_t(strings.size())))
+        .first->second;
+  };
+
+  for (auto &name : deps.providesTopLevel)
+    intern(name);
+  for (auto &mangled : deps.providesNominal)
+    intern(mangled);
+  for (auto &entry : deps.providesMember) {
+    intern(entry.first);
+    intern(entry.second);
+  }
+  for (auto &name : deps.providesDynamicLookup)
+    intern(name);
+  for (auto &entry : deps.dependsTopLevel)
+    intern(entry.first);
+  for (auto &entry : deps.dependsMember) {
+    intern(std::get<0>(entry));
+    intern(std::get<1>(entry));
+  }
+  for (auto &entry : deps.dependsNominal)
+    intern(entry.first);
+  for (auto &entry : deps.dependsDynamicLookup)
+    intern(entry.first);
+  for (auto &name : deps.dependsExternal)
+    intern(name);
+  intern(deps.interfaceHash);
+
+  out.write(BinaryMagic, sizeof(BinaryMagic));
+  writeUInt32(out, BinaryVersion);
+
+  writeUInt32(out, strings.size());
+  for (auto &entry : strings) {
+    writeUInt32(out, entry.first.size());
+    out << entry.first;
   }
 
-  llvm::SmallString<32> interfaceHash;
-  SF->getInterfaceHash(interfaceHash);
-  out << "interface-hash: \"" << interfaceHash << "\"\n";
+  auto beginSection = [&out](BinarySection section, size_t count) {
+    out.write(uint8_t(section));
+    writeUInt32(out, count);
+  };
+
+  beginSection(BinarySection::ProvidesTopLevel, deps.providesTopLevel.size());
+  for (auto &name : deps.providesTopLevel)
+    writeUInt32(out, intern(name));
+
+  beginSection(BinarySection::ProvidesNominal, deps.providesNominal.size());
+  for (auto &mangled : deps.providesNominal)
+    writeUInt32(out, intern(mangled));
+
+  beginSection(BinarySection::ProvidesMember, deps.providesMember.size());
+  for (auto &entry : deps.providesMember) {
+    writeUInt32(out, intern(entry.first));
+    writeUInt32(out, intern(entry.second));
+  }
+
+  if (deps.hasDynamicLookup) {
+    beginSection(BinarySection::ProvidesDynamicLookup,
+                 deps.providesDynamicLookup.size());
+    for (auto &name : deps.providesDynamicLookup)
+      writeUInt32(out, intern(name));
+  }
+
+  beginSection(BinarySection::DependsTopLevel, deps.dependsTopLevel.size());
+  for (auto &entry : deps.dependsTopLevel) {
+    writeUInt32(out, intern(entry.first));
+    out.write(uint8_t(entry.second));
+  }
+
+  beginSection(BinarySection::DependsMember, deps.dependsMember.size());
+  for (auto &entry : deps.dependsMember) {
+    writeUInt32(out, intern(std::get<0>(entry)));
+    writeUInt32(out, intern(std::get<1>(entry)));
+    out.write(uint8_t(std::get<2>(entry)));
+  }
+
+  beginSection(BinarySection::DependsNominal, deps.dependsNominal.size());
+  for (auto &entry : deps.dependsNominal) {
+    writeUInt32(out, intern(entry.first));
+    out.write(uint8_t(entry.second));
+  }
+
+  beginSection(BinarySection::DependsDynamicLookup,
+               deps.dependsDynamicLookup.size());
+  for (auto &entry : deps.dependsDynamicLookup) {
+    writeUInt32(out, intern(entry.first));
+    out.write(uint8_t(entry.second));
+  }
+
+  beginSection(BinarySection::DependsExternal, deps.dependsExternal.size());
+  for (auto &name : deps.dependsExternal)
+    writeUInt32(out, intern(name));
+
+  beginSection(BinarySection::InterfaceHash, 1);
+  writeUInt32(out, intern(deps.interfaceHash));
+}
+
+bool swift::emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
+                                      DependencyTracker &depTracker,
+                                      StringRef outputPath,
+                                      bool emitBinaryFormat) {
+  assert(SF && "Cannot emit reference dependencies without a SourceFile");
+
+  // Before writing to the dependencies file path, preserve any previous file
+  // that may have been there. No error handling -- this is just a nicety, it
+  // doesn't matter if it fails.
+  llvm::sys::fs::rename(outputPath, outputPath + "~");
+
+  std::error_code EC;
+  llvm::raw_fd_ostream out(outputPath, EC, llvm::sys::fs::F_None);
+
+  if (out.has_error() || EC) {
+    diags.diagnose(SourceLoc(), diag::error_opening_output, outputPath,
+                   EC.message());
+    out.clear_error();
+    return true;
+  }
+
+  CollectedDependencies deps;
+  collectReferenceDependencies(SF, depTracker, deps);
+
+  if (emitBinaryFormat)
+    emitDependenciesAsBinary(deps, out);
+  else
+    emitDependenciesAsYAML(deps, out);
 
   return false;
 }
@@ -32,9 +32,13 @@ std::vector<std::string>
 reversePathSortedFilenames(const llvm::ArrayRef<std::string> paths);
 
 /// Emit a Swift-style dependencies file for \p SF.
+///
+/// When \p emitBinaryFormat is set, the compact binary encoding described in
+/// swift/Basic/ReferenceDependencyFormat.h is written instead of YAML.
 bool emitReferenceDependencies(DiagnosticEngine &diags, SourceFile *SF,
                                DependencyTracker &depTracker,
-                               StringRef outputPath);
+                               StringRef outputPath,
+                               bool emitBinaryFormat);
 } // end namespace swift
 
 #endif
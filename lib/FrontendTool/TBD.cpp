@@ -16,6 +16,7 @@
 #include "swift/AST/DiagnosticEngine.h"
 #include "swift/AST/DiagnosticsFrontend.h"
 #include "swift/AST/Module.h"
+#include "swift/Basic/FileSystem.h"
 #include "swift/Basic/LLVM.h"
 #include "swift/Demangling/Demangle.h"
 #include "swift/Frontend/FrontendOptions.h"
@@ -25,7 +26,6 @@
 #include "llvm/ADT/StringSet.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/ValueSymbolTable.h"
-#include "llvm/Support/FileSystem.h"
 #include <vector>
 
 using namespace swift;
@@ -39,17 +39,18 @@ static std::vector<StringRef> sortSymbols(llvm::StringSet<> &symbols) {
 }
 
 bool swift::writeTBD(ModuleDecl *M, bool hasMultipleIGMs,
-                     StringRef OutputFilename, StringRef installName) {
-  std::error_code EC;
-  llvm::raw_fd_ostream OS(OutputFilename, EC, llvm::sys::fs::F_None);
+                     StringRef OutputFilename, StringRef installName,
+                     TBDSymbolCache *cache) {
+  std::error_code EC = swift::atomicallyWritingToFile(
+      OutputFilename, [&](llvm::raw_pwrite_stream &OS) {
+        writeTBDFile(M, OS, hasMultipleIGMs, installName, cache);
+      });
   if (EC) {
     M->getASTContext().Diags.diagnose(SourceLoc(), diag::error_opening_output,
                                       OutputFilename, EC.message());
     return true;
   }
 
-  writeTBDFile(M, OS, hasMultipleIGMs, installName);
-
   return false;
 }
 
@@ -117,9 +118,10 @@ static bool validateSymbolSet(DiagnosticEngine &diags,
 }
 
 bool swift::validateTBD(ModuleDecl *M, llvm::Module &IRModule,
-                        bool hasMultipleIGMs, bool diagnoseExtraSymbolsInTBD) {
+                        bool hasMultipleIGMs, bool diagnoseExtraSymbolsInTBD,
+                        TBDSymbolCache *cache) {
   llvm::StringSet<> symbols;
-  enumeratePublicSymbols(M, symbols, hasMultipleIGMs);
+  enumeratePublicSymbols(M, symbols, hasMultipleIGMs, cache);
 
   return validateSymbolSet(M->getASTContext().Diags, symbols, IRModule,
                            diagnoseExtraSymbolsInTBD);
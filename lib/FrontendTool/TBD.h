@@ -23,12 +23,14 @@ namespace swift {
 class ModuleDecl;
 class FileUnit;
 class FrontendOptions;
+struct TBDSymbolCache;
 
 bool writeTBD(ModuleDecl *M, bool hasMultipleIGMs, StringRef OutputFilename,
-              llvm::StringRef installName);
+              llvm::StringRef installName, TBDSymbolCache *cache = nullptr);
 bool inputFileKindCanHaveTBDValidated(InputFileKind kind);
 bool validateTBD(ModuleDecl *M, llvm::Module &IRModule, bool hasMultipleIGMs,
-                 bool diagnoseExtraSymbolsInTBD);
+                 bool diagnoseExtraSymbolsInTBD,
+                 TBDSymbolCache *cache = nullptr);
 bool validateTBD(FileUnit *M, llvm::Module &IRModule, bool hasMultipleIGMs,
                  bool diagnoseExtraSymbolsInTBD);
 }
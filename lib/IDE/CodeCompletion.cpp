@@ -5679,6 +5679,14 @@ void swift::ide::copyCodeCompletionResults(CodeCompletionResultSink &targetSink,
   // results alive.
   targetSink.ForeignAllocators.push_back(sourceSink.Allocator);
 
+  // Results deserialized from an on-disk cache reference strings in the
+  // cache file's buffer; share ownership of it too, so the strings stay
+  // valid if the cache entry is evicted or replaced while these results are
+  // still in use.
+  targetSink.SourceBuffers.insert(targetSink.SourceBuffers.end(),
+                                  sourceSink.SourceBuffers.begin(),
+                                  sourceSink.SourceBuffers.end());
+
   if (onlyTypes) {
     std::copy_if(sourceSink.Results.begin(), sourceSink.Results.end(),
                  std::back_inserter(targetSink.Results),
@@ -102,12 +102,6 @@ CodeCompletionCache::~CodeCompletionCache() {}
 /// cached results. This isn't expected to change very often.
 static constexpr uint32_t onDiskCompletionCacheVersion = 1;
 
-static StringRef copyString(llvm::BumpPtrAllocator &Allocator, StringRef Str) {
-  char *Mem = Allocator.Allocate<char>(Str.size());
-  std::copy(Str.begin(), Str.end(), Mem);
-  return StringRef(Mem, Str.size());
-}
-
 static ArrayRef<StringRef> copyStringArray(llvm::BumpPtrAllocator &Allocator,
                                            ArrayRef<StringRef> Arr) {
   StringRef *Buff = Allocator.Allocate<StringRef>(Arr.size());
@@ -174,13 +168,17 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
   (void)stringCount; // so it is not seen as "unused" in release builds.
   
   // STRINGS
+  //
+  // Returned strings point directly into the file's buffer, which the
+  // caller hands to the sink to keep alive; see
+  // CodeCompletionResultSink::SourceBuffers.
   auto getString = [&](uint32_t index) -> StringRef {
     if (index == ~0u)
       return "";
 
     const char *p = strings + index;
     auto size = read32le(p);
-    return copyString(*V.Sink.Allocator, StringRef(p, size));
+    return StringRef(p, size);
   };
 
   // CHUNKS
@@ -440,7 +438,9 @@ static std::string getName(StringRef cacheDirectory,
 Optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::get(const Key &K) {
   // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(getName(cacheDirectory, K));
+  auto bufferOrErr = llvm::MemoryBuffer::getFile(getName(cacheDirectory, K),
+                                                 /*FileSize=*/-1,
+                                                 /*RequiresNullTerminator=*/false);
   if (!bufferOrErr)
     return None;
 
@@ -449,6 +449,9 @@ OnDiskCodeCompletionCache::get(const Key &K) {
   if (!readCachedModule(bufferOrErr.get().get(), K, *V))
     return None;
 
+  // The results reference strings in the file's buffer; the sink shares
+  // ownership of it so they survive eviction of this cache entry.
+  V->Sink.SourceBuffers.push_back(std::move(bufferOrErr.get()));
   return V;
 }
 
@@ -482,7 +485,8 @@ std::error_code OnDiskCodeCompletionCache::set(const Key &K, ValueRefCntPtr V) {
 Optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
   // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename);
+  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename, /*FileSize=*/-1,
+                                                 /*RequiresNullTerminator=*/false);
   if (!bufferOrErr)
     return None;
 
@@ -495,6 +499,9 @@ OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
                         /*allowOutOfDate*/ true))
     return None;
 
+  // The results reference strings in the file's buffer; the sink shares
+  // ownership of it so they survive eviction of this cache entry.
+  V->Sink.SourceBuffers.push_back(std::move(bufferOrErr.get()));
   return V;
 }
 
@@ -143,6 +143,7 @@ SpareBitVector getBitVectorFromAPInt(const APInt &bits, unsigned startBit = 0) {
     return SpareBitVector::fromAPInt(bits);
   }
   SpareBitVector result;
+  result.reserve(startBit + bits.getBitWidth());
   result.appendClearBits(startBit);
   result.append(SpareBitVector::fromAPInt(bits));
   return result;
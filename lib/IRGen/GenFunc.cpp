@@ -77,6 +77,7 @@
 #include "swift/AST/PrettyStackTrace.h"
 #include "swift/AST/SubstitutionMap.h"
 #include "swift/AST/Types.h"
+#include "swift/Basic/Statistic.h"
 #include "clang/CodeGen/CodeGenABITypes.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
@@ -594,11 +595,18 @@ const TypeInfo *TypeConverter::convertFunctionType(SILFunctionType *T) {
 }
 
 Signature FuncSignatureInfo::getSignature(IRGenModule &IGM) const {
+  auto *Stats = IGM.Context.Stats;
   // If it's already been filled in, we're done.
-  if (TheSignature.isValid())
+  if (TheSignature.isValid()) {
+    if (Stats)
+      Stats->getFrontendCounters().NumIRSignatureCacheHits++;
     return TheSignature;
+  }
 
-  // Update the cache and return.
+  // Update the cache and return. For foreign conventions this runs the
+  // Clang ABI lowering, so misses are what show up in profiles.
+  if (Stats)
+    Stats->getFrontendCounters().NumIRSignatureCacheMisses++;
   TheSignature = Signature::getUncached(IGM, FormalType);
   assert(TheSignature.isValid());
   return TheSignature;
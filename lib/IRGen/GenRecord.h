@@ -128,6 +128,36 @@ public:
     return {this->template getTrailingObjects<FieldImpl>(), NumFields};
   }
 
+private:
+  /// Whether outlining a copy or destroy of this record shrinks the caller.
+  /// The call to the outlined function is no smaller than a single field
+  /// operation, so only a sequence of several operations is worth a shared
+  /// per-type function; \p numFieldOps is the number of fields the operation
+  /// would actually visit.
+  bool isOutliningProfitable(unsigned numFieldOps) const {
+    return numFieldOps > 1;
+  }
+
+  /// Number of fields a copy or assignment visits.
+  unsigned getNumNonEmptyFields() const {
+    unsigned count = 0;
+    for (auto &field : getFields())
+      if (!field.isEmpty())
+        ++count;
+    return count;
+  }
+
+  /// Number of fields a destroy visits.
+  unsigned getNumNonPODFields() const {
+    unsigned count = 0;
+    for (auto &field : getFields())
+      if (!field.isPOD())
+        ++count;
+    return count;
+  }
+
+public:
+
   /// The standard schema is just all the fields jumbled together.
   void getSchema(ExplosionSchema &schema) const override {
     for (auto &field : getFields()) {
@@ -137,7 +167,8 @@ public:
 
   void assignWithCopy(IRGenFunction &IGF, Address dest, Address src, SILType T,
                       bool isOutlined) const override {
-    if (isOutlined || T.hasOpenedExistential()) {
+    if (isOutlined || T.hasOpenedExistential() ||
+        !isOutliningProfitable(getNumNonEmptyFields())) {
       auto offsets = asImpl().getNonFixedOffsets(IGF, T);
       for (auto &field : getFields()) {
         if (field.isEmpty())
@@ -160,7 +191,8 @@ public:
 
   void assignWithTake(IRGenFunction &IGF, Address dest, Address src, SILType T,
                       bool isOutlined) const override {
-    if (isOutlined || T.hasOpenedExistential()) {
+    if (isOutlined || T.hasOpenedExistential() ||
+        !isOutliningProfitable(getNumNonEmptyFields())) {
       auto offsets = asImpl().getNonFixedOffsets(IGF, T);
       for (auto &field : getFields()) {
         if (field.isEmpty())
@@ -190,7 +222,8 @@ public:
           IGF, dest, src, T, isOutlined);
     }
 
-    if (isOutlined || T.hasOpenedExistential()) {
+    if (isOutlined || T.hasOpenedExistential() ||
+        !isOutliningProfitable(getNumNonEmptyFields())) {
       auto offsets = asImpl().getNonFixedOffsets(IGF, T);
       for (auto &field : getFields()) {
         if (field.isEmpty())
@@ -221,7 +254,8 @@ public:
       return;
     }
 
-    if (isOutlined || T.hasOpenedExistential()) {
+    if (isOutlined || T.hasOpenedExistential() ||
+        !isOutliningProfitable(getNumNonEmptyFields())) {
       auto offsets = asImpl().getNonFixedOffsets(IGF, T);
       for (auto &field : getFields()) {
         if (field.isEmpty())
@@ -244,7 +278,8 @@ public:
 
   void destroy(IRGenFunction &IGF, Address addr, SILType T,
                bool isOutlined) const override {
-    if (isOutlined || T.hasOpenedExistential()) {
+    if (isOutlined || T.hasOpenedExistential() ||
+        !isOutliningProfitable(getNumNonPODFields())) {
       auto offsets = asImpl().getNonFixedOffsets(IGF, T);
       for (auto &field : getFields()) {
         if (field.isPOD())
@@ -19,6 +19,7 @@
 #include "swift/AST/PrettyStackTrace.h"
 #include "swift/AST/ProtocolConformance.h"
 #include "swift/AST/SubstitutionMap.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/IRGen/Linking.h"
 #include "swift/Reflection/MetadataSourceBuilder.h"
 #include "swift/Reflection/Records.h"
@@ -839,12 +840,44 @@ const char *IRGenModule::getReflectionTypeRefSectionName() {
 }
 
 llvm::Constant *IRGenModule::getAddrOfFieldName(StringRef Name) {
+  auto *Stats = Context.Stats;
   auto &entry = FieldNames[Name];
-  if (entry.second)
+  if (entry.second) {
+    if (Stats)
+      Stats->getFrontendCounters().NumReflectionStringBytesSaved
+        += Name.size() + 1;
     return entry.second;
+  }
+
+  // These strings are nul-terminated and never coalesced by the linker (see
+  // createStringConstant), so if the name is a suffix of a string we already
+  // emitted we can point into the tail of the existing global instead of
+  // emitting a second copy. A suffix of an emitted string is a prefix of its
+  // reversal, and the keys with a given prefix form a contiguous range
+  // starting at lower_bound.
+  std::string Reversed(Name.rbegin(), Name.rend());
+  auto tail = ReflectionStringTails.lower_bound(Reversed);
+  if (tail != ReflectionStringTails.end() &&
+      StringRef(tail->first).startswith(Reversed)) {
+    auto global = tail->second;
+    auto zero = llvm::ConstantInt::get(SizeTy, 0);
+    auto offset = llvm::ConstantInt::get(SizeTy,
+                                         tail->first.size() - Name.size());
+    llvm::Constant *indices[] = { zero, offset };
+    entry.first = global;
+    entry.second = llvm::ConstantExpr::getInBoundsGetElementPtr(
+      global->getValueType(), global, indices);
+    if (Stats)
+      Stats->getFrontendCounters().NumReflectionStringBytesSaved
+        += Name.size() + 1;
+    return entry.second;
+  }
 
   entry = createStringConstant(Name, /*willBeRelativelyAddressed*/ true,
                                getReflectionStringsSectionName());
+  ReflectionStringTails[std::move(Reversed)] = entry.first;
+  if (Stats)
+    Stats->getFrontendCounters().NumReflectionStringBytes += Name.size() + 1;
   return entry.second;
 }
 
@@ -63,6 +63,17 @@ namespace irgen {
 typedef llvm::PointerUnion<const TypeInfo*, llvm::Type*> TypeCacheEntry;
 
 /// The helper class for generating types.
+///
+/// Lowering results are memoized for the lifetime of the process, with
+/// equivalent archetypes folded to exemplars so constraint-equal types share
+/// one entry. The caches cannot be persisted across frontend invocations:
+/// a TypeInfo is built around a process-local llvm::Type and virtual
+/// strategy objects, so only its scalar facts (size, alignment, spare bits,
+/// flags) would survive serialization, and rebuilding the rest dominates
+/// the cost of lowering. Any cross-invocation cache would therefore have to
+/// live at a level that can regenerate TypeInfos from such a summary, and
+/// would need to be keyed on everything layout depends on (target,
+/// resilience expansion and the layouts of all component types).
 class TypeConverter {
 public:
   IRGenModule &IGM;
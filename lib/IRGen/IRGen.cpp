@@ -26,6 +26,7 @@
 #include "swift/Basic/Timer.h"
 #include "swift/Basic/Version.h"
 #include "swift/ClangImporter/ClangImporter.h"
+#include "swift/Demangling/Demangle.h"
 #include "swift/IRGen/IRGenPublic.h"
 #include "swift/IRGen/IRGenSILPasses.h"
 #include "swift/LLVMPasses/Passes.h"
@@ -174,6 +175,12 @@ void swift::performLLVMOptimizations(IRGenOptions &Opts, llvm::Module *Module,
         llvm::createAlwaysInlinerLegacyPass(/*insertlifetime*/false);
   }
 
+  // When the object file will carry bitcode for link-time optimization, hold
+  // back the transformations the LTO backends want to run themselves with
+  // whole-program visibility.
+  PMBuilder.PrepareForLTO = Opts.LLVMLTOKind == IRGenLLVMLTOKind::Full;
+  PMBuilder.PrepareForThinLTO = Opts.LLVMLTOKind == IRGenLLVMLTOKind::Thin;
+
   // If the optimizer is enabled, we run the ARCOpt pass in the scalar optimizer
   // and the Contract pass as late as possible.
   if (!Opts.DisableLLVMARCOpts) {
@@ -369,6 +376,23 @@ static bool needsRecompile(StringRef OutputFilename, ArrayRef<uint8_t> HashData,
   return true;
 }
 
+/// Returns true if \p name mangles a type metadata variable, i.e. the
+/// metadata itself, the full metadata or a generic metadata pattern.
+static bool isTypeMetadataSymbol(Demangle::Context &DCtx, StringRef name) {
+  auto *node = DCtx.demangleSymbolAsNode(name);
+  if (!node || node->getKind() != Demangle::Node::Kind::Global ||
+      node->getNumChildren() == 0)
+    return false;
+  switch (node->getChild(0)->getKind()) {
+  case Demangle::Node::Kind::TypeMetadata:
+  case Demangle::Node::Kind::FullTypeMetadata:
+  case Demangle::Node::Kind::GenericTypeMetadataPattern:
+    return true;
+  default:
+    return false;
+  }
+}
+
 static void countStatsPostIRGen(UnifiedStatsReporter &Stats,
                                 const llvm::Module& Module) {
   auto &C = Stats.getFrontendCounters();
@@ -386,6 +410,17 @@ static void countStatsPostIRGen(UnifiedStatsReporter &Stats,
       C.NumIRInsts += BB.size();
     }
   }
+  // Sum up the size of all type metadata defined in this module, so that
+  // per-module metadata contributions to the binary can be compared.
+  auto &DL = Module.getDataLayout();
+  Demangle::Context DCtx;
+  for (auto const &GV : Module.globals()) {
+    if (GV.isDeclaration())
+      continue;
+    if (isTypeMetadataSymbol(DCtx, GV.getName()))
+      C.NumIRTypeMetadataBytes += DL.getTypeAllocSize(GV.getValueType());
+    DCtx.clear();
+  }
 }
 
 /// Run the LLVM passes. In multi-threaded compilation this will be done for
@@ -475,6 +510,18 @@ bool swift::performLLVM(IRGenOptions &Opts, DiagnosticEngine *Diags,
     break;
   case IRGenOutputKind::NativeAssembly:
   case IRGenOutputKind::ObjectFile: {
+    if (Opts.OutputKind == IRGenOutputKind::ObjectFile &&
+        Opts.LLVMLTOKind != IRGenLLVMLTOKind::None) {
+      // Emit bitcode into the object file and leave code generation to the
+      // linker's LTO backends. The ThinLTO writer also attaches the module
+      // summary that the thin-link phase indexes.
+      if (Opts.LLVMLTOKind == IRGenLLVMLTOKind::Thin)
+        EmitPasses.add(createWriteThinLTOBitcodePass(*RawOS));
+      else
+        EmitPasses.add(createBitcodeWriterPass(*RawOS));
+      break;
+    }
+
     llvm::TargetMachine::CodeGenFileType FileType;
     FileType = (Opts.OutputKind == IRGenOutputKind::NativeAssembly
                   ? llvm::TargetMachine::CGFT_AssemblyFile
@@ -864,6 +911,16 @@ static void ThreadEntryPoint(IRGenerator *irgen,
 
 /// Generates LLVM IR, runs the LLVM passes and produces the output files.
 /// All this is done in multiple threads.
+///
+/// The unit of parallelism is the source file: each file gets its own
+/// IRGenModule and output, so a single-file WMO build degenerates to one
+/// thread. Sharding the functions of one file across several LLVM modules
+/// would require decoupling the output list from the source file list in
+/// the driver, a cost-based partitioning in IRGenerator::getGenModule
+/// (only functions without a source file may be assigned freely today),
+/// and a guarantee that symbols with private linkage - including targets
+/// of relative references in reflection metadata - are never referenced
+/// across shards.
 static void performParallelIRGeneration(
     IRGenOptions &Opts, swift::ModuleDecl *M, std::unique_ptr<SILModule> SILMod,
     StringRef ModuleName, int numThreads,
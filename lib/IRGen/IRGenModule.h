@@ -43,6 +43,7 @@
 #include "llvm/Target/TargetMachine.h"
 
 #include <atomic>
+#include <map>
 
 namespace llvm {
   class Constant;
@@ -864,6 +865,11 @@ private:
     StringsForTypeRef;
   llvm::DenseMap<CanType, llvm::GlobalVariable*> TypeRefs;
   llvm::StringMap<std::pair<llvm::GlobalVariable*, llvm::Constant*>> FieldNames;
+  /// Maps the reversed text of each emitted reflection string to its global,
+  /// so a new name which is a suffix of an emitted one (a prefix here) can
+  /// point into the existing storage instead of getting its own global.
+  /// Ordered so the prefix search is a lower_bound.
+  std::map<std::string, llvm::GlobalVariable*> ReflectionStringTails;
   llvm::StringMap<llvm::Constant*> ObjCSelectorRefs;
   llvm::StringMap<llvm::Constant*> ObjCMethodNames;
 
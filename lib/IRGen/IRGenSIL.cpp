@@ -743,8 +743,10 @@ public:
                                       bool IsAnonymous,
                                       Alignment Align = Alignment(0)) {
     // Never emit shadow copies when optimizing, or if already on the stack.
-    // No debug info is emitted for refcounts either.
+    // No debug info is emitted for refcounts either. In line-tables-only
+    // mode the variable the copy would be described by is never emitted.
     if (IGM.IRGen.Opts.shouldOptimize() || IsAnonymous ||
+        IGM.IRGen.Opts.DebugInfoKind <= IRGenDebugInfoKind::LineTables ||
         isa<llvm::AllocaInst>(Storage) || isa<llvm::UndefValue>(Storage) ||
         Storage->getType() == IGM.RefCountedPtrTy)
       return Storage;
@@ -3608,6 +3610,9 @@ void IRGenSILFunction::emitErrorResultVar(SILResultInfo ErrorInfo,
 void IRGenSILFunction::visitDebugValueInst(DebugValueInst *i) {
   if (!IGM.DebugInfo)
     return;
+  // There are no variables in line-tables-only mode to describe the value.
+  if (IGM.IRGen.Opts.DebugInfoKind <= IRGenDebugInfoKind::LineTables)
+    return;
 
   auto VarInfo = i->getVarInfo();
   assert(VarInfo && "debug_value without debug info");
@@ -3651,6 +3656,9 @@ void IRGenSILFunction::visitDebugValueInst(DebugValueInst *i) {
 void IRGenSILFunction::visitDebugValueAddrInst(DebugValueAddrInst *i) {
   if (!IGM.DebugInfo)
     return;
+  // There are no variables in line-tables-only mode to describe the address.
+  if (IGM.IRGen.Opts.DebugInfoKind <= IRGenDebugInfoKind::LineTables)
+    return;
   VarDecl *Decl = i->getDecl();
   if (!Decl)
     return;
@@ -3890,6 +3898,11 @@ void IRGenSILFunction::emitDebugInfoForAllocStack(AllocStackInst *i,
   if (!VarInfo)
     return;
 
+  // In line-tables-only mode the variable itself is never emitted, so don't
+  // emit a shadow copy of its address either.
+  if (IGM.IRGen.Opts.DebugInfoKind <= IRGenDebugInfoKind::LineTables)
+    return;
+
   VarDecl *Decl = i->getDecl();
   // Describe the underlying alloca. This way an llvm.dbg.declare instrinsic
   // is used, which is valid for the entire lifetime of the alloca.
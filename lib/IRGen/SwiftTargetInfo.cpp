@@ -150,6 +150,14 @@ SwiftTargetInfo SwiftTargetInfo::get(IRGenModule &IGM) {
   // which exposes a barrier-free inline path with -1 as the "done" value.
   if (triple.isOSDarwin())
     target.OnceDonePredicateValue = -1L;
+  // On Linux, swift_once is implemented on futexes and also stores -1 when
+  // done.  Only x86, being TSO, may check for the done state with a plain
+  // inline load; other architectures would need a barrier on the read side
+  // that the runtime does not arrange, so they go through swift_once's own
+  // acquire-load fast path instead.
+  else if (triple.isOSLinux() && (triple.getArch() == llvm::Triple::x86 ||
+                                  triple.getArch() == llvm::Triple::x86_64))
+    target.OnceDonePredicateValue = -1L;
   // Other platforms use std::call_once() and we don't
   // assume that they have a barrier-free inline fast path.
   
@@ -369,6 +369,11 @@ int swift::RunImmediately(CompilerInstance &CI, const ProcessCmdLine &CmdLine,
   builder.setMAttrs(Features);
   builder.setErrorStr(&ErrorMsg);
   builder.setEngineKind(llvm::EngineKind::JIT);
+  // Immediate-mode scripts tend to be bound by the time it takes to compile
+  // them rather than by the quality of the compiled code, so favor fast
+  // emission unless the user asked for optimization.
+  if (!IRGenOpts.shouldOptimize())
+    builder.setOptLevel(llvm::CodeGenOpt::Less);
   llvm::ExecutionEngine *EE = builder.create();
   if (!EE) {
     llvm::errs() << "Error loading JIT: " << ErrorMsg;
@@ -913,13 +913,18 @@ private:
     // LineModule will get destroy by the following link process.
     // Make a copy of it to be able to correct produce DumpModule.
     std::unique_ptr<llvm::Module> SaveLineModule(CloneModule(LineModule.get()));
-    
+
+    // The module handed to the JIT only needs the current line: symbols from
+    // earlier lines are already resident in the execution engine, and
+    // stripPreviouslyGenerated turns any re-emitted ones back into
+    // declarations. Cloning just the line keeps per-entry cost flat instead
+    // of growing with the length of the session.
+    std::unique_ptr<llvm::Module> NewModule(CloneModule(LineModule.get()));
+
     if (!linkLLVMModules(Module, std::move(LineModule))) {
       return false;
     }
 
-    std::unique_ptr<llvm::Module> NewModule(CloneModule(Module));
-
     Module->getFunction("main")->eraseFromParent();
 
     stripPreviouslyGenerated(*NewModule);
@@ -652,6 +652,17 @@ collectFileDependencies(llvm::SetVector<const clang::FileEntry *> &result,
 //===----------------------------------------------------------------------===//
 // Indexing entry points
 //===----------------------------------------------------------------------===//
+//
+// A note on incrementality and parallelism: record files are content-addressed
+// (beginRecord hashes the symbols and occurrences and answers AlreadyExists),
+// so re-indexing a file whose declarations and references did not change never
+// produces a new record write; only the small unit file is refreshed. Units
+// for serialized modules are additionally skipped wholesale when they are up
+// to date (see isUnitUpToDateForOutputFile above). Parallelism across files
+// comes from the driver running one frontend process per primary input; the
+// entry points below must stay single-threaded within a process because
+// walking the AST triggers lazy member loading and deserialization that
+// mutate shared ASTContext state.
 
 bool index::indexAndRecord(SourceFile *primarySourceFile,
                            StringRef indexUnitToken,
@@ -33,6 +33,7 @@
 #include "llvm/Transforms/Utils/Local.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringSwitch.h"
@@ -59,6 +60,10 @@ STATISTIC(NumStoreOnlyObjectsEliminated,
           "Number of swift stored-only objects eliminated");
 STATISTIC(NumUnknownRetainReleaseSRed,
           "Number of unknownretain/release strength reduced to retain/release");
+STATISTIC(NumReleasesHoistedAcrossBlocks,
+          "Number of releases hoisted into a predecessor block");
+STATISTIC(NumRetainsSunkAcrossBlocks,
+          "Number of retains sunk into a successor block");
 
 llvm::cl::opt<bool>
 DisableARCOpts("disable-llvm-arc-opts", llvm::cl::init(false));
@@ -251,12 +256,18 @@ static bool canonicalizeInputFunction(Function &F, ARCEntryPointBuilder &B,
 /// moving it earlier in the function if possible, over instructions that do not
 /// access the released object.  If we get to a retain or allocation of the
 /// object, zap both.
+///
+/// If the scan reaches the top of the block, it continues into a unique
+/// predecessor which can only branch here; \p VisitedBBs bounds that walk on
+/// cycles of blocks not reachable from the entry block.
 static bool performLocalReleaseMotion(CallInst &Release, BasicBlock &BB,
-                                      SwiftRCIdentity *RC) {
+                                      SwiftRCIdentity *RC,
+                                      SmallPtrSetImpl<BasicBlock *> &VisitedBBs) {
   // FIXME: Call classifier should identify the object for us.  Too bad C++
   // doesn't have nice Swift-style enums.
   Value *ReleasedObject = RC->getSwiftRCIdentityRoot(Release.getArgOperand(0));
 
+  VisitedBBs.insert(&BB);
   BasicBlock::iterator BBI = Release.getIterator();
 
   // Scan until we get to the top of the block.
@@ -381,6 +392,23 @@ static bool performLocalReleaseMotion(CallInst &Release, BasicBlock &BB,
   }
 OutOfLoop:
 
+  // If we scanned all the way to the top of the block, everything the release
+  // depends on is defined in a block above it.  If the block has a unique
+  // predecessor which can only branch here, the release runs in exactly the
+  // same set of executions when placed above that branch, so continue the
+  // scan there.  Conditional branches and merge points stop the walk.
+  if (BBI == BB.begin()) {
+    BasicBlock *Pred = BB.getSinglePredecessor();
+    if (Pred && VisitedBBs.insert(Pred).second) {
+      auto *Br = dyn_cast<BranchInst>(Pred->getTerminator());
+      if (Br && Br->isUnconditional()) {
+        Release.moveBefore(Br);
+        ++NumReleasesHoistedAcrossBlocks;
+        performLocalReleaseMotion(Release, *Pred, RC, VisitedBBs);
+        return true;
+      }
+    }
+  }
 
   // If we got to the top of the block, (and if the instruction didn't start
   // there) move the release to the top of the block.
@@ -402,14 +430,20 @@ OutOfLoop:
 /// later in the function if possible, over instructions that provably can't
 /// release the object.  If we get to a release of the object, zap both.
 ///
+/// If the scan reaches the terminator, it continues into a successor which is
+/// only reachable from this block; \p VisitedBBs bounds that walk on cycles.
+///
 /// NOTE: this handles both objc_retain and swift_retain.
 ///
 static bool performLocalRetainMotion(CallInst &Retain, BasicBlock &BB,
-                                     SwiftRCIdentity *RC) {
+                                     SwiftRCIdentity *RC,
+                                     SmallPtrSetImpl<BasicBlock *> &VisitedBBs) {
   // FIXME: Call classifier should identify the object for us.  Too bad C++
   // doesn't have nice Swift-style enums.
   Value *RetainedObject = RC->getSwiftRCIdentityRoot(Retain.getArgOperand(0));
 
+  VisitedBBs.insert(&BB);
+
   BasicBlock::iterator BBI = Retain.getIterator(),
                        BBE = BB.getTerminator()->getIterator();
 
@@ -506,6 +540,24 @@ static bool performLocalRetainMotion(CallInst &Retain, BasicBlock &BB,
   }
 OutOfLoop:
 
+  // If we scanned all the way to the terminator and it unconditionally
+  // branches to a block with no other predecessors, the retain runs in
+  // exactly the same set of executions when placed at the top of that block,
+  // so continue the scan there.  PHIs cannot release, so the retain goes
+  // below them.
+  if (BBI == BBE) {
+    auto *Br = dyn_cast<BranchInst>(BB.getTerminator());
+    if (Br && Br->isUnconditional()) {
+      BasicBlock *Succ = Br->getSuccessor(0);
+      if (Succ->getSinglePredecessor() && VisitedBBs.insert(Succ).second) {
+        Retain.moveBefore(Succ->getFirstNonPHI());
+        ++NumRetainsSunkAcrossBlocks;
+        performLocalRetainMotion(Retain, *Succ, RC, VisitedBBs);
+        return true;
+      }
+    }
+  }
+
   // If we were able to move the retain down, move it now.
   // TODO: This is where we'd plug in some global algorithms someday.
   if (MadeProgress) {
@@ -934,9 +986,12 @@ static bool performGeneralOptimizations(Function &F, ARCEntryPointBuilder &B,
       case RT_BridgeRelease:
       case RT_ObjCRelease:
       case RT_UnknownRelease:
-      case RT_Release:
-        Changed |= performLocalReleaseMotion(cast<CallInst>(I), BB, RC);
+      case RT_Release: {
+        SmallPtrSet<BasicBlock *, 4> VisitedBBs;
+        Changed |= performLocalReleaseMotion(cast<CallInst>(I), BB, RC,
+                                             VisitedBBs);
         break;
+      }
       case RT_BridgeRetain:
       case RT_Retain:
       case RT_UnknownRetain:
@@ -945,7 +1000,8 @@ static bool performGeneralOptimizations(Function &F, ARCEntryPointBuilder &B,
         // invalidate our iterators by parking it on the instruction before I.
         BasicBlock::iterator Safe = I.getIterator();
         Safe = Safe != BB.begin() ? std::prev(Safe) : BB.end();
-        if (performLocalRetainMotion(cast<CallInst>(I), BB, RC)) {
+        SmallPtrSet<BasicBlock *, 4> VisitedBBs;
+        if (performLocalRetainMotion(cast<CallInst>(I), BB, RC, VisitedBBs)) {
           // If we zapped or moved the retain, reset the iterator on the
           // instruction *newly* after the prev instruction.
           BBI = Safe != BB.end() ? std::next(Safe) : BB.begin();
@@ -341,3 +341,20 @@ Document *swift::markup::parseDocument(MarkupContext &MC, LineList &LL) {
   cmark_iter_free(State.Iter);
   return Document::create(MC, Children);
 }
+
+Paragraph *swift::markup::parseBriefParagraph(MarkupContext &MC,
+                                              LineList &LL) {
+  auto Lines = LL.getLines();
+  size_t NumLeadingLines = 0;
+  while (NumLeadingLines < Lines.size() &&
+         !Lines[NumLeadingLines].Text.trim().empty())
+    ++NumLeadingLines;
+  if (NumLeadingLines == 0)
+    return nullptr;
+
+  LineList LeadingLines(MC.allocateCopy(Lines.take_front(NumLeadingLines)));
+  auto *Doc = parseDocument(MC, LeadingLines);
+  if (!Doc || Doc->getChildren().empty())
+    return nullptr;
+  return dyn_cast<Paragraph>(Doc->getChildren().front());
+}
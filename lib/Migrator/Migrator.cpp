@@ -26,6 +26,13 @@
 using namespace swift;
 using namespace swift::migrator;
 
+/// Note on parallelism: the migrator runs inside a frontend invocation and
+/// migrates that invocation's primary input only. Migrating the files of a
+/// module in parallel therefore happens at the driver level, which schedules
+/// one frontend job (and so one migrator run, with its own remap output) per
+/// primary file across its job pool. Within one run, the syntactic passes
+/// share an EditorAdapter and walk the same AST, which lazily materializes
+/// state in the shared ASTContext, so they must stay sequential.
 bool migrator::updateCodeAndEmitRemapIfNeeded(
     CompilerInstance *Instance, const CompilerInvocation &Invocation) {
   if (!Invocation.getMigratorOptions().shouldRunMigrator())
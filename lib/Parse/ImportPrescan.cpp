@@ -0,0 +1,81 @@
+//===--- ImportPrescan.cpp - Lexer-based import discovery -----------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Parse/ImportPrescan.h"
+#include "swift/Parse/Lexer.h"
+#include "swift/Parse/Token.h"
+
+using namespace swift;
+
+/// Is this token acceptable as a component of an import path?  Module
+/// names are identifiers, but scoped imports may name operators ("import
+/// func Swift.+") and member names that collide with keywords.
+static bool isImportPathComponent(const Token &Tok) {
+  return Tok.is(tok::identifier) || Tok.isKeyword() || Tok.isAnyOperator();
+}
+
+void swift::prescanImports(const SourceManager &SM, unsigned BufferID,
+                           const LangOptions &LangOpts,
+                           SmallVectorImpl<PrescannedImport> &Imports) {
+  // Lex without diagnostics: malformed code should yield whatever imports
+  // are recognizable, not errors.  The lexer handles comments, string
+  // literals (including interpolations), and #if lines for us; since we
+  // do not evaluate conditions, imports in every #if branch are reported.
+  Lexer L(LangOpts, SM, BufferID, /*Diags*/ nullptr, /*InSILMode*/ false);
+
+  Token Tok;
+  L.lex(Tok);
+  while (Tok.isNot(tok::eof)) {
+    if (Tok.isNot(tok::kw_import)) {
+      L.lex(Tok);
+      continue;
+    }
+
+    PrescannedImport Import;
+    Import.Loc = Tok.getLoc();
+    L.lex(Tok);
+
+    // Skip an import-kind keyword, as in "import func Swift.min".
+    switch (Tok.getKind()) {
+    case tok::kw_typealias:
+    case tok::kw_struct:
+    case tok::kw_class:
+    case tok::kw_enum:
+    case tok::kw_protocol:
+    case tok::kw_var:
+    case tok::kw_func:
+    case tok::kw_let:
+      L.lex(Tok);
+      break;
+    default:
+      break;
+    }
+
+    // An 'import' keyword not followed by a name (for example, inside a
+    // string we failed to model or a code comment in a doc example) is
+    // skipped; scanning resumes at the current token.
+    if (!isImportPathComponent(Tok))
+      continue;
+
+    Import.Path = Tok.getText();
+    L.lex(Tok);
+    while (Tok.is(tok::period)) {
+      L.lex(Tok);
+      if (!isImportPathComponent(Tok))
+        break;
+      Import.Path += '.';
+      Import.Path += Tok.getText();
+      L.lex(Tok);
+    }
+    Imports.push_back(std::move(Import));
+  }
+}
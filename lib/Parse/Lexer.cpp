@@ -44,6 +44,156 @@ using clang::isHorizontalWhitespace;
 using clang::isPrintable;
 using clang::isWhitespace;
 
+//===----------------------------------------------------------------------===//
+// Block-scanning fast paths
+//===----------------------------------------------------------------------===//
+//
+// The hottest lexer loops -- identifier bodies, comment skipping, and string
+// literal scanning -- spend almost all of their time consuming long runs of
+// plain ASCII. The helpers below scan 16 bytes per iteration and hand control
+// back to the byte-at-a-time code as soon as they see a byte that needs real
+// handling (delimiters, escapes, NUL, or non-ASCII). They never consume such
+// a byte themselves, so the scalar loops remain the single source of truth
+// for correctness.
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SWIFT_LEXER_HAS_BLOCK_SCAN 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SWIFT_LEXER_HAS_BLOCK_SCAN 1
+#else
+#define SWIFT_LEXER_HAS_BLOCK_SCAN 0
+#endif
+
+#if SWIFT_LEXER_HAS_BLOCK_SCAN
+
+#if defined(__SSE2__)
+
+/// Return a bitmask with bit i set if byte i of \p Block is nonzero in
+/// \p StopBytes or has its high bit set in \p Block itself.
+static inline unsigned getStopMask(__m128i Block, __m128i StopBytes) {
+  return _mm_movemask_epi8(StopBytes) | _mm_movemask_epi8(Block);
+}
+
+#else // NEON
+
+/// Return a bitmask with four bits set per stopping byte; only the position
+/// of the lowest set bit is meaningful, matching the SSE2 variant up to a
+/// shift of two.
+static inline uint64_t getStopMask(uint8x16_t Block, uint8x16_t StopBytes) {
+  uint8x16_t Stop = vorrq_u8(StopBytes, vcgeq_u8(Block, vdupq_n_u8(0x80)));
+  // Narrow each 16-bit lane to its middle nibble, giving a 64-bit mask with
+  // one nibble per byte of the block.
+  uint8x8_t Narrowed = vshrn_n_u16(vreinterpretq_u16_u8(Stop), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(Narrowed), 0);
+}
+
+#endif
+
+/// Advance \p Ptr over bytes that are plain line content: anything other
+/// than '\r', '\n', NUL, or a non-ASCII byte. Stops short of \p End.
+static const char *fastScanLineContent(const char *Ptr, const char *End) {
+  while (End - Ptr >= 16) {
+#if defined(__SSE2__)
+    __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    __m128i Stop = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Block, _mm_set1_epi8('\n')),
+                     _mm_cmpeq_epi8(Block, _mm_set1_epi8('\r'))),
+        _mm_cmpeq_epi8(Block, _mm_setzero_si128()));
+    if (unsigned Mask = getStopMask(Block, Stop))
+      return Ptr + llvm::countTrailingZeros(Mask);
+#else
+    uint8x16_t Block = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t Stop = vorrq_u8(
+        vorrq_u8(vceqq_u8(Block, vdupq_n_u8('\n')),
+                 vceqq_u8(Block, vdupq_n_u8('\r'))),
+        vceqq_u8(Block, vdupq_n_u8(0)));
+    if (uint64_t Mask = getStopMask(Block, Stop))
+      return Ptr + (llvm::countTrailingZeros(Mask) >> 2);
+#endif
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+/// Advance \p Ptr over ASCII identifier continuation bytes:
+/// [a-zA-Z_$0-9]. Stops short of \p End.
+static const char *fastScanASCIIIdentifierBody(const char *Ptr,
+                                               const char *End) {
+  while (End - Ptr >= 16) {
+#if defined(__SSE2__)
+    __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    // Fold letters to lowercase; non-ASCII bytes stay negative and fail all
+    // of the signed range checks below, so they stop the scan as intended.
+    __m128i Lower = _mm_or_si128(Block, _mm_set1_epi8(0x20));
+    __m128i IsAlpha =
+        _mm_and_si128(_mm_cmpgt_epi8(Lower, _mm_set1_epi8('a' - 1)),
+                      _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), Lower));
+    __m128i IsDigit =
+        _mm_and_si128(_mm_cmpgt_epi8(Block, _mm_set1_epi8('0' - 1)),
+                      _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), Block));
+    __m128i IsAllowed = _mm_or_si128(
+        _mm_or_si128(IsAlpha, IsDigit),
+        _mm_or_si128(_mm_cmpeq_epi8(Block, _mm_set1_epi8('_')),
+                     _mm_cmpeq_epi8(Block, _mm_set1_epi8('$'))));
+    unsigned Mask = (~_mm_movemask_epi8(IsAllowed)) & 0xFFFF;
+    if (Mask)
+      return Ptr + llvm::countTrailingZeros(Mask);
+#else
+    uint8x16_t Block = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t Lower = vorrq_u8(Block, vdupq_n_u8(0x20));
+    uint8x16_t IsAlpha = vandq_u8(vcgeq_u8(Lower, vdupq_n_u8('a')),
+                                  vcleq_u8(Lower, vdupq_n_u8('z')));
+    uint8x16_t IsDigit = vandq_u8(vcgeq_u8(Block, vdupq_n_u8('0')),
+                                  vcleq_u8(Block, vdupq_n_u8('9')));
+    uint8x16_t IsAllowed =
+        vorrq_u8(vorrq_u8(IsAlpha, IsDigit),
+                 vorrq_u8(vceqq_u8(Block, vdupq_n_u8('_')),
+                          vceqq_u8(Block, vdupq_n_u8('$'))));
+    if (uint64_t Mask = getStopMask(Block, vmvnq_u8(IsAllowed)))
+      return Ptr + (llvm::countTrailingZeros(Mask) >> 2);
+#endif
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+/// Advance \p Ptr over plain string-literal body bytes: anything other than
+/// \p StopQuote, '\\', '\r', '\n', NUL, or a non-ASCII byte. Stops short of
+/// \p End.
+static const char *fastScanStringLiteralBody(const char *Ptr, const char *End,
+                                             char StopQuote) {
+  while (End - Ptr >= 16) {
+#if defined(__SSE2__)
+    __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    __m128i Stop = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Block, _mm_set1_epi8(StopQuote)),
+                     _mm_cmpeq_epi8(Block, _mm_set1_epi8('\\'))),
+        _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(Block, _mm_set1_epi8('\n')),
+                         _mm_cmpeq_epi8(Block, _mm_set1_epi8('\r'))),
+            _mm_cmpeq_epi8(Block, _mm_setzero_si128())));
+    if (unsigned Mask = getStopMask(Block, Stop))
+      return Ptr + llvm::countTrailingZeros(Mask);
+#else
+    uint8x16_t Block = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t Stop = vorrq_u8(
+        vorrq_u8(vceqq_u8(Block, vdupq_n_u8(StopQuote)),
+                 vceqq_u8(Block, vdupq_n_u8('\\'))),
+        vorrq_u8(vorrq_u8(vceqq_u8(Block, vdupq_n_u8('\n')),
+                          vceqq_u8(Block, vdupq_n_u8('\r'))),
+                 vceqq_u8(Block, vdupq_n_u8(0))));
+    if (uint64_t Mask = getStopMask(Block, Stop))
+      return Ptr + (llvm::countTrailingZeros(Mask) >> 2);
+#endif
+    Ptr += 16;
+  }
+  return Ptr;
+}
+
+#endif // SWIFT_LEXER_HAS_BLOCK_SCAN
+
 //===----------------------------------------------------------------------===//
 // UTF8 Validation/Encoding/Decoding helper functions
 //===----------------------------------------------------------------------===//
@@ -231,7 +381,8 @@ void Lexer::initSubLexer(Lexer &Parent, State BeginState, State EndState) {
 InFlightDiagnostic Lexer::diagnose(const char *Loc, Diagnostic Diag) {
   if (Diags)
     return Diags->diagnose(getSourceLoc(Loc), Diag);
-  
+
+  ++NumSuppressedDiagnostics;
   return InFlightDiagnostic();
 }
 
@@ -332,6 +483,9 @@ static void diagnoseEmbeddedNul(DiagnosticEngine *Diags, const char *Ptr) {
 
 void Lexer::skipToEndOfLine(bool EatNewline) {
   while (1) {
+#if SWIFT_LEXER_HAS_BLOCK_SCAN
+    CurPtr = fastScanLineContent(CurPtr, BufferEnd);
+#endif
     switch (*CurPtr++) {
     case '\n':
     case '\r':
@@ -608,7 +762,15 @@ void Lexer::lexIdentifier() {
   (void) didStart;
 
   // Lex [a-zA-Z_$0-9[[:XID_Continue:]]]*
-  while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
+  while (true) {
+#if SWIFT_LEXER_HAS_BLOCK_SCAN
+    CurPtr = fastScanASCIIIdentifierBody(CurPtr, BufferEnd);
+#endif
+    // Handle Unicode continuation characters (and re-enter the fast path
+    // after consuming one).
+    if (!advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd))
+      break;
+  }
 
   tok Kind = kindOfIdentifier(StringRef(TokStart, CurPtr-TokStart), InSILMode);
   return formToken(Kind, TokStart);
@@ -1647,6 +1809,12 @@ void Lexer::lexStringLiteral() {
   }
 
   while (true) {
+#if SWIFT_LEXER_HAS_BLOCK_SCAN
+    // Consume runs of plain literal content in bulk; every byte that needs
+    // real handling (the quote, escapes, newlines, NUL, non-ASCII) stops the
+    // scan and is handled by the code below.
+    CurPtr = fastScanStringLiteralBody(CurPtr, BufferEnd, *TokStart);
+#endif
     if (*CurPtr == '\\' && *(CurPtr + 1) == '(') {
       // Consume tokens until we hit the corresponding ')'.
       CurPtr += 2;
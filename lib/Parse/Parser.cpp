@@ -300,6 +300,109 @@ std::vector<Token> swift::tokenize(const LangOptions &LangOpts,
   return Tokens;
 }
 
+std::vector<Token> swift::relexAfterEdit(const LangOptions &LangOpts,
+                                         const SourceManager &SM,
+                                         unsigned OldBufferID,
+                                         unsigned NewBufferID,
+                                         ArrayRef<Token> OldTokens,
+                                         unsigned EditOffset,
+                                         unsigned OldLength,
+                                         unsigned NewLength,
+                                         DiagnosticEngine *Diags,
+                                         bool KeepComments) {
+  // With no previous stream to reuse, fall back to a full lex.
+  if (OldTokens.empty())
+    return tokenize(LangOpts, SM, NewBufferID, 0, 0, Diags, KeepComments,
+                    /*TokenizeInterpolatedString=*/false);
+
+  int Delta = int(NewLength) - int(OldLength);
+  unsigned OldEditEnd = EditOffset + OldLength;
+
+  auto getOldOffset = [&](const Token &Tok) -> unsigned {
+    return SM.getLocOffsetInBuffer(Tok.getLoc(), OldBufferID);
+  };
+
+  // Find the first token the edit may have damaged: the first one whose
+  // range reaches EditOffset. Tokens are sorted by source offset.
+  auto FirstDamaged = std::lower_bound(
+      OldTokens.begin(), OldTokens.end(), EditOffset,
+      [&](const Token &Tok, unsigned Offset) {
+        return getOldOffset(Tok) + Tok.getLength() < Offset;
+      });
+  // Include one token of lookbehind; the lexer inspects neighbouring
+  // characters (e.g. to classify operator tokens), so an edit can change how
+  // the token immediately before it lexes.
+  if (FirstDamaged != OldTokens.begin())
+    --FirstDamaged;
+
+  unsigned ReLexOffset =
+      FirstDamaged != OldTokens.end() ? getOldOffset(*FirstDamaged) : 0;
+
+  // The edit may land in leading trivia, before the start of the first
+  // damaged token (e.g. an insertion at offset 0); never start re-lexing
+  // beyond the edit itself, or the inserted text would be skipped.
+  ReLexOffset = std::min(ReLexOffset, EditOffset);
+
+  // The first old token lying entirely beyond the edited range is the
+  // earliest candidate for reuse.
+  auto Reusable = std::lower_bound(
+      OldTokens.begin(), OldTokens.end(), OldEditEnd,
+      [&](const Token &Tok, unsigned Offset) {
+        return getOldOffset(Tok) < Offset;
+      });
+
+  StringRef NewBuffer = SM.extractText(SM.getRangeForBuffer(NewBufferID));
+
+  // Reused tokens keep their kind and flags but must point at the new
+  // buffer's text so that getLoc() is valid against \p NewBufferID.
+  auto retarget = [&](Token Tok, unsigned NewOffset) {
+    Tok.setText(NewBuffer.substr(NewOffset, Tok.getLength()));
+    return Tok;
+  };
+
+  std::vector<Token> Result;
+  Result.reserve(OldTokens.size());
+  for (auto I = OldTokens.begin(); I != FirstDamaged; ++I)
+    Result.push_back(retarget(*I, getOldOffset(*I)));
+
+  // Re-lex the damaged region, stopping as soon as the lexer produces a
+  // token that realigns with the unchanged suffix of the old stream.
+  Lexer L(LangOpts, SM, NewBufferID, Diags, /*InSILMode=*/false,
+          KeepComments ? CommentRetentionMode::ReturnAsTokens
+                       : CommentRetentionMode::AttachToNextToken,
+          TriviaRetentionMode::WithoutTrivia, ReLexOffset, NewBuffer.size());
+
+  Token Tok;
+  syntax::Trivia LeadingTrivia, TrailingTrivia;
+  while (true) {
+    L.lex(Tok, LeadingTrivia, TrailingTrivia);
+    if (Tok.is(tok::eof))
+      break;
+    unsigned NewOffset = SM.getLocOffsetInBuffer(Tok.getLoc(), NewBufferID);
+
+    // Skip reuse candidates the new lexer has already lexed past.
+    while (Reusable != OldTokens.end() &&
+           int(getOldOffset(*Reusable)) + Delta < int(NewOffset))
+      ++Reusable;
+
+    if (Reusable != OldTokens.end() &&
+        int(getOldOffset(*Reusable)) + Delta == int(NewOffset) &&
+        Reusable->getKind() == Tok.getKind() &&
+        Reusable->getLength() == Tok.getLength()) {
+      // Realigned. Keep the freshly lexed token (its at-start-of-line flag
+      // reflects trivia that may have spanned the edit) and splice in the
+      // remainder of the old stream at adjusted offsets.
+      Result.push_back(Tok);
+      for (auto I = std::next(Reusable); I != OldTokens.end(); ++I)
+        Result.push_back(retarget(*I, getOldOffset(*I) + Delta));
+      return Result;
+    }
+    Result.push_back(Tok);
+  }
+
+  return Result;
+}
+
 std::vector<std::pair<RC<syntax::RawSyntax>, syntax::AbsolutePosition>>
 swift::tokenizeWithTrivia(const LangOptions &LangOpts, const SourceManager &SM,
                           unsigned BufferID, unsigned Offset,
@@ -486,6 +589,12 @@ Parser::Parser(std::unique_ptr<Lexer> Lex, SourceFile &SF,
   // This cannot be tok::unknown, since that is a token the lexer could produce.
   Tok.setKind(tok::NUM_TOKENS);
 
+  // Optionally run the lexer on a producer thread, a bounded number of
+  // tokens ahead of the parser. Code completion cuts the lexer off
+  // mid-buffer, which the pipelined mode does not support.
+  if (Context.LangOpts.EnablePipelinedLexing && !L->isCodeCompletion())
+    PipelinedLex.reset(new PipelinedLexer(*L));
+
   auto ParserPos = State->takeParserPosition();
   if (ParserPos.isValid() &&
       L->isStateForCurrentBuffer(ParserPos.LS)) {
@@ -495,12 +604,16 @@ Parser::Parser(std::unique_ptr<Lexer> Lex, SourceFile &SF,
 }
 
 Parser::~Parser() {
+  // Shut the producer thread down before destroying the lexer it reads from.
+  PipelinedLex.reset();
   delete L;
   delete TokReceiver;
   delete SyntaxContext;
 }
 
 const Token &Parser::peekToken() {
+  if (PipelinedLex)
+    return PipelinedLex->peekNextToken();
   return L->peekNextToken();
 }
 
@@ -511,7 +624,10 @@ SourceLoc Parser::consumeTokenWithoutFeedingReceiver() {
   if (IsParsingInterfaceTokens && !Tok.getText().empty()) {
     SF.recordInterfaceToken(Tok.getText());
   }
-  L->lex(Tok, LeadingTrivia, TrailingTrivia);
+  if (PipelinedLex)
+    PipelinedLex->lex(Tok, LeadingTrivia, TrailingTrivia);
+  else
+    L->lex(Tok, LeadingTrivia, TrailingTrivia);
   PreviousLoc = Loc;
   return Loc;
 }
@@ -0,0 +1,154 @@
+//===--- PipelinedLexer.cpp - Background lexing ahead of the parser -------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Parse/PipelinedLexer.h"
+
+using namespace swift;
+using namespace swift::syntax;
+
+PipelinedLexer::PipelinedLexer(Lexer &L) : L(L), Diags(L.Diags) {
+  // The producer must not emit through the shared DiagnosticEngine while the
+  // consumer thread is parsing, so detach it. The lexer counts the
+  // diagnostics it drops, and the tokens they belong to are re-lexed with
+  // the engine attached when the consumer takes them out of the ring.
+  L.Diags = nullptr;
+  NumSuppressedSeen = L.NumSuppressedDiagnostics;
+  Producer = std::thread([this] { producerLoop(); });
+}
+
+PipelinedLexer::~PipelinedLexer() {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Stopping = true;
+  }
+  RingNotFull.notify_all();
+  Producer.join();
+  L.Diags = Diags;
+}
+
+void PipelinedLexer::producerLoop() {
+  std::unique_lock<std::mutex> Lock(Mutex);
+  while (true) {
+    RingNotFull.wait(Lock, [&] {
+      return Stopping || (!ReachedEOF && Ring.size() < MaxRingSize);
+    });
+    if (Stopping)
+      return;
+
+    // Lex a small batch while holding the lock. The consumer only takes the
+    // lock for quick ring operations, so batching keeps lock traffic low
+    // without letting the consumer observe the lexer mid-token.
+    for (size_t i = 0; i < BatchSize && Ring.size() < MaxRingSize; ++i) {
+      LexedToken Next;
+      Next.HadSuppressedDiagnostic = PendingDiagnostic;
+      L.lex(Next.Tok, Next.LeadingTrivia, Next.TrailingTrivia);
+      // A diagnostic dropped by that call was encountered while scanning the
+      // *following* token, which the lexer lexes ahead; it flags the next
+      // ring entry, not this one.
+      PendingDiagnostic = L.NumSuppressedDiagnostics != NumSuppressedSeen;
+      NumSuppressedSeen = L.NumSuppressedDiagnostics;
+      LastLexed = Next;
+      Ring.push_back(std::move(Next));
+      if (Ring.back().Tok.is(tok::eof)) {
+        ReachedEOF = true;
+        break;
+      }
+    }
+    RingNotEmpty.notify_all();
+  }
+}
+
+void PipelinedLexer::replaySuppressedDiagnostics(const LexedToken &LT) {
+  // Tokens the parser re-consumes after backtracking already had their
+  // diagnostics replayed on the first pass; like Lexer::restoreState, do not
+  // emit them a second time.
+  if (!Diags ||
+      (MaxReplayedLoc.isValid() &&
+       !L.SourceMgr.isBeforeInBuffer(MaxReplayedLoc, LT.Tok.getLoc())))
+    return;
+
+  // Re-lex the token with the diagnostic engine attached, starting from the
+  // end of the previously consumed token so that diagnostics in the
+  // intervening trivia are emitted as well. Sub-lexer construction inherits
+  // the (detached) engine, so nothing is emitted until the explicit restore.
+  Lexer::State Begin =
+      PrevConsumedTok.isNot(tok::NUM_TOKENS)
+          ? L.getStateForEndOfTokenLoc(PrevConsumedTok.getLoc())
+          : L.getStateForBeginningOfToken(LT.Tok, LT.LeadingTrivia);
+  Lexer::State End = L.getStateForEndOfTokenLoc(LT.Tok.getLoc());
+  Lexer ReLexer(L, Begin, End);
+  ReLexer.Diags = Diags;
+  ReLexer.restoreState(Begin, /*enableDiagnostics=*/true);
+  MaxReplayedLoc = LT.Tok.getLoc();
+}
+
+void PipelinedLexer::lex(Token &Result, Trivia &LeadingTriviaResult,
+                         Trivia &TrailingTriviaResult) {
+  std::unique_lock<std::mutex> Lock(Mutex);
+  RingNotEmpty.wait(Lock, [&] { return !Ring.empty() || ReachedEOF; });
+  if (Ring.empty()) {
+    // Past the end; keep handing out the eof token like Lexer does.
+    Result = LastLexed.Tok;
+    LeadingTriviaResult = LastLexed.LeadingTrivia;
+    TrailingTriviaResult = LastLexed.TrailingTrivia;
+    return;
+  }
+  LexedToken Next = std::move(Ring.front());
+  Ring.pop_front();
+  RingNotFull.notify_all();
+  if (Next.HadSuppressedDiagnostic)
+    replaySuppressedDiagnostics(Next);
+  PrevConsumedTok = Next.Tok;
+  Result = Next.Tok;
+  LeadingTriviaResult = Next.LeadingTrivia;
+  TrailingTriviaResult = Next.TrailingTrivia;
+}
+
+const Token &PipelinedLexer::peekNextToken() {
+  std::unique_lock<std::mutex> Lock(Mutex);
+  RingNotEmpty.wait(Lock, [&] { return !Ring.empty() || ReachedEOF; });
+  if (!Ring.empty() && Ring.front().HadSuppressedDiagnostic) {
+    // Peeking hands the token to the parser, so its diagnostics are due now.
+    replaySuppressedDiagnostics(Ring.front());
+    Ring.front().HadSuppressedDiagnostic = false;
+  }
+  PeekSlot = Ring.empty() ? LastLexed.Tok : Ring.front().Tok;
+  return PeekSlot;
+}
+
+void PipelinedLexer::restoreState(Lexer::State S, bool enableDiagnostics) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Ring.clear();
+  ReachedEOF = false;
+  L.restoreState(S, enableDiagnostics);
+  // The restore re-lexed the token at \p S with diagnostics detached; flag
+  // the first entry the producer pushes so its diagnostics are replayed (or
+  // skipped, if this position was consumed once already) like any other
+  // prefetched token's.
+  PendingDiagnostic = L.NumSuppressedDiagnostics != NumSuppressedSeen;
+  NumSuppressedSeen = L.NumSuppressedDiagnostics;
+  PrevConsumedTok = Token();
+  if (enableDiagnostics)
+    MaxReplayedLoc = SourceLoc();
+  RingNotFull.notify_all();
+}
+
+void PipelinedLexer::backtrackToState(Lexer::State S) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Ring.clear();
+  ReachedEOF = false;
+  L.backtrackToState(S);
+  PendingDiagnostic = L.NumSuppressedDiagnostics != NumSuppressedSeen;
+  NumSuppressedSeen = L.NumSuppressedDiagnostics;
+  PrevConsumedTok = Token();
+  RingNotFull.notify_all();
+}
@@ -5105,6 +5105,18 @@ bool SILParser::parseSILBasicBlock(SILBuilder &B) {
 ///     'sil' sil-linkage '@' identifier ':' sil-type decl-sil-body?
 ///   decl-sil-body:
 ///     '{' sil-basic-block+ '}'
+// Function bodies are parsed serially, one 'sil' decl at a time. Handing
+// bodies to a thread pool after a symbol-table prepass looks attractive for
+// round-tripping large textual SIL dumps, but the prepass would only solve
+// inter-function references (ForwardRefFns). The dominant shared state is
+// per-instruction: every type written in a body is resolved through
+// performTypeLocChecking, which re-enters Sema and interns types and
+// identifiers in the ASTContext, and every instruction and SILFunction is
+// allocated from the SILModule's single bump allocator. None of that locks.
+// Until the ASTContext and SILModule allocation paths are thread-safe,
+// body-level parallelism here would just be a data race; splitting the dump
+// into multiple .sil files and using separate invocations is the supported
+// way to spread the work.
 bool SILParserTUState::parseDeclSIL(Parser &P) {
   // Inform the lexer that we're lexing the body of the SIL declaration.  Do
   // this before we consume the 'sil' token so that all later tokens are
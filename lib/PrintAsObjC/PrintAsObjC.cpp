@@ -2625,7 +2625,13 @@ public:
   void writeImports(raw_ostream &out) {
     out << "#if __has_feature(modules)\n";
 
-    // Track printed names to handle overlay modules.
+    // Collect the names and print them sorted, so that the imports don't
+    // depend on the order in which the printer happened to reach each
+    // module. Any unnecessary churn here dirties every file that includes
+    // the generated header.
+    SmallVector<std::string, 8> importNames;
+
+    // Track collected names to handle overlay modules.
     llvm::SmallPtrSet<Identifier, 8> seenImports;
     bool includeUnderlying = false;
     for (auto import : imports) {
@@ -2636,23 +2642,28 @@ public:
           continue;
         }
         if (seenImports.insert(Name).second)
-          out << "@import " << Name.str() << ";\n";
+          importNames.push_back(Name.str());
       } else {
         const auto *clangModule = import.get<const clang::Module *>();
-        out << "@import ";
         // FIXME: This should be an API on clang::Module.
         SmallVector<StringRef, 4> submoduleNames;
         do {
           submoduleNames.push_back(clangModule->Name);
           clangModule = clangModule->Parent;
         } while (clangModule);
+        std::string dottedName;
+        llvm::raw_string_ostream nameOS(dottedName);
         interleave(submoduleNames.rbegin(), submoduleNames.rend(),
-                   [&out](StringRef next) { out << next; },
-                   [&out] { out << "."; });
-        out << ";\n";
+                   [&nameOS](StringRef next) { nameOS << next; },
+                   [&nameOS] { nameOS << "."; });
+        importNames.push_back(nameOS.str());
       }
     }
 
+    std::sort(importNames.begin(), importNames.end());
+    for (auto &name : importNames)
+      out << "@import " << name << ";\n";
+
     out << "#endif\n\n";
 
     if (includeUnderlying) {
@@ -28,6 +28,7 @@
 #include "swift/AST/TypeRepr.h"
 #include "swift/Basic/Mangler.h"
 #include "swift/ClangImporter/ClangImporter.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringSwitch.h"
 
 // TODO: Develop a proper interface for this.
@@ -788,16 +789,53 @@ namespace {
 /// The template subclasses do target-specific logic.
 class RemoteASTContextImpl {
   std::unique_ptr<IRGenContext> IRGen;
+
+  /// Memoized results of successful queries, keyed by the remote address.
+  /// Debuggers issue the same metadata-pointer queries repeatedly while the
+  /// inferior is stopped, and the answers cannot change until it is allowed
+  /// to run again; the client invalidates the memo through
+  /// RemoteASTContext::clearCaches() when that happens. The type cache is
+  /// split by the skipArtificial flag, which can change the answer.
+  llvm::DenseMap<uint64_t, Type> TypesForMetadata[2];
+  llvm::DenseMap<uint64_t, NominalTypeDecl *> DeclsForDescriptors;
+
 public:
   RemoteASTContextImpl() = default;
   virtual ~RemoteASTContextImpl() = default;
 
-  virtual Result<Type>
-  getTypeForRemoteTypeMetadata(RemoteAddress metadata, bool skipArtificial) = 0;
+  Result<Type>
+  getTypeForRemoteTypeMetadata(RemoteAddress metadata, bool skipArtificial) {
+    auto &cache = TypesForMetadata[unsigned(skipArtificial)];
+    auto known = cache.find(metadata.getAddressData());
+    if (known != cache.end())
+      return known->second;
+    auto result = getTypeForRemoteTypeMetadataUncached(metadata,
+                                                       skipArtificial);
+    if (result)
+      cache.insert({metadata.getAddressData(), result.getValue()});
+    return result;
+  }
+
+  Result<NominalTypeDecl*>
+  getDeclForRemoteNominalTypeDescriptor(RemoteAddress descriptor) {
+    auto known = DeclsForDescriptors.find(descriptor.getAddressData());
+    if (known != DeclsForDescriptors.end())
+      return known->second;
+    auto result = getDeclForRemoteNominalTypeDescriptorUncached(descriptor);
+    if (result)
+      DeclsForDescriptors.insert(
+          {descriptor.getAddressData(), result.getValue()});
+    return result;
+  }
+
+  void clearCaches() {
+    TypesForMetadata[0].clear();
+    TypesForMetadata[1].clear();
+    DeclsForDescriptors.clear();
+  }
+
   virtual Result<MetadataKind>
   getKindForRemoteTypeMetadata(RemoteAddress metadata) = 0;
-  virtual Result<NominalTypeDecl*>
-  getDeclForRemoteNominalTypeDescriptor(RemoteAddress descriptor) = 0;
   virtual Result<RemoteAddress>
   getHeapMetadataForObject(RemoteAddress object) = 0;
 
@@ -835,6 +873,11 @@ protected:
   }
 
 private:
+  virtual Result<Type>
+  getTypeForRemoteTypeMetadataUncached(RemoteAddress metadata,
+                                       bool skipArtificial) = 0;
+  virtual Result<NominalTypeDecl*>
+  getDeclForRemoteNominalTypeDescriptorUncached(RemoteAddress descriptor) = 0;
   virtual RemoteASTTypeBuilder &getBuilder() = 0;
   virtual MemoryReader &getReader() = 0;
   virtual bool readWordOffset(RemoteAddress address, int64_t *offset) = 0;
@@ -1100,8 +1143,9 @@ public:
                                ASTContext &ctx)
     : Reader(std::move(reader), ctx) {}
 
-  Result<Type> getTypeForRemoteTypeMetadata(RemoteAddress metadata,
-                                            bool skipArtificial) override {
+  Result<Type>
+  getTypeForRemoteTypeMetadataUncached(RemoteAddress metadata,
+                                       bool skipArtificial) override {
     if (auto result = Reader.readTypeFromMetadata(metadata.getAddressData(),
                                                   skipArtificial))
       return result;
@@ -1117,7 +1161,8 @@ public:
   }
 
   Result<NominalTypeDecl*>
-  getDeclForRemoteNominalTypeDescriptor(RemoteAddress descriptor) override {
+  getDeclForRemoteNominalTypeDescriptorUncached(
+      RemoteAddress descriptor) override {
     if (auto result =
           Reader.readNominalTypeFromDescriptor(descriptor.getAddressData()))
       return result;
@@ -1209,3 +1254,7 @@ Result<remote::RemoteAddress>
 RemoteASTContext::getHeapMetadataForObject(remote::RemoteAddress address) {
   return asImpl(Impl)->getHeapMetadataForObject(address);
 }
+
+void RemoteASTContext::clearCaches() {
+  asImpl(Impl)->clearCaches();
+}
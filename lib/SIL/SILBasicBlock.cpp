@@ -63,6 +63,17 @@ SILBasicBlock::~SILBasicBlock() {
   InstList.clearAndLeakNodesUnsafely();
 }
 
+void *SILBasicBlock::operator new(size_t Bytes, SILModule &M) {
+  return M.allocateBlock(Bytes, alignof(SILBasicBlock));
+}
+
+void SILBasicBlock::deleteNode(SILBasicBlock *BB) {
+  assert(BB->getParent() && "erased block is not in a function");
+  SILModule &M = BB->getModule();
+  BB->~SILBasicBlock();
+  M.deallocateBlock(BB);
+}
+
 int SILBasicBlock::getDebugID() const {
   if (!getParent())
     return -1;
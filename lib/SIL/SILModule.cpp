@@ -127,6 +127,19 @@ void SILModule::deallocateInst(SILInstruction *I) {
   AlignedFree(I);
 }
 
+void *SILModule::allocateBlock(unsigned Size, unsigned Align) {
+  assert(Size == sizeof(SILBasicBlock) &&
+         "recycled memory is sized for a basic block");
+  if (!FreeBlocks.empty())
+    return FreeBlocks.pop_back_val();
+
+  return allocate(Size, Align);
+}
+
+void SILModule::deallocateBlock(SILBasicBlock *BB) {
+  FreeBlocks.push_back(BB);
+}
+
 SILWitnessTable *
 SILModule::createWitnessTableDeclaration(ProtocolConformance *C,
                                          SILLinkage linkage) {
@@ -496,7 +496,23 @@ class SILPrinter : public SILInstructionVisitor<SILPrinter> {
   
   SILPrinter &operator<<(SILType t) {
     printSILTypeColorAndSigil(PrintState.OS, t);
-    t.getSwiftRValueType().print(PrintState.OS, PrintState.ASTOptions);
+    CanType Ty = t.getSwiftRValueType();
+
+    // Alternative type names change how a type is rendered, so the rendered
+    // string cannot be shared through the context in that case.
+    if (PrintState.ASTOptions.AlternativeTypeNames) {
+      Ty.print(PrintState.OS, PrintState.ASTOptions);
+      return *this;
+    }
+
+    // Render each canonical type only once and replay the rendered string
+    // afterwards; this dominates printing time for large modules.
+    std::string &TypeStr = Ctx.getTypeStringCache()[Ty];
+    if (TypeStr.empty()) {
+      llvm::raw_string_ostream TypeOS(TypeStr);
+      Ty.print(TypeOS, PrintState.ASTOptions);
+    }
+    PrintState.OS << TypeStr;
     return *this;
   }
   
@@ -12,6 +12,7 @@
 
 #include "Cleanup.h"
 #include "ManagedValue.h"
+#include "swift/Basic/Statistic.h"
 #include "RValue.h"
 #include "SILGenBuilder.h"
 #include "SILGenFunction.h"
@@ -51,6 +52,7 @@ void CleanupManager::popTopDeadCleanups(CleanupsDepth end) {
   while (stack.stable_begin() != end && stack.begin()->isDead()) {
     assert(!stack.empty());
     stack.pop();
+    ++cleanupsGeneration;
     stack.checkIterator(end);
   }
 }
@@ -72,8 +74,10 @@ void CleanupManager::emitCleanups(CleanupsDepth depth, CleanupLocation loc,
     begin = stack.stabilize(++iter);
 
     // Pop now.
-    if (popCleanups)
+    if (popCleanups) {
       stack.pop();
+      ++cleanupsGeneration;
+    }
 
     if (cleanup.isActive() && SGF.B.hasValidInsertionPoint())
       cleanup.emit(SGF, loc);
@@ -136,10 +140,33 @@ SILBasicBlock *CleanupManager::emitBlockForCleanups(JumpDest dest,
   if (!hasAnyActiveCleanups(dest.getDepth()))
     return dest.getBlock();
 
+  // Branch sites with the same stack generation run exactly the same
+  // cleanup sequence with the same operands, and those operands dominate
+  // every site at which their cleanups are live, so all such sites can
+  // share one emitted block.  Blocks that carry branch arguments are not
+  // shared, since the argument values differ per site.
+  bool canShare = args.empty();
+  auto key = std::make_pair(
+      std::make_pair(dest.getBlock(), dest.getDepth().getDepth()),
+      cleanupsGeneration);
+  if (canShare) {
+    auto known = sharedCleanupBlocks.find(key);
+    if (known != sharedCleanupBlocks.end()) {
+      if (auto *Stats = SGF.getASTContext().Stats)
+        Stats->getFrontendCounters().NumSharedCleanupBlocks++;
+      return known->second;
+    }
+  }
+
   // Otherwise, create and emit a new block.
   auto *newBlock = SGF.createBasicBlock();
   SILGenSavedInsertionPoint IPRAII(SGF, newBlock);
   emitBranchAndCleanups(dest, branchLoc, args);
+
+  // Note that emitting the cleanups may itself have moved the generation
+  // on; the block is filed under the generation it was requested for.
+  if (canShare)
+    sharedCleanupBlocks.insert({key, newBlock});
   return newBlock;
 }
 
@@ -149,6 +176,7 @@ Cleanup &CleanupManager::initCleanup(Cleanup &cleanup,
                                      CleanupState state) {
   cleanup.allocatedSize = allocSize;
   cleanup.state = state;
+  ++cleanupsGeneration;
   return cleanup;
 }
 
@@ -188,9 +216,9 @@ void CleanupManager::setCleanupState(Cleanup &cleanup, CleanupState state) {
   assert(state != oldState && "trivial cleanup state change");
   assert(oldState != CleanupState::Dead && "changing state of dead cleanup");
 
-  // Our current cleanup emission logic, where we don't try to re-use
-  // cleanup emissions between various branches, doesn't require any
-  // code to be emitted at transition points.
+  // State transitions change which cleanups a branch site would emit, so
+  // they retire any cleanup blocks shared under the old generation.
+  ++cleanupsGeneration;
 }
 
 void CleanupStateRestorationScope::pushCleanupState(CleanupHandle handle,
@@ -206,6 +234,7 @@ void CleanupStateRestorationScope::pushCleanupState(CleanupHandle handle,
 
   CleanupState oldState = cleanup.getState();
   cleanup.setState(cleanups.SGF, newState);
+  ++cleanups.cleanupsGeneration;
 
   savedStates.push_back({handle, oldState});
 }
@@ -235,6 +264,7 @@ void CleanupStateRestorationScope::popImpl() {
     assert(cleanup.getState() != CleanupState::Dead &&
            "changing state of dead cleanup");
     cleanup.setState(cleanups.SGF, stateToRestore);
+    ++cleanups.cleanupsGeneration;
   }
 
   savedStates.clear();
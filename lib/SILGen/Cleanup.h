@@ -19,6 +19,7 @@
 
 #include "swift/Basic/DiverseStack.h"
 #include "swift/SIL/SILLocation.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
 
 namespace swift {
@@ -118,6 +119,19 @@ class LLVM_LIBRARY_VISIBILITY CleanupManager {
   /// that we've handed out as a Scope.
   CleanupsDepth innermostScope;
 
+  /// A generation count for the cleanup stack, bumped on every push, pop
+  /// and state transition.  Two program points with the same generation
+  /// have bit-identical cleanup stacks, and therefore identical cleanup
+  /// sequences to any given depth.
+  uint64_t cleanupsGeneration = 0;
+
+  /// Blocks already emitted by emitBlockForCleanups for a given
+  /// (destination block, depth, generation), so that branch sites with
+  /// identical cleanup sequences share one emitted block instead of each
+  /// getting a copy.
+  llvm::DenseMap<std::pair<std::pair<SILBasicBlock *, size_t>, uint64_t>,
+                 SILBasicBlock *> sharedCleanupBlocks;
+
   void popTopDeadCleanups(CleanupsDepth end);
   void emitCleanups(CleanupsDepth depth, CleanupLocation l,
                     bool popCleanups=true);
@@ -138,6 +152,9 @@ public:
   /// Return a stable reference to the last cleanup pushed.
   CleanupsDepth getCleanupsDepth() const { return stack.stable_begin(); }
 
+  /// Return the largest size, in bytes, the cleanup stack has reached.
+  size_t getStackHighWaterMark() const { return stack.getHighWaterMark(); }
+
   /// Return a stable reference to the last cleanup pushed.
   CleanupHandle getTopCleanup() const {
     assert(!stack.empty());
@@ -1439,6 +1439,15 @@ public:
 } // end anonymous namespace
 
 void SILGenModule::emitSourceFile(SourceFile *sf, unsigned startElem) {
+  // FIXME: Emission is strictly serial, even though function bodies lower
+  // mostly independently once their types are known. Distributing the
+  // lowering across a thread pool would require more than sharding the
+  // module's function and global tables: SILGenFunction re-enters Sema
+  // through lazy type lowering and conformance checks, lazily emits
+  // thunks, closures, and witness tables through this SILGenModule, and
+  // allocates types and declarations from the non-thread-safe parts of
+  // the ASTContext. Until those are isolated, the parallelism story for
+  // a build is multithreaded IRGen and multiple frontend jobs.
   SourceFileScope scope(*this, sf);
   for (Decl *D : llvm::makeArrayRef(sf->Decls).slice(startElem))
     visit(D);
@@ -19,6 +19,7 @@
 #include "RValue.h"
 #include "Scope.h"
 #include "swift/AST/Initializer.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/SIL/SILArgument.h"
 #include "swift/SIL/SILUndef.h"
 
@@ -48,6 +49,15 @@ SILGenFunction::~SILGenFunction() {
   // If we didn't clean up the rethrow destination, we screwed up somewhere.
   assert(!ThrowDest.isValid() &&
          "SILGenFunction did not emit throw destination");
+
+  // Record how deep the cleanup stack got, as a proxy for the deepest
+  // scope/closure nesting we had to emit.
+  if (auto *Stats = getASTContext().Stats) {
+    auto &C = Stats->getFrontendCounters();
+    C.MaxSILGenCleanupStackBytes =
+        std::max(C.MaxSILGenCleanupStackBytes,
+                 int64_t(Cleanups.getStackHighWaterMark()));
+  }
 }
 
 //===----------------------------------------------------------------------===//
@@ -259,6 +259,19 @@ static bool processFunctionWithLoopSupport(
 //                              Top Level Driver
 //===----------------------------------------------------------------------===//
 
+/// Returns true if \p F contains a reference count increment. Every matching
+/// set is built starting at an increment, so a function without one is a
+/// guaranteed no-op for this pass and we can skip the dataflow entirely.
+static bool functionHasRCIncrement(SILFunction *F) {
+  for (SILBasicBlock &BB : *F) {
+    for (SILInstruction &I : BB) {
+      if (isa<StrongRetainInst>(&I) || isa<RetainValueInst>(&I))
+        return true;
+    }
+  }
+  return false;
+}
+
 namespace {
 class ARCSequenceOpts : public SILFunctionTransform {
   /// The entry point to the transformation.
@@ -268,6 +281,13 @@ class ARCSequenceOpts : public SILFunctionTransform {
     if (!getOptions().EnableARCOptimizations)
       return;
 
+    // This pass runs several times per pipeline. The pass manager already
+    // skips it on functions which did not change since the last run; for
+    // functions which did change, at least avoid setting up the dataflow
+    // when there is provably nothing to pair.
+    if (!functionHasRCIncrement(F))
+      return;
+
     if (!EnableLoopARC) {
       auto *AA = getAnalysis<AliasAnalysis>();
       auto *POTA = getAnalysis<PostOrderAnalysis>();
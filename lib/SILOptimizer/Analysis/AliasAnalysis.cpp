@@ -24,6 +24,7 @@
 #include "swift/SIL/SILFunction.h"
 #include "swift/SIL/SILModule.h"
 #include "swift/SIL/InstructionUtils.h"
+#include "swift/Basic/Statistic.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
@@ -537,12 +538,17 @@ bool AliasAnalysis::typesMayAlias(SILType T1, SILType T2) {
 AliasResult AliasAnalysis::alias(SILValue V1, SILValue V2,
                                  SILType TBAAType1, SILType TBAAType2) {
   AliasKeyTy Key = toAliasKey(V1, V2, TBAAType1, TBAAType2);
+  auto *Stats = Mod->getASTContext().Stats;
 
   // Check if we've already computed this result.
   auto It = AliasCache.find(Key);
   if (It != AliasCache.end()) {
+    if (Stats)
+      Stats->getFrontendCounters().NumAliasCacheHits++;
     return It->second;
   }
+  if (Stats)
+    Stats->getFrontendCounters().NumAliasCacheMisses++;
 
   // Flush the cache if the size of the cache is too large.
   if (AliasCache.size() > AliasAnalysisMaxCacheSize) {
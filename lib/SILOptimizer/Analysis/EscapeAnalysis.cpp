@@ -2008,6 +2008,12 @@ void EscapeAnalysis::invalidate() {
   DEBUG(llvm::dbgs() << "invalidate all\n");
 }
 
+// Note: invalidation is already keyed to the modified function - only the
+// function's own graph and those of its transitive callers are dropped, and
+// recomputation skips callees whose graphs are still valid. Reusing graphs
+// of serialized stdlib functions across invalidations would additionally
+// require a summary form that survives in the module file, which the
+// serialization format doesn't provide.
 void EscapeAnalysis::invalidate(SILFunction *F, InvalidationKind K) {
   if (FunctionInfo *FInfo = Function2Info.lookup(F)) {
     DEBUG(llvm::dbgs() << "  invalidate " << FInfo->Graph.F->getName() << '\n');
@@ -2016,6 +2022,11 @@ void EscapeAnalysis::invalidate(SILFunction *F, InvalidationKind K) {
 }
 
 void EscapeAnalysis::handleDeleteNotification(SILNode *node) {
+  // This handler is called for every value deleted anywhere in the module,
+  // so bail out as early as possible if no graphs were computed yet.
+  if (Function2Info.empty())
+    return;
+
   auto value = dyn_cast<ValueBase>(node);
   if (!value) return;
 
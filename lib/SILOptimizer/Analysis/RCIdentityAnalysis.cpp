@@ -10,13 +10,19 @@
 //
 //===----------------------------------------------------------------------===//
 
+#define DEBUG_TYPE "sil-rc-identity"
 #include "swift/SILOptimizer/Analysis/RCIdentityAnalysis.h"
 #include "swift/SILOptimizer/Analysis/DominanceAnalysis.h"
 #include "swift/SIL/SILInstruction.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/CommandLine.h"
 
 using namespace swift;
 
+STATISTIC(NumRCIdentityQueries, "Number of RC identity root queries");
+STATISTIC(NumRCIdentityCacheHits, "Number of RC identity queries served from "
+                                  "the cache");
+
 //===----------------------------------------------------------------------===//
 //                                  Utility
 //===----------------------------------------------------------------------===//
@@ -453,10 +459,14 @@ SILValue RCIdentityFunctionInfo::getRCIdentityRootInner(SILValue V,
 }
 
 SILValue RCIdentityFunctionInfo::getRCIdentityRoot(SILValue V) {
+  ++NumRCIdentityQueries;
+
   // Do we have it in the RCCache ?
   auto Iter = RCCache.find(V);
-  if (Iter != RCCache.end())
+  if (Iter != RCCache.end()) {
+    ++NumRCIdentityCacheHits;
     return Iter->second;
+  }
 
   SILValue Root = getRCIdentityRootInner(V, 0);
   VisitedArgs.clear();
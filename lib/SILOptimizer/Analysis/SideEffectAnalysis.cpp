@@ -437,6 +437,13 @@ void SideEffectAnalysis::initialize(SILPassManager *PM) {
   BCA = PM->getAnalysis<BasicCalleeAnalysis>();
 }
 
+// FIXME: The bottom-up order would in principle allow computing the initial
+// per-function summaries of an SCC level in parallel, but everything this
+// walk touches is shared mutable state: the FunctionInfo graph with its
+// caller edge lists, BasicCalleeAnalysis, and - through getCalleeList -
+// lazy deserialization into the SILModule. Until those are thread-safe the
+// best we can do is keep recomputation lazy, which BottomUpIPAnalysis
+// already does by skipping still-valid callees in prepareForVisiting().
 void SideEffectAnalysis::recompute(FunctionInfo *Initial) {
   allocNewUpdateID();
 
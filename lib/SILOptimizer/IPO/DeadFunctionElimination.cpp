@@ -429,6 +429,19 @@ public:
     Module(module) {}
 
   /// The main entry point of the optimization.
+  ///
+  /// The marking walk is a textbook candidate for a parallel graph traversal
+  /// (work-stealing deques plus an atomic mark bit per function), but it is
+  /// not a pure traversal in this form. Visiting a method instruction creates
+  /// and mutates MethodInfos through a shared DenseMap and bump allocator,
+  /// canHaveSameImplementation calls findImplementingMethod, which iterates
+  /// class members and can fault in lazily loaded members from a serialized
+  /// module or the Clang importer, and the alive set doubles as the worklist
+  /// membership check. Parallelizing this would need the method-info table
+  /// built up front in a serial prepass, a mark bit on SILFunction itself,
+  /// and member loading to be thread-safe; only the last is a real obstacle,
+  /// but it is the same one that keeps the pass pipelines sequential (see
+  /// runFunctionPasses).
   bool findAliveFunctions() {
 
     DEBUG(llvm::dbgs() << "running function elimination\n");
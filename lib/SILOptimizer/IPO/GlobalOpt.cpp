@@ -735,6 +735,17 @@ replaceLoadsByKnownValue(BuiltinInst *CallToOnce, SILFunction *AddrF,
 /// We analyze the body of globalinit_func to see if it can be statically
 /// initialized. If yes, we set the initial value of the SILGlobalVariable and
 /// remove the "once" call to globalinit_func from the addressor.
+///
+/// This covers scalar lets as well as arbitrarily nested structs and tuples
+/// of trivial types: analyzeStaticInitializer recurses through struct and
+/// tuple instructions, and IRGen's GenConstant emits the matching constant
+/// aggregates. What stays once-guarded are lets whose value holds a
+/// reference, most notably Array: the stored value is a struct wrapping an
+/// alloc_ref'd buffer, so isSimpleType rejects it. Folding those needs the
+/// outlined static-object form (object instructions, as produced by the
+/// ObjectOutliner for locally visible allocations) to be usable as a global's
+/// initializer and GenConstant to emit references to such objects; neither
+/// exists yet, so a statically initialized array let cannot be expressed.
 void SILGlobalOpt::optimizeInitializer(SILFunction *AddrF,
                                        GlobalInitCalls &Calls) {
   if (UnhandledOnceCallee)
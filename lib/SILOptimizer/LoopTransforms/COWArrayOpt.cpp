@@ -337,6 +337,14 @@ namespace {
 ///
 /// TODO: Completely eliminate make_mutable calls if all operations that the
 /// guard are already guarded by either "init" or "mutate_unknown".
+///
+/// TODO: Uniqueness established in a caller is lost at every opaque call
+/// boundary, so @inline(never) helpers re-check buffers their callers just
+/// made unique. Propagating it interprocedurally needs a per-function
+/// summary ("argument N is unique on entry/exit") computed bottom-up the
+/// way SideEffectAnalysis computes effect summaries, and a guarantee that
+/// no escape between the caller's check and the call can break uniqueness.
+/// Neither exists yet; everything below reasons strictly within one loop.
 class COWArrayOpt {
   typedef StructUseCollector::UserList UserList;
   typedef StructUseCollector::UserOperList UserOperList;
@@ -21,6 +21,7 @@
 #include "swift/SILOptimizer/PassManager/PrettyStackTrace.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/SILOptimizer/Utils/OptimizerStatsUtils.h"
+#include "swift/Basic/Statistic.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringSwitch.h"
@@ -343,6 +344,12 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
     F->dump(getOptions().EmitVerboseSIL);
   }
 
+  // When stats are enabled, record the pass as a traced event on the
+  // function, so per-pass durations and counter deltas end up in the stats
+  // reporter's trace output.
+  FrontendStatsTracer StatsTracer(F->getModule().getASTContext().Stats,
+                                  SFT->getTag(), F);
+
   llvm::sys::TimePoint<> StartTime = std::chrono::system_clock::now();
   Mod->registerDeleteNotificationHandler(SFT);
   if (breakBeforeRunning(F->getName(), SFT))
@@ -379,6 +386,14 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
   ++NumPassesRun;
 }
 
+// FIXME: Functions in disjoint call-graph regions could in principle run
+// their pipelines concurrently, but none of the state a function pipeline
+// touches is confined to the function: the inliner and the specializers
+// read callee bodies and create new functions in the module, passes
+// deserialize callees on demand, the analyses keep module-wide caches which
+// every invalidation mutates, and type lowering goes through the shared
+// ASTContext. Making those thread-safe has to come before any scheduler
+// change here; until then the worklist below stays strictly sequential.
 void SILPassManager::
 runFunctionPasses(unsigned FromTransIdx, unsigned ToTransIdx) {
   if (ToTransIdx <= FromTransIdx)
@@ -467,6 +482,10 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
     printModule(Mod, Options.EmitVerboseSIL);
   }
 
+  // Record module passes as traced events as well; they have no function
+  // entity, only the pass tag.
+  FrontendStatsTracer StatsTracer(Mod->getASTContext().Stats, SMT->getTag());
+
   llvm::sys::TimePoint<> StartTime = std::chrono::system_clock::now();
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
   Mod->registerDeleteNotificationHandler(SMT);
@@ -21,6 +21,7 @@
 #define DEBUG_TYPE "sil-combine"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "SILCombiner.h"
+#include "swift/SIL/CFG.h"
 #include "swift/SIL/SILBuilder.h"
 #include "swift/SIL/SILVisitor.h"
 #include "swift/SIL/DebugUtils.h"
@@ -28,6 +29,7 @@
 #include "swift/SILOptimizer/Analysis/SimplifyInstruction.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/SILOptimizer/Utils/Local.h"
+#include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
@@ -43,25 +45,23 @@ STATISTIC(NumDeadInst, "Number of dead insts eliminated");
 //                              Utility Methods
 //===----------------------------------------------------------------------===//
 
-/// addReachableCodeToWorklist - Walk the function in depth-first order, adding
-/// all reachable code to the worklist.
+/// addReachableCodeToWorklist - Walk the function in reverse post-order,
+/// adding all reachable code to the worklist.
 ///
 /// This has a couple of tricks to make the code faster and more powerful.  In
 /// particular, we DCE instructions as we go, to avoid adding them to the
 /// worklist (this significantly speeds up SILCombine on code where many
 /// instructions are dead or constant).
 void SILCombiner::addReachableCodeToWorklist(SILBasicBlock *BB) {
-  llvm::SmallVector<SILBasicBlock *, 256> Worklist;
   llvm::SmallVector<SILInstruction *, 128> InstrsForSILCombineWorklist;
-  llvm::SmallPtrSet<SILBasicBlock *, 32> Visited;
-
-  Worklist.push_back(BB);
-  do {
-    BB = Worklist.pop_back_val();
-
-    // We have now visited this block!  If we've already been here, ignore it.
-    if (!Visited.insert(BB).second) continue;
 
+  // Visit the reachable blocks in reverse post-order so that an instruction's
+  // operands are collected before the instructions that use them, whichever
+  // branch of a diamond they are defined in. Visiting operands first lets a
+  // single pass over the worklist simplify most chains bottom-up instead of
+  // revisiting users in a later iteration.
+  llvm::ReversePostOrderTraversal<SILBasicBlock *> RPOT(BB);
+  for (SILBasicBlock *BB : RPOT) {
     for (SILBasicBlock::iterator BBI = BB->begin(), E = BB->end(); BBI != E; ) {
       SILInstruction *Inst = &*BBI;
       ++BBI;
@@ -86,11 +86,7 @@ void SILCombiner::addReachableCodeToWorklist(SILBasicBlock *BB) {
 
       InstrsForSILCombineWorklist.push_back(Inst);
     }
-
-    // Recursively visit successors.
-    for (auto SI = BB->succ_begin(), SE = BB->succ_end(); SI != SE; ++SI)
-      Worklist.push_back(*SI);
-  } while (!Worklist.empty());
+  }
 
   // Once we've found all of the instructions to add to the worklist, add them
   // in reverse order. This way SILCombine will visit from the top of the
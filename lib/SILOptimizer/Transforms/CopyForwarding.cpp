@@ -1242,7 +1242,10 @@ void CopyForwarding::forwardCopiesOf(SILValue Def, SILFunction *F) {
     // splitting critical edges and will naturally handle redundant branch
     // targets.
     for (unsigned EdgeIdx : DeadInSuccs) {
-      SILBasicBlock *SuccBB = splitCriticalEdge(BB->getTerminator(), EdgeIdx);
+      // Splitting the edge patches the dominator tree, so it stays valid and
+      // doesn't need to be recomputed by the next pass.
+      SILBasicBlock *SuccBB = splitCriticalEdge(BB->getTerminator(), EdgeIdx,
+                                                DomAnalysis->get(F));
       if (SuccBB)
         HasChangedCFG = true;
       else
@@ -1423,8 +1426,11 @@ class CopyForwardingPass : public SILFunctionTransform
       } while (Forwarding.hasForwardedToCopy());
     }
     if (Forwarding.hasChangedCFG()) {
-      // We've split critical edges so we can't preserve CFG.
+      // We've split critical edges so we can't preserve CFG, but the
+      // dominator tree was kept up to date while splitting.
+      DA->lockInvalidation();
       invalidateAnalysis(SILAnalysis::InvalidationKind::FunctionBody);
+      DA->unlockInvalidation();
     } else {
       invalidateAnalysis(SILAnalysis::InvalidationKind::CallsAndInstructions);
       }
@@ -594,10 +594,10 @@ bool BridgedProperty::matchInstSequence(SILBasicBlock::iterator It) {
   if (Load) {
     // There will be a release matching the earlier retain. The only user of the
     // retained value is the unowned objective-c method consumer.
-    unsigned NumUses = 0;
+    if (!Load->hasNUses(4))
+      return false;
     Release = nullptr;
     for (auto *Use : Load->getUses()) {
-      ++NumUses;
       if (auto *R = dyn_cast<StrongReleaseInst>(Use->getUser())) {
         if (!Release) {
           Release = R;
@@ -607,7 +607,7 @@ bool BridgedProperty::matchInstSequence(SILBasicBlock::iterator It) {
         }
       }
     }
-    if (!Release || NumUses != 4)
+    if (!Release)
       return false;
   }
   return true;
@@ -56,6 +56,12 @@ class SILPerformanceInliner {
   llvm::DenseMap<SILFunction *, ShortestPathAnalysis *> SPAs;
   llvm::SpecificBumpPtrAllocator<ShortestPathAnalysis> SPAAllocator;
 
+  /// Remembers for each callee whether the cost of its whole body is at most
+  /// TrivialFunctionThreshold. Callee bodies don't change while this inliner
+  /// instance collects call sites, so the answer can be reused for every call
+  /// site of a popular callee.
+  llvm::DenseMap<SILFunction *, bool> TrivialCalleeCache;
+
   ColdBlockInfo CBI;
 
   OptRemark::Emitter &ORE;
@@ -154,6 +160,8 @@ class SILPerformanceInliner {
       int &NumCallerBlocks,
       const llvm::DenseMap<SILBasicBlock *, uint64_t> &BBToWeightMap);
 
+  bool isTrivialFunction(SILFunction *Callee);
+
   bool decideInColdBlock(FullApplySite AI, SILFunction *Callee);
 
   void visitColdBlocks(SmallVectorImpl<FullApplySite> &AppliesToInline,
@@ -282,6 +290,18 @@ bool SILPerformanceInliner::isProfitableToInline(
     return false;
   }
 
+  // A thunk only accepts trivial callees (checked again below on the cost
+  // after constant folding, which can only be smaller). The whole-body cost
+  // is cached, so this avoids re-walking a popular callee at each call site.
+  if (AI.getFunction()->isThunk() && isTrivialFunction(Callee)) {
+    DEBUG(
+      dumpCaller(AI.getFunction());
+      llvm::dbgs() << "    decision {trivial into thunk} " <<
+          Callee->getName() << '\n';
+    );
+    return true;
+  }
+
   SILLoopInfo *LI = LA->get(Callee);
   ShortestPathAnalysis *SPA = getSPA(Callee, LI);
   assert(SPA->isValid());
@@ -546,6 +566,31 @@ bool SILPerformanceInliner::decideInWarmBlock(
                               BBToWeightMap);
 }
 
+/// Returns true if the cost of the whole \p Callee body does not exceed
+/// TrivialFunctionThreshold. The result is cached so that a popular callee
+/// is only walked once per inliner run and not once per call site.
+bool SILPerformanceInliner::isTrivialFunction(SILFunction *Callee) {
+  auto CacheIter = TrivialCalleeCache.find(Callee);
+  if (CacheIter != TrivialCalleeCache.end())
+    return CacheIter->second;
+
+  int CalleeCost = 0;
+  bool IsTrivial = true;
+  for (SILBasicBlock &Block : *Callee) {
+    for (SILInstruction &I : Block) {
+      CalleeCost += int(instructionInlineCost(I));
+      if (CalleeCost > TrivialFunctionThreshold) {
+        IsTrivial = false;
+        break;
+      }
+    }
+    if (!IsTrivial)
+      break;
+  }
+  TrivialCalleeCache[Callee] = IsTrivial;
+  return IsTrivial;
+}
+
 /// Return true if inlining this call site into a cold block is profitable.
 bool SILPerformanceInliner::decideInColdBlock(FullApplySite AI,
                                               SILFunction *Callee) {
@@ -566,18 +611,12 @@ bool SILPerformanceInliner::decideInColdBlock(FullApplySite AI,
     return true;
   }
 
-  int CalleeCost = 0;
+  if (!isTrivialFunction(Callee))
+    return false;
 
-  for (SILBasicBlock &Block : *Callee) {
-    for (SILInstruction &I : Block) {
-      CalleeCost += int(instructionInlineCost(I));
-      if (CalleeCost > TrivialFunctionThreshold)
-        return false;
-    }
-  }
   DEBUG(
     dumpCaller(AI.getFunction());
-    llvm::dbgs() << "    cold decision {" << CalleeCost << "} " <<
+    llvm::dbgs() << "    cold decision {trivial} " <<
               Callee->getName() << '\n';
   );
   return true;
@@ -450,7 +450,10 @@ static bool tryToSpeculateTarget(FullApplySite AI, ClassHierarchyAnalysis *CHA,
   // checks.
 
   // TODO: The ordering of checks may benefit from using a PGO, because
-  // the most probable alternatives could be checked first.
+  // the most probable alternatives could be checked first. This needs value
+  // profiling of the dynamic receiver types at the call site; the current
+  // instrumentation only records execution counts of source constructs, which
+  // cannot tell the subclasses of a call site apart.
 
   for (auto S : Subs) {
     DEBUG(llvm::dbgs() << "Inserting a speculative call for class "
@@ -559,6 +562,12 @@ namespace {
       if (CurFn.isThunk())
         return;
 
+      // If we know from profile data that the function was never executed,
+      // the speculative checks can only add code size.
+      auto EntryCount = CurFn.getEntryCount();
+      if (EntryCount && EntryCount.getValue() == 0)
+        return;
+
       ClassHierarchyAnalysis *CHA = PM->getAnalysis<ClassHierarchyAnalysis>();
 
       bool Changed = false;
@@ -34,6 +34,15 @@ namespace {
 /// It handles alloc_ref instructions of native swift classes: if promoted,
 /// the [stack] attribute is set in the alloc_ref and a dealloc_ref [stack] is
 /// inserted at the end of the object's lifetime.
+///
+/// This also covers the tail-allocated buffers of fixed-size array literals,
+/// but only after the allocation function is inlined: the escape analysis
+/// models the array semantics calls (in particular array.uninitialized, which
+/// just packages the buffer into the array value), so an inlined buffer
+/// alloc_ref of a non-escaping array is promotable like any other alloc_ref.
+/// A buffer allocated behind a non-inlined semantics call cannot be promoted
+/// here; that would need a stack-allocating entry point in the standard
+/// library.
 class StackPromotion : public SILFunctionTransform {
 
 public:
@@ -2440,7 +2440,18 @@ void swift::trySpecializeApplyOfGeneric(
 // =============================================================================
 // Prespecialized symbol lookup.
 //
-// This uses the SIL linker to checks for the does not load the body of the pres
+// This looks up a specialization by its mangled name in other modules and,
+// if found, imports it as an external declaration without deserializing the
+// body. Currently only a fixed list of stdlib specializations (built into
+// the -Onone support module) is eligible.
+//
+// TODO: Generalizing this into a shared cache of optimized specializations
+// needs more than the lookup below: a home for the serialized bodies with a
+// staleness key (compiler version and relevant build flags), a way for the
+// specializer to register newly created specializations with that cache, and
+// linkage ensuring IRGen emits cache hits as external references that the
+// linker can deduplicate. The mangled specialized name is already a suitable
+// cache key.
 // =============================================================================
 
 /// Link a specialization for generating prespecialized code.
@@ -8482,6 +8482,15 @@ bool ConstraintSystem::salvage(SmallVectorImpl<Solution> &viable, Expr *expr) {
   // eliminated.
   viable.clear();
 
+  // If the initial solve already blew past the complexity limits, don't
+  // redo the entire search just to rediscover that; the scope count and
+  // memory high-water marks survive from the failed attempt.
+  if (getExpressionTooComplex(viable)) {
+    TC.diagnose(expr->getLoc(), diag::expression_too_complex).
+      highlight(expr->getSourceRange());
+    return true;
+  }
+
   {
     // Set up solver state.
     SolverState state(expr, *this);
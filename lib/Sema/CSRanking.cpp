@@ -1178,6 +1178,26 @@ ConstraintSystem::findBestSolution(SmallVectorImpl<Solution> &viable,
     }
   }
 
+  // The fixed score is the primary comparison criterion, so a solution
+  // whose score is worse than the minimum of the set can never win.
+  // Discard the dominated solutions up front; the pairwise comparison
+  // below is quadratic in the number of solutions that remain.
+  auto minScore = viable[0].getFixedScore();
+  for (unsigned i = 1, n = viable.size(); i != n; ++i) {
+    auto &score = viable[i].getFixedScore();
+    if (score < minScore)
+      minScore = score;
+  }
+
+  auto dominatedEnd = std::remove_if(
+      viable.begin(), viable.end(), [&](const Solution &solution) {
+        return minScore < solution.getFixedScore();
+      });
+  viable.erase(dominatedEnd, viable.end());
+
+  if (viable.size() == 1)
+    return 0;
+
   SolutionDiff diff(viable);
 
   // Find a potential best.
@@ -17,6 +17,7 @@
 #include "ConstraintGraph.h"
 #include "swift/AST/ParameterList.h"
 #include "swift/AST/TypeWalker.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/raw_ostream.h"
@@ -809,6 +810,155 @@ ConstraintSystem::solveSingle(FreeTypeVariableBinding allowFreeTypeVariables) {
   return std::move(solutions[0]);
 }
 
+bool ConstraintSystem::Candidate::buildShapeFingerprint(
+    llvm::SmallVectorImpl<char> &fingerprint) const {
+  // Collects the shape of the candidate expression - node kinds together
+  // with the declarations they reference - into a string key. Any node
+  // whose typing isn't fully determined by that information makes the
+  // candidate ineligible for caching.
+  struct ShapeWalker : public ASTWalker {
+    llvm::raw_svector_ostream OS;
+    bool Eligible = true;
+
+    ShapeWalker(llvm::SmallVectorImpl<char> &fingerprint) : OS(fingerprint) {}
+
+    std::pair<bool, Expr *> walkToExprPre(Expr *expr) override {
+      if (!Eligible)
+        return {false, expr};
+
+      OS << unsigned(expr->getKind()) << ':';
+
+      // The value of a literal doesn't affect how it's typed,
+      // only its kind does, and that is already part of the key.
+      if (isa<LiteralExpr>(expr))
+        return {true, expr};
+
+      // Overload sets are keyed on their current domain, so any
+      // difference in visible choices produces a different fingerprint.
+      if (auto *OSR = dyn_cast<OverloadSetRefExpr>(expr)) {
+        for (auto *decl : OSR->getDecls())
+          OS << (const void *)decl << ',';
+        return {true, expr};
+      }
+
+      if (auto *DRE = dyn_cast<DeclRefExpr>(expr)) {
+        OS << (const void *)DRE->getDecl() << ';';
+        return {true, expr};
+      }
+
+      // Purely structural nodes - their contribution is their kind
+      // together with the fingerprints of their children. Argument labels
+      // and trailing closures participate in overload choice, so tuples
+      // contribute their element names and both argument forms their
+      // trailing-closure bit: f(a: 1) and f(x: 1) must not collide.
+      if (auto *TE = dyn_cast<TupleExpr>(expr)) {
+        for (auto name : TE->getElementNames())
+          OS << (name.empty() ? StringRef("_") : name.str()) << ',';
+        OS << unsigned(TE->hasTrailingClosure()) << ';';
+        return {true, expr};
+      }
+      if (auto *PE = dyn_cast<ParenExpr>(expr)) {
+        OS << unsigned(PE->hasTrailingClosure()) << ';';
+        return {true, expr};
+      }
+      if (isa<ApplyExpr>(expr) || isa<IdentityExpr>(expr) ||
+          isa<CollectionExpr>(expr) || isa<AnyTryExpr>(expr))
+        return {true, expr};
+
+      // Anything else might draw on information the fingerprint
+      // doesn't capture, so it's not safe to cache.
+      Eligible = false;
+      return {false, expr};
+    }
+  };
+
+  ShapeWalker walker(fingerprint);
+  E->walk(walker);
+  if (!walker.Eligible)
+    return false;
+
+  // Name resolution and contextual conversion are sensitive to where
+  // the candidate appears, so both are part of the key as well.
+  llvm::raw_svector_ostream OS(fingerprint);
+  OS << '|' << (const void *)DC << '|' << (const void *)CT.getPointer() << '|'
+     << unsigned(CTP);
+  return true;
+}
+
+/// Collect all of the overload sets in \p expr in pre-order, which matches
+/// the traversal used to build candidate shape fingerprints.
+static void
+collectOverloadSets(Expr *expr,
+                    llvm::SmallVectorImpl<OverloadSetRefExpr *> &overloadSets) {
+  struct Collector : public ASTWalker {
+    llvm::SmallVectorImpl<OverloadSetRefExpr *> &Sets;
+
+    Collector(llvm::SmallVectorImpl<OverloadSetRefExpr *> &sets)
+        : Sets(sets) {}
+
+    std::pair<bool, Expr *> walkToExprPre(Expr *expr) override {
+      if (auto *OSR = dyn_cast<OverloadSetRefExpr>(expr))
+        Sets.push_back(OSR);
+      return {true, expr};
+    }
+  };
+
+  Collector collector(overloadSets);
+  expr->walk(collector);
+}
+
+bool ConstraintSystem::Candidate::replayShrunkDomains(
+    const TypeChecker::ShrunkDomainsCacheEntry &entry,
+    llvm::SmallDenseSet<OverloadSetRefExpr *> &shrunkExprs) const {
+  // An unsolvable candidate didn't reduce anything, so there is nothing
+  // to re-apply; the caller restores the original domains in that case.
+  if (entry.NoSolutions)
+    return true;
+
+  llvm::SmallVector<OverloadSetRefExpr *, 4> overloadSets;
+  collectOverloadSets(E, overloadSets);
+
+  for (auto &domain : entry.ReducedDomains) {
+    auto *OSR = overloadSets[domain.first];
+    auto &choices = domain.second;
+
+    // Update the expression with the previously reduced domain.
+    MutableArrayRef<ValueDecl *> decls(
+        Allocator.Allocate<ValueDecl *>(choices.size()), choices.size());
+
+    std::uninitialized_copy(choices.begin(), choices.end(), decls.begin());
+    OSR->setDecls(decls);
+
+    shrunkExprs.insert(OSR);
+  }
+
+  return false;
+}
+
+void ConstraintSystem::Candidate::recordShrunkDomains(
+    StringRef fingerprint, bool noSolutions,
+    llvm::SmallDenseSet<OverloadSetRefExpr *> &shrunkExprs) const {
+  auto &entry = TC.ShrunkDomainsCache[fingerprint];
+  entry.NoSolutions = noSolutions;
+  entry.ReducedDomains.clear();
+
+  if (noSolutions)
+    return;
+
+  llvm::SmallVector<OverloadSetRefExpr *, 4> overloadSets;
+  collectOverloadSets(E, overloadSets);
+
+  for (unsigned i = 0, n = overloadSets.size(); i != n; ++i) {
+    auto *OSR = overloadSets[i];
+    if (shrunkExprs.count(OSR) == 0)
+      continue;
+
+    auto choices = OSR->getDecls();
+    entry.ReducedDomains.emplace_back(
+        i, llvm::SmallVector<ValueDecl *, 2>(choices.begin(), choices.end()));
+  }
+}
+
 bool ConstraintSystem::Candidate::solve(
     llvm::SmallDenseSet<OverloadSetRefExpr *> &shrunkExprs) {
   // Don't attempt to solve candidate if there is closure
@@ -826,6 +976,18 @@ bool ConstraintSystem::Candidate::solve(
   if (containsClosure)
     return false;
 
+  // If an identically shaped candidate has already been solved in this
+  // context, re-apply its reduced domains instead of solving it again.
+  // This commonly fires for literal-heavy sub-expressions which are
+  // repeated throughout a file.
+  llvm::SmallString<128> fingerprint;
+  bool isCacheable = buildShapeFingerprint(fingerprint);
+  if (isCacheable) {
+    auto known = TC.ShrunkDomainsCache.find(fingerprint);
+    if (known != TC.ShrunkDomainsCache.end())
+      return replayShrunkDomains(known->second, shrunkExprs);
+  }
+
   auto cleanupImplicitExprs = [&](Expr *expr) {
     expr->forEachChildExpr([&](Expr *childExpr) -> Expr * {
       Type type = childExpr->getType();
@@ -917,6 +1079,11 @@ bool ConstraintSystem::Candidate::solve(
   // Record found solutions as suggestions.
   this->applySolutions(solutions, shrunkExprs);
 
+  // Memoize the reduced domains, so identically shaped candidates can
+  // re-apply them without solving.
+  if (isCacheable)
+    recordShrunkDomains(fingerprint, solutions.empty(), shrunkExprs);
+
   // Let's double-check if we have any implicit expressions
   // with type variables and nullify their types.
   cleanupImplicitExprs(E);
@@ -1933,8 +2100,35 @@ bool ConstraintSystem::solveSimplified(
 
   ++solverState->NumDisjunctions;
   auto constraints = disjunction->getNestedConstraints();
+
+  // Order the choices before attempting them: favored choices first,
+  // then everything else, with generic operators and unavailable
+  // overloads last. Solving a non-generic choice early gives the
+  // "skip generic operators" heuristic above a score to compare
+  // against, which prunes the most expensive branches of pathological
+  // operator expressions. The order within each group is preserved,
+  // and remembered choices are recorded with their original index.
+  SmallVector<unsigned, 4> choiceOrder;
+  choiceOrder.reserve(constraints.size());
+  {
+    SmallVector<unsigned, 4> generalChoices;
+    SmallVector<unsigned, 4> genericOrUnavailableChoices;
+    for (auto index : indices(constraints)) {
+      auto choice = DisjunctionChoice(this, disjunction, constraints[index]);
+      if (constraints[index]->isFavored())
+        choiceOrder.push_back(index);
+      else if (choice.isGenericOperatorOrUnavailable())
+        genericOrUnavailableChoices.push_back(index);
+      else
+        generalChoices.push_back(index);
+    }
+    choiceOrder.append(generalChoices.begin(), generalChoices.end());
+    choiceOrder.append(genericOrUnavailableChoices.begin(),
+                       genericOrUnavailableChoices.end());
+  }
+
   // Try each of the constraints within the disjunction.
-  for (auto index : indices(constraints)) {
+  for (auto index : choiceOrder) {
     auto currentChoice =
         DisjunctionChoice(this, disjunction, constraints[index]);
     if (shouldSkipDisjunctionChoice(*this, currentChoice, bestNonGenericScore))
@@ -32,6 +32,7 @@ Constraint::Constraint(ConstraintKind kind, ArrayRef<Constraint *> constraints,
                        ArrayRef<TypeVariableType *> typeVars)
   : Kind(kind), HasRestriction(false), HasFix(false), IsActive(false),
     IsDisabled(false), RememberChoice(false), IsFavored(false),
+    IsDisjunctionChoice(false),
     NumTypeVariables(typeVars.size()),
     Nested(constraints), Locator(locator)
 {
@@ -45,6 +46,7 @@ Constraint::Constraint(ConstraintKind Kind, Type First, Type Second,
                        ArrayRef<TypeVariableType *> typeVars)
   : Kind(Kind), HasRestriction(false), HasFix(false), IsActive(false),
     IsDisabled(false), RememberChoice(false), IsFavored(false),
+    IsDisjunctionChoice(false),
     NumTypeVariables(typeVars.size()), Types { First, Second, Type() },
     Locator(locator)
 {
@@ -105,6 +107,7 @@ Constraint::Constraint(ConstraintKind Kind, Type First, Type Second, Type Third,
                        ArrayRef<TypeVariableType *> typeVars)
   : Kind(Kind), HasRestriction(false), HasFix(false), IsActive(false),
     IsDisabled(false), RememberChoice(false), IsFavored(false),
+    IsDisjunctionChoice(false),
     NumTypeVariables(typeVars.size()), Types { First, Second, Third },
     Locator(locator)
 {
@@ -156,6 +159,7 @@ Constraint::Constraint(ConstraintKind kind, Type first, Type second,
                        ArrayRef<TypeVariableType *> typeVars)
   : Kind(kind), HasRestriction(false), HasFix(false), IsActive(false),
     IsDisabled(false), RememberChoice(false), IsFavored(false),
+    IsDisjunctionChoice(false),
     NumTypeVariables(typeVars.size()), Member { first, second, member, useDC },
     Locator(locator)
 {
@@ -174,7 +178,8 @@ Constraint::Constraint(Type type, OverloadChoice choice, DeclContext *useDC,
                        ArrayRef<TypeVariableType *> typeVars)
   : Kind(ConstraintKind::BindOverload),
     HasRestriction(false), HasFix(false), IsActive(false), IsDisabled(false),
-    RememberChoice(false), IsFavored(false), NumTypeVariables(typeVars.size()),
+    RememberChoice(false), IsFavored(false), IsDisjunctionChoice(false),
+    NumTypeVariables(typeVars.size()),
     Overload{type, choice, useDC}, Locator(locator)
 { 
   std::copy(typeVars.begin(), typeVars.end(), getTypeVariablesBuffer().begin());
@@ -186,7 +191,8 @@ Constraint::Constraint(ConstraintKind kind,
                        ArrayRef<TypeVariableType *> typeVars)
     : Kind(kind), Restriction(restriction),
       HasRestriction(true), HasFix(false), IsActive(false), IsDisabled(false),
-      RememberChoice(false), IsFavored(false), NumTypeVariables(typeVars.size()),
+      RememberChoice(false), IsFavored(false), IsDisjunctionChoice(false),
+    NumTypeVariables(typeVars.size()),
       Types{ first, second, Type() }, Locator(locator)
 {
   assert(!first.isNull());
@@ -199,7 +205,8 @@ Constraint::Constraint(ConstraintKind kind, Fix fix,
                        ArrayRef<TypeVariableType *> typeVars)
   : Kind(kind), FixData(fix.getData()), TheFix(fix.getKind()),
     HasRestriction(false), HasFix(true),
-    IsActive(false), IsDisabled(false), RememberChoice(false), IsFavored(false),
+    IsActive(false), IsDisabled(false), RememberChoice(false),
+    IsFavored(false), IsDisjunctionChoice(false),
     NumTypeVariables(typeVars.size()),
     Types{ first, second, Type() }, Locator(locator)
 {
@@ -617,7 +624,7 @@ Constraint *Constraint::create(ConstraintSystem &cs, ConstraintKind kind,
 
   // Create the constraint.
   unsigned size = totalSizeToAlloc<TypeVariableType*>(typeVars.size());
-  void *mem = cs.getAllocator().Allocate(size, alignof(Constraint));
+  void *mem = cs.allocateConstraint(typeVars.size(), size);
   return ::new (mem) Constraint(kind, first, second, locator, typeVars);
 }
 
@@ -635,7 +642,7 @@ Constraint *Constraint::create(ConstraintSystem &cs, ConstraintKind kind,
   uniqueTypeVariables(typeVars);
   
   unsigned size = totalSizeToAlloc<TypeVariableType*>(typeVars.size());
-  void *mem = cs.getAllocator().Allocate(size, alignof(Constraint));
+  void *mem = cs.allocateConstraint(typeVars.size(), size);
   return ::new (mem) Constraint(kind,
                                 first, second, third,
                                 locator, typeVars);
@@ -657,7 +664,7 @@ Constraint *Constraint::createMember(ConstraintSystem &cs, ConstraintKind kind,
 
   // Create the constraint.
   unsigned size = totalSizeToAlloc<TypeVariableType*>(typeVars.size());
-  void *mem = cs.getAllocator().Allocate(size, alignof(Constraint));
+  void *mem = cs.allocateConstraint(typeVars.size(), size);
   return new (mem) Constraint(kind, first, second, member, useDC,
                               functionRefKind, locator, typeVars);
 }
@@ -676,7 +683,7 @@ Constraint *Constraint::createBindOverload(ConstraintSystem &cs, Type type,
 
   // Create the constraint.
   unsigned size = totalSizeToAlloc<TypeVariableType*>(typeVars.size());
-  void *mem = cs.getAllocator().Allocate(size, alignof(Constraint));
+  void *mem = cs.allocateConstraint(typeVars.size(), size);
   return new (mem) Constraint(type, choice, useDC, locator, typeVars);
 }
 
@@ -695,7 +702,7 @@ Constraint *Constraint::createRestricted(ConstraintSystem &cs,
 
   // Create the constraint.
   unsigned size = totalSizeToAlloc<TypeVariableType*>(typeVars.size());
-  void *mem = cs.getAllocator().Allocate(size, alignof(Constraint));
+  void *mem = cs.allocateConstraint(typeVars.size(), size);
   return new (mem) Constraint(kind, restriction, first, second, locator,
                               typeVars);
 }
@@ -714,7 +721,7 @@ Constraint *Constraint::createFixed(ConstraintSystem &cs, ConstraintKind kind,
 
   // Create the constraint.
   unsigned size = totalSizeToAlloc<TypeVariableType*>(typeVars.size());
-  void *mem = cs.getAllocator().Allocate(size, alignof(Constraint));
+  void *mem = cs.allocateConstraint(typeVars.size(), size);
   return new (mem) Constraint(kind, fix, first, second, locator, typeVars);
 }
 
@@ -766,10 +773,16 @@ Constraint *Constraint::createDisjunction(ConstraintSystem &cs,
   // Create the disjunction constraint.
   uniqueTypeVariables(typeVars);
   unsigned size = totalSizeToAlloc<TypeVariableType*>(typeVars.size());
-  void *mem = cs.getAllocator().Allocate(size, alignof(Constraint));
+  void *mem = cs.allocateConstraint(typeVars.size(), size);
   auto disjunction =  new (mem) Constraint(ConstraintKind::Disjunction,
                               cs.allocateCopy(constraints), locator, typeVars);
   disjunction->RememberChoice = (bool) rememberChoice;
+
+  // The disjunction owns its nested constraints; mark them so their
+  // memory isn't reclaimed while the disjunction is still alive.
+  for (auto *constraint : disjunction->getNestedConstraints())
+    constraint->IsDisjunctionChoice = true;
+
   return disjunction;
 }
 
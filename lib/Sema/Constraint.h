@@ -323,6 +323,10 @@ class Constraint final : public llvm::ilist_node<Constraint>,
   /// in its disjunction.
   unsigned IsFavored : 1;
 
+  /// Whether this constraint is nested inside of a disjunction, which
+  /// owns it and might outlive the solver scope that attempted it.
+  unsigned IsDisjunctionChoice : 1;
+
   /// The number of type variables referenced by this constraint.
   ///
   /// The type variables themselves are tail-allocated.
@@ -508,6 +512,10 @@ public:
   void setFavored() { IsFavored = true; }
   bool isFavored() const { return IsFavored; }
 
+  /// Whether this constraint is owned by a disjunction, which means its
+  /// memory cannot be reclaimed when a solver scope is rolled back.
+  bool isDisjunctionChoice() const { return IsDisjunctionChoice; }
+
   /// Whether the solver should remember which choice was taken for
   /// this constraint.
   bool shouldRememberChoice() const { return RememberChoice; }
@@ -516,42 +516,46 @@ void ConstraintGraph::gatherConstraints(
 
 #pragma mark Algorithms
 
-/// Depth-first search for connected components
-static void connectedComponentsDFS(ConstraintGraph &cg,
-                                   ConstraintGraphNode &node,
-                                   unsigned component,
-                                   SmallVectorImpl<unsigned> &components) {
-  // Local function that recurses on the given set of type variables.
-  auto visitAdjacencies = [&](ArrayRef<TypeVariableType *> typeVars) {
-    for (auto adj : typeVars) {
-      auto nodeAndIndex = cg.lookupNode(adj);
-      // If we've already seen this node in this component, we're done.
-      unsigned &curComponent = components[nodeAndIndex.second];
-      if (curComponent == component)
-        continue;
+namespace {
+/// Union-find structure over constraint graph nodes, used to gather the
+/// connected components of the graph in near-linear time.
+class ConnectedComponents {
+  /// Parent index of each node in the union-find forest; a node whose
+  /// parent is itself is the representative of its component.
+  SmallVector<unsigned, 16> Parent;
+
+public:
+  explicit ConnectedComponents(unsigned numNodes) {
+    Parent.resize(numNodes);
+    for (unsigned i = 0; i != numNodes; ++i)
+      Parent[i] = i;
+  }
 
-      // Mark this node as part of this connected component, then recurse.
-      assert(curComponent == components.size() && "Already in a component?");
-      curComponent = component;
-      connectedComponentsDFS(cg, nodeAndIndex.first, component, components);
+  /// Find the representative of the component containing \p node,
+  /// compressing the path along the way.
+  unsigned findRepresentative(unsigned node) {
+    while (Parent[node] != node) {
+      Parent[node] = Parent[Parent[node]];
+      node = Parent[node];
     }
-  };
-
-  // Recurse to mark adjacent nodes as part of this connected component.
-  visitAdjacencies(node.getAdjacencies());
-
-  // Figure out the representative for this type variable.
-  auto &cs = cg.getConstraintSystem();
-  auto typeVarRep = cs.getRepresentative(node.getTypeVariable());
-  if (typeVarRep == node.getTypeVariable()) {
-    // This type variable is the representative of its set; visit all of the
-    // other type variables in the same equivalence class.
-    visitAdjacencies(node.getEquivalenceClass().slice(1));
-  } else {
-    // Otherwise, visit the representative of the set.
-    visitAdjacencies(typeVarRep);
+    return node;
   }
-}
+
+  /// Merge the components containing \p first and \p second. The node
+  /// with the smallest index becomes the representative, which keeps
+  /// component numbering stable with respect to discovery order.
+  void merge(unsigned first, unsigned second) {
+    first = findRepresentative(first);
+    second = findRepresentative(second);
+    if (first == second)
+      return;
+
+    if (second < first)
+      std::swap(first, second);
+    Parent[second] = first;
+  }
+};
+} // end anonymous namespace
 
 unsigned ConstraintGraph::computeConnectedComponents(
            SmallVectorImpl<TypeVariableType *> &typeVars,
@@ -566,26 +570,35 @@ unsigned ConstraintGraph::computeConnectedComponents(
   unsigned numTypeVariables = TypeVariables.size();
   components.assign(numTypeVariables, numTypeVariables);
 
-  // Perform a depth-first search from each type variable to identify
-  // what component it is in.
-  unsigned numComponents = 0;
+  // Merge components along constraint edges and equivalence classes.
+  // The graph shrinks as well as grows while solver scopes are pushed
+  // and popped, and union-find doesn't support edge removal, so the
+  // components are recomputed for each split; a single union-find pass
+  // over the nodes is near-linear, where the previous depth-first
+  // search paid a node lookup for every edge it crossed.
+  ConnectedComponents connectedComponents(numTypeVariables);
   for (unsigned i = 0; i != numTypeVariables; ++i) {
     auto typeVar = TypeVariables[i];
-
-    // Look up the node for this type variable.
     auto nodeAndIndex = lookupNode(typeVar);
 
-    // If we're already assigned a component for this node, skip it.
-    unsigned &curComponent = components[nodeAndIndex.second];
-    if (curComponent != numTypeVariables)
-      continue;
+    for (auto adj : nodeAndIndex.first.getAdjacencies())
+      connectedComponents.merge(i, lookupNode(adj).second);
 
-    // Record this component.
-    unsigned component = numComponents++;
+    // Merge this type variable with the representative of its
+    // equivalence class; the other members merge themselves the same
+    // way, which connects the entire class.
+    auto typeVarRep = CS.getRepresentative(typeVar);
+    if (typeVarRep != typeVar)
+      connectedComponents.merge(i, lookupNode(typeVarRep).second);
+  }
 
-    // Note that this node is part of this component, then visit it.
-    curComponent = component;
-    connectedComponentsDFS(*this, nodeAndIndex.first, component, components);
+  // Number the components in order of discovery.
+  unsigned numComponents = 0;
+  for (unsigned i = 0; i != numTypeVariables; ++i) {
+    unsigned rep = connectedComponents.findRepresentative(i);
+    if (components[rep] == numTypeVariables)
+      components[rep] = numComponents++;
+    components[i] = components[rep];
   }
 
   // Figure out which components have unbound type variables; these
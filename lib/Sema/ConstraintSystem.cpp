@@ -75,6 +75,17 @@ ConstraintSystem::ConstraintSystem(TypeChecker &tc, DeclContext *dc,
 }
 
 ConstraintSystem::~ConstraintSystem() {
+  // Record the high-water mark of the solver arena before it is torn down;
+  // MaxMemory alone is only updated when the too-complex check runs.
+  if (TC.Context.Stats) {
+    auto &maxSolverMemory =
+        TC.Context.Stats->getFrontendCounters().MaxSolverMemory;
+    auto used = static_cast<int64_t>(
+        std::max(MaxMemory, TC.Context.getSolverMemory()));
+    if (maxSolverMemory < used)
+      maxSolverMemory = used;
+  }
+
   delete &CG;
 }
 
@@ -352,6 +363,28 @@ getAlternativeLiteralTypes(KnownProtocolKind kind) {
   return *AlternativeLiteralTypes[index];
 }
 
+void *ConstraintSystem::allocateConstraint(unsigned numTypeVars,
+                                           unsigned size) {
+  // Constraints of the same shape have the same size, so any recycled
+  // block from the matching bucket fits.
+  auto known = RecycledConstraintBlocks.find(numTypeVars);
+  if (known != RecycledConstraintBlocks.end() && !known->second.empty())
+    return known->second.pop_back_val();
+
+  return getAllocator().Allocate(size, alignof(Constraint));
+}
+
+void ConstraintSystem::recycleConstraint(Constraint *constraint) {
+  // The failed constraint is inspected during diagnosis after the solver
+  // has unwound, and disjunction choices are owned by their disjunction,
+  // which can outlive the scope that attempted them.
+  if (constraint == failedConstraint || constraint->isDisjunctionChoice())
+    return;
+
+  RecycledConstraintBlocks[constraint->getTypeVariables().size()].push_back(
+      static_cast<void *>(constraint));
+}
+
 ConstraintLocator *ConstraintSystem::getConstraintLocator(
                      Expr *anchor,
                      ArrayRef<ConstraintLocator::PathElement> path,
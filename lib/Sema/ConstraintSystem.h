@@ -919,6 +919,12 @@ private:
   /// \brief Allocator used for all of the related constraint systems.
   llvm::BumpPtrAllocator Allocator;
 
+  /// \brief Memory blocks of constraints which were rolled back together
+  /// with the solver scope that generated them, bucketed by the number of
+  /// trailing type variables so they can be reused by allocateConstraint.
+  llvm::SmallDenseMap<unsigned, llvm::SmallVector<void *, 8>, 4>
+    RecycledConstraintBlocks;
+
   /// \brief Arena used for memory management of constraint-checker-related
   /// allocations.
   ConstraintCheckerArenaRAII Arena;
@@ -1084,6 +1090,27 @@ private:
         llvm::SmallVectorImpl<Solution> &solutions,
         llvm::SmallDenseSet<OverloadSetRefExpr *> &shrunkExprs) const;
 
+    /// \brief Build a canonical shape fingerprint for this candidate,
+    /// used as a key into the shrunk domains cache.
+    ///
+    /// \returns false if the expression contains nodes whose typing isn't
+    /// fully captured by the fingerprint, i.e. candidate isn't cacheable.
+    bool buildShapeFingerprint(llvm::SmallVectorImpl<char> &fingerprint) const;
+
+    /// \brief Re-apply reduced overload domains previously recorded for
+    /// an identically shaped candidate, instead of solving it again.
+    ///
+    /// \returns true if the recorded candidate had no solutions.
+    bool replayShrunkDomains(
+        const TypeChecker::ShrunkDomainsCacheEntry &entry,
+        llvm::SmallDenseSet<OverloadSetRefExpr *> &shrunkExprs) const;
+
+    /// \brief Record the reduced overload domains of this candidate in
+    /// the shrunk domains cache.
+    void recordShrunkDomains(
+        StringRef fingerprint, bool noSolutions,
+        llvm::SmallDenseSet<OverloadSetRefExpr *> &shrunkExprs) const;
+
     /// Check if attempt at solving of the candidate makes sense given
     /// the current conditions - number of shrunk domains which is related
     /// to the given candidate over the total number of disjunctions present.
@@ -1236,11 +1263,14 @@ private:
                                     retiredConstraints,
                                     retiredConstraints.begin(), lastRetiredPos);
 
-      // And remove all of the generated constraints.
+      // And remove all of the generated constraints, recycling their
+      // memory so constraint allocations stay proportional to the
+      // active solver path instead of the whole search tree.
       auto genStart = generatedConstraints.begin() + numGenerated,
            genEnd = generatedConstraints.end();
       for (auto genI = genStart; genI != genEnd; ++genI) {
         CS.InactiveConstraints.erase(ConstraintList::iterator(*genI));
+        CS.recycleConstraint(*genI);
       }
 
       generatedConstraints.erase(genStart, genEnd);
@@ -2195,6 +2225,15 @@ public:
   /// \brief Retrieve the allocator used by this constraint system.
   llvm::BumpPtrAllocator &getAllocator() { return Allocator; }
 
+  /// \brief Allocate memory for a constraint with \p numTypeVars trailing
+  /// type variables, reusing the block of a rolled-back constraint with
+  /// the same shape when one is available.
+  void *allocateConstraint(unsigned numTypeVars, unsigned size);
+
+  /// \brief Hand the memory of a constraint which a scope rollback has
+  /// removed from the system over to allocateConstraint for reuse.
+  void recycleConstraint(Constraint *constraint);
+
   template <typename It>
   ArrayRef<typename std::iterator_traits<It>::value_type>
   allocateCopy(It start, It end) {
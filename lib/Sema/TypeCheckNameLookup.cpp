@@ -20,6 +20,7 @@
 #include "swift/AST/Initializer.h"
 #include "swift/AST/NameLookup.h"
 #include "swift/AST/ProtocolConformance.h"
+#include "swift/AST/ReferencedNameTracker.h"
 #include "swift/Basic/TopCollection.h"
 #include <algorithm>
 
@@ -201,6 +202,58 @@ namespace {
 LookupResult TypeChecker::lookupUnqualified(DeclContext *dc, DeclName name,
                                             SourceLoc loc,
                                             NameLookupOptions options) {
+  // Build a LookupResult for this context from raw lookup entries.
+  auto buildResult = [&](ArrayRef<LookupResultEntry> entries) -> LookupResult {
+    LookupResult result;
+    LookupResultBuilder builder(*this, result, dc, options,
+                                /*memberLookup*/false);
+    for (const auto &found : entries) {
+      // Determine which type we looked through to find this result.
+      Type foundInType;
+
+      if (auto *baseDC = found.getDeclContext()) {
+        if (!baseDC->isTypeContext()) {
+          baseDC = baseDC->getParent();
+          assert(baseDC->isTypeContext());
+        }
+        foundInType = dc->mapTypeIntoContext(
+          baseDC->getDeclaredInterfaceType());
+        assert(foundInType && "bogus base declaration?");
+      }
+
+      builder.add(found.getValueDecl(), found.getDeclContext(), foundInType);
+    }
+    return result;
+  };
+
+  // Operator lookups never consider local scopes and always resolve at
+  // module scope, so the raw entries they produce depend only on the file
+  // the use appears in and on the set of loaded modules. Cache them per
+  // file instead of rescanning every visible module for each use of an
+  // operator.
+  Optional<std::pair<DeclContext *, DeclBaseName>> cacheKey;
+  if (name.isOperator() &&
+      !options.contains(NameLookupFlags::IgnoreAccessControl)) {
+    cacheKey = {dc->getModuleScopeContext(), name.getBaseName()};
+    auto known = OperatorLookupCache.find(*cacheKey);
+    if (known != OperatorLookupCache.end() &&
+        known->second.Generation == Context.getCurrentGeneration()) {
+      // The cached lookup couldn't register the top-level name dependency
+      // for this particular use, so record it here.
+      if (auto *SF = dyn_cast<SourceFile>(cacheKey->first)) {
+        if (auto *nameTracker = SF->getReferencedNameTracker()) {
+          bool isCascading =
+              !options.contains(NameLookupFlags::KnownPrivate) &&
+              dc->isCascadingContextForLookup(
+                  /*functionsAreNonCascading=*/true);
+          nameTracker->addTopLevelName(name.getBaseName(), isCascading);
+        }
+      }
+
+      return buildResult(known->second.Results);
+    }
+  }
+
   UnqualifiedLookup lookup(
       name, dc, this,
       options.contains(NameLookupFlags::KnownPrivate),
@@ -209,26 +262,13 @@ LookupResult TypeChecker::lookupUnqualified(DeclContext *dc, DeclName name,
       options.contains(NameLookupFlags::ProtocolMembers),
       options.contains(NameLookupFlags::IgnoreAccessControl));
 
-  LookupResult result;
-  LookupResultBuilder builder(*this, result, dc, options,
-                              /*memberLookup*/false);
-  for (const auto &found : lookup.Results) {
-    // Determine which type we looked through to find this result.
-    Type foundInType;
-
-    if (auto *baseDC = found.getDeclContext()) {
-      if (!baseDC->isTypeContext()) {
-        baseDC = baseDC->getParent();
-        assert(baseDC->isTypeContext());
-      }
-      foundInType = dc->mapTypeIntoContext(
-        baseDC->getDeclaredInterfaceType());
-      assert(foundInType && "bogus base declaration?");
-    }
-
-    builder.add(found.getValueDecl(), found.getDeclContext(), foundInType);
+  if (cacheKey) {
+    auto &entry = OperatorLookupCache[*cacheKey];
+    entry.Generation = Context.getCurrentGeneration();
+    entry.Results.assign(lookup.Results.begin(), lookup.Results.end());
   }
-  return result;
+
+  return buildResult(lookup.Results);
 }
 
 LookupResult
@@ -502,6 +542,18 @@ static unsigned getCallEditDistance(DeclName argName, DeclName paramName,
   StringRef argBase = argName.getBaseIdentifier().str();
   StringRef paramBase = paramName.getBaseIdentifier().str();
 
+  // The edit distance is at least the difference in length, so if that
+  // alone makes the candidate unreasonable we can reject it without
+  // running the dynamic program at all.  Most visible names fail here,
+  // which matters when correcting against SDK-sized namespaces.
+  size_t lengthDifference = argBase.size() > paramBase.size()
+                                ? argBase.size() - paramBase.size()
+                                : paramBase.size() - argBase.size();
+  if (lengthDifference >= maxEditDistance ||
+      lengthDifference > (paramBase.size() + 2) / 3) {
+    return UnreasonableCallEditDistance;
+  }
+
   unsigned distance = argBase.edit_distance(paramBase, maxEditDistance);
 
   // Bound the distance to UnreasonableCallEditDistance.
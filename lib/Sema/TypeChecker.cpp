@@ -404,6 +404,13 @@ void TypeChecker::bindExtension(ExtensionDecl *ext) {
   ::bindExtensionDecl(ext, *this);
 }
 
+// Note on parallelizing this loop: once signatures are validated, the
+// bodies on the worklist look naturally independent, but checking any of
+// them can trigger validation of arbitrary other declarations, type
+// uniquing in the ASTContext, and conformance checking, all of which
+// mutate shared state. Until those are thread-safe, bodies must be
+// checked serially; carving out independent bodies with a declaration
+// level dependency graph would still race inside the ASTContext.
 static void typeCheckFunctionsAndExternalDecls(TypeChecker &TC) {
   unsigned currentFunctionIdx = 0;
   unsigned currentExternalDef = TC.Context.LastCheckedExternalDefinition;
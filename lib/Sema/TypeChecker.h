@@ -31,6 +31,7 @@
 #include "swift/Basic/OptionSet.h"
 #include "swift/Config.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include <functional>
 
@@ -779,6 +780,40 @@ public:
   /// computed.
   llvm::DenseMap<AnyFunctionRef, std::vector<Expr*>> LocalCFunctionPointers;
 
+  /// The result of solving a shrink() candidate, memoized so structurally
+  /// identical sub-expressions (common in literal-heavy arithmetic) are
+  /// domain-reduced once instead of re-solved for every occurrence.
+  struct ShrunkDomainsCacheEntry {
+    /// Whether the candidate had no solutions, i.e. the enclosing
+    /// expression needs salvaging.
+    bool NoSolutions;
+
+    /// Reduced overload domains, keyed by the preorder index of the
+    /// overload set in the candidate expression.
+    llvm::SmallVector<std::pair<unsigned, llvm::SmallVector<ValueDecl *, 2>>,
+                      2> ReducedDomains;
+  };
+
+  /// Memoized shrink() candidate results keyed on a canonical shape
+  /// fingerprint of the candidate (node kinds, referenced declarations,
+  /// overload domains, and contextual type). \see
+  /// ConstraintSystem::Candidate::solve.
+  llvm::StringMap<ShrunkDomainsCacheEntry> ShrunkDomainsCache;
+
+  /// A cached unqualified operator lookup, together with the ASTContext
+  /// generation it was computed in; loading another module invalidates it.
+  struct OperatorLookupCacheEntry {
+    unsigned Generation;
+    SmallVector<LookupResultEntry, 4> Results;
+  };
+
+  /// Cached operator lookups, keyed by the module-scope context of the use
+  /// and the operator name. Operator lookup never considers local scopes,
+  /// so the raw results depend only on the file the use appears in and on
+  /// the set of loaded modules. \see lookupUnqualified.
+  llvm::DenseMap<std::pair<DeclContext *, DeclBaseName>,
+                 OperatorLookupCacheEntry> OperatorLookupCache;
+
 private:
   /// Return statements with functions as return values.
   llvm::DenseMap<AbstractFunctionDecl *, llvm::DenseSet<ReturnStmt *>>
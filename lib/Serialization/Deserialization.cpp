@@ -55,6 +55,26 @@ StringRef swift::getNameOfModule(const ModuleFile *MF) {
 }
 
 namespace {
+  /// Adds the number of bytes a cursor advances over this object's lifetime
+  /// to \p counter, if it is non-null.
+  ///
+  /// Destroy this before any \c BCOffsetRAII protecting the same cursor, so
+  /// the distance is measured before the cursor is rewound.
+  class BytesReadRAII {
+    llvm::BitstreamCursor &Cursor;
+    int64_t *Counter;
+    uint64_t StartBit;
+
+  public:
+    BytesReadRAII(llvm::BitstreamCursor &cursor, int64_t *counter)
+        : Cursor(cursor), Counter(counter),
+          StartBit(counter ? cursor.GetCurrentBitNo() : 0) {}
+    ~BytesReadRAII() {
+      if (Counter)
+        *Counter += (Cursor.GetCurrentBitNo() - StartBit) / 8;
+    }
+  };
+
   struct IDAndKind {
     const Decl *D;
     DeclID ID;
@@ -591,6 +611,7 @@ ProtocolConformanceRef ModuleFile::readConformance(
 
 NormalProtocolConformance *ModuleFile::readNormalConformance(
                              NormalConformanceID conformanceID) {
+  readIndexBlockIfNeeded();
   auto &conformanceEntry = NormalConformances[conformanceID-1];
   if (conformanceEntry.isComplete()) {
     return conformanceEntry.get();
@@ -920,6 +941,7 @@ GenericSignature *ModuleFile::getGenericSignature(
   // Zero is a sentinel for having no generic signature.
   if (ID == 0) return nullptr;
 
+  readIndexBlockIfNeeded();
   assert(ID <= GenericSignatures.size() && "invalid GenericSignature ID");
   auto &sigOrOffset = GenericSignatures[ID-1];
 
@@ -987,6 +1009,7 @@ ModuleFile::getGenericSignatureOrEnvironment(
   // Zero is a sentinel for having no generic environment.
   if (ID == 0) return result;
 
+  readIndexBlockIfNeeded();
   assert(ID <= GenericEnvironments.size() && "invalid GenericEnvironment ID");
   auto &envOrOffset = GenericEnvironments[ID-1];
 
@@ -1740,6 +1763,7 @@ DeclBaseName ModuleFile::getDeclBaseName(IdentifierID IID) {
   }
 
   size_t rawID = IID - NUM_SPECIAL_IDS;
+  readIndexBlockIfNeeded();
   assert(rawID < Identifiers.size() && "invalid identifier ID");
   auto identRecord = Identifiers[rawID];
 
@@ -1764,6 +1788,7 @@ Identifier ModuleFile::getIdentifier(IdentifierID IID) {
 
 DeclContext *ModuleFile::getLocalDeclContext(DeclContextID DCID) {
   assert(DCID != 0 && "invalid local DeclContext ID 0");
+  readIndexBlockIfNeeded();
   auto &declContextOrOffset = LocalDeclContexts[DCID-1];
 
   if (declContextOrOffset.isComplete())
@@ -1852,6 +1877,7 @@ DeclContext *ModuleFile::getDeclContext(DeclContextID DCID) {
   if (DCID == 0)
     return FileContext;
 
+  readIndexBlockIfNeeded();
   assert(DCID <= DeclContexts.size() && "invalid DeclContext ID");
   auto &declContextOrOffset = DeclContexts[DCID-1];
 
@@ -2248,6 +2274,7 @@ ModuleFile::getDeclCheckedImpl(DeclID DID, Optional<DeclContext *> ForcedContext
   if (DID == 0)
     return nullptr;
 
+  readIndexBlockIfNeeded();
   assert(DID <= Decls.size() && "invalid decl ID");
   auto &declOrOffset = Decls[DID-1];
 
@@ -2272,6 +2299,20 @@ ModuleFile::getDeclCheckedImpl(DeclID DID, Optional<DeclContext *> ForcedContext
   if (auto s = ctx.Stats)
     s->getFrontendCounters().NumDeclsDeserialized++;
 
+  // With -trace-stats-events, this shows up as a nested event carrying the
+  // counter deltas for everything this decl faulted in, which is usually
+  // enough to see why an innocuous-looking lookup deserialized half a module.
+  FrontendStatsTracer statsTracer(ctx.Stats, "deserialize-decl");
+
+  // Destroyed before restoreOffset rewinds the cursor, so this measures only
+  // the records belonging to this decl; decls and types it faults in
+  // recursively count themselves.
+  BytesReadRAII declBytes(DeclTypeCursor,
+                          ctx.Stats
+                              ? &ctx.Stats->getFrontendCounters()
+                                     .NumDeclRecordBytesDeserialized
+                              : nullptr);
+
   // Read the attributes (if any).
   // This isn't just using DeclAttributes because that would result in the
   // attributes getting reversed.
@@ -4110,6 +4151,7 @@ Expected<Type> ModuleFile::getTypeChecked(TypeID TID) {
   if (TID == 0)
     return Type();
 
+  readIndexBlockIfNeeded();
   assert(TID <= Types.size() && "invalid type ID");
   auto &typeOrOffset = Types[TID-1];
 
@@ -4130,11 +4172,20 @@ Expected<Type> ModuleFile::getTypeChecked(TypeID TID) {
 
   SmallVector<uint64_t, 64> scratch;
   StringRef blobData;
-  unsigned recordID = DeclTypeCursor.readRecord(entry.ID, scratch, &blobData);
 
   if (auto s = ctx.Stats)
     s->getFrontendCounters().NumTypesDeserialized++;
 
+  // Destroyed before restoreOffset rewinds the cursor; nested decls and types
+  // count themselves.
+  BytesReadRAII typeBytes(DeclTypeCursor,
+                          ctx.Stats
+                              ? &ctx.Stats->getFrontendCounters()
+                                     .NumTypeRecordBytesDeserialized
+                              : nullptr);
+
+  unsigned recordID = DeclTypeCursor.readRecord(entry.ID, scratch, &blobData);
+
   switch (recordID) {
   case decls_block::NAME_ALIAS_TYPE: {
     DeclID underlyingID;
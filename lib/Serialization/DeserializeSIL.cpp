@@ -2400,6 +2400,12 @@ bool SILDeserializer::hasSILFunction(StringRef Name,
       (cacheEntry.isDeserialized()))
     return !Linkage || cacheEntry.get()->getLinkage() == *Linkage;
 
+  // If an earlier query already read the linkage of this function, don't
+  // take another trip through the bitstream.
+  auto cachedLinkage = FuncLinkageCache.find(FID);
+  if (cachedLinkage != FuncLinkageCache.end())
+    return !Linkage || cachedLinkage->second == *Linkage;
+
   BCOffsetRAII restoreOffset(SILCursor);
   SILCursor.JumpToBit(cacheEntry.getOffset());
 
@@ -2417,8 +2423,6 @@ bool SILDeserializer::hasSILFunction(StringRef Name,
   (void)kind;
 
   // Read function properties only, e.g. its linkage and other attributes.
-  // TODO: If this results in any noticeable performance problems, Cache the
-  // linkage to avoid re-reading it from the bitcode each time?
   DeclID clangOwnerID;
   TypeID funcTyID;
   GenericEnvironmentID genericEnvID;
@@ -2437,6 +2441,7 @@ bool SILDeserializer::hasSILFunction(StringRef Name,
                        << " for SIL function " << Name << "\n");
     return false;
   }
+  FuncLinkageCache[FID] = linkage.getValue();
 
   // Bail if it is not a required linkage.
   if (Linkage && linkage.getValue() != *Linkage)
@@ -39,6 +39,11 @@ namespace swift {
     std::unique_ptr<SerializedFuncTable> FuncTable;
     std::vector<ModuleFile::PartiallySerialized<SILFunction*>> Funcs;
 
+    /// The linkage of serialized functions for which \c hasSILFunction has
+    /// already read the function record, so that repeated queries don't jump
+    /// through the bitstream again.
+    llvm::DenseMap<serialization::DeclID, SILLinkage> FuncLinkageCache;
+
     std::unique_ptr<SerializedFuncTable> VTableList;
     std::vector<ModuleFile::Serialized<SILVTable*>> VTables;
 
@@ -241,7 +241,8 @@ bool serialization::isSerializedAST(StringRef data) {
 
 ValidationInfo serialization::validateSerializedAST(
     StringRef data,
-    ExtendedValidationInfo *extendedInfo) {
+    ExtendedValidationInfo *extendedInfo,
+    bool requiresModuleSize) {
   ValidationInfo result;
 
   // Check 32-bit alignment.
@@ -268,6 +269,12 @@ ValidationInfo serialization::validateSerializedAST(
       result = validateControlBlock(cursor, scratch, extendedInfo);
       if (result.status == Status::Malformed)
         return result;
+      // The control block has everything the compatibility check needs, and
+      // it sits at the front of the file. Unless the caller wants to know
+      // where this module ends in the buffer, don't page in the rest of the
+      // file just to skip over it.
+      if (!requiresModuleSize)
+        return result;
     } else {
       if (cursor.SkipBlock()) {
         result.status = Status::Malformed;
@@ -462,6 +469,42 @@ public:
   }
 };
 
+class ModuleFile::DeclInterfaceHashTableInfo {
+public:
+  using internal_key_type = StringRef;
+  using external_key_type = internal_key_type;
+  using data_type = StringRef; // interface hash
+  using hash_value_type = uint32_t;
+  using offset_type = unsigned;
+
+  internal_key_type GetInternalKey(external_key_type ID) {
+    return ID;
+  }
+
+  hash_value_type ComputeHash(internal_key_type key) {
+    return llvm::HashString(key);
+  }
+
+  static bool EqualKey(internal_key_type lhs, internal_key_type rhs) {
+    return lhs == rhs;
+  }
+
+  static std::pair<unsigned, unsigned> ReadKeyDataLength(const uint8_t *&data) {
+    unsigned keyLength = endian::readNext<uint16_t, little, unaligned>(data);
+    unsigned dataLength = endian::readNext<uint16_t, little, unaligned>(data);
+    return { keyLength, dataLength };
+  }
+
+  static internal_key_type ReadKey(const uint8_t *data, unsigned length) {
+    return StringRef(reinterpret_cast<const char *>(data), length);
+  }
+
+  static data_type ReadData(internal_key_type key, const uint8_t *data,
+                            unsigned length) {
+    return StringRef(reinterpret_cast<const char *>(data), length);
+  }
+};
+
 class ModuleFile::NestedTypeDeclsTableInfo {
 public:
   using internal_key_type = StringRef;
@@ -651,6 +694,18 @@ ModuleFile::readLocalDeclTable(ArrayRef<uint64_t> fields, StringRef blobData) {
     base + sizeof(uint32_t), base));
 }
 
+std::unique_ptr<ModuleFile::SerializedDeclInterfaceHashTable>
+ModuleFile::readDeclInterfaceHashTable(ArrayRef<uint64_t> fields,
+                                       StringRef blobData) {
+  uint32_t tableOffset;
+  index_block::DeclInterfaceHashesLayout::readRecord(fields, tableOffset);
+  auto base = reinterpret_cast<const uint8_t *>(blobData.data());
+
+  using OwnedTable = std::unique_ptr<SerializedDeclInterfaceHashTable>;
+  return OwnedTable(SerializedDeclInterfaceHashTable::Create(base + tableOffset,
+    base + sizeof(uint32_t), base));
+}
+
 std::unique_ptr<ModuleFile::SerializedNestedTypeDeclsTable>
 ModuleFile::readNestedTypeDeclsTable(ArrayRef<uint64_t> fields,
                                      StringRef blobData) {
@@ -840,6 +895,9 @@ bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
       case index_block::DECL_MEMBER_NAMES:
         DeclMemberNames = readDeclMemberNamesTable(scratch, blobData);
         break;
+      case index_block::DECL_INTERFACE_HASHES:
+        DeclInterfaceHashes = readDeclInterfaceHashTable(scratch, blobData);
+        break;
       case index_block::LOCAL_DECL_CONTEXT_OFFSETS:
         assert(blobData.empty());
         LocalDeclContexts.assign(scratch.begin(), scratch.end());
@@ -872,6 +930,67 @@ bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
   return false;
 }
 
+bool ModuleFile::skimIndexBlock(llvm::BitstreamCursor &cursor) {
+  cursor.EnterSubBlock(INDEX_BLOCK_ID);
+
+  SmallVector<uint64_t, 4> scratch;
+
+  while (!cursor.AtEndOfStream()) {
+    auto entry = cursor.advance();
+    switch (entry.Kind) {
+    case llvm::BitstreamEntry::EndBlock:
+      return true;
+
+    case llvm::BitstreamEntry::Error:
+      return false;
+
+    case llvm::BitstreamEntry::SubBlock:
+      // Sub-blocks are handled when the block is actually read.
+      if (cursor.SkipBlock())
+        return false;
+      break;
+
+    case llvm::BitstreamEntry::Record:
+      // The point of skimming is to avoid decoding the large offset arrays,
+      // so identify each record from its abbreviation alone when possible.
+      // The entry point is emitted with a literal record code; the layouts
+      // that encode their code as an operand instead are all offset arrays
+      // and lookup tables, so anything not spelled ENTRY_POINT in its
+      // abbreviation can be skipped outright.
+      if (entry.ID >= llvm::bitc::FIRST_APPLICATION_ABBREV) {
+        const llvm::BitCodeAbbrev *abbrev = cursor.getAbbrev(entry.ID);
+        bool mayBeEntryPoint =
+            abbrev->getNumOperandInfos() > 0 &&
+            abbrev->getOperandInfo(0).isLiteral() &&
+            abbrev->getOperandInfo(0).getLiteralValue() ==
+              index_block::ENTRY_POINT;
+        if (!mayBeEntryPoint) {
+          cursor.skipRecord(entry.ID);
+          break;
+        }
+      }
+
+      scratch.clear();
+      unsigned kind = cursor.readRecord(entry.ID, scratch);
+      if (kind == index_block::ENTRY_POINT)
+        setEntryPointClassID(scratch.front());
+      break;
+    }
+  }
+
+  return false;
+}
+
+void ModuleFile::readIndexBlockIfNeeded() {
+  if (!HasLazyIndexBlock)
+    return;
+  HasLazyIndexBlock = false;
+
+  PrettyStackTraceModuleFile stackEntry(*this);
+  if (!readIndexBlock(IndexCursor))
+    error();
+}
+
 class ModuleFile::DeclCommentTableInfo {
   ModuleFile &F;
 
@@ -1260,7 +1379,19 @@ ModuleFile::ModuleFile(
     }
 
     case INDEX_BLOCK_ID: {
-      if (!hasValidControlBlock || !readIndexBlock(cursor)) {
+      if (!hasValidControlBlock) {
+        error();
+        return;
+      }
+
+      // The index block is read lazily; a frontend job imports many modules
+      // it never actually looks into, and those shouldn't pay to set up
+      // their lookup tables. Save a cursor for later and skim the block now
+      // for just the entry-point record.
+      IndexCursor = cursor;
+      HasLazyIndexBlock = true;
+
+      if (!skimIndexBlock(cursor)) {
         error();
         return;
       }
@@ -1309,16 +1440,27 @@ ModuleFile::ModuleFile(
     return;
   }
 
-  if (!this->ModuleDocInputBuffer)
+  // The module documentation sidecar is only read when a client asks for
+  // comments or group information; batch compiles never touch it.
+  if (this->ModuleDocInputBuffer)
+    HasLazyModuleDoc = true;
+}
+
+void ModuleFile::readModuleDocIfNeeded() {
+  if (!HasLazyModuleDoc)
     return;
+  HasLazyModuleDoc = false;
 
   llvm::BitstreamCursor docCursor{ModuleDocInputBuffer->getMemBufferRef()};
   if (!checkModuleDocSignature(docCursor) ||
       !enterTopLevelModuleBlock(docCursor, MODULE_DOC_BLOCK_ID)) {
-    error(Status::MalformedDocumentation);
+    // The documentation is strictly advisory, so a malformed sidecar just
+    // means there are no comments.
     return;
   }
 
+  llvm::BitstreamEntry topLevelEntry;
+
   while (!docCursor.AtEndOfStream()) {
     topLevelEntry = docCursor.advance(AF_DontPopBlockAtEnd);
     if (topLevelEntry.Kind != llvm::BitstreamEntry::SubBlock)
@@ -1326,8 +1468,9 @@ ModuleFile::ModuleFile(
 
     switch (topLevelEntry.ID) {
     case COMMENT_BLOCK_ID: {
-      if (!hasValidControlBlock || !readCommentBlock(docCursor)) {
-        error(Status::MalformedDocumentation);
+      if (!readCommentBlock(docCursor)) {
+        DeclCommentTable.reset();
+        GroupNamesMap.reset();
         return;
       }
       break;
@@ -1337,17 +1480,13 @@ ModuleFile::ModuleFile(
       // Unknown top-level block, possibly for use by a future version of the
       // module format.
       if (docCursor.SkipBlock()) {
-        error(Status::MalformedDocumentation);
+        DeclCommentTable.reset();
+        GroupNamesMap.reset();
         return;
       }
       break;
     }
   }
-
-  if (topLevelEntry.Kind != llvm::BitstreamEntry::EndBlock) {
-    error(Status::MalformedDocumentation);
-    return;
-  }
 }
 
 Status ModuleFile::associateWithFileContext(FileUnit *file,
@@ -1468,6 +1607,7 @@ ModuleFile::~ModuleFile() { }
 void ModuleFile::lookupValue(DeclName name,
                              SmallVectorImpl<ValueDecl*> &results) {
   PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
 
   if (TopLevelDecls) {
     // Find top-level declarations with the given name.
@@ -1512,6 +1652,7 @@ void ModuleFile::lookupValue(DeclName name,
 
 TypeDecl *ModuleFile::lookupLocalType(StringRef MangledName) {
   PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
 
   if (!LocalTypeDecls)
     return nullptr;
@@ -1526,6 +1667,7 @@ TypeDecl *ModuleFile::lookupLocalType(StringRef MangledName) {
 TypeDecl *ModuleFile::lookupNestedType(Identifier name,
                                        const NominalTypeDecl *parent) {
   PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
 
   if (!NestedTypeDecls)
     return nullptr;
@@ -1550,8 +1692,62 @@ TypeDecl *ModuleFile::lookupNestedType(Identifier name,
   return nullptr;
 }
 
+Optional<StringRef> ModuleFile::getDeclInterfaceHash(StringRef MangledName) {
+  PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
+
+  if (!DeclInterfaceHashes)
+    return None;
+
+  auto iter = DeclInterfaceHashes->find(MangledName);
+  if (iter == DeclInterfaceHashes->end())
+    return None;
+
+  return *iter;
+}
+
+void ModuleFile::collectDeclsWithChangedInterfaces(
+    ModuleFile &other, SmallVectorImpl<StringRef> &changed) {
+  PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
+  other.readIndexBlockIfNeeded();
+
+  auto getHash = [](SerializedDeclInterfaceHashTable *table,
+                    StringRef name) -> Optional<StringRef> {
+    if (!table)
+      return None;
+    auto iter = table->find(name);
+    if (iter == table->end())
+      return None;
+    return *iter;
+  };
+
+  if (DeclInterfaceHashes) {
+    for (auto keyIter = DeclInterfaceHashes->key_begin(),
+              keyEnd = DeclInterfaceHashes->key_end();
+         keyIter != keyEnd; ++keyIter) {
+      StringRef name = *keyIter;
+      if (getHash(DeclInterfaceHashes.get(), name) !=
+          getHash(other.DeclInterfaceHashes.get(), name))
+        changed.push_back(name);
+    }
+  }
+
+  // Anything recorded only by \p other has changed as well.
+  if (other.DeclInterfaceHashes) {
+    for (auto keyIter = other.DeclInterfaceHashes->key_begin(),
+              keyEnd = other.DeclInterfaceHashes->key_end();
+         keyIter != keyEnd; ++keyIter) {
+      StringRef name = *keyIter;
+      if (!getHash(DeclInterfaceHashes.get(), name).hasValue())
+        changed.push_back(name);
+    }
+  }
+}
+
 OperatorDecl *ModuleFile::lookupOperator(Identifier name, DeclKind fixity) {
   PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
 
   if (!OperatorDecls)
     return nullptr;
@@ -1572,6 +1768,7 @@ OperatorDecl *ModuleFile::lookupOperator(Identifier name, DeclKind fixity) {
 
 PrecedenceGroupDecl *ModuleFile::lookupPrecedenceGroup(Identifier name) {
   PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
 
   if (!PrecedenceGroupDecls)
     return nullptr;
@@ -1672,6 +1869,7 @@ void ModuleFile::lookupVisibleDecls(ModuleDecl::AccessPathTy accessPath,
                                     NLKind lookupKind) {
   PrettyStackTraceModuleFile stackEntry(*this);
   assert(accessPath.size() <= 1 && "can only refer to top-level decls");
+  readIndexBlockIfNeeded();
 
   if (!TopLevelDecls)
     return;
@@ -1707,6 +1905,7 @@ void ModuleFile::lookupVisibleDecls(ModuleDecl::AccessPathTy accessPath,
 
 void ModuleFile::loadExtensions(NominalTypeDecl *nominal) {
   PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
   if (!ExtensionDecls)
     return;
 
@@ -1764,6 +1963,8 @@ void ModuleFile::loadObjCMethods(
        ObjCSelector selector,
        bool isInstanceMethod,
        llvm::TinyPtrVector<AbstractFunctionDecl *> &methods) {
+  readIndexBlockIfNeeded();
+
   // If we don't have an Objective-C method table, there's nothing to do.
   if (!ObjCMethods)
     return;
@@ -1853,6 +2054,7 @@ void ModuleFile::lookupClassMember(ModuleDecl::AccessPathTy accessPath,
                                    SmallVectorImpl<ValueDecl*> &results) {
   PrettyStackTraceModuleFile stackEntry(*this);
   assert(accessPath.size() <= 1 && "can only refer to top-level decls");
+  readIndexBlockIfNeeded();
 
   if (!ClassMembersForDynamicLookup)
     return;
@@ -1902,6 +2104,7 @@ void ModuleFile::lookupClassMembers(ModuleDecl::AccessPathTy accessPath,
                                     VisibleDeclConsumer &consumer) {
   PrettyStackTraceModuleFile stackEntry(*this);
   assert(accessPath.size() <= 1 && "can only refer to top-level decls");
+  readIndexBlockIfNeeded();
 
   if (!ClassMembersForDynamicLookup)
     return;
@@ -1931,6 +2134,8 @@ void ModuleFile::lookupClassMembers(ModuleDecl::AccessPathTy accessPath,
 void ModuleFile::lookupObjCMethods(
        ObjCSelector selector,
        SmallVectorImpl<AbstractFunctionDecl *> &results) {
+  readIndexBlockIfNeeded();
+
   // If we don't have an Objective-C method table, there's nothing to do.
   if (!ObjCMethods) return;
 
@@ -1955,8 +2160,35 @@ ModuleFile::collectLinkLibraries(ModuleDecl::LinkLibraryCallback callback) const
     callback(LinkLibrary(Name, LibraryKind::Framework));
 }
 
+void ModuleFile::preloadAllDecls() {
+  PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
+
+  // Gather the decls that haven't been materialized yet and visit them in
+  // the order their records appear in the file, so the cursor sweeps forward
+  // once instead of bouncing around in whatever order the lookup tables
+  // would hand them out.
+  std::vector<std::pair<uint64_t, DeclID>> declsByOffset;
+  declsByOffset.reserve(Decls.size());
+  for (unsigned i = 0, e = Decls.size(); i != e; ++i) {
+    if (!Decls[i].isComplete())
+      declsByOffset.push_back({Decls[i], DeclID(i + 1)});
+  }
+  std::sort(declsByOffset.begin(), declsByOffset.end());
+
+  for (const auto &entry : declsByOffset) {
+    Expected<Decl *> declOrError = getDeclChecked(entry.second);
+    if (!declOrError) {
+      if (!getContext().LangOpts.EnableDeserializationRecovery)
+        fatal(declOrError.takeError());
+      llvm::consumeError(declOrError.takeError());
+    }
+  }
+}
+
 void ModuleFile::getTopLevelDecls(SmallVectorImpl<Decl *> &results) {
   PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
   if (PrecedenceGroupDecls) {
     for (auto entry : PrecedenceGroupDecls->data()) {
       for (auto item : entry)
@@ -2005,6 +2237,7 @@ void ModuleFile::getTopLevelDecls(SmallVectorImpl<Decl *> &results) {
 void
 ModuleFile::getLocalTypeDecls(SmallVectorImpl<TypeDecl *> &results) {
   PrettyStackTraceModuleFile stackEntry(*this);
+  readIndexBlockIfNeeded();
   if (!LocalTypeDecls)
     return;
 
@@ -2025,7 +2258,7 @@ void ModuleFile::getDisplayDecls(SmallVectorImpl<Decl *> &results) {
   getTopLevelDecls(results);
 }
 
-Optional<CommentInfo> ModuleFile::getCommentForDecl(const Decl *D) const {
+Optional<CommentInfo> ModuleFile::getCommentForDecl(const Decl *D) {
   assert(D);
 
   // Keep these as assertions instead of early exits to ensure that we are not
@@ -2035,6 +2268,8 @@ Optional<CommentInfo> ModuleFile::getCommentForDecl(const Decl *D) const {
   assert(D->getDeclContext()->getModuleScopeContext() == FileContext &&
          "Decl is from a different serialized file");
 
+  readModuleDocIfNeeded();
+
   if (!DeclCommentTable)
     return None;
 
@@ -2069,7 +2304,8 @@ Optional<CommentInfo> ModuleFile::getCommentForDecl(const Decl *D) const {
 
 const static StringRef Separator = "/";
 
-Optional<StringRef> ModuleFile::getGroupNameById(unsigned Id) const {
+Optional<StringRef> ModuleFile::getGroupNameById(unsigned Id) {
+  readModuleDocIfNeeded();
   if (!GroupNamesMap || GroupNamesMap->count(Id) == 0)
     return None;
   auto Original = (*GroupNamesMap)[Id];
@@ -2080,7 +2316,8 @@ Optional<StringRef> ModuleFile::getGroupNameById(unsigned Id) const {
   return StringRef(Original.data(), SepPos);
 }
 
-Optional<StringRef> ModuleFile::getSourceFileNameById(unsigned Id) const {
+Optional<StringRef> ModuleFile::getSourceFileNameById(unsigned Id) {
+  readModuleDocIfNeeded();
   if (!GroupNamesMap || GroupNamesMap->count(Id) == 0)
     return None;
   auto Original = (*GroupNamesMap)[Id];
@@ -2093,7 +2330,7 @@ Optional<StringRef> ModuleFile::getSourceFileNameById(unsigned Id) const {
   return StringRef(Start, Len);
 }
 
-Optional<StringRef> ModuleFile::getGroupNameForDecl(const Decl *D) const {
+Optional<StringRef> ModuleFile::getGroupNameForDecl(const Decl *D) {
   auto Triple = getCommentForDecl(D);
   if (!Triple.hasValue()) {
     return None;
@@ -2103,7 +2340,7 @@ Optional<StringRef> ModuleFile::getGroupNameForDecl(const Decl *D) const {
 
 
 Optional<StringRef>
-ModuleFile::getSourceFileNameForDecl(const Decl *D) const {
+ModuleFile::getSourceFileNameForDecl(const Decl *D) {
   auto Triple = getCommentForDecl(D);
   if (!Triple.hasValue()) {
     return None;
@@ -2112,7 +2349,7 @@ ModuleFile::getSourceFileNameForDecl(const Decl *D) const {
 }
 
 Optional<unsigned>
-ModuleFile::getSourceOrderForDecl(const Decl *D) const {
+ModuleFile::getSourceOrderForDecl(const Decl *D) {
   auto Triple = getCommentForDecl(D);
   if (!Triple.hasValue()) {
     return None;
@@ -2120,7 +2357,8 @@ ModuleFile::getSourceOrderForDecl(const Decl *D) const {
   return Triple.getValue().SourceOrder;
 }
 
-void ModuleFile::collectAllGroups(std::vector<StringRef> &Names) const {
+void ModuleFile::collectAllGroups(std::vector<StringRef> &Names) {
+  readModuleDocIfNeeded();
   if (!GroupNamesMap)
     return;
   for (auto It = GroupNamesMap->begin(); It != GroupNamesMap->end(); ++ It) {
@@ -2138,7 +2376,8 @@ void ModuleFile::collectAllGroups(std::vector<StringRef> &Names) const {
 }
 
 Optional<CommentInfo>
-ModuleFile::getCommentForDeclByUSR(StringRef USR) const {
+ModuleFile::getCommentForDeclByUSR(StringRef USR) {
+  readModuleDocIfNeeded();
   if (!DeclCommentTable)
     return None;
 
@@ -2150,7 +2389,7 @@ ModuleFile::getCommentForDeclByUSR(StringRef USR) const {
 }
 
 Optional<StringRef>
-ModuleFile::getGroupNameByUSR(StringRef USR) const {
+ModuleFile::getGroupNameByUSR(StringRef USR) {
   if (auto Comment = getCommentForDeclByUSR(USR)) {
     return getGroupNameById(Comment.getValue().Group);
   }
@@ -2178,6 +2417,7 @@ bool SerializedASTFile::hasEntryPoint() const {
 
 bool SerializedASTFile::getAllGenericSignatures(
                        SmallVectorImpl<GenericSignature*> &genericSignatures) {
+  File.readIndexBlockIfNeeded();
   genericSignatures.clear();
   for (unsigned index : indices(File.GenericSignatures)) {
     if (auto genericSig = File.getGenericSignature(index + 1))
@@ -24,11 +24,13 @@
 #include "swift/AST/ParameterList.h"
 #include "swift/AST/Pattern.h"
 #include "swift/AST/PrettyStackTrace.h"
+#include "swift/AST/PrintOptions.h"
 #include "swift/AST/ProtocolConformance.h"
 #include "swift/AST/RawComment.h"
 #include "swift/AST/USRGeneration.h"
 #include "swift/Basic/Dwarf.h"
 #include "swift/Basic/FileSystem.h"
+#include "swift/Basic/Range.h"
 #include "swift/Basic/STLExtras.h"
 #include "swift/Basic/SourceManager.h"
 #include "swift/Basic/Timer.h"
@@ -37,10 +39,6 @@
 #include "swift/ClangImporter/ClangModule.h"
 #include "swift/Serialization/SerializationOptions.h"
 
-// FIXME: We're just using CompilerInstance::createOutputFile.
-// This API should be sunk down to LLVM.
-#include "clang/Frontend/CompilerInstance.h"
-
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Bitcode/BitstreamWriter.h"
@@ -50,6 +48,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/OnDiskHashTable.h"
 #include "llvm/Support/Path.h"
@@ -258,6 +257,44 @@ namespace {
   using LocalTypeHashTableGenerator =
     llvm::OnDiskChainedHashTableGenerator<LocalDeclTableInfo>;
 
+  class DeclInterfaceHashTableInfo {
+  public:
+    using key_type = std::string;  // mangled decl name
+    using key_type_ref = StringRef;
+    using data_type = std::string; // interface hash
+    using data_type_ref = StringRef;
+    using hash_value_type = uint32_t;
+    using offset_type = unsigned;
+
+    hash_value_type ComputeHash(key_type_ref key) {
+      assert(!key.empty());
+      return llvm::HashString(key);
+    }
+
+    std::pair<unsigned, unsigned> EmitKeyDataLength(raw_ostream &out,
+                                                    key_type_ref key,
+                                                    data_type_ref data) {
+      uint32_t keyLength = key.size();
+      uint32_t dataLength = data.size();
+      endian::Writer<little> writer(out);
+      writer.write<uint16_t>(keyLength);
+      writer.write<uint16_t>(dataLength);
+      return { keyLength, dataLength };
+    }
+
+    void EmitKey(raw_ostream &out, key_type_ref key, unsigned len) {
+      out << key;
+    }
+
+    void EmitData(raw_ostream &out, key_type_ref key, data_type_ref data,
+                  unsigned len) {
+      out << data;
+    }
+  };
+
+  using DeclInterfaceHashTableGenerator =
+    llvm::OnDiskChainedHashTableGenerator<DeclInterfaceHashTableInfo>;
+
   class NestedTypeDeclsTableInfo {
   public:
     using key_type = Identifier;
@@ -4114,9 +4151,37 @@ void Serializer::writeAllIdentifiers() {
   // Make sure no identifier has an offset of 0.
   stringData.push_back('\0');
 
-  for (Identifier ident : IdentifiersToWrite) {
-    IdentifierOffsets.push_back(stringData.size());
-    stringData.append(ident.get());
+  // The reader extracts a NUL-terminated string at each offset, so an
+  // identifier that is a suffix of another can simply point into the longer
+  // identifier's bytes. Sorting the identifiers by their reversed characters
+  // places each identifier right before its extensions, so emitting in
+  // reverse sorted order only requires comparing against the last string
+  // actually emitted.
+  std::vector<unsigned> order;
+  order.reserve(IdentifiersToWrite.size());
+  for (unsigned i = 0, e = IdentifiersToWrite.size(); i != e; ++i)
+    order.push_back(i);
+  std::sort(order.begin(), order.end(), [&](unsigned lhsIndex,
+                                            unsigned rhsIndex) {
+    StringRef lhs = IdentifiersToWrite[lhsIndex].str();
+    StringRef rhs = IdentifiersToWrite[rhsIndex].str();
+    return std::lexicographical_compare(lhs.rbegin(), lhs.rend(),
+                                        rhs.rbegin(), rhs.rend());
+  });
+
+  IdentifierOffsets.resize(IdentifiersToWrite.size());
+  StringRef lastEmitted;
+  CharOffset lastOffset = 0;
+  for (unsigned index : reversed(order)) {
+    StringRef str = IdentifiersToWrite[index].str();
+    if (!str.empty() && lastEmitted.endswith(str)) {
+      IdentifierOffsets[index] = lastOffset + (lastEmitted.size() - str.size());
+      continue;
+    }
+    lastOffset = stringData.size();
+    lastEmitted = str;
+    IdentifierOffsets[index] = lastOffset;
+    stringData.append(str);
     stringData.push_back('\0');
   }
 
@@ -4195,6 +4260,48 @@ static void writeLocalDeclTable(const index_block::DeclListLayout &DeclList,
   DeclList.emit(scratch, kind, tableOffset, hashTableBlob);
 }
 
+static void writeDeclInterfaceHashTable(
+    const index_block::DeclInterfaceHashesLayout &hashesList,
+    DeclInterfaceHashTableGenerator &generator) {
+  SmallVector<uint64_t, 8> scratch;
+  llvm::SmallString<4096> hashTableBlob;
+  uint32_t tableOffset;
+  {
+    llvm::raw_svector_ostream blobStream(hashTableBlob);
+    // Make sure that no bucket is at offset 0
+    endian::Writer<little>(blobStream).write<uint32_t>(0);
+    tableOffset = generator.Emit(blobStream);
+  }
+
+  hashesList.emit(scratch, tableOffset, hashTableBlob);
+}
+
+/// Computes the hash recorded for a top-level decl in the
+/// DECL_INTERFACE_HASHES table.
+///
+/// The hash covers the decl's printed public interface, so comment and
+/// implementation changes don't perturb it.
+static std::string hashDeclInterface(const ValueDecl *VD) {
+  PrintOptions options = PrintOptions::printInterface();
+  // Doc comments don't affect clients.
+  options.PrintDocumentationComments = false;
+
+  SmallString<512> interfaceText;
+  {
+    llvm::raw_svector_ostream out(interfaceText);
+    VD->print(out, options);
+  }
+
+  llvm::MD5 hash;
+  hash.update(interfaceText);
+  llvm::MD5::MD5Result hashBuf;
+  hash.final(hashBuf);
+
+  SmallString<32> hashString;
+  llvm::MD5::stringifyResult(hashBuf, hashString);
+  return hashString.str().str();
+}
+
 static void
 writeNestedTypeDeclsTable(const index_block::NestedTypeDeclsLayout &declList,
                           const Serializer::NestedTypeDeclsTable &table) {
@@ -4803,8 +4910,10 @@ void Serializer::writeAST(ModuleOrSourceFile DC,
   ObjCMethodTable objcMethods;
   NestedTypeDeclsTable nestedTypeDecls;
   LocalTypeHashTableGenerator localTypeGenerator;
+  DeclInterfaceHashTableGenerator interfaceHashGenerator;
   ExtensionTable extensionDecls;
   bool hasLocalTypes = false;
+  bool hasInterfaceHashes = false;
 
   Optional<DeclID> entryPointClassID;
 
@@ -4833,6 +4942,17 @@ void Serializer::writeAST(ModuleOrSourceFile DC,
           continue;
         topLevelDecls[VD->getBaseName()]
           .push_back({ getKindForTable(D), addDeclRef(D) });
+
+        if (VD->getEffectiveAccess() >= swift::AccessLevel::Public) {
+          Mangle::ASTMangler Mangler;
+          std::string MangledName =
+              Mangler.mangleDeclAsUSR(VD, /*USRPrefix*/"");
+          if (!MangledName.empty()) {
+            interfaceHashGenerator.insert(MangledName,
+                                          hashDeclInterface(VD));
+            hasInterfaceHashes = true;
+          }
+        }
       } else if (auto ED = dyn_cast<ExtensionDecl>(D)) {
         Type extendedTy = ED->getExtendedType();
         assert(!extendedTy->hasUnboundGenericType());
@@ -4933,6 +5053,11 @@ void Serializer::writeAST(ModuleOrSourceFile DC,
       EntryPoint.emit(ScratchRecord, entryPointClassID.getValue());
     }
 
+    if (hasInterfaceHashes) {
+      index_block::DeclInterfaceHashesLayout InterfaceHashes(Out);
+      writeDeclInterfaceHashTable(InterfaceHashes, interfaceHashGenerator);
+    }
+
     {
       // Write sub-tables to a skippable sub-block.
       BCBlockRAII restoreBlock(Out, DECL_MEMBER_TABLES_BLOCK_ID, 4);
@@ -5014,43 +5139,13 @@ void Serializer::writeDocToStream(raw_ostream &os, ModuleOrSourceFile DC,
 static inline bool
 withOutputFile(ASTContext &ctx, StringRef outputPath,
                llvm::function_ref<void(raw_ostream &)> action){
-  namespace path = llvm::sys::path;
-  clang::CompilerInstance Clang;
-
-  std::string tmpFilePath;
-  {
-    std::error_code EC;
-    std::unique_ptr<llvm::raw_pwrite_stream> out =
-      Clang.createOutputFile(outputPath, EC,
-                             /*Binary=*/true,
-                             /*RemoveFileOnSignal=*/true,
-                             /*BaseInput=*/"",
-                             path::extension(outputPath),
-                             /*UseTemporary=*/true,
-                             /*CreateMissingDirectories=*/false,
-                             /*ResultPathName=*/nullptr,
-                             &tmpFilePath);
-
-    if (!out) {
-      StringRef problematicPath =
-          tmpFilePath.empty() ? outputPath : StringRef(tmpFilePath);
-      ctx.Diags.diagnose(SourceLoc(), diag::error_opening_output,
-                         problematicPath, EC.message());
-      return true;
-    }
-
-    action(*out);
-  }
-
-  if (!tmpFilePath.empty()) {
-    std::error_code EC = swift::moveFileIfDifferent(tmpFilePath, outputPath);
-    if (EC) {
-      ctx.Diags.diagnose(SourceLoc(), diag::error_opening_output,
-                         outputPath, EC.message());
-      return true;
-    }
+  std::error_code EC = swift::atomicallyWritingToFile(
+      outputPath, [&](llvm::raw_pwrite_stream &out) { action(out); });
+  if (EC) {
+    ctx.Diags.diagnose(SourceLoc(), diag::error_opening_output,
+                       outputPath, EC.message());
+    return true;
   }
-
   return false;
 }
 
@@ -5083,3 +5178,40 @@ void swift::serialize(ModuleOrSourceFile DC,
     });
   }
 }
+
+void swift::serializeToBuffers(
+    ModuleOrSourceFile DC, const SerializationOptions &options,
+    std::unique_ptr<llvm::MemoryBuffer> *moduleBuffer,
+    std::unique_ptr<llvm::MemoryBuffer> *moduleDocBuffer,
+    const SILModule *M) {
+  assert(options.OutputPath && options.OutputPath[0] != '\0');
+
+  if (moduleBuffer) {
+    SharedTimer timer("Serialization, swiftmodule, to buffer");
+    llvm::SmallString<1024> buf;
+    llvm::raw_svector_ostream stream(buf);
+    Serializer::writeToStream(stream, DC, M, options);
+    *moduleBuffer = llvm::MemoryBuffer::getMemBufferCopy(stream.str(),
+                                                         options.OutputPath);
+  }
+
+  if (moduleDocBuffer && options.DocOutputPath &&
+      options.DocOutputPath[0] != '\0') {
+    SharedTimer timer("Serialization, swiftdoc, to buffer");
+    llvm::SmallString<1024> buf;
+    llvm::raw_svector_ostream stream(buf);
+    Serializer::writeDocToStream(stream, DC, options.GroupInfoPath,
+                                 getContext(DC));
+    *moduleDocBuffer = llvm::MemoryBuffer::getMemBufferCopy(
+        stream.str(), options.DocOutputPath);
+  }
+}
+
+std::error_code swift::writeSerializedBuffer(StringRef outputPath,
+                                             const llvm::MemoryBuffer &buffer,
+                                             std::string &problematicPath) {
+  return writeToOutputPath(outputPath, problematicPath,
+                           [&](raw_ostream &out) {
+    out << buffer.getBuffer();
+  });
+}
@@ -121,8 +121,18 @@ RC<RawSyntax> RawSyntax::make(SyntaxKind Kind, ArrayRef<RC<RawSyntax>> Layout,
                               SourcePresence Presence, SyntaxArena *Arena) {
   auto size = totalSizeToAlloc<RC<RawSyntax>, OwnedString, TriviaPiece>(
       Layout.size(), 0, 0);
-  void *data = Arena ? Arena->AllocateRawSyntax(size, alignof(RawSyntax))
-                     : ::operator new(size);
+  void *data;
+  if (Arena) {
+    // If every child is arena-owned, destroying the node's RC<RawSyntax>
+    // copies is a no-op and the arena need not track the allocation.
+    bool NeedsDestruction = any_of(Layout, [](const RC<RawSyntax> &Child) {
+      return Child && !Child->isManualMemory();
+    });
+    data = Arena->AllocateRawSyntax(size, alignof(RawSyntax),
+                                    NeedsDestruction);
+  } else {
+    data = ::operator new(size);
+  }
   return RC<RawSyntax>(new (data)
                            RawSyntax(Kind, Layout, Presence, bool(Arena)));
 }
@@ -133,8 +143,19 @@ RC<RawSyntax> RawSyntax::make(tok TokKind, OwnedString Text,
                               SourcePresence Presence, SyntaxArena *Arena) {
   auto size = totalSizeToAlloc<RC<RawSyntax>, OwnedString, TriviaPiece>(
       0, 1, LeadingTrivia.size() + TrailingTrivia.size());
-  void *data = Arena ? Arena->AllocateRawSyntax(size, alignof(RawSyntax))
-                     : ::operator new(size);
+  void *data;
+  if (Arena) {
+    // Token nodes only need destruction if their text or trivia own heap
+    // memory; text pointing into the source buffer does not.
+    auto pieceOwnsText = [](const TriviaPiece &P) { return P.hasOwnedText(); };
+    bool NeedsDestruction = Text.isOwned() ||
+                            any_of(LeadingTrivia, pieceOwnsText) ||
+                            any_of(TrailingTrivia, pieceOwnsText);
+    data = Arena->AllocateRawSyntax(size, alignof(RawSyntax),
+                                    NeedsDestruction);
+  } else {
+    data = ::operator new(size);
+  }
   return RC<RawSyntax>(new (data) RawSyntax(
       TokKind, Text, LeadingTrivia, TrailingTrivia, Presence, bool(Arena)));
 }
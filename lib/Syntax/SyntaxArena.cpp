@@ -37,10 +37,13 @@ struct SyntaxArena::Implementation {
     return Allocator.Allocate(size, alignment);
   }
 
-  void *AllocateRawSyntax(size_t size, size_t alignment) {
+  void *AllocateRawSyntax(size_t size, size_t alignment,
+                          bool NeedsDestruction) {
     void *data = Allocator.Allocate(size, alignment);
-    /// Remember the allocated pointers so that we can destruct them.
-    AllocatedRawSyntaxList.push_back(static_cast<RawSyntax *>(data));
+    /// Remember the allocated pointers so that we can destruct them, unless
+    /// destruction is known to be a no-op for this node.
+    if (NeedsDestruction)
+      AllocatedRawSyntaxList.push_back(static_cast<RawSyntax *>(data));
     return data;
   }
 
@@ -63,8 +66,9 @@ void *SyntaxArena::Allocate(size_t size, size_t alignment) {
   return Impl.Allocate(size, alignment);
 }
 
-void *SyntaxArena::AllocateRawSyntax(size_t size, size_t alignment) {
-  return Impl.AllocateRawSyntax(size, alignment);
+void *SyntaxArena::AllocateRawSyntax(size_t size, size_t alignment,
+                                     bool NeedsDestruction) {
+  return Impl.AllocateRawSyntax(size, alignment, NeedsDestruction);
 }
 
 namespace {
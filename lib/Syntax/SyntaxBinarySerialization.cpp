@@ -0,0 +1,159 @@
+//===--- SyntaxBinarySerialization.cpp - Binary Syntax Serialization ------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Syntax/Serialization/SyntaxBinarySerialization.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/LEB128.h"
+
+#include <map>
+#include <tuple>
+
+using namespace swift;
+using namespace swift::syntax;
+
+namespace {
+
+/// Emits the tree in the format described in SyntaxBinarySerialization.h.
+///
+/// Every node payload is prefixed by its byte length, which depends on the
+/// interning state at the point the node is reached. The tree is therefore
+/// traversed twice: a measuring pass records each payload's size in
+/// pre-order, and the writing pass replays the same traversal with a fresh
+/// interning state, consuming the recorded sizes.
+class BinarySyntaxSerializer {
+  /// The stream to write to; null during the measuring pass.
+  llvm::raw_ostream *OS = nullptr;
+
+  /// The number of bytes emitted so far during the measuring pass.
+  uint64_t Size = 0;
+
+  /// Payload sizes of all non-null nodes, in pre-order.
+  std::vector<uint64_t> PayloadSizes;
+
+  /// The next entry of \c PayloadSizes to consume during the writing pass.
+  size_t NextPayloadSize = 0;
+
+  /// Interned strings, mapped to their 1-based index of first appearance.
+  llvm::StringMap<unsigned> StringIndices;
+
+  /// Interned trivia pieces, keyed by kind, count, and text, mapped to their
+  /// 1-based index of first appearance.
+  std::map<std::tuple<unsigned, unsigned, StringRef>, unsigned> TriviaIndices;
+
+  void emitVarint(uint64_t Value) {
+    if (OS)
+      llvm::encodeULEB128(Value, *OS);
+    else
+      Size += llvm::getULEB128Size(Value);
+  }
+
+  void emitByte(uint8_t Value) {
+    if (OS)
+      OS->write(static_cast<char>(Value));
+    else
+      ++Size;
+  }
+
+  void emitString(StringRef Str) {
+    auto Inserted = StringIndices.insert({Str, StringIndices.size() + 1});
+    if (!Inserted.second) {
+      emitVarint(Inserted.first->second);
+      return;
+    }
+    emitVarint(0);
+    emitVarint(Str.size());
+    if (OS)
+      *OS << Str;
+    else
+      Size += Str.size();
+  }
+
+  void emitTriviaPiece(const TriviaPiece &Piece) {
+    auto Key = std::make_tuple(unsigned(Piece.getKind()), Piece.getCount(),
+                               Piece.getText());
+    auto Inserted = TriviaIndices.insert({Key, TriviaIndices.size() + 1});
+    if (!Inserted.second) {
+      emitVarint(Inserted.first->second);
+      return;
+    }
+    emitVarint(0);
+    emitVarint(unsigned(Piece.getKind()));
+    emitVarint(Piece.getCount());
+    emitString(Piece.getText());
+  }
+
+  void emitPayload(const RawSyntax &Node) {
+    emitVarint(unsigned(Node.getKind()));
+    emitByte(Node.isPresent() ? 1 : 0);
+    if (Node.isToken()) {
+      emitVarint(unsigned(Node.getTokenKind()));
+      emitString(Node.getTokenText());
+      auto Leading = Node.getLeadingTrivia();
+      emitVarint(Leading.size());
+      for (auto &Piece : Leading)
+        emitTriviaPiece(Piece);
+      auto Trailing = Node.getTrailingTrivia();
+      emitVarint(Trailing.size());
+      for (auto &Piece : Trailing)
+        emitTriviaPiece(Piece);
+    } else {
+      auto Layout = Node.getLayout();
+      emitVarint(Layout.size());
+      for (auto &Child : Layout)
+        emitNode(Child);
+    }
+  }
+
+  void emitNode(const RC<RawSyntax> &Node) {
+    if (!Node) {
+      emitVarint(0);
+      return;
+    }
+    if (OS) {
+      assert(NextPayloadSize < PayloadSizes.size());
+      emitVarint(PayloadSizes[NextPayloadSize++]);
+      emitPayload(*Node);
+    } else {
+      size_t Slot = PayloadSizes.size();
+      PayloadSizes.push_back(0);
+      uint64_t SizeBefore = Size;
+      emitPayload(*Node);
+      uint64_t PayloadSize = Size - SizeBefore;
+      PayloadSizes[Slot] = PayloadSize;
+      Size += llvm::getULEB128Size(PayloadSize);
+    }
+  }
+
+public:
+  void serialize(const RC<RawSyntax> &Root, llvm::raw_ostream &Out) {
+    // Measuring pass.
+    emitNode(Root);
+
+    // Writing pass, with the interning state reset so the indices the writer
+    // assigns match those the measuring pass saw.
+    StringIndices.clear();
+    TriviaIndices.clear();
+    OS = &Out;
+    Out << "SSYN";
+    llvm::support::endian::Writer<llvm::support::little>(Out).write<uint32_t>(
+        /*version=*/1);
+    emitNode(Root);
+  }
+};
+
+} // end anonymous namespace
+
+void syntax::serializeRawSyntaxAsBinary(const RC<RawSyntax> &Root,
+                                        llvm::raw_ostream &OS) {
+  BinarySyntaxSerializer().serialize(Root, OS);
+}
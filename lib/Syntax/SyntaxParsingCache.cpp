@@ -0,0 +1,83 @@
+//===--- SyntaxParsingCache.cpp - Incremental syntax parsing lookup -------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Syntax/SyntaxParsingCache.h"
+#include "swift/Syntax/RawSyntax.h"
+
+using namespace swift;
+using namespace swift::syntax;
+
+/// The width of the node in source bytes, including its leading and trailing
+/// trivia.
+static size_t getNodeTextLength(const RC<RawSyntax> &Raw) {
+  AbsolutePosition Pos;
+  Raw->accumulateAbsolutePosition(Pos);
+  return Pos.getOffset();
+}
+
+size_t
+SyntaxParsingCache::translateToPreEditPosition(size_t PostEditPosition) const {
+  size_t Position = PostEditPosition;
+  for (auto &Edit : Edits) {
+    if (Edit.Start >= Position)
+      break;
+    Position = Position - Edit.ReplacementLength + Edit.originalLength();
+  }
+  return Position;
+}
+
+llvm::Optional<Syntax> SyntaxParsingCache::lookUp(size_t NewPosition,
+                                                  SyntaxKind Kind) const {
+  size_t OldPosition = translateToPreEditPosition(NewPosition);
+  return lookUpFrom(OldTree, /*NodeStart=*/0, OldPosition, Kind);
+}
+
+llvm::Optional<Syntax> SyntaxParsingCache::lookUpFrom(const Syntax &Node,
+                                                      size_t NodeStart,
+                                                      size_t Position,
+                                                      SyntaxKind Kind) const {
+  if (nodeCanBeReused(Node, NodeStart, Position, Kind))
+    return Node;
+
+  // Descend into the child that covers the position.
+  size_t ChildStart = NodeStart;
+  for (size_t I = 0, E = Node.getNumChildren(); I != E; ++I) {
+    llvm::Optional<Syntax> Child = Node.getChild(I);
+    if (!Child)
+      continue;
+    size_t ChildEnd = ChildStart + getNodeTextLength(Child->getRaw());
+    if (ChildStart <= Position && Position < ChildEnd)
+      return lookUpFrom(*Child, ChildStart, Position, Kind);
+    ChildStart = ChildEnd;
+  }
+  return llvm::None;
+}
+
+bool SyntaxParsingCache::nodeCanBeReused(const Syntax &Node, size_t NodeStart,
+                                         size_t Position,
+                                         SyntaxKind Kind) const {
+  if (NodeStart != Position)
+    return false;
+  if (Node.getKind() != Kind)
+    return false;
+
+  size_t NodeEnd = NodeStart + getNodeTextLength(Node.getRaw());
+  for (auto &Edit : Edits) {
+    // The lexer and parser may have looked at the character directly after
+    // the node to decide where it ends (e.g. to split or glue operator
+    // tokens), so an edit that merely touches the node's range from either
+    // side still invalidates it.
+    if (Edit.intersectsOrTouchesRange(NodeStart, NodeEnd + 1))
+      return false;
+  }
+  return true;
+}
@@ -288,21 +288,44 @@ static void enumeratePublicSymbolsAndWrite(ModuleDecl *M, FileUnit *singleFile,
                                            StringSet &symbols,
                                            bool hasMultipleIGMs,
                                            llvm::raw_ostream *os,
-                                           StringRef installName) {
+                                           StringRef installName,
+                                           TBDSymbolCache *cache = nullptr) {
   auto isWholeModule = singleFile == nullptr;
   const auto &target = M->getASTContext().LangOpts.Target;
   UniversalLinkageInfo linkInfo(target, hasMultipleIGMs, isWholeModule);
 
-  TBDGenVisitor visitor(symbols, target, linkInfo, M, installName);
+  // Cache entries are enumerated with whole-module linkage, so the cache is
+  // only usable (and only passed in) for whole-module enumeration.
+  assert((!cache || isWholeModule) &&
+         "per-file symbol cache used for a single-file enumeration");
 
   auto visitFile = [&](FileUnit *file) {
+    if (cache) {
+      auto cached = cache->PerFileSymbols.find(file);
+      if (cached != cache->PerFileSymbols.end()) {
+        for (auto &symbol : cached->second)
+          symbols.insert(symbol);
+        return;
+      }
+    }
+
     SmallVector<Decl *, 16> decls;
     file->getTopLevelDecls(decls);
 
+    StringSet fileSymbols;
+    TBDGenVisitor visitor(fileSymbols, target, linkInfo, M, installName);
     visitor.setFileHasEntryPoint(file->hasEntryPoint());
 
     for (auto d : decls)
       visitor.visit(d);
+
+    std::vector<std::string> *entry =
+        cache ? &cache->PerFileSymbols[file] : nullptr;
+    for (auto &symbol : fileSymbols) {
+      symbols.insert(symbol.getKey());
+      if (entry)
+        entry->push_back(symbol.getKey());
+    }
   };
 
   if (singleFile) {
@@ -333,13 +356,14 @@ void swift::enumeratePublicSymbols(FileUnit *file, StringSet &symbols,
                                  hasMultipleIGMs, nullptr, StringRef());
 }
 void swift::enumeratePublicSymbols(ModuleDecl *M, StringSet &symbols,
-                                   bool hasMultipleIGMs) {
+                                   bool hasMultipleIGMs, TBDSymbolCache *cache) {
   enumeratePublicSymbolsAndWrite(M, nullptr, symbols, hasMultipleIGMs, nullptr,
-                                 StringRef());
+                                 StringRef(), cache);
 }
 void swift::writeTBDFile(ModuleDecl *M, llvm::raw_ostream &os,
-                         bool hasMultipleIGMs, StringRef installName) {
+                         bool hasMultipleIGMs, StringRef installName,
+                         TBDSymbolCache *cache) {
   StringSet symbols;
   enumeratePublicSymbolsAndWrite(M, nullptr, symbols, hasMultipleIGMs, &os,
-                                 installName);
+                                 installName, cache);
 }
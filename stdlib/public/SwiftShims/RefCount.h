@@ -183,6 +183,28 @@ typedef InlineRefCountsPlaceholder InlineRefCounts;
 
   DEAD
   The object and its side table are gone.
+
+
+  Atomicity and thread-local objects:
+
+  Every inline operation is an atomic RMW on the refcount word, even for
+  objects that never escape their allocating thread. Biased counting --
+  parking a thread ID in the refcount word and counting non-atomically
+  until some other thread touches the object -- has been considered and
+  rejected for now:
+  * There are no free bits in the 32-bit inline layout to store a bias,
+    and stealing bits from the strong RC would push common objects into
+    side tables.
+  * Every fast path, including ones in fixed-ABI generated code, would
+    need a bias check before the non-atomic path, and the revocation
+    handshake needs either signals or safepoints, neither of which the
+    runtime has.
+  The supported way to elide atomics is static: the SIL optimizer proves
+  an object does not escape its thread and emits calls to the
+  swift_nonatomic_* entry points, which perform the same transitions
+  with non-atomic loads and stores. Measurements motivating cheaper
+  refcounting should therefore first check whether the hot retains are
+  eligible for that analysis rather than dynamic biasing.
 */
 
 namespace swift {
@@ -1297,6 +1319,13 @@ inline uint32_t RefCounts<InlineRefCountBits>::getWeakCount() const;
 template <>
 inline uint32_t RefCounts<SideTableRefCountBits>::getWeakCount() const;
 
+// Declared in swift/Runtime/HeapObject.h, which cannot be included here;
+// see the class-specific operator new below.
+SWIFT_RUNTIME_EXPORT
+void *swift_slowAlloc(size_t bytes, size_t alignMask);
+SWIFT_RUNTIME_EXPORT
+void swift_slowDealloc(void *ptr, size_t bytes, size_t alignMask);
+
 class HeapObjectSideTableEntry {
   // FIXME: does object need to be atomic?
   std::atomic<HeapObject*> object;
@@ -1307,6 +1336,20 @@ class HeapObjectSideTableEntry {
     : object(newObject), refCounts()
   { }
 
+  // Side table entries are created and destroyed on the first-weak-reference
+  // and last-weak-reference paths, which weak-heavy workloads hit from many
+  // threads at once.  Allocate them through the runtime's own allocator,
+  // which serves fixed-size blocks from per-thread caches, instead of
+  // contending the global malloc.  The class is final in practice (nothing
+  // subclasses it), so the deallocating size is statically known.
+  void *operator new(size_t size) {
+    return swift_slowAlloc(size, alignof(HeapObjectSideTableEntry) - 1);
+  }
+  void operator delete(void *p) {
+    swift_slowDealloc(p, sizeof(HeapObjectSideTableEntry),
+                      alignof(HeapObjectSideTableEntry) - 1);
+  }
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Winvalid-offsetof"
   static ptrdiff_t refCountsOffset() {
@@ -75,6 +75,18 @@ HashableConformances;
 template<bool KnownToConformToHashable>
 LLVM_ATTRIBUTE_ALWAYS_INLINE
 static const Metadata *findHashableBaseTypeImpl(const Metadata *type) {
+  // Types that are not classes have no superclass chain to walk: if they
+  // conform to `Hashable` at all, they introduce the conformance
+  // themselves.  Answer without touching the cache, and — when the caller
+  // already knows the type conforms — without the conformance query.
+  // This covers the stdlib value types that dominate AnyHashable use.
+  if (!type->isAnyClass()) {
+    if (!KnownToConformToHashable &&
+        !swift_conformsToProtocol(type, &HashableProtocolDescriptor))
+      return nullptr;
+    return type;
+  }
+
   // Check the cache first.
   if (HashableConformanceEntry *entry =
           HashableConformances.find(HashableConformanceKey{type})) {
@@ -98,8 +110,19 @@ static const Metadata *findHashableBaseTypeImpl(const Metadata *type) {
       break;
     baseTypeThatConformsToHashable = superclass;
   }
-  HashableConformances.getOrInsert(HashableConformanceKey{type},
-                                   baseTypeThatConformsToHashable);
+
+  // Cache the result for every class the walk visited, not just the
+  // query type: every class between `type` and the base shares the same
+  // answer, so a later query for an intermediate class (or for a subclass
+  // whose walk would pass through one) hits the cache instead of redoing
+  // the conformance queries above it.
+  for (const Metadata *visited = type;;
+       visited = _swift_class_getSuperclass(visited)) {
+    HashableConformances.getOrInsert(HashableConformanceKey{visited},
+                                     baseTypeThatConformsToHashable);
+    if (visited == baseTypeThatConformsToHashable)
+      break;
+  }
   return baseTypeThatConformsToHashable;
 }
 
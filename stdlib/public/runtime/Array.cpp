@@ -25,6 +25,7 @@
 #include "swift/Runtime/Config.h"
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Metadata.h"
+#include "Private.h"
 
 using namespace swift;
 
@@ -58,6 +59,16 @@ static void array_pod_copy(ArrayCopy copyKind, OpaqueValue *dest,
   memmove(dest, src, stride * count);
 }
 
+/// Does the element layout consist of a single Swift-native-refcounted
+/// class reference?  Such arrays can be copied as bits plus a batch of
+/// refcount adjustments instead of an indirect witness call per element.
+static bool element_is_native_class_pointer(const Metadata *self) {
+  if (self->getKind() != MetadataKind::Class)
+    return false;
+  auto classMetadata = static_cast<const ClassMetadata *>(self);
+  return usesNativeSwiftReferenceCounting(classMetadata);
+}
+
 namespace {
 typedef OpaqueValue *(*const WitnessFunction)(OpaqueValue *, OpaqueValue *,
                                               const Metadata *);
@@ -108,6 +119,26 @@ static void array_copy_operation(OpaqueValue *dest, OpaqueValue *src,
     }
   }
 
+  // Arrays of Swift-native class references move their bits like POD and
+  // only additionally need the refcounts adjusted, so batch those and
+  // copy the bits in bulk.  Retain the new values before releasing the
+  // old ones in case they overlap.
+  if (element_is_native_class_pointer(self)) {
+    assert(stride == sizeof(HeapObject *));
+    auto destPtrs = reinterpret_cast<HeapObject **>(dest);
+    auto srcPtrs = reinterpret_cast<HeapObject **>(src);
+    if (srcOp == ArraySource::Copy) {
+      for (size_t i = 0; i < count; ++i)
+        swift_retain(srcPtrs[i]);
+    }
+    if (destOp == ArrayDest::Assign) {
+      for (size_t i = 0; i < count; ++i)
+        swift_release(destPtrs[i]);
+    }
+    array_pod_copy(copyKind, dest, src, stride, count);
+    return;
+  }
+
   // Call the witness to do the copy.
   if (copyKind == ArrayCopy::NoAlias || copyKind == ArrayCopy::FrontToBack) {
     auto copy = get_witness_function<destOp, srcOp>(wtable);
@@ -202,6 +233,17 @@ void swift_arrayDestroy(OpaqueValue *begin, size_t count, const Metadata *self)
     return;
 
   auto stride = wtable->getStride();
+
+  // Swift-native class references just need a release per element, not
+  // an indirect witness call.
+  if (element_is_native_class_pointer(self)) {
+    assert(stride == sizeof(HeapObject *));
+    auto objects = reinterpret_cast<HeapObject **>(begin);
+    for (size_t i = 0; i < count; ++i)
+      swift_release(objects[i]);
+    return;
+  }
+
   for (size_t i = 0; i < count; ++i) {
     auto offset = i * stride;
     auto *obj = reinterpret_cast<OpaqueValue *>((char *)begin + offset);
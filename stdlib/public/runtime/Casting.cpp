@@ -24,6 +24,7 @@
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/Lazy.h"
 #include "swift/Demangling/Demangler.h"
+#include "swift/Runtime/Concurrent.h"
 #include "swift/Runtime/Config.h"
 #include "swift/Runtime/Debug.h"
 #include "swift/Runtime/Enum.h"
@@ -254,18 +255,85 @@ static bool _succeed(OpaqueValue *dest, OpaqueValue *src,
   return true;
 }
 
+namespace {
+  /// A memoized class/class cast verdict.  A class's superclass chain is
+  /// immutable once its metadata has been instantiated, so verdicts never
+  /// need to be invalidated, not even when new images are loaded.
+  struct ClassCastCacheEntry {
+  private:
+    const ClassMetadata *Source;
+    const ClassMetadata *Target;
+    bool Success;
+
+  public:
+    struct Key {
+      const ClassMetadata *Source;
+      const ClassMetadata *Target;
+    };
+
+    ClassCastCacheEntry(Key key, bool success)
+      : Source(key.Source), Target(key.Target), Success(success) {}
+
+    bool isSuccessful() const { return Success; }
+
+    int compareWithKey(const Key &key) const {
+      if (key.Source != Source) {
+        return (uintptr_t(key.Source) < uintptr_t(Source) ? -1 : 1);
+      } else if (key.Target != Target) {
+        return (uintptr_t(key.Target) < uintptr_t(Target) ? -1 : 1);
+      } else {
+        return 0;
+      }
+    }
+
+    template <class... T>
+    static size_t getExtraAllocationSize(T &&... ignored) {
+      return 0;
+    }
+  };
+} // end anonymous namespace
+
+/// Memoized (source, target) pairs for class/class casts that were not
+/// decided by the first two levels of the source's superclass chain.
+static ConcurrentMap<ClassCastCacheEntry, /*Destructor*/ false>
+  ClassCastCache;
+
 /// Dynamically cast a class metatype to a Swift class metatype.
 static const ClassMetadata *
 _dynamicCastClassMetatype(const ClassMetadata *sourceType,
                           const ClassMetadata *targetType) {
+  // Casts to the dynamic type itself or its immediate superclass are
+  // common enough, and cheap enough, that they are not worth memoizing.
+  if (sourceType == targetType) {
+    return sourceType;
+  }
+  auto superclass = sourceType->Superclass;
+  if (!superclass) {
+    return nullptr;
+  }
+  if (superclass == targetType) {
+    return targetType;
+  }
+
+  // Deeper walks consult the memo table, so that repeated casts along
+  // deep hierarchies (and repeated failing casts, which walk the whole
+  // chain) are decided by a single lookup.
+  ClassCastCacheEntry::Key key = {sourceType, targetType};
+  if (auto *entry = ClassCastCache.find(key)) {
+    return entry->isSuccessful() ? targetType : nullptr;
+  }
+
+  bool success = false;
   do {
-    if (sourceType == targetType) {
-      return sourceType;
+    superclass = superclass->Superclass;
+    if (superclass == targetType) {
+      success = true;
+      break;
     }
-    sourceType = sourceType->Superclass;
-  } while (sourceType);
-  
-  return nullptr;
+  } while (superclass);
+
+  ClassCastCache.getOrInsert(key, success);
+  return success ? targetType : nullptr;
 }
 
 /// Dynamically cast a class instance to a Swift class type.
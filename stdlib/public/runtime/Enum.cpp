@@ -223,6 +223,13 @@ static void storeMultiPayloadTag(OpaqueValue *value,
                                  MultiPayloadLayout layout,
                                  unsigned tag) {
   auto tagBytes = reinterpret_cast<char *>(value) + layout.payloadSize;
+  // A single tag byte suffices for all but pathologically large enums, so
+  // make that case a plain byte store instead of a size dispatch.  (A one
+  // byte access is the same on either endianness.)
+  if (layout.numTagBytes == 1) {
+    *reinterpret_cast<unsigned char *>(tagBytes) = (unsigned char)tag;
+    return;
+  }
 #if defined(__BIG_ENDIAN__)
   small_memcpy(tagBytes,
                reinterpret_cast<char *>(&tag) + 4 - layout.numTagBytes,
@@ -264,6 +271,11 @@ static unsigned loadMultiPayloadTag(const OpaqueValue *value,
                                     MultiPayloadLayout layout) {
   auto tagBytes = reinterpret_cast<const char *>(value) + layout.payloadSize;
 
+  // See storeMultiPayloadTag: a one-byte tag is the common layout, and a
+  // byte load needs no size dispatch or byte-order adjustment.
+  if (layout.numTagBytes == 1)
+    return *reinterpret_cast<const unsigned char *>(tagBytes);
+
   unsigned tag = 0;
 #if defined(__BIG_ENDIAN__)
   small_memcpy(reinterpret_cast<char *>(&tag) + 4 - layout.numTagBytes,
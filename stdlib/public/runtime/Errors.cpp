@@ -200,6 +200,60 @@ void swift::printCurrentBacktrace(unsigned framesToSkip) {
 #endif
 }
 
+#if SWIFT_SUPPORTS_BACKTRACE_REPORTING
+/// Print one raw stack trace entry: the frame PC and its offset within
+/// the containing image.  Unlike dumpStackTraceEntry this does no
+/// demangling and allocates nothing, so it is cheap enough to always run
+/// before symbolication, and the output can be symbolicated offline from
+/// the images' symbol tables.
+static void dumpRawStackTraceEntry(unsigned index, void *framePC) {
+  SymbolInfo syminfo;
+  if (lookupSymbol(framePC, &syminfo) != 0 && syminfo.fileName) {
+    StringRef libraryName = StringRef(syminfo.fileName).rsplit('/').second;
+    fprintf(stderr, "%-4u 0x%0.16tx %s + %td\n", index, uintptr_t(framePC),
+            libraryName.data(),
+            ptrdiff_t(uintptr_t(framePC) - uintptr_t(syminfo.baseAddress)));
+  } else {
+    fprintf(stderr, "%-4u 0x%0.16tx\n", index, uintptr_t(framePC));
+  }
+}
+
+/// Whether fatal-error reporting should symbolicate the backtrace
+/// inline.  Symbolication demangles every frame and is orders of
+/// magnitude slower than the raw dump; crash watchdogs with short
+/// timeouts can set SWIFT_RUNTIME_SYMBOLICATE_BACKTRACE=0 to get only
+/// the raw dump and symbolicate server-side.
+static bool shouldSymbolicateBacktrace() {
+  const char *env = getenv("SWIFT_RUNTIME_SYMBOLICATE_BACKTRACE");
+  return !(env && env[0] == '0' && env[1] == '\0');
+}
+
+/// Report the current backtrace for a fatal error: first a raw frame
+/// dump, flushed so that it survives even if the process is killed
+/// mid-symbolication, then the symbolicated trace unless it is disabled.
+LLVM_ATTRIBUTE_NOINLINE
+static void printCurrentBacktraceForFatalError(unsigned framesToSkip = 1) {
+  constexpr unsigned maxSupportedStackDepth = 128;
+  void *addrs[maxSupportedStackDepth];
+
+  int symbolCount = backtrace(addrs, maxSupportedStackDepth);
+
+  fputs("Current stack trace:\n", stderr);
+  for (int i = framesToSkip; i < symbolCount; ++i) {
+    dumpRawStackTraceEntry(i - framesToSkip, addrs[i]);
+  }
+  fflush(stderr);
+
+  if (!shouldSymbolicateBacktrace())
+    return;
+
+  fputs("Symbolicated stack trace:\n", stderr);
+  for (int i = framesToSkip; i < symbolCount; ++i) {
+    dumpStackTraceEntry(i - framesToSkip, addrs[i]);
+  }
+}
+#endif
+
 #ifdef SWIFT_HAVE_CRASHREPORTERCLIENT
 #include <malloc/malloc.h>
 
@@ -268,8 +322,7 @@ reportNow(uint32_t flags, const char *message)
 #endif
 #if SWIFT_SUPPORTS_BACKTRACE_REPORTING
   if (flags & FatalErrorFlags::ReportBacktrace) {
-    fputs("Current stack trace:\n", stderr);
-    printCurrentBacktrace();
+    printCurrentBacktraceForFatalError();
   }
 #endif
 }
@@ -182,16 +182,34 @@ static_assert(sizeof(Access) <= sizeof(ValueBuffer) &&
               alignof(Access) <= alignof(ValueBuffer),
               "Access doesn't fit in a value buffer!");
 
-/// A set of accesses that we're tracking.  Just a singly-linked list.
+/// A set of accesses that we're tracking.  Accesses are hashed into
+/// buckets by the accessed pointer and chained through their
+/// NextAndAction field, so the cost of beginning or ending an access is
+/// proportional to the number of live accesses in one bucket rather
+/// than to all of them.  Code with deep recursion through access
+/// markers used to degrade quadratically on the old single-list
+/// representation.
 class AccessSet {
-  Access *Head = nullptr;
+  enum : size_t { NumBuckets = 64 };
+  Access *Buckets[NumBuckets];
+
+  static size_t bucketForPointer(void *pointer) {
+    // Accessed values are at least word-aligned, so drop the low bits
+    // that are mostly zero before mixing.
+    uintptr_t value = reinterpret_cast<uintptr_t>(pointer) >> 4;
+    value *= (sizeof(uintptr_t) == 8 ? (uintptr_t)0x9E3779B97F4A7C15ULL
+                                     : (uintptr_t)0x9E3779B9U);
+    return value % NumBuckets;
+  }
+
 public:
-  constexpr AccessSet() {}
+  constexpr AccessSet() : Buckets{} {}
 
   void insert(Access *access, void *pc, void *pointer, ExclusivityFlags flags) {
     auto action = getAccessAction(flags);
+    Access *&head = Buckets[bucketForPointer(pointer)];
 
-    for (Access *cur = Head; cur != nullptr; cur = cur->getNext()) {
+    for (Access *cur = head; cur != nullptr; cur = cur->getNext()) {
       // Ignore accesses to different values.
       if (cur->Pointer != pointer)
         continue;
@@ -209,16 +227,18 @@ public:
       break;
     }
 
-    // Insert to the front of the array so that remove tends to find it faster.
-    access->initialize(pc, pointer, Head, action);
-    Head = access;
+    // Insert to the front of the bucket so that remove tends to find it
+    // faster.
+    access->initialize(pc, pointer, head, action);
+    head = access;
   }
 
   void remove(Access *access) {
-    auto cur = Head;
+    Access *&head = Buckets[bucketForPointer(access->Pointer)];
+    auto cur = head;
     // Fast path: stack discipline.
     if (cur == access) {
-      Head = cur->getNext();
+      head = cur->getNext();
       return;
     }
 
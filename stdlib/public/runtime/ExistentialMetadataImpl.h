@@ -31,6 +31,16 @@ struct LLVM_LIBRARY_VISIBILITY ExistentialBoxBase {
 
 /// A common base class for fixed and non-fixed opaque-existential box
 /// implementations.
+///
+/// Note that the isValueInline() branches below cannot be hoisted into
+/// separately specialized witness tables selected when the existential's
+/// metadata is built: whether a value is stored inline depends on the
+/// layout of the type *contained* in the existential, which varies from
+/// value to value, while the witness table is a property of the
+/// existential type itself.  The specialization that is possible at
+/// metadata-construction time — on the number of protocol witness tables
+/// in the container — already happens; see the fixed boxes below and
+/// getOpaqueExistentialValueWitnesses() in Metadata.cpp.
 struct LLVM_LIBRARY_VISIBILITY OpaqueExistentialBoxBase
     : ExistentialBoxBase<OpaqueExistentialBoxBase> {
   template <class Container, class... A>
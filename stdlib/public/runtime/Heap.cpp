@@ -17,8 +17,11 @@
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Heap.h"
 #include "Private.h"
+#include "swift/Basic/Lazy.h"
 #include "swift/Runtime/Debug.h"
+#include "swift/Runtime/Mutex.h"
 #include <algorithm>
+#include <cstring>
 #include <stdlib.h>
 
 using namespace swift;
@@ -50,9 +53,190 @@ using namespace swift;
 
 
 
+// A size-classed per-thread magazine allocator for small Swift heap
+// allocations.  Every caller of swift_slowDealloc knows the allocated size
+// statically, so small blocks can be recycled on free lists without any
+// per-block metadata: each thread keeps a magazine (an unlocked singly
+// linked free list) per size class and exchanges batches of blocks with a
+// global depot when a magazine runs empty or overfills.  Memory acquired
+// for the pool is carved out of large malloc chunks and stays in the pool;
+// it is never handed back to malloc, so a block must be freed with
+// swift_slowDealloc and the same size it was allocated with, which is
+// already the contract of these entry points.
+//
+// Define SWIFT_RUNTIME_NO_OBJECT_MAGAZINES to route everything straight to
+// malloc, e.g. when running under heap-analysis tools that want to see
+// every object as its own malloc block.
+
+#if defined(SWIFT_RUNTIME_NO_OBJECT_MAGAZINES)
+#define SWIFT_RUNTIME_USE_OBJECT_MAGAZINES 0
+#elif __clang__ && !__has_feature(cxx_thread_local)
+// clang without thread_local support; there is no way to spill the
+// magazines when a thread exits, so don't pool.
+#define SWIFT_RUNTIME_USE_OBJECT_MAGAZINES 0
+#else
+#define SWIFT_RUNTIME_USE_OBJECT_MAGAZINES 1
+#endif
+
+#if SWIFT_RUNTIME_USE_OBJECT_MAGAZINES
+
+namespace {
+
+/// Blocks are grouped into size classes this many bytes apart.  Sixteen
+/// keeps every class at least malloc-aligned on all supported platforms.
+constexpr size_t MagazineQuantum = 16;
+
+/// The largest block size served from the pool.  Beyond this, malloc's own
+/// metadata overhead is proportionally small and the pool stops paying.
+constexpr size_t MagazineMaxSize = 256;
+
+constexpr size_t MagazineNumSizeClasses = MagazineMaxSize / MagazineQuantum;
+
+/// The number of blocks moved between a thread magazine and the depot at
+/// a time, and the number carved out of a fresh chunk.
+constexpr size_t MagazineBatchSize = 32;
+
+/// A magazine holds more than this many blocks only transiently; the
+/// excess is returned to the depot in batches.
+constexpr size_t MagazineFullCount = 2 * MagazineBatchSize;
+
+/// Return the size class for an eligible size, counting from zero.
+static size_t magazineSizeClass(size_t size) {
+  assert(size > 0 && size <= MagazineMaxSize);
+  return (size + MagazineQuantum - 1) / MagazineQuantum - 1;
+}
+
+/// A free block's first word links to the next free block of its class.
+static void *&nextFreeBlock(void *block) {
+  return *reinterpret_cast<void **>(block);
+}
+
+/// The global depot: per-class free lists that thread magazines refill
+/// from and spill to in batches, under a lock.
+struct MagazineDepot {
+  Mutex Lock;
+  void *Heads[MagazineNumSizeClasses];
+  size_t Counts[MagazineNumSizeClasses];
+
+  MagazineDepot() {
+    memset(Heads, 0, sizeof(Heads));
+    memset(Counts, 0, sizeof(Counts));
+  }
+
+  /// Move up to MagazineBatchSize blocks of the given class to \p head,
+  /// allocating a fresh chunk from malloc if the depot is empty.
+  /// Returns the number of blocks supplied.
+  size_t refill(size_t sizeClass, void *&head) {
+    {
+      ScopedLock guard(Lock);
+      if (Counts[sizeClass] > 0) {
+        size_t supplied = 0;
+        void *block = Heads[sizeClass];
+        head = block;
+        void *last = nullptr;
+        while (block && supplied < MagazineBatchSize) {
+          last = block;
+          block = nextFreeBlock(block);
+          ++supplied;
+        }
+        nextFreeBlock(last) = nullptr;
+        Heads[sizeClass] = block;
+        Counts[sizeClass] -= supplied;
+        return supplied;
+      }
+    }
+
+    // Carve a batch out of a fresh chunk.  The chunk belongs to the pool
+    // from here on; blocks from it are never passed back to free().
+    size_t blockSize = (sizeClass + 1) * MagazineQuantum;
+    char *chunk = reinterpret_cast<char *>(
+        malloc(blockSize * MagazineBatchSize));
+    if (!chunk) swift::crash("Could not allocate memory.");
+    for (size_t i = 0; i + 1 < MagazineBatchSize; ++i) {
+      nextFreeBlock(chunk + i * blockSize) = chunk + (i + 1) * blockSize;
+    }
+    nextFreeBlock(chunk + (MagazineBatchSize - 1) * blockSize) = nullptr;
+    head = chunk;
+    return MagazineBatchSize;
+  }
+
+  /// Accept a chain of \p count blocks of the given class.
+  void spill(size_t sizeClass, void *head, void *tail, size_t count) {
+    ScopedLock guard(Lock);
+    nextFreeBlock(tail) = Heads[sizeClass];
+    Heads[sizeClass] = head;
+    Counts[sizeClass] += count;
+  }
+};
+
+static Lazy<MagazineDepot> TheMagazineDepot;
+
+/// A thread's magazines, one free list per size class.  Destruction
+/// spills everything back to the depot when the thread exits.
+struct ThreadMagazines {
+  void *Heads[MagazineNumSizeClasses] = {};
+  size_t Counts[MagazineNumSizeClasses] = {};
+
+  void *alloc(size_t sizeClass) {
+    if (!Heads[sizeClass]) {
+      Counts[sizeClass] =
+        TheMagazineDepot.get().refill(sizeClass, Heads[sizeClass]);
+    }
+    void *block = Heads[sizeClass];
+    Heads[sizeClass] = nextFreeBlock(block);
+    --Counts[sizeClass];
+    return block;
+  }
+
+  void dealloc(void *block, size_t sizeClass) {
+    nextFreeBlock(block) = Heads[sizeClass];
+    Heads[sizeClass] = block;
+    if (++Counts[sizeClass] >= MagazineFullCount) {
+      // Return a batch, keeping the most recently freed (cache-warm)
+      // blocks here.
+      void *head = Heads[sizeClass];
+      void *tail = head;
+      for (size_t i = 1; i < MagazineBatchSize; ++i)
+        tail = nextFreeBlock(tail);
+      Heads[sizeClass] = nextFreeBlock(tail);
+      Counts[sizeClass] -= MagazineBatchSize;
+      TheMagazineDepot.get().spill(sizeClass, head, tail, MagazineBatchSize);
+    }
+  }
+
+  ~ThreadMagazines() {
+    for (size_t sizeClass = 0; sizeClass < MagazineNumSizeClasses;
+         ++sizeClass) {
+      if (void *head = Heads[sizeClass]) {
+        void *tail = head;
+        while (nextFreeBlock(tail))
+          tail = nextFreeBlock(tail);
+        TheMagazineDepot.get().spill(sizeClass, head, tail,
+                                     Counts[sizeClass]);
+      }
+      // The depot owns the chains now.  A TLS destructor that runs after
+      // this one may still allocate through the dead magazines; clearing
+      // the lists makes such calls refill from the depot instead of
+      // handing out blocks twice.
+      Heads[sizeClass] = nullptr;
+      Counts[sizeClass] = 0;
+    }
+  }
+};
+
+static thread_local ThreadMagazines TheThreadMagazines;
+
+} // end anonymous namespace
+
+#endif // SWIFT_RUNTIME_USE_OBJECT_MAGAZINES
+
 void *swift::swift_slowAlloc(size_t size, size_t alignMask) {
   void *p;
   if (alignMask <= MALLOC_ALIGN_MASK) {
+#if SWIFT_RUNTIME_USE_OBJECT_MAGAZINES
+    if (size > 0 && size <= MagazineMaxSize)
+      return TheThreadMagazines.alloc(magazineSizeClass(size));
+#endif
     p = malloc(size);
   } else {
     p = AlignedAlloc(size, alignMask + 1);
@@ -63,6 +247,12 @@ void *swift::swift_slowAlloc(size_t size, size_t alignMask) {
 
 void swift::swift_slowDealloc(void *ptr, size_t bytes, size_t alignMask) {
   if (alignMask <= MALLOC_ALIGN_MASK) {
+#if SWIFT_RUNTIME_USE_OBJECT_MAGAZINES
+    if (bytes > 0 && bytes <= MagazineMaxSize) {
+      TheThreadMagazines.dealloc(ptr, magazineSizeClass(bytes));
+      return;
+    }
+#endif
     free(ptr);
   } else {
     AlignedFree(ptr);
@@ -70,6 +70,136 @@ static inline bool isValidPointerForNativeRetain(const void *p) {
 #endif
 }
 
+// Sampling heap profiler ----------------------------------------------------
+//
+// When the SWIFT_ALLOC_SAMPLE_RATE environment variable is set to N, every
+// Nth call to swift_allocObject on each thread records (type metadata, size,
+// backtrace) into a fixed ring of samples, so heap growth can be attributed
+// by type in production without attaching a profiler.  Recording is
+// lock-free: each sample claims its slot with an atomic increment.  The
+// ring is dumped to stderr by sending the process the signal numbered in
+// SWIFT_ALLOC_SAMPLE_SIGNAL, or by calling _swift_dumpHeapProfilerSamples
+// from a debugger.  The signal handler only sets a flag; the dump itself
+// runs from the next sampling thread, so nothing async-signal-unsafe
+// happens in the handler.  When the rate is unset, the allocation path
+// pays a single load and branch.
+
+#if defined(__CYGWIN__) || defined(__ANDROID__) || defined(_WIN32) || defined(__HAIKU__)
+#  define SWIFT_RUNTIME_HEAP_PROFILER_BACKTRACE 0
+#else
+#  define SWIFT_RUNTIME_HEAP_PROFILER_BACKTRACE 1
+#  include <execinfo.h>
+#endif
+
+#include <atomic>
+#include <csignal>
+
+namespace {
+
+/// One sampled allocation.
+struct HeapProfilerSample {
+  enum : unsigned { MaxFrames = 8 };
+  const HeapMetadata *Metadata;
+  size_t Size;
+  unsigned NumFrames;
+  void *Frames[MaxFrames];
+};
+
+/// A fixed ring of the most recent samples.  Slots are overwritten on
+/// wrap-around, and a dump may read a slot that is concurrently being
+/// rewritten; both are acceptable for a profiler.
+struct HeapProfilerState {
+  enum : uint32_t { Capacity = 4096 };
+  std::atomic<uint64_t> SampleCount{0};
+  HeapProfilerSample Samples[Capacity];
+};
+
+} // end anonymous namespace
+
+/// Created on first use if profiling is enabled; never freed.
+static HeapProfilerState *HeapProfiler = nullptr;
+static std::atomic<bool> HeapProfilerDumpRequested{false};
+
+/// Counts allocations on the current thread until the next sample.
+static LLVM_THREAD_LOCAL uint32_t HeapProfilerCountdown = 0;
+
+SWIFT_RUNTIME_EXPORT
+void _swift_dumpHeapProfilerSamples();
+
+static void heapProfilerDumpSignalHandler(int signal) {
+  HeapProfilerDumpRequested.store(true, std::memory_order_relaxed);
+}
+
+/// Return the allocations-per-sample interval, or 0 when profiling is
+/// disabled.  The first call reads the environment and, if profiling is
+/// enabled, creates the sample ring and installs the dump signal handler.
+static uint32_t getHeapProfilerInterval() {
+  static uint32_t interval = []() -> uint32_t {
+    const char *rate = getenv("SWIFT_ALLOC_SAMPLE_RATE");
+    if (!rate)
+      return 0;
+    long parsed = strtol(rate, nullptr, 0);
+    if (parsed <= 0)
+      return 0;
+    HeapProfiler = new HeapProfilerState();
+    if (const char *signalName = getenv("SWIFT_ALLOC_SAMPLE_SIGNAL")) {
+      long signo = strtol(signalName, nullptr, 0);
+      if (signo > 0)
+        signal((int)signo, heapProfilerDumpSignalHandler);
+    }
+    return (uint32_t)parsed;
+  }();
+  return interval;
+}
+
+LLVM_ATTRIBUTE_NOINLINE
+static void recordHeapProfilerSample(const HeapMetadata *metadata,
+                                     size_t size) {
+  auto *state = HeapProfiler;
+  auto index = state->SampleCount.fetch_add(1, std::memory_order_relaxed);
+  auto &sample = state->Samples[index % HeapProfilerState::Capacity];
+  sample.Metadata = metadata;
+  sample.Size = size;
+#if SWIFT_RUNTIME_HEAP_PROFILER_BACKTRACE
+  // Capture two extra frames and drop them: this function and the
+  // allocation entry point.
+  void *frames[HeapProfilerSample::MaxFrames + 2];
+  int numFrames = backtrace(frames, HeapProfilerSample::MaxFrames + 2);
+  unsigned framesToSkip = numFrames > 2 ? 2 : 0;
+  sample.NumFrames = (unsigned)numFrames - framesToSkip;
+  memcpy(sample.Frames, frames + framesToSkip,
+         sample.NumFrames * sizeof(void *));
+#else
+  sample.NumFrames = 0;
+#endif
+
+  if (HeapProfilerDumpRequested.exchange(false, std::memory_order_relaxed))
+    _swift_dumpHeapProfilerSamples();
+}
+
+/// Dump the sampled allocations to stderr, oldest retained sample first.
+SWIFT_RUNTIME_EXPORT
+void _swift_dumpHeapProfilerSamples() {
+  auto *state = HeapProfiler;
+  if (!state)
+    return;
+  uint64_t end = state->SampleCount.load(std::memory_order_relaxed);
+  uint64_t begin = end > HeapProfilerState::Capacity
+                       ? end - HeapProfilerState::Capacity
+                       : 0;
+  fprintf(stderr, "Swift heap samples (%llu of %llu retained):\n",
+          (unsigned long long)(end - begin), (unsigned long long)end);
+  for (uint64_t i = begin; i != end; ++i) {
+    auto &sample = state->Samples[i % HeapProfilerState::Capacity];
+    auto typeName = swift_getTypeName(
+        static_cast<const Metadata *>(sample.Metadata), /*qualified=*/true);
+    fprintf(stderr, "  %6zu bytes  %s\n", sample.Size, typeName.data);
+    for (unsigned frame = 0; frame != sample.NumFrames; ++frame)
+      fprintf(stderr, "      %p\n", sample.Frames[frame]);
+  }
+  fflush(stderr);
+}
+
 HeapObject *swift::swift_allocObject(HeapMetadata const *metadata,
                                      size_t requiredSize,
                                      size_t requiredAlignmentMask) {
@@ -91,6 +221,14 @@ static HeapObject *_swift_allocObject_(HeapMetadata const *metadata,
 
   SWIFT_RT_TRACK_INVOCATION(object, swift_allocObject);
 
+  // If heap sampling is enabled, maybe record this allocation.
+  if (auto interval = getHeapProfilerInterval()) {
+    if (++HeapProfilerCountdown >= interval) {
+      HeapProfilerCountdown = 0;
+      recordHeapProfilerSample(metadata, requiredSize);
+    }
+  }
+
   return object;
 }
 
@@ -235,6 +373,9 @@ BoxPair swift::swift_allocBox(const Metadata *type) {
   auto metadata = &Boxes.getOrInsert(type).first->Data;
 
   // Allocate and project the box.
+  // This counter measures, among other things, how often opaque
+  // existentials spill their payloads out of line.
+  SWIFT_RT_TRACK_INVOCATION(nullptr, swift_allocBox);
   auto allocation = swift_allocObject(metadata, metadata->getAllocSize(),
                                       metadata->getAllocAlignMask());
   auto projection = metadata->project(allocation);
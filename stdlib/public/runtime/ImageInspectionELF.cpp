@@ -22,7 +22,12 @@
 
 #include "ImageInspection.h"
 #include "ImageInspectionELF.h"
+#include "swift/Basic/Lazy.h"
+#include "swift/Runtime/Mutex.h"
+#include <algorithm>
 #include <dlfcn.h>
+#include <link.h>
+#include <vector>
 
 using namespace swift;
 
@@ -40,6 +45,102 @@ void record(const swift::MetadataSections *sections) {
     registered->prev = sections;
   }
 }
+
+/// The address span and identity of one registered Swift image, covering
+/// all of its PT_LOAD segments.  Swift images cannot be unloaded (their
+/// metadata is registered by address), so the entries and the loader-owned
+/// name strings stay valid forever.
+struct ImageRange {
+  uintptr_t start;
+  uintptr_t end;
+  const char *name;
+  void *baseAddress;
+};
+
+struct ImageRangeComparator {
+  bool operator()(const ImageRange &lhs, const ImageRange &rhs) const {
+    return lhs.start < rhs.start;
+  }
+};
+
+/// All registered image ranges, sorted by start address.  Built up once
+/// per image as images announce themselves; queried with a binary search.
+struct ImageRangeState {
+  ReadWriteLock Lock;
+  std::vector<ImageRange> Ranges;
+};
+static Lazy<ImageRangeState> ImageRanges;
+
+struct ImageRangeSearch {
+  uintptr_t address;
+  ImageRange range;
+  bool found;
+};
+
+/// dl_iterate_phdr callback: find the image whose PT_LOAD segments contain
+/// the searched address and record their overall span.
+int findImageContainingAddress(struct dl_phdr_info *info, size_t size,
+                               void *data) {
+  auto &search = *static_cast<ImageRangeSearch *>(data);
+  uintptr_t base = info->dlpi_addr;
+  uintptr_t lowest = UINTPTR_MAX, highest = 0;
+  bool contains = false;
+  for (int i = 0; i < info->dlpi_phnum; ++i) {
+    auto &phdr = info->dlpi_phdr[i];
+    if (phdr.p_type != PT_LOAD)
+      continue;
+    uintptr_t segmentStart = base + phdr.p_vaddr;
+    uintptr_t segmentEnd = segmentStart + phdr.p_memsz;
+    lowest = std::min(lowest, segmentStart);
+    highest = std::max(highest, segmentEnd);
+    if (search.address >= segmentStart && search.address < segmentEnd)
+      contains = true;
+  }
+  if (!contains)
+    return 0;
+  search.range = {lowest, highest, info->dlpi_name,
+                  reinterpret_cast<void *>(base)};
+  search.found = true;
+  return 1;
+}
+
+/// Record the address range of the image containing the given address,
+/// iterating the loader's image list once.
+void registerImageContainingAddress(const void *address) {
+  ImageRangeSearch search;
+  search.address = reinterpret_cast<uintptr_t>(address);
+  search.found = false;
+  dl_iterate_phdr(findImageContainingAddress, &search);
+  if (!search.found)
+    return;
+
+  auto &state = ImageRanges.get();
+  ScopedWriteLock guard(state.Lock);
+  auto position = std::lower_bound(state.Ranges.begin(), state.Ranges.end(),
+                                   search.range, ImageRangeComparator());
+  // An image announces itself only once, but be idempotent anyway.
+  if (position != state.Ranges.end() && position->start == search.range.start)
+    return;
+  state.Ranges.insert(position, search.range);
+}
+
+/// Find the registered image containing the given address with a binary
+/// search.  Returns the entry by value because the table can grow.
+bool findRegisteredImage(const void *address, ImageRange &result) {
+  uintptr_t value = reinterpret_cast<uintptr_t>(address);
+  auto &state = ImageRanges.get();
+  ScopedReadLock guard(state.Lock);
+  ImageRange key = {value, 0, nullptr, nullptr};
+  auto position = std::upper_bound(state.Ranges.begin(), state.Ranges.end(),
+                                   key, ImageRangeComparator());
+  if (position == state.Ranges.begin())
+    return false;
+  --position;
+  if (value >= position->end)
+    return false;
+  result = *position;
+  return true;
+}
 }
 
 void swift::initializeProtocolLookup() {
@@ -110,6 +211,7 @@ void swift_addNewDSOImage(const void *addr) {
       static_cast<const swift::MetadataSections *>(addr);
 
   record(sections);
+  registerImageContainingAddress(addr);
 
   const auto &protocols_section = sections->swift5_protocol_conformances;
   const void *protocols =
@@ -133,7 +235,20 @@ void swift_addNewDSOImage(const void *addr) {
 int swift::lookupSymbol(const void *address, SymbolInfo *info) {
   Dl_info dlinfo;
   if (dladdr(address, &dlinfo) == 0) {
-    return 0;
+    // dladdr answers by iterating the loader's image list and can fail
+    // outright for addresses it cannot attribute (notably in statically
+    // linked executables).  The image registry built up in
+    // swift_addNewDSOImage can still attribute the address to a Swift
+    // image with a binary search; only the symbol-level fields, which
+    // require the image's symbol table, stay unknown.
+    ImageRange image;
+    if (!findRegisteredImage(address, image))
+      return 0;
+    info->fileName = image.name;
+    info->baseAddress = image.baseAddress;
+    info->symbolName = nullptr;
+    info->symbolAddress = nullptr;
+    return 1;
   }
 
   info->fileName = dlinfo.dli_fname;
@@ -460,6 +460,22 @@ swift::swift_allocateGenericValueMetadata(const ValueTypeDescriptor *description
 }
 
 /// The primary entrypoint.
+///
+/// Note on statically pre-instantiated metadata: it is tempting to have
+/// IRGen emit fully-instantiated metadata for common instantiations
+/// (Array<Int> and the like) and have this function consult them before
+/// instantiating, since launch traces show many instantiations happening
+/// before main.  That cannot be bolted on here: cached metadata must be
+/// preceded in memory by a GenericCacheEntry header (see getFromMetadata
+/// above, which recovers the entry by fixed arithmetic from the address
+/// point), and that header's layout — including the cache's key storage —
+/// is private to the runtime and free to change.  Emitting it from the
+/// compiler would freeze it into the ABI.  Pre-instantiation therefore
+/// needs its own compiler-to-runtime contract (a separate section of
+/// instantiation records consulted on the cache-miss path), which is a
+/// coordinated ABI addition, not a local change.  Until then, the miss
+/// path below is the only way metadata is created, and the hit path is a
+/// lock-free cache lookup.
 const Metadata *
 swift::swift_getGenericMetadata(const TypeContextDescriptor *description,
                                 const void *arguments) {
@@ -257,17 +257,36 @@ template <class ValueTy> class MetadataCache {
     }
   };
 
-  /// The concurrent map.
-  ConcurrentMap<Entry, /*Destructor*/ false, MetadataAllocator> Map;
+  /// The number of shards the cache is split into.  Each shard has its
+  /// own map and its own in-flight lock, so threads instantiating
+  /// different keys mostly touch disjoint cache lines instead of
+  /// serializing on one tree root and one mutex.
+  ///
+  /// Must be a power of two.  Don't raise this casually: the inline
+  /// portion of the cache has to stay small enough that a Lazy<> wrapper
+  /// around it still fits in GenericMetadataInstantiationCache's
+  /// PrivateData (see the static_asserts in Metadata.cpp).
+  enum : size_t { NumShards = 4 };
+
+  /// The concurrent maps, sharded by key hash.
+  ConcurrentMap<Entry, /*Destructor*/ false, MetadataAllocator>
+    Shards[NumShards];
 
   struct ConcurrencyControl {
     Mutex Lock;
     ConditionVariable Queue;
   };
-  std::unique_ptr<ConcurrencyControl> Concurrency;
+  std::unique_ptr<ConcurrencyControl[]> Concurrency;
+
+  static size_t shardIndexForHash(size_t hash) {
+    // The hash is well-mixed by KeyDataRef::hash(), so the low bits are
+    // as good as any.  Entries within a shard are still ordered by the
+    // full hash.
+    return hash & (NumShards - 1);
+  }
 
 public:
-  MetadataCache() : Concurrency(new ConcurrencyControl()) {}
+  MetadataCache() : Concurrency(new ConcurrencyControl[NumShards]) {}
   ~MetadataCache() = default;
 
   /// Caches are not copyable.
@@ -277,7 +296,7 @@ public:
   /// Get the allocator for metadata in this cache.
   /// The allocator can only be safely used while the cache is locked during
   /// an addMetadataEntry call.
-  MetadataAllocator &getAllocator() { return Map.getAllocator(); }
+  MetadataAllocator &getAllocator() { return Shards[0].getAllocator(); }
 
   /// Look up a cached metadata entry. If a cache match exists, return it.
   /// Otherwise, call entryBuilder() and add that to the cache.
@@ -299,8 +318,13 @@ public:
            ValueTy::getName(), this, key.Hash);
 #endif
 
+    // Pick the shard responsible for this key.  All operations on this
+    // key, including the in-flight wait below, stay within the shard.
+    size_t shardIndex = shardIndexForHash(key.Hash);
+    auto &map = Shards[shardIndex];
+
     // Ensure the existence of a map entry.
-    auto insertResult = Map.getOrInsert(key);
+    auto insertResult = map.getOrInsert(key);
     Entry *entry = insertResult.first;
 
     // If we didn't insert the entry, then we just need to get the
@@ -316,7 +340,7 @@ public:
       // Otherwise, we have to grab the lock and wait for the value to
       // appear there.  Note that we have to check again immediately
       // after acquiring the lock to prevent a race.
-      auto concurrency = Concurrency.get();
+      auto concurrency = &Concurrency[shardIndex];
       concurrency->Lock.withLockOrWait(concurrency->Queue, [&, this] {
         if ((value = entry->getValue())) {
           return true; // found a value, done waiting
@@ -348,7 +372,7 @@ public:
 #endif
 
     // Acquire the lock, set the value, and notify any waiters.
-    auto concurrency = Concurrency.get();
+    auto concurrency = &Concurrency[shardIndex];
     concurrency->Lock.withLockThenNotifyAll(
         concurrency->Queue, [&entry, &value] { entry->setValue(value); });
 
@@ -32,7 +32,9 @@
 #include "llvm/ADT/StringExtras.h"
 #include "Private.h"
 #include "ImageInspection.h"
+#include <algorithm>
 #include <functional>
+#include <new>
 #include <vector>
 #include <list>
 
@@ -70,26 +72,95 @@ static Demangler getDemanglerForRuntimeTypeResolution() {
 namespace {
   struct TypeMetadataSection {
     const TypeMetadataRecord *Begin, *End;
+
+    /// An entry in the per-section name index: a type context descriptor
+    /// keyed by its identifier (which lives in the image, so no copy is
+    /// needed).
+    typedef std::pair<llvm::StringRef, const TypeContextDescriptor *>
+      IndexEntry;
+
+    /// This section's type context descriptors, sorted by identifier.
+    /// Built lazily, under SectionsToScanLock, the first time the
+    /// section is searched; afterwards a lookup that names a nominal
+    /// type binary-searches the index instead of matching the mangling
+    /// against every record in the section.
+    std::vector<IndexEntry> NameIndex;
+    bool NameIndexBuilt;
+
+    TypeMetadataSection(const TypeMetadataRecord *begin,
+                        const TypeMetadataRecord *end)
+      : Begin(begin), End(end), NameIndexBuilt(false) {}
+
     const TypeMetadataRecord *begin() const {
       return Begin;
     }
     const TypeMetadataRecord *end() const {
       return End;
     }
+
+    struct IndexEntryComparator {
+      bool operator()(const IndexEntry &lhs, llvm::StringRef rhs) const {
+        return lhs.first < rhs;
+      }
+      bool operator()(llvm::StringRef lhs, const IndexEntry &rhs) const {
+        return lhs < rhs.first;
+      }
+      bool operator()(const IndexEntry &lhs, const IndexEntry &rhs) const {
+        return lhs.first < rhs.first;
+      }
+    };
+
+    /// Return the range of index entries for descriptors named \p name.
+    /// Builds the index on first use; the caller must hold
+    /// SectionsToScanLock.
+    std::pair<std::vector<IndexEntry>::const_iterator,
+              std::vector<IndexEntry>::const_iterator>
+    getRecordsWithName(llvm::StringRef name) {
+      if (!NameIndexBuilt) {
+        NameIndex.reserve(End - Begin);
+        for (const auto &record : *this) {
+          if (auto ntd = record.getTypeContextDescriptor())
+            NameIndex.push_back(IndexEntry(ntd->Name.get(), ntd));
+        }
+        std::sort(NameIndex.begin(), NameIndex.end(), IndexEntryComparator());
+        NameIndexBuilt = true;
+      }
+      return std::equal_range(NameIndex.begin(), NameIndex.end(),
+                              name, IndexEntryComparator());
+    }
   };
 
   struct NominalTypeDescriptorCacheEntry {
   private:
     std::string Name;
-    const TypeContextDescriptor *Description;
+    std::atomic<const TypeContextDescriptor *> Description;
+    std::atomic<uintptr_t> FailureGeneration;
 
   public:
     NominalTypeDescriptorCacheEntry(const llvm::StringRef name,
-                                    const TypeContextDescriptor *description)
-      : Name(name.str()), Description(description) {}
+                                    const TypeContextDescriptor *description,
+                                    uintptr_t failureGeneration)
+      : Name(name.str()), Description(description),
+        FailureGeneration(failureGeneration) {}
+
+    /// Get the cached descriptor, or null if this is a negative entry.
+    const TypeContextDescriptor *getDescription() const {
+      return Description.load(std::memory_order_acquire);
+    }
+
+    void makeSuccessful(const TypeContextDescriptor *description) {
+      Description.store(description, std::memory_order_release);
+    }
+
+    void updateFailureGeneration(uintptr_t failureGeneration) {
+      assert(!getDescription());
+      FailureGeneration.store(failureGeneration, std::memory_order_relaxed);
+    }
 
-    const TypeContextDescriptor *getDescription() {
-      return Description;
+    /// Get the generation number under which this lookup failed.
+    uintptr_t getFailureGeneration() const {
+      assert(!getDescription());
+      return FailureGeneration.load(std::memory_order_relaxed);
     }
 
     int compareWithKey(llvm::StringRef aName) const {
@@ -113,6 +184,26 @@ struct TypeMetadataState {
     initializeTypeMetadataRecordLookup();
   }
 
+  void cacheSuccess(llvm::StringRef name,
+                    const TypeContextDescriptor *description) {
+    auto result = NominalCache.getOrInsert(name, description, uintptr_t(0));
+
+    // If the entry was already present, we may need to update it.
+    if (!result.second) {
+      result.first->makeSuccessful(description);
+    }
+  }
+
+  void cacheFailure(llvm::StringRef name, uintptr_t failureGeneration) {
+    auto result = NominalCache.getOrInsert(
+        name, (const TypeContextDescriptor *) nullptr, failureGeneration);
+
+    // If the entry was already present, we may need to update it, unless
+    // somebody else found the descriptor in the meantime.
+    if (!result.second && !result.first->getDescription()) {
+      result.first->updateFailureGeneration(failureGeneration);
+    }
+  }
 };
 
 static Lazy<TypeMetadataState> TypeMetadataRecords;
@@ -241,12 +332,60 @@ swift::_contextDescriptorMatchesMangling(const ContextDescriptor *context,
   return true;
 }
 
+/// Extract the identifier of the last type component of the mangled
+/// node, if it directly names a nominal type.  Returns an empty string
+/// for manglings we can only match structurally.
+static llvm::StringRef _getTypeNodeLeafName(Demangle::NodePointer node) {
+  if (node->getKind() == Demangle::Node::Kind::Type)
+    node = node->getChild(0);
+
+  switch (node->getKind()) {
+  case Demangle::Node::Kind::Structure:
+  case Demangle::Node::Kind::Class:
+  case Demangle::Node::Kind::Enum:
+  case Demangle::Node::Kind::TypeAlias:
+  case Demangle::Node::Kind::OtherNominalType:
+    break;
+  default:
+    return llvm::StringRef();
+  }
+
+  if (node->getNumChildren() < 2)
+    return llvm::StringRef();
+
+  auto nameNode = node->getChild(1);
+  if (nameNode->getKind() != Demangle::Node::Kind::Identifier ||
+      !nameNode->hasText())
+    return llvm::StringRef();
+
+  return nameNode->getText();
+}
+
 // returns the nominal type descriptor for the type named by typeName
 static const TypeContextDescriptor *
-_searchTypeMetadataRecords(const TypeMetadataState &T,
+_searchTypeMetadataRecords(TypeMetadataState &T,
                            Demangle::NodePointer node) {
   unsigned sectionIdx = 0;
   unsigned endSectionIdx = T.SectionsToScan.size();
+
+  // A record can only match if its descriptor carries the identifier the
+  // mangling ends in, so when the mangling names a nominal type directly,
+  // probe each section's name index instead of matching the mangling
+  // against every record.
+  auto leafName = _getTypeNodeLeafName(node);
+  if (!leafName.empty()) {
+    for (; sectionIdx < endSectionIdx; ++sectionIdx) {
+      auto matches =
+        T.SectionsToScan[sectionIdx].getRecordsWithName(leafName);
+      for (auto i = matches.first; i != matches.second; ++i) {
+        if (_contextDescriptorMatchesMangling(i->second, node)) {
+          return i->second;
+        }
+      }
+    }
+    return nullptr;
+  }
+
   for (; sectionIdx < endSectionIdx; ++sectionIdx) {
     auto &section = T.SectionsToScan[sectionIdx];
     for (const auto &record : section) {
@@ -278,8 +417,26 @@ _findNominalTypeDescriptor(Demangle::NodePointer node) {
 
   // Look for an existing entry.
   // Find the bucket for the metadata entry.
-  if (auto Value = T.NominalCache.find(mangledName))
-    return Value->getDescription();
+  auto Value = T.NominalCache.find(mangledName);
+  if (Value) {
+    if (auto description = Value->getDescription())
+      return description;
+    // This is a negative entry; check below whether it is up to date.
+  }
+
+  // The generation a negative result is cached under: the total number
+  // of sections registered with the two tables we search.  It only
+  // grows, and only when a new image is loaded, so a cached failure
+  // recorded under the current generation is authoritative.  Snapshot
+  // it before searching so that any concurrently loaded image makes the
+  // entry we record look out of date rather than the reverse.
+  uintptr_t generation = _getNumProtocolConformanceSections();
+  T.SectionsToScanLock.withLock([&] {
+    generation += T.SectionsToScan.size();
+  });
+
+  if (Value && Value->getFailureGeneration() == generation)
+    return nullptr;
 
   // Check type metadata records
   T.SectionsToScanLock.withLock([&] {
@@ -292,7 +449,9 @@ _findNominalTypeDescriptor(Demangle::NodePointer node) {
     foundNominal = _searchConformancesByMangledTypeName(node);
 
   if (foundNominal) {
-    T.NominalCache.getOrInsert(mangledName, foundNominal);
+    T.cacheSuccess(mangledName, foundNominal);
+  } else {
+    T.cacheFailure(mangledName, generation);
   }
 
   return foundNominal;
@@ -449,6 +608,56 @@ public:
   }
 };
 
+/// One fully resolved field of a reflected type: the name as spelled in
+/// the field descriptor and the field type with its metadata resolved.
+struct ResolvedField {
+  StringRef Name;
+  FieldType Info;
+};
+
+/// A per-type table of resolved fields, keyed by the type metadata.  Once
+/// built, mirror lookups take fields straight from the table instead of
+/// demangling the descriptor's mangled type names again.  The records are
+/// laid out inline after the entry.
+class ResolvedFieldCacheEntry {
+private:
+  const Metadata *Type;
+  unsigned NumFields;
+
+  ResolvedField *getFieldsBuffer() {
+    return reinterpret_cast<ResolvedField *>(this + 1);
+  }
+
+public:
+  ResolvedFieldCacheEntry(const Metadata *type, const ResolvedField *fields,
+                          unsigned numFields)
+      : Type(type), NumFields(numFields) {
+    auto *buffer = getFieldsBuffer();
+    for (unsigned i = 0; i != numFields; ++i)
+      new (&buffer[i]) ResolvedField(fields[i]);
+  }
+
+  const ResolvedField &getField(unsigned index) {
+    assert(index < NumFields && "field index out of bounds");
+    return getFieldsBuffer()[index];
+  }
+
+  int compareWithKey(const Metadata *other) const {
+    auto a = (uintptr_t)Type;
+    auto b = (uintptr_t)other;
+    return a == b ? 0 : (a < b ? -1 : 1);
+  }
+
+  static size_t getExtraAllocationSize(const Metadata *type,
+                                       const ResolvedField *fields,
+                                       unsigned numFields) {
+    return numFields * sizeof(ResolvedField);
+  }
+  size_t getExtraAllocationSize() const {
+    return NumFields * sizeof(ResolvedField);
+  }
+};
+
 class StaticFieldSection {
   const void *Begin;
   const void *End;
@@ -481,8 +690,11 @@ public:
 
 struct FieldCacheState {
   ConcurrentMap<FieldDescriptorCacheEntry> FieldCache;
+  ConcurrentMap<ResolvedFieldCacheEntry> ResolvedFieldCache;
 
-  Mutex SectionsLock;
+  // Registrations are rare (once per image); cache misses that scan the
+  // sections are not, so readers take a shared lock.
+  ReadWriteLock SectionsLock;
   std::vector<StaticFieldSection> StaticSections;
   std::vector<DynamicFieldSection> DynamicSections;
 
@@ -499,7 +711,7 @@ static Lazy<FieldCacheState> FieldCache;
 void swift::swift_registerFieldDescriptors(const FieldDescriptor **records,
                                            size_t size) {
   auto &cache = FieldCache.get();
-  ScopedLock guard(cache.SectionsLock);
+  ScopedWriteLock guard(cache.SectionsLock);
   cache.DynamicSections.push_back({records, size});
 }
 
@@ -510,7 +722,7 @@ void swift::addImageTypeFieldDescriptorBlockCallback(const void *recordsBegin,
 
   // Field cache should always be sufficiently initialized by this point.
   auto &cache = FieldCache.unsafeGetAlreadyInitialized();
-  ScopedLock guard(cache.SectionsLock);
+  ScopedWriteLock guard(cache.SectionsLock);
   cache.StaticSections.push_back({recordsBegin, recordsEnd});
 }
 
@@ -1056,15 +1268,22 @@ void swift::swift_getFieldAt(
   if (!baseDesc)
     return;
 
-  auto getFieldAt = [&](const FieldDescriptor &descriptor) {
-    auto &field = descriptor.getFields()[index];
+  auto &cache = FieldCache.get();
+
+  // Fast path: this type's fields have already been resolved once; answer
+  // straight from the table.
+  if (auto *resolved = cache.ResolvedFieldCache.find(base)) {
+    auto &field = resolved->getField(index);
+    callback(field.Name, field.Info);
+    return;
+  }
+
+  auto resolveField = [&](const FieldRecord &field) -> ResolvedField {
     auto name = field.getFieldName(0);
 
     // Enum cases don't always have types.
-    if (!field.hasMangledTypeName()) {
-      callback(name, FieldType().withIndirect(field.isIndirectCase()));
-      return;
-    }
+    if (!field.hasMangledTypeName())
+      return {name, FieldType().withIndirect(field.isIndirectCase())};
 
     std::vector<const ContextDescriptor *> descriptorPath;
     {
@@ -1103,15 +1322,35 @@ void swift::swift_getFieldAt(
           return base->getGenericArgs()[flatIndex];
         });
 
-    callback(name, FieldType()
-                       .withType(typeInfo)
-                       .withIndirect(field.isIndirectCase())
-                       .withWeak(typeInfo.isWeak()));
+    return {name, FieldType()
+                      .withType(typeInfo)
+                      .withIndirect(field.isIndirectCase())
+                      .withWeak(typeInfo.isWeak())};
+  };
 
+  auto getFieldAt = [&](const FieldDescriptor &descriptor) {
+    // Resolve every field of the type once and freeze the table, so later
+    // lookups for the same type skip the demangler entirely.  A field type
+    // can fail to resolve if its metadata has not been registered yet; in
+    // that case answer from the partial result without caching it.
+    auto fieldRecords = descriptor.getFields();
+    std::vector<ResolvedField> fields;
+    fields.reserve(fieldRecords.size());
+    bool complete = true;
+    for (auto &field : fieldRecords) {
+      fields.push_back(resolveField(field));
+      if (field.hasMangledTypeName() && !fields.back().Info.getType())
+        complete = false;
+    }
+    if (complete)
+      cache.ResolvedFieldCache.getOrInsert(base, fields.data(),
+                                           unsigned(fields.size()));
+
+    auto &field = fields[index];
+    callback(field.Name, field.Info);
   };
 
   auto dem = getDemanglerForRuntimeTypeResolution();
-  auto &cache = FieldCache.get();
   auto isRequestedDescriptor = [&](const FieldDescriptor &descriptor) {
     assert(descriptor.hasMangledTypeName());
     auto mangledName = descriptor.getMangledTypeName(0);
@@ -1132,7 +1371,10 @@ void swift::swift_getFieldAt(
     return;
   }
 
-  ScopedLock guard(cache.SectionsLock);
+  // Concurrent misses may scan in parallel; insertions into the lock-free
+  // FieldCache during the scan are idempotent, so duplicated scans are
+  // merely wasted work.
+  ScopedReadLock guard(cache.SectionsLock);
   // Otherwise let's try to find it in one of the sections.
   for (auto &section : cache.DynamicSections) {
     for (const auto *descriptor : section) {
@@ -30,10 +30,50 @@ using namespace swift;
 #include <dispatch/dispatch.h>
 static_assert(std::is_same<swift_once_t, dispatch_once_t>::value,
               "swift_once_t and dispatch_once_t must stay in sync");
+
+#elif defined(__linux__)
+
+// On Linux, swift_once is implemented directly on futexes so that threads
+// that lose the race to run the initializer park in the kernel instead of
+// contending a lock.  The predicate word holds one of the states below.
+// The "done" state is -1, matching SwiftTargetInfo.OnceDonePredicateValue,
+// which lets the compiler check for it inline on TSO targets; everywhere
+// else the fast path is the acquire load at the top of swift_once.
+
+#include <atomic>
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+enum : swift_once_t {
+  /// Zero-initialized global state; the initializer has not run.
+  OnceIncomplete = 0,
+  /// Some thread is running the initializer.
+  OnceInProgress = 1,
+  /// ... and at least one other thread is parked on the futex.
+  OnceWaiting = 2,
+  /// The initializer has completed.  Matches OnceDonePredicateValue.
+  OnceDone = -1
+};
+} // end anonymous namespace
+
+/// A futex operates on 32 bits, but the predicate is a word.  All of the
+/// states above are distinguishable in the low-order 32 bits, so wait and
+/// wake on the word's low half.
+static int *futexWordForOnce(swift_once_t *predicate) {
+#if defined(__BIG_ENDIAN__) && __SIZEOF_POINTER__ == 8
+  return reinterpret_cast<int *>(reinterpret_cast<char *>(predicate) + 4);
+#else
+  return reinterpret_cast<int *>(predicate);
+#endif
+}
+
 #else
 
-// On non-Darwin platforms we do not assume any barrier-free inline path
-// and SwiftTargetInfo.OnceDonePredicateValue is unset in the compiler.
+// On other non-Darwin platforms we do not assume any barrier-free inline
+// path and SwiftTargetInfo.OnceDonePredicateValue is unset in the compiler.
 
 #endif
 
@@ -52,6 +92,41 @@ void swift::swift_once(swift_once_t *predicate, void (*fn)(void *),
   dispatch_once_f(predicate, context, fn);
 #elif defined(__CYGWIN__)
   _swift_once_f(predicate, context, fn);
+#elif defined(__linux__)
+  auto atomicPredicate =
+      reinterpret_cast<std::atomic<swift_once_t> *>(predicate);
+
+  auto state = atomicPredicate->load(std::memory_order_acquire);
+  while (state != OnceDone) {
+    if (state == OnceIncomplete) {
+      // Try to claim the initializer.
+      if (!atomicPredicate->compare_exchange_weak(state, OnceInProgress,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_acquire))
+        continue;
+      fn(context);
+      // Publish the result and wake anyone who parked meanwhile.
+      if (atomicPredicate->exchange(OnceDone, std::memory_order_release)
+            == OnceWaiting) {
+        syscall(SYS_futex, futexWordForOnce(predicate), FUTEX_WAKE_PRIVATE,
+                INT_MAX, nullptr, nullptr, 0);
+      }
+      return;
+    }
+
+    // Another thread is running the initializer.  Advertise that we are
+    // about to park so the winner knows to issue a wake, then wait.  The
+    // kernel rechecks the futex word against OnceWaiting under its own
+    // lock, so a wake between the exchange and the wait is not lost.
+    if (state == OnceInProgress &&
+        !atomicPredicate->compare_exchange_weak(state, OnceWaiting,
+                                                std::memory_order_acquire,
+                                                std::memory_order_acquire))
+      continue;
+    syscall(SYS_futex, futexWordForOnce(predicate), FUTEX_WAIT_PRIVATE,
+            (int)OnceWaiting, nullptr, nullptr, 0);
+    state = atomicPredicate->load(std::memory_order_acquire);
+  }
 #else
   std::call_once(*predicate, [fn, context]() { fn(context); });
 #endif
@@ -215,6 +215,12 @@ public:
   const TypeContextDescriptor *
   _searchConformancesByMangledTypeName(Demangle::NodePointer node);
 
+  /// The number of conformance sections registered so far.  Grows
+  /// monotonically, only when an image is loaded; used to version
+  /// negative caches over lookups that consult
+  /// _searchConformancesByMangledTypeName.
+  size_t _getNumProtocolConformanceSections();
+
   Demangle::NodePointer _swift_buildDemanglingForMetadata(const Metadata *type,
                                                       Demangle::Demangler &Dem);
 
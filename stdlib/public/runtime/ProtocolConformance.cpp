@@ -26,6 +26,7 @@
 #include "ImageInspection.h"
 #include "Private.h"
 
+#include <algorithm>
 #include <vector>
 
 using namespace swift;
@@ -203,12 +204,67 @@ ProtocolConformanceDescriptor::getWitnessTable(const Metadata *type) const {
 namespace {
   struct ConformanceSection {
     const ProtocolConformanceRecord *Begin, *End;
+
+    /// An entry in the per-section protocol index: a conformance
+    /// descriptor keyed by the protocol it declares a conformance to.
+    typedef std::pair<const ProtocolDescriptor *,
+                      const ProtocolConformanceDescriptor *> IndexEntry;
+
+    /// This section's conformance descriptors, sorted by protocol.
+    /// Built lazily, under SectionsToScanLock, the first time the
+    /// section is scanned; afterwards a conformance-cache miss probes
+    /// the index by binary search instead of walking every record in
+    /// the section again for every new (type, protocol) query.
+    std::vector<IndexEntry> ProtocolIndex;
+    bool ProtocolIndexBuilt;
+
+    ConformanceSection(const ProtocolConformanceRecord *begin,
+                       const ProtocolConformanceRecord *end)
+      : Begin(begin), End(end), ProtocolIndexBuilt(false) {}
+
     const ProtocolConformanceRecord *begin() const {
       return Begin;
     }
     const ProtocolConformanceRecord *end() const {
       return End;
     }
+
+    struct IndexEntryComparator {
+      bool operator()(const IndexEntry &lhs,
+                      const ProtocolDescriptor *rhs) const {
+        return uintptr_t(lhs.first) < uintptr_t(rhs);
+      }
+      bool operator()(const ProtocolDescriptor *lhs,
+                      const IndexEntry &rhs) const {
+        return uintptr_t(lhs) < uintptr_t(rhs.first);
+      }
+      bool operator()(const IndexEntry &lhs, const IndexEntry &rhs) const {
+        return uintptr_t(lhs.first) < uintptr_t(rhs.first);
+      }
+    };
+
+    /// Return the range of index entries for conformances to \p protocol.
+    /// Builds the index on first use; the caller must hold
+    /// SectionsToScanLock.  The returned iterators point into heap
+    /// storage owned by this section and stay valid as long as the
+    /// section itself does.
+    std::pair<std::vector<IndexEntry>::const_iterator,
+              std::vector<IndexEntry>::const_iterator>
+    getRecordsForProtocol(const ProtocolDescriptor *protocol) {
+      if (!ProtocolIndexBuilt) {
+        ProtocolIndex.reserve(End - Begin);
+        for (const auto &record : *this) {
+          auto &descriptor = *record.get();
+          ProtocolIndex.push_back(
+            IndexEntry(descriptor.getProtocol(), &descriptor));
+        }
+        std::sort(ProtocolIndex.begin(), ProtocolIndex.end(),
+                  IndexEntryComparator());
+        ProtocolIndexBuilt = true;
+      }
+      return std::equal_range(ProtocolIndex.begin(), ProtocolIndex.end(),
+                              protocol, IndexEntryComparator());
+    }
   };
 
   struct ConformanceCacheKey {
@@ -621,24 +677,19 @@ swift::swift_conformsToProtocol(const Metadata * const type,
     C.cacheFailure(type, protocol);
   };
 
-  // Really scan conformance records.
+  // Really scan conformance records, visiting only the ones that declare
+  // a conformance to the protocol we are asking about.
 
   for (unsigned sectionIdx = startSectionIdx;
        sectionIdx < endSectionIdx;
        ++sectionIdx) {
-    auto &section = C.SectionsToScan[sectionIdx];
+    auto matches = C.SectionsToScan[sectionIdx].getRecordsForProtocol(protocol);
     // Eagerly pull records for nondependent witnesses into our cache.
-    for (const auto &record : section) {
-      auto &descriptor = *record.get();
+    for (auto i = matches.first; i != matches.second; ++i) {
+      auto &descriptor = *i->second;
 
       // If the record applies to a specific type, cache it.
       if (auto metadata = descriptor.getCanonicalTypeMetadata()) {
-        auto P = descriptor.getProtocol();
-
-        // Look for an exact match.
-        if (protocol != P)
-          continue;
-
         if (!isRelatedType(type, metadata, /*candidateIsMetadata=*/true))
           continue;
 
@@ -653,11 +704,6 @@ swift::swift_conformsToProtocol(const Metadata * const type,
                  descriptor.getTypeKind()
                   == TypeMetadataRecordKind::IndirectNominalTypeDescriptor) {
         auto R = descriptor.getTypeContextDescriptor();
-        auto P = descriptor.getProtocol();
-
-        // Look for an exact match.
-        if (protocol != P)
-          continue;
 
         if (!isRelatedType(type, R, /*candidateIsMetadata=*/false))
           continue;
@@ -701,6 +747,12 @@ swift::_searchConformancesByMangledTypeName(Demangle::NodePointer node) {
   return nullptr;
 }
 
+size_t swift::_getNumProtocolConformanceSections() {
+  auto &C = Conformances.get();
+  ScopedLock guard(C.SectionsToScanLock);
+  return C.SectionsToScan.size();
+}
+
 /// Resolve a reference to a generic parameter to type metadata.
 static const Metadata *resolveGenericParamRef(
                             const GenericParamRef &param,
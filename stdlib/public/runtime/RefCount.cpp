@@ -104,8 +104,9 @@ HeapObjectSideTableEntry* RefCounts<InlineRefCountBits>::allocateSideTable()
   }
 
   // Preflight passed. Allocate a side table.
-  
-  // FIXME: custom side table allocator
+
+  // Served from the runtime's per-thread block caches; see the
+  // class-specific operator new on HeapObjectSideTableEntry.
   HeapObjectSideTableEntry *side = new HeapObjectSideTableEntry(getHeapObject());
   
   auto newbits = InlineRefCountBits(side);
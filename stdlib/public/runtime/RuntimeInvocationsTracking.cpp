@@ -20,6 +20,9 @@
 #include "swift/Basic/Lazy.h"
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Mutex.h"
+#include <atomic>
+#include <chrono>
+#include <stdlib.h>
 
 #if defined(SWIFT_ENABLE_RUNTIME_FUNCTION_COUNTERS)
 
@@ -94,11 +97,100 @@ static uint16_t RuntimeFunctionCountersOffsets[] = {
 #include "RuntimeInvocationsTracking.def"
 };
 
+/// Sampling of runtime function invocations.
+///
+/// In addition to the counters, every Nth tracked invocation can be recorded
+/// as a (runtime function, object type, timestamp) event into a per-thread
+/// ring buffer. Each ring is written only by its owning thread, so recording
+/// a sample takes no lock. Rings are linked into a global list when they are
+/// created and are never unlinked or freed, because the dump API may run
+/// after their threads have exited.
+///
+/// Sampling is enabled by setting the SWIFT_RUNTIME_FUNCTION_SAMPLING_RATE
+/// environment variable to the number of tracked invocations per sample.
+
+/// A single sampled invocation of a runtime function.
+struct RuntimeFunctionSample {
+  /// Nanoseconds on a monotonic clock.
+  uint64_t Timestamp;
+  /// The metadata of the object the function was invoked on, if any.
+  const void *Type;
+  /// An enumerator from RuntimeFunctionNamesIDs.
+  uint32_t FunctionID;
+};
+
+/// A fixed-size ring of the most recent samples taken by one thread.
+struct RuntimeFunctionSampleRing {
+  enum : uint32_t { Capacity = 4096 };
+  RuntimeFunctionSampleRing *Next = nullptr;
+  /// The total number of samples ever taken by this thread. The slot of
+  /// sample number N is N % Capacity. Written with release ordering after
+  /// the slot, so a concurrent dump never reads an unwritten slot; a slot
+  /// being overwritten on wrap-around may be read torn, which is acceptable
+  /// for a diagnostic facility.
+  std::atomic<uint64_t> SampleCount{0};
+  RuntimeFunctionSample Samples[Capacity];
+};
+
+/// The list of all per-thread sample rings, for the dump API.
+static std::atomic<RuntimeFunctionSampleRing *> RuntimeFunctionSampleRings{
+    nullptr};
+
+/// The ring of the current thread, created on its first sample.
+static LLVM_THREAD_LOCAL RuntimeFunctionSampleRing *ThreadSampleRing = nullptr;
+
+/// Counts tracked invocations on the current thread until the next sample.
+static LLVM_THREAD_LOCAL uint32_t ThreadSampleCountdown = 0;
+
+/// Return the number of tracked invocations per sample, or 0 if sampling
+/// is disabled. The environment is consulted once.
+static uint32_t getRuntimeFunctionSamplingInterval() {
+  static uint32_t interval = []() -> uint32_t {
+    const char *value = getenv("SWIFT_RUNTIME_FUNCTION_SAMPLING_RATE");
+    if (!value)
+      return 0;
+    long parsed = strtol(value, nullptr, 0);
+    return parsed > 0 ? (uint32_t)parsed : 0;
+  }();
+  return interval;
+}
+
+/// Record one sample into the current thread's ring.
+static void recordRuntimeFunctionSample(uint32_t functionID,
+                                        HeapObject *object) {
+  auto *ring = ThreadSampleRing;
+  if (!ring) {
+    ring = new RuntimeFunctionSampleRing();
+    // Publish the ring so that the dump API can find it.
+    auto *head = RuntimeFunctionSampleRings.load(std::memory_order_relaxed);
+    do {
+      ring->Next = head;
+    } while (!RuntimeFunctionSampleRings.compare_exchange_weak(
+        head, ring, std::memory_order_release, std::memory_order_relaxed));
+    ThreadSampleRing = ring;
+  }
+  auto count = ring->SampleCount.load(std::memory_order_relaxed);
+  auto &sample = ring->Samples[count % RuntimeFunctionSampleRing::Capacity];
+  sample.Timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now().time_since_epoch())
+                         .count();
+  sample.Type = object ? object->metadata : nullptr;
+  sample.FunctionID = functionID;
+  ring->SampleCount.store(count + 1, std::memory_order_release);
+}
+
 /// Define implementations of tracking functions.
 /// TODO: Track only objects that were registered for tracking?
 /// TODO: Perform atomic increments?
 #define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
   void SWIFT_RT_TRACK_INVOCATION_NAME(RT_FUNCTION)(HeapObject * object) {      \
+    /* Sample this invocation if sampling is enabled. */                       \
+    if (auto interval = getRuntimeFunctionSamplingInterval()) {                \
+      if (++ThreadSampleCountdown >= interval) {                               \
+        ThreadSampleCountdown = 0;                                             \
+        recordRuntimeFunctionSample(RT_FUNCTION_ID(RT_FUNCTION), object);      \
+      }                                                                        \
+    }                                                                          \
     /* Update global counters. */                                              \
     if (UpdateGlobalRuntimeFunctionCounters) {                                 \
       StaticScopedWriteLock lock(RuntimeGlobalFunctionCountersState.Lock);     \
@@ -200,6 +292,28 @@ void _swift_dumpObjectsRuntimeFunctionPointers() {
   }
 }
 
+/// Dump the sampled runtime function invocations of every thread, oldest
+/// retained sample first.
+void _swift_dumpRuntimeFunctionSamples() {
+  unsigned threadIndex = 0;
+  for (auto *ring = RuntimeFunctionSampleRings.load(std::memory_order_acquire);
+       ring; ring = ring->Next, ++threadIndex) {
+    uint64_t end = ring->SampleCount.load(std::memory_order_acquire);
+    uint64_t begin = end > RuntimeFunctionSampleRing::Capacity
+                         ? end - RuntimeFunctionSampleRing::Capacity
+                         : 0;
+    printf("\n\nRuntime function samples for thread %u "
+           "(%llu of %llu retained):\n",
+           threadIndex, (unsigned long long)(end - begin),
+           (unsigned long long)end);
+    for (uint64_t i = begin; i != end; ++i) {
+      auto &sample = ring->Samples[i % RuntimeFunctionSampleRing::Capacity];
+      printf("%llu %s %p\n", (unsigned long long)sample.Timestamp,
+             RuntimeFunctionNames[sample.FunctionID], sample.Type);
+    }
+  }
+}
+
 /// Set mode for global runtime function counters.
 /// Return the old value of this flag.
 int _swift_setGlobalRuntimeFunctionCountersMode(int mode) {
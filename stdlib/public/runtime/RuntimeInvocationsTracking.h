@@ -86,6 +86,11 @@ SWIFT_RUNTIME_EXPORT uint64_t _swift_getNumRuntimeFunctionCounters();
 /// Dump all per-object runtime function pointers.
 SWIFT_RUNTIME_EXPORT void _swift_dumpObjectsRuntimeFunctionPointers();
 
+/// Dump the sampled runtime function invocations recorded by every thread.
+/// Sampling is enabled by setting the SWIFT_RUNTIME_FUNCTION_SAMPLING_RATE
+/// environment variable to the number of tracked invocations per sample.
+SWIFT_RUNTIME_EXPORT void _swift_dumpRuntimeFunctionSamples();
+
 /// Set mode for global runtime function counters.
 /// Return the old value of this flag.
 SWIFT_RUNTIME_EXPORT int
@@ -182,6 +182,13 @@ _SwiftValue *swift::bridgeAnythingToSwiftValueObject(OpaqueValue *src,
   size_t totalSize =
       getSwiftValuePayloadOffset(alignMask) + srcType->getValueWitnesses()->size;
 
+  // Note that boxes for common small layouts are recycled on per-thread
+  // free lists by swift_slowAlloc/swift_slowDealloc themselves (see
+  // Heap.cpp), so high-frequency bridging of small values does not reach
+  // malloc.  Don't be tempted to pool constructed instances instead: an
+  // instance may pick up weak references or associated objects during its
+  // lifetime, and those are only torn down by the objc_destructInstance
+  // call in -dealloc.
   void *instanceMemory = swift_slowAlloc(totalSize, alignMask);
   _SwiftValue *instance
     = objc_constructInstance(getSwiftValueClass(), instanceMemory);
@@ -36,6 +36,7 @@
 #endif
 #include <climits>
 #include <clocale>
+#include <cmath>
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
@@ -190,13 +191,404 @@ static int swift_snprintf_l(char *Str, size_t StrSize, locale_t Locale,
 }
 #endif
 
+// Shortest round-trip floating-point formatting (Grisu2).
+//
+// Grisu2 converts a finite nonzero IEEE value into a shortest-form decimal
+// digit string that reads back as exactly the original value, using only
+// 64-bit integer arithmetic; see Florian Loitsch, "Printing Floating-Point
+// Numbers Quickly and Accurately with Integers" (PLDI 2010).  The produced
+// string is locale-independent and usually, though not always, the shortest
+// possible.  Zeros, infinities, NaNs, and long double fall back to the
+// snprintf path below.
+
+namespace {
+/// A floating-point value in "do-it-yourself" form: a 64-bit significand
+/// with a separate binary exponent.
+struct DiyFp {
+  uint64_t Significand;
+  int Exponent;
+};
+} // end anonymous namespace
+
+/// Multiply two DiyFps, keeping the upper 64 bits of the 128-bit product
+/// rounded to nearest.
+static DiyFp diyFpMultiply(DiyFp Lhs, DiyFp Rhs) {
+  const uint64_t Mask32 = 0xFFFFFFFFu;
+  uint64_t A = Lhs.Significand >> 32;
+  uint64_t B = Lhs.Significand & Mask32;
+  uint64_t C = Rhs.Significand >> 32;
+  uint64_t D = Rhs.Significand & Mask32;
+  uint64_t AC = A * C, BC = B * C, AD = A * D, BD = B * D;
+  uint64_t Mid = (BD >> 32) + (AD & Mask32) + (BC & Mask32);
+  // Round up at the halfway point.
+  Mid += UINT64_C(1) << 31;
+  DiyFp Result = {AC + (AD >> 32) + (BC >> 32) + (Mid >> 32),
+                  Lhs.Exponent + Rhs.Exponent + 64};
+  return Result;
+}
+
+/// Normalized significands of 10^k for k in [-348, 340] in steps of 8.
+static const uint64_t CachedPowerSignificands[] = {
+    UINT64_C(0xFA8FD5A0081C0288), UINT64_C(0xBAAEE17FA23EBF76),
+    UINT64_C(0x8B16FB203055AC76), UINT64_C(0xCF42894A5DCE35EA),
+    UINT64_C(0x9A6BB0AA55653B2D), UINT64_C(0xE61ACF033D1A45DF),
+    UINT64_C(0xAB70FE17C79AC6CA), UINT64_C(0xFF77B1FCBEBCDC4F),
+    UINT64_C(0xBE5691EF416BD60C), UINT64_C(0x8DD01FAD907FFC3C),
+    UINT64_C(0xD3515C2831559A83), UINT64_C(0x9D71AC8FADA6C9B5),
+    UINT64_C(0xEA9C227723EE8BCB), UINT64_C(0xAECC49914078536D),
+    UINT64_C(0x823C12795DB6CE57), UINT64_C(0xC21094364DFB5637),
+    UINT64_C(0x9096EA6F3848984F), UINT64_C(0xD77485CB25823AC7),
+    UINT64_C(0xA086CFCD97BF97F4), UINT64_C(0xEF340A98172AACE5),
+    UINT64_C(0xB23867FB2A35B28E), UINT64_C(0x84C8D4DFD2C63F3B),
+    UINT64_C(0xC5DD44271AD3CDBA), UINT64_C(0x936B9FCEBB25C996),
+    UINT64_C(0xDBAC6C247D62A584), UINT64_C(0xA3AB66580D5FDAF6),
+    UINT64_C(0xF3E2F893DEC3F126), UINT64_C(0xB5B5ADA8AAFF80B8),
+    UINT64_C(0x87625F056C7C4A8B), UINT64_C(0xC9BCFF6034C13053),
+    UINT64_C(0x964E858C91BA2655), UINT64_C(0xDFF9772470297EBD),
+    UINT64_C(0xA6DFBD9FB8E5B88F), UINT64_C(0xF8A95FCF88747D94),
+    UINT64_C(0xB94470938FA89BCF), UINT64_C(0x8A08F0F8BF0F156B),
+    UINT64_C(0xCDB02555653131B6), UINT64_C(0x993FE2C6D07B7FAC),
+    UINT64_C(0xE45C10C42A2B3B06), UINT64_C(0xAA242499697392D3),
+    UINT64_C(0xFD87B5F28300CA0E), UINT64_C(0xBCE5086492111AEB),
+    UINT64_C(0x8CBCCC096F5088CC), UINT64_C(0xD1B71758E219652C),
+    UINT64_C(0x9C40000000000000), UINT64_C(0xE8D4A51000000000),
+    UINT64_C(0xAD78EBC5AC620000), UINT64_C(0x813F3978F8940984),
+    UINT64_C(0xC097CE7BC90715B3), UINT64_C(0x8F7E32CE7BEA5C70),
+    UINT64_C(0xD5D238A4ABE98068), UINT64_C(0x9F4F2726179A2245),
+    UINT64_C(0xED63A231D4C4FB27), UINT64_C(0xB0DE65388CC8ADA8),
+    UINT64_C(0x83C7088E1AAB65DB), UINT64_C(0xC45D1DF942711D9A),
+    UINT64_C(0x924D692CA61BE758), UINT64_C(0xDA01EE641A708DEA),
+    UINT64_C(0xA26DA3999AEF774A), UINT64_C(0xF209787BB47D6B85),
+    UINT64_C(0xB454E4A179DD1877), UINT64_C(0x865B86925B9BC5C2),
+    UINT64_C(0xC83553C5C8965D3D), UINT64_C(0x952AB45CFA97A0B3),
+    UINT64_C(0xDE469FBD99A05FE3), UINT64_C(0xA59BC234DB398C25),
+    UINT64_C(0xF6C69A72A3989F5C), UINT64_C(0xB7DCBF5354E9BECE),
+    UINT64_C(0x88FCF317F22241E2), UINT64_C(0xCC20CE9BD35C78A5),
+    UINT64_C(0x98165AF37B2153DF), UINT64_C(0xE2A0B5DC971F303A),
+    UINT64_C(0xA8D9D1535CE3B396), UINT64_C(0xFB9B7CD9A4A7443C),
+    UINT64_C(0xBB764C4CA7A44410), UINT64_C(0x8BAB8EEFB6409C1A),
+    UINT64_C(0xD01FEF10A657842C), UINT64_C(0x9B10A4E5E9913129),
+    UINT64_C(0xE7109BFBA19C0C9D), UINT64_C(0xAC2820D9623BF429),
+    UINT64_C(0x80444B5E7AA7CF85), UINT64_C(0xBF21E44003ACDD2D),
+    UINT64_C(0x8E679C2F5E44FF8F), UINT64_C(0xD433179D9C8CB841),
+    UINT64_C(0x9E19DB92B4E31BA9), UINT64_C(0xEB96BF6EBADF77D9),
+    UINT64_C(0xAF87023B9BF0EE6B),
+};
+
+/// Binary exponents matching CachedPowerSignificands.
+static const int16_t CachedPowerExponents[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034,
+    -1007,  -980,  -954,  -927,  -901,  -874,  -847,  -821,
+     -794,  -768,  -741,  -715,  -688,  -661,  -635,  -608,
+     -582,  -555,  -529,  -502,  -475,  -449,  -422,  -396,
+     -369,  -343,  -316,  -289,  -263,  -236,  -210,  -183,
+     -157,  -130,  -103,   -77,   -50,   -24,     3,    30,
+       56,    83,   109,   136,   162,   189,   216,   242,
+      269,   295,   322,   348,   375,   402,   428,   455,
+      481,   508,   534,   561,   588,   614,   641,   667,
+      694,   720,   747,   774,   800,   827,   853,   880,
+      907,   933,   960,   986,  1013,  1039,  1066,
+};
+
+/// Return a cached power of ten 10^-K chosen so that scaling a DiyFp with
+/// binary exponent \p Exponent by it lands the result's exponent in
+/// [-63, -32].
+static DiyFp getCachedPower(int Exponent, int *K) {
+  // ceil((-61 - Exponent) * 1/log2(10)) + 347, computed in doubles.
+  double D = (-61 - Exponent) * 0.30102999566398114 + 347;
+  int Power = static_cast<int>(D);
+  if (D - Power > 0.0)
+    ++Power;
+  unsigned Index = static_cast<unsigned>(Power >> 3) + 1;
+  *K = -(-348 + static_cast<int>(Index << 3));
+  DiyFp Result = {CachedPowerSignificands[Index],
+                  CachedPowerExponents[Index]};
+  return Result;
+}
+
+static int countDecimalDigits32(uint32_t Value) {
+  if (Value < 10) return 1;
+  if (Value < 100) return 2;
+  if (Value < 1000) return 3;
+  if (Value < 10000) return 4;
+  if (Value < 100000) return 5;
+  if (Value < 1000000) return 6;
+  if (Value < 10000000) return 7;
+  if (Value < 100000000) return 8;
+  if (Value < 1000000000) return 9;
+  return 10;
+}
+
+/// Nudge the last generated digit as close to the scaled value as the
+/// boundary interval allows, keeping the result inside it.
+static void grisuRound(char *Digits, int Length, uint64_t Delta,
+                       uint64_t Rest, uint64_t TenKappa,
+                       uint64_t PlusDistance) {
+  while (Rest < PlusDistance && Delta - Rest >= TenKappa &&
+         (Rest + TenKappa < PlusDistance ||
+          PlusDistance - Rest > Rest + TenKappa - PlusDistance)) {
+    --Digits[Length - 1];
+    Rest += TenKappa;
+  }
+}
+
+/// Generate the decimal digits of the value scaled into [Minus, Plus],
+/// cutting the digit stream as soon as the result is unambiguously within
+/// the boundary interval.
+static void grisuDigitGen(DiyFp W, DiyFp Plus, uint64_t Delta, char *Digits,
+                          int *Length, int *K) {
+  static const uint64_t PowersOfTen[] = {
+      1,      10,      100,      1000,      10000,
+      100000, 1000000, 10000000, 100000000, 1000000000};
+  DiyFp One = {UINT64_C(1) << -Plus.Exponent, Plus.Exponent};
+  uint64_t PlusDistance = Plus.Significand - W.Significand;
+  uint32_t Integral = static_cast<uint32_t>(Plus.Significand >> -One.Exponent);
+  uint64_t Fractional = Plus.Significand & (One.Significand - 1);
+  int Kappa = countDecimalDigits32(Integral);
+  *Length = 0;
+
+  while (Kappa > 0) {
+    uint32_t Divisor = static_cast<uint32_t>(PowersOfTen[Kappa - 1]);
+    uint32_t Digit = Integral / Divisor;
+    if (Digit || *Length)
+      Digits[(*Length)++] = static_cast<char>('0' + Digit);
+    Integral %= Divisor;
+    --Kappa;
+    uint64_t Rest =
+        (static_cast<uint64_t>(Integral) << -One.Exponent) + Fractional;
+    if (Rest <= Delta) {
+      *K += Kappa;
+      grisuRound(Digits, *Length, Delta, Rest,
+                 PowersOfTen[Kappa] << -One.Exponent, PlusDistance);
+      return;
+    }
+  }
+
+  // The integral part was consumed; generate digits from the fractional
+  // part until the result is within the interval.
+  for (;;) {
+    Fractional *= 10;
+    Delta *= 10;
+    char Digit = static_cast<char>(Fractional >> -One.Exponent);
+    if (Digit || *Length)
+      Digits[(*Length)++] = static_cast<char>('0' + Digit);
+    Fractional &= One.Significand - 1;
+    --Kappa;
+    if (Fractional < Delta) {
+      *K += Kappa;
+      // Small-magnitude values can push -Kappa past the end of the table;
+      // the scaled distance would overflow 64 bits anyway, so saturate the
+      // rounding distance to 0 (no nudging) as rapidjson does.
+      grisuRound(Digits, *Length, Delta, Fractional, One.Significand,
+                 -Kappa < 10 ? PlusDistance * PowersOfTen[-Kappa] : 0);
+      return;
+    }
+  }
+}
+
+namespace {
+template <typename T> struct IEEETraits;
+
+template <> struct IEEETraits<float> {
+  typedef uint32_t BitsType;
+  enum : int { SignificandBits = 23, ExponentBias = 127 };
+};
+
+template <> struct IEEETraits<double> {
+  typedef uint64_t BitsType;
+  enum : int { SignificandBits = 52, ExponentBias = 1023 };
+};
+} // end anonymous namespace
+
+/// Decompose a finite positive IEEE value into its DiyFp form \p W and its
+/// normalized boundaries: the value's rounding interval is
+/// (\p Minus, \p Plus), brought to a common exponent.
+template <typename T>
+static void grisuBoundaries(T Value, DiyFp *W, DiyFp *Minus, DiyFp *Plus) {
+  typedef typename IEEETraits<T>::BitsType BitsType;
+  const int SignificandBits = IEEETraits<T>::SignificandBits;
+  const BitsType HiddenBit = BitsType(1) << SignificandBits;
+
+  BitsType Bits;
+  memcpy(&Bits, &Value, sizeof(Value));
+  int BiasedExponent =
+      static_cast<int>(Bits >> SignificandBits) & ((1 << (sizeof(BitsType) * 8 - 1 - SignificandBits)) - 1);
+  uint64_t Significand = Bits & (HiddenBit - 1);
+  int Exponent;
+  if (BiasedExponent != 0) {
+    Significand |= HiddenBit;
+    Exponent = BiasedExponent - IEEETraits<T>::ExponentBias - SignificandBits;
+  } else {
+    Exponent = 1 - IEEETraits<T>::ExponentBias - SignificandBits;
+  }
+
+  // The upper boundary is half an ulp above the value.
+  DiyFp Upper = {(Significand << 1) + 1, Exponent - 1};
+  while (!(Upper.Significand & (UINT64_C(1) << 63))) {
+    Upper.Significand <<= 1;
+    --Upper.Exponent;
+  }
+
+  // The lower boundary is closer when the value sits on a power of two,
+  // where the ulp below it is half the ulp above.
+  DiyFp Lower;
+  if (Significand == HiddenBit && BiasedExponent > 1) {
+    Lower.Significand = (Significand << 2) - 1;
+    Lower.Exponent = Exponent - 2;
+  } else {
+    Lower.Significand = (Significand << 1) - 1;
+    Lower.Exponent = Exponent - 1;
+  }
+  Lower.Significand <<= Lower.Exponent - Upper.Exponent;
+  Lower.Exponent = Upper.Exponent;
+
+  DiyFp Result = {Significand, Exponent};
+  while (!(Result.Significand & (UINT64_C(1) << 63))) {
+    Result.Significand <<= 1;
+    --Result.Exponent;
+  }
+
+  *W = Result;
+  *Minus = Lower;
+  *Plus = Upper;
+}
+
+/// Produce shortest-form decimal digits for a finite positive value:
+/// on return, Value == Digits[0..Length) * 10^DecimalExponent.
+template <typename T>
+static void grisuShortest(T Value, char *Digits, int *Length,
+                          int *DecimalExponent) {
+  DiyFp W, Minus, Plus;
+  grisuBoundaries(Value, &W, &Minus, &Plus);
+
+  DiyFp CachedPower = getCachedPower(Plus.Exponent, DecimalExponent);
+  W = diyFpMultiply(W, CachedPower);
+  Plus = diyFpMultiply(Plus, CachedPower);
+  Minus = diyFpMultiply(Minus, CachedPower);
+
+  // Shrink the interval by one unit on each side so that any decimal
+  // inside it still converts back to the original value despite the
+  // rounding error of the scaled boundaries.
+  ++Minus.Significand;
+  --Plus.Significand;
+
+  grisuDigitGen(W, Plus, Plus.Significand - Minus.Significand, Digits, Length,
+                DecimalExponent);
+}
+
+/// Lay the digits out in the style of printf's %g: plain decimal notation
+/// for moderate exponents, scientific notation otherwise.  Trailing ".0"
+/// for integral values is appended by the caller.
+static uint64_t formatShortestDecimal(char *Buffer, bool Negative,
+                                      const char *Digits, int Length,
+                                      int DecimalExponent,
+                                      int MaxFixedDigits) {
+  // Position of the decimal point relative to the first digit; the value
+  // is Digits[0].Digits[1...] * 10^(PointPosition - 1).
+  int PointPosition = Length + DecimalExponent;
+  char *P = Buffer;
+  if (Negative)
+    *P++ = '-';
+
+  int ScientificExponent = PointPosition - 1;
+  if (ScientificExponent < -4 || ScientificExponent >= MaxFixedDigits) {
+    // d.ddde[+-]dd
+    *P++ = Digits[0];
+    if (Length > 1) {
+      *P++ = '.';
+      memcpy(P, Digits + 1, Length - 1);
+      P += Length - 1;
+    }
+    *P++ = 'e';
+    int Exp = ScientificExponent;
+    if (Exp < 0) {
+      *P++ = '-';
+      Exp = -Exp;
+    } else {
+      *P++ = '+';
+    }
+    // printf writes at least two exponent digits; match it.
+    char ExpDigits[4];
+    int NumExpDigits = 0;
+    while (Exp) {
+      ExpDigits[NumExpDigits++] = static_cast<char>('0' + Exp % 10);
+      Exp /= 10;
+    }
+    while (NumExpDigits < 2)
+      ExpDigits[NumExpDigits++] = '0';
+    while (NumExpDigits)
+      *P++ = ExpDigits[--NumExpDigits];
+  } else if (PointPosition <= 0) {
+    // 0.000ddd
+    *P++ = '0';
+    *P++ = '.';
+    for (int i = 0; i != -PointPosition; ++i)
+      *P++ = '0';
+    memcpy(P, Digits, Length);
+    P += Length;
+  } else if (PointPosition >= Length) {
+    // ddd00; the caller appends ".0".
+    memcpy(P, Digits, Length);
+    P += Length;
+    for (int i = Length; i != PointPosition; ++i)
+      *P++ = '0';
+  } else {
+    // dd.ddd
+    memcpy(P, Digits, PointPosition);
+    P += PointPosition;
+    *P++ = '.';
+    memcpy(P, Digits + PointPosition, Length - PointPosition);
+    P += Length - PointPosition;
+  }
+  *P = '\0';
+  return P - Buffer;
+}
+
+template <typename T>
+static bool formatShortestRoundTrip(char *Buffer, T Value, uint64_t *Length) {
+  if (Value == 0 || !std::isfinite(Value))
+    return false;
+
+  bool Negative = std::signbit(Value);
+  T Absolute = Negative ? -Value : Value;
+
+  char Digits[18];
+  int NumDigits, DecimalExponent;
+  grisuShortest(Absolute, Digits, &NumDigits, &DecimalExponent);
+  *Length = formatShortestDecimal(Buffer, Negative, Digits, NumDigits,
+                                  DecimalExponent,
+                                  std::numeric_limits<T>::max_digits10);
+  return true;
+}
+
+static bool formatShortestRoundTrip(char *Buffer, long double Value,
+                                    uint64_t *Length) {
+  // No DiyFp decomposition for the 80-bit format; use the snprintf path.
+  return false;
+}
+
 template <typename T>
 static uint64_t swift_floatingPointToString(char *Buffer, size_t BufferLength,
-                                            T Value, const char *Format, 
+                                            T Value, const char *Format,
                                             bool Debug) {
   if (BufferLength < 32)
     swift::crash("swift_floatingPointToString: insufficient buffer size");
 
+  // When a round-trip representation is requested, try the shortest
+  // round-trip formatter first; it is considerably faster than snprintf
+  // and needs no locale management.
+  if (Debug) {
+    uint64_t ShortestLength;
+    if (formatShortestRoundTrip(Buffer, Value, &ShortestLength)) {
+      // Add ".0" to integral values, as the snprintf path below does.
+      if (strchr(Buffer, 'e') == nullptr && strchr(Buffer, '.') == nullptr) {
+        Buffer[ShortestLength++] = '.';
+        Buffer[ShortestLength++] = '0';
+      }
+      return ShortestLength;
+    }
+  }
+
   int Precision = std::numeric_limits<T>::digits10;
   if (Debug) {
     Precision = std::numeric_limits<T>::max_digits10;
@@ -17,6 +17,7 @@
 #include "../SwiftShims/UnicodeShims.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #if defined(__APPLE__)
 
@@ -244,6 +245,74 @@ template <typename T, typename U> const T *ptr_cast(const U *p) {
 }
 }
 
+// ASCII fast paths for the NFC entry points.
+//
+// All-ASCII strings are already in NFC and nothing in them can compose
+// with what follows, so both the quick-check span and the normalization
+// itself are the identity on them.  Answering those cases here avoids the
+// ICU entry overhead, which dominates short-string comparisons.  The scan
+// checks four UTF-16 units per 64-bit word; the compiler vectorizes it
+// further where profitable.
+
+/// Returns true if all \p Length units of \p Str are ASCII.
+static bool isAllASCII(const swift::__swift_stdlib_UChar *Str,
+                       int32_t Length) {
+  const uint16_t *Units = ptr_cast<uint16_t>(Str);
+  int32_t i = 0;
+  uint64_t Word;
+  for (; i + 4 <= Length; i += 4) {
+    memcpy(&Word, Units + i, sizeof(Word));
+    if (Word & UINT64_C(0xFF80FF80FF80FF80))
+      return false;
+  }
+  for (; i < Length; ++i) {
+    if (Units[i] & 0xFF80)
+      return false;
+  }
+  return true;
+}
+
+// Per-call-site fast-path counters, for measuring hit rates.  Disabled by
+// default; define SWIFT_STDLIB_UNICODE_FASTPATH_COUNTERS to enable them.
+// The totals are printed at process exit.
+#if defined(SWIFT_STDLIB_UNICODE_FASTPATH_COUNTERS)
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+struct UnicodeFastPathCounters {
+  std::atomic<uint64_t> QuickCheckASCII{0};
+  std::atomic<uint64_t> QuickCheckICU{0};
+  std::atomic<uint64_t> NormalizeASCII{0};
+  std::atomic<uint64_t> NormalizeICU{0};
+
+  void dump() {
+    fprintf(stderr, "Unicode fast-path counters:\n");
+    fprintf(stderr, "  spanQuickCheckYes: ASCII = %llu, ICU = %llu\n",
+            (unsigned long long)QuickCheckASCII.load(),
+            (unsigned long long)QuickCheckICU.load());
+    fprintf(stderr, "  normalize:         ASCII = %llu, ICU = %llu\n",
+            (unsigned long long)NormalizeASCII.load(),
+            (unsigned long long)NormalizeICU.load());
+  }
+};
+}
+
+static UnicodeFastPathCounters &getUnicodeFastPathCounters() {
+  static UnicodeFastPathCounters Counters;
+  static bool AtExitRegistered =
+      (atexit([] { getUnicodeFastPathCounters().dump(); }), true);
+  (void)AtExitRegistered;
+  return Counters;
+}
+
+#define UNICODE_FASTPATH_COUNT(NAME)                                         \
+  getUnicodeFastPathCounters().NAME.fetch_add(1, std::memory_order_relaxed)
+#else
+#define UNICODE_FASTPATH_COUNT(NAME) (void)0
+#endif
+
 void swift::__swift_stdlib_ubrk_close(
     swift::__swift_stdlib_UBreakIterator *bi) {
   ubrk_close(ptr_cast<UBreakIterator>(bi));
@@ -292,6 +361,14 @@ int32_t swift::__swift_stdlib_unorm2_normalize(
     const __swift_stdlib_UNormalizer2 *norm, const __swift_stdlib_UChar *src,
     __swift_int32_t len, __swift_stdlib_UChar *dst, __swift_int32_t capacity,
     __swift_stdlib_UErrorCode *err) {
+  // All-ASCII input normalizes to itself.  Leave the pre-flighting case
+  // (insufficient capacity) to ICU so the overflow error codes match.
+  if (len >= 0 && capacity >= len && isAllASCII(src, len)) {
+    UNICODE_FASTPATH_COUNT(NormalizeASCII);
+    memcpy(dst, src, size_t(len) * sizeof(*src));
+    return len;
+  }
+  UNICODE_FASTPATH_COUNT(NormalizeICU);
   // TODO remove this compatibility when we require ICU >= 60 on Linux
 #if defined(__APPLE__) || U_ICU_VERSION_MAJOR_NUM >= 60
   return unorm2_normalize(ptr_cast<UNormalizer2>(norm), src, len, dst, capacity,
@@ -307,6 +384,14 @@ int32_t swift::__swift_stdlib_unorm2_normalize(
 __swift_int32_t swift::__swift_stdlib_unorm2_spanQuickCheckYes(
     const __swift_stdlib_UNormalizer2 *norm, const __swift_stdlib_UChar *ptr,
     __swift_int32_t len, __swift_stdlib_UErrorCode *err) {
+  // An all-ASCII string is entirely within the NFC "yes" span.  A partial
+  // ASCII prefix is not enough: a combining mark right after it may
+  // compose with the last ASCII character, so anything else goes to ICU.
+  if (len >= 0 && isAllASCII(ptr, len)) {
+    UNICODE_FASTPATH_COUNT(QuickCheckASCII);
+    return len;
+  }
+  UNICODE_FASTPATH_COUNT(QuickCheckICU);
   return unorm2_spanQuickCheckYes(ptr_cast<UNormalizer2>(norm),
                                   ptr_cast<UChar>(ptr), len,
                                   ptr_cast<UErrorCode>(err));
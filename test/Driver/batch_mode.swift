@@ -62,3 +62,16 @@
 // SEED2: Added to TaskQueue: {compile: {{.*}} <= {{file-[0-3][2-9].swift .*}}}
 // SEED2: Added to TaskQueue: {compile: {{.*}} <= {{.*}}}
 // SEED2: Added to TaskQueue: {compile: {{.*}} <= {{.*}}}
+//
+// RUN: %swiftc_driver -enable-batch-mode -driver-show-job-lifecycle -driver-skip-execution -j 4 -driver-batch-size-limit 5 %t/file-01.swift %t/file-02.swift %t/file-03.swift %t/file-04.swift %t/file-05.swift %t/file-06.swift %t/file-07.swift %t/file-08.swift %t/file-09.swift %t/file-10.swift %t/file-11.swift %t/file-12.swift %t/file-13.swift %t/file-14.swift %t/file-15.swift %t/file-16.swift %t/file-17.swift %t/file-18.swift %t/file-19.swift %t/file-20.swift %t/file-21.swift %t/file-22.swift %t/file-23.swift %t/file-24.swift %t/file-25.swift %t/file-26.swift %t/file-27.swift %t/file-28.swift %t/file-29.swift %t/file-30.swift | %FileCheck %s -check-prefix=SIZE5
+//
+// 30 files with a size limit of 5 => 6 batches of 5 jobs
+//
+// SIZE5: Found 30 batchable jobs
+// SIZE5: Forming into 6 batches
+// SIZE5: Forming batch job from 5 constituents
+// SIZE5: Forming batch job from 5 constituents
+// SIZE5: Forming batch job from 5 constituents
+// SIZE5: Forming batch job from 5 constituents
+// SIZE5: Forming batch job from 5 constituents
+// SIZE5: Forming batch job from 5 constituents
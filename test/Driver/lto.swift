@@ -0,0 +1,12 @@
+// RUN: %target-swiftc_driver -lto=llvm-thin %s -### | %FileCheck %s -check-prefix=CHECK-THIN
+// CHECK-THIN: -frontend
+// CHECK-THIN: -c
+// CHECK-THIN: -lto=llvm-thin
+
+// RUN: %target-swiftc_driver -lto=llvm-full %s -### | %FileCheck %s -check-prefix=CHECK-FULL
+// CHECK-FULL: -frontend
+// CHECK-FULL: -c
+// CHECK-FULL: -lto=llvm-full
+
+// RUN: not %target-swiftc_driver -lto=unknown %s 2>&1 | %FileCheck %s -check-prefix=CHECK-INVALID
+// CHECK-INVALID: invalid value 'unknown' in '-lto=unknown'
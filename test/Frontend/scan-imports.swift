@@ -0,0 +1,27 @@
+// RUN: %target-swift-frontend -scan-imports %s | %FileCheck %s
+
+// The scan is purely lexical: no modules are loaded, so nonexistent module
+// names are fine here.
+
+import Alpha
+import struct Bravo.Thing
+import func Charlie.Inner.doIt
+
+#if DEBUG
+import DebugOnly
+#else
+import ReleaseOnly
+#endif
+
+// import NotAnImport
+let x = "import StringLiteral"
+
+// Only unique top-level names appear, in source order; both branches of the
+// conditional are reported.
+// CHECK: Alpha
+// CHECK-NEXT: Bravo
+// CHECK-NEXT: Charlie
+// CHECK-NEXT: DebugOnly
+// CHECK-NEXT: ReleaseOnly
+// CHECK-NOT: NotAnImport
+// CHECK-NOT: StringLiteral
@@ -357,9 +357,11 @@ define void @unknown_release_promotion(%swift.refcounted* %A) {
   ret void
 }
 
+; The strong retain sinks into bb1, but must not promote the unknown retain
+; there: canonicalization works block-locally and runs before the motion.
 ; CHECK-LABEL: @unknown_retain_nopromotion
 ; CHECK: bb1
-; CHECK-NOT: swift_retain
+; CHECK: swift_unknownRetain
 ; CHECK: ret
 define void @unknown_retain_nopromotion(%swift.refcounted* %A) {
   tail call %swift.refcounted* @swift_retain(%swift.refcounted* %A)
@@ -369,6 +371,57 @@ bb1:
   ret void
 }
 
+; CHECK-LABEL: @retain_release_across_blocks
+; CHECK-NOT: swift_retain
+; CHECK-NOT: swift_release
+; CHECK: ret
+define void @retain_release_across_blocks(%swift.refcounted* %A) {
+entry:
+  tail call %swift.refcounted* @swift_retain(%swift.refcounted* %A)
+  br label %bb1
+bb1:
+  tail call void @swift_release(%swift.refcounted* %A)
+  ret void
+}
+
+; The release in bb1 hoists into the entry block, past the release of the
+; unrelated object, and cancels with the retain. The retain cannot sink here
+; because of that unrelated release.
+; CHECK-LABEL: @release_hoist_across_blocks
+; CHECK-NOT: swift_retain
+; CHECK: @swift_release(%swift.refcounted* %B)
+; CHECK-NOT: @swift_release(%swift.refcounted* %A)
+; CHECK: ret
+define void @release_hoist_across_blocks(%swift.refcounted* %A,
+                                         %swift.refcounted* %B) {
+entry:
+  tail call %swift.refcounted* @swift_retain(%swift.refcounted* %A)
+  tail call void @swift_release(%swift.refcounted* %B)
+  br label %bb1
+bb1:
+  tail call void @swift_release(%swift.refcounted* %A)
+  ret void
+}
+
+; The release must not be hoisted above a conditional branch, and the retain
+; must not sink into a block with another predecessor.
+; CHECK-LABEL: @no_motion_across_conditional_branch
+; CHECK: swift_retain
+; CHECK: bb2
+; CHECK: swift_release
+; CHECK: ret
+define void @no_motion_across_conditional_branch(%swift.refcounted* %A, i1 %c) {
+entry:
+  tail call %swift.refcounted* @swift_retain(%swift.refcounted* %A)
+  br i1 %c, label %bb1, label %bb2
+bb1:
+  call void @unknown_func()
+  br label %bb2
+bb2:
+  tail call void @swift_release(%swift.refcounted* %A)
+  ret void
+}
+
 
 !llvm.dbg.cu = !{!1}
 !llvm.module.flags = !{!4}
@@ -25,9 +25,12 @@
 
 // RUN: %target-swiftc_driver -c -o %t/out.o -stats-output-dir %t/this/is/not/a/directory %s 2>&1 | %FileCheck -check-prefix=CHECK-NODIR %s
 
+// CHECK: {{"AST.MaxASTContextBytes"	[1-9][0-9]*$}}
 // CHECK: {{"AST.NumSourceLines"	[1-9][0-9]*$}}
+// CHECK: {{"Frontend.MaxMallocUsage"	[1-9][0-9]*$}}
 // CHECK: {{"IRModule.NumIRFunctions"	[1-9][0-9]*$}}
 // CHECK: {{"LLVM.NumLLVMBytesOutput"	[1-9][0-9]*$}}
+// CHECK: {{"SILModule.MaxSILModuleBytes"	[1-9][0-9]*$}}
 
 // CHECK-NODIR: {{Error opening -stats-output-dir file}}
 
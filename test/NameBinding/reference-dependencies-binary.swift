@@ -0,0 +1,21 @@
+// RUN: %empty-directory(%t)
+// RUN: %target-swift-frontend -typecheck -primary-file %s -emit-reference-dependencies-path %t/binary.swiftdeps -enable-binary-reference-dependencies
+// RUN: %FileCheck %s < %t/binary.swiftdeps
+
+// Check that the output is deterministic.
+// RUN: %target-swift-frontend -typecheck -primary-file %s -emit-reference-dependencies-path %t/binary-2.swiftdeps -enable-binary-reference-dependencies
+// RUN: cmp %t/binary.swiftdeps %t/binary-2.swiftdeps
+
+// The file leads with the binary magic number instead of the YAML header,
+// and the string table carries the provided names verbatim.
+// CHECK: {{^DEPS}}
+// CHECK: IntWrapper
+// CHECK: topLevelFunction
+
+struct IntWrapper {
+  var value: Int
+}
+
+func topLevelFunction() -> IntWrapper {
+  return IntWrapper(value: 0)
+}
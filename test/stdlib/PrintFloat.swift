@@ -205,10 +205,12 @@ PrintTests.test("Printable") {
   expectPrinted("1.25e-17", asFloat80(0.0000000000000000125))
 #endif
 
-  expectDebugPrinted("1.10000002", asFloat32(1.1))
-  expectDebugPrinted("1.24999998e+17", asFloat32(125000000000000000.0))
+  // debugDescription produces a shortest string that round-trips to the
+  // same value, not a fixed 9 significant digits.
+  expectDebugPrinted("1.1", asFloat32(1.1))
+  expectDebugPrinted("1.25e+17", asFloat32(125000000000000000.0))
   expectDebugPrinted("1.25", asFloat32(1.25))
-  expectDebugPrinted("1.24999997e-05", asFloat32(0.0000125))
+  expectDebugPrinted("1.25e-05", asFloat32(0.0000125))
   expectDebugPrinted("inf", Float.infinity)
   expectDebugPrinted("-inf", -Float.infinity)
   expectDebugPrinted("nan", Float.nan)
@@ -228,10 +230,10 @@ PrintTests.test("Printable") {
   expectDebugPrinted("snan(0x1fffff)", Float(bitPattern: 0x7fbf_ffff))
 #endif
 
-  expectDebugPrinted("1.1000000000000001", asFloat64(1.1))
+  expectDebugPrinted("1.1", asFloat64(1.1))
   expectDebugPrinted("1.25e+17", asFloat64(125000000000000000.0))
   expectDebugPrinted("1.25", asFloat64(1.25))
-  expectDebugPrinted("1.2500000000000001e-05", asFloat64(0.0000125))
+  expectDebugPrinted("1.25e-05", asFloat64(0.0000125))
   expectDebugPrinted("inf", Double.infinity)
   expectDebugPrinted("-inf", -Double.infinity)
   expectDebugPrinted("nan", Double.nan)
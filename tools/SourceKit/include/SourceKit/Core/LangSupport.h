@@ -226,6 +226,11 @@ public:
                                                  unsigned Offset,
                                                  unsigned Length) = 0;
 
+  /// Whether the client asked for document structure. When this returns false
+  /// the substructure callbacks above are never invoked, so producers may skip
+  /// computing the structure information altogether.
+  virtual bool documentStructureEnabled() { return true; }
+
   virtual bool recordAffectedRange(unsigned Offset, unsigned Length) = 0;
 
   virtual bool recordAffectedLineRange(unsigned Line, unsigned Length) = 0;
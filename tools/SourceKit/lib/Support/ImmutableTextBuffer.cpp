@@ -209,23 +209,43 @@ ImmutableTextBufferRef EditableTextBuffer::getBufferForSnapshot(
   }
   StringRef StartText = StartBuf->getText();
 
-  RewriteRope Rope;
-  auto applyUpdate = [&](const ImmutableTextUpdateRef &Upd) {
-    if (auto ReplaceUpd = dyn_cast<ReplaceImmutableTextUpdate>(Upd)) {
-      Rope.erase(ReplaceUpd->getByteOffset(), ReplaceUpd->getLength());
-      StringRef Text = ReplaceUpd->getText();
-      Rope.insert(ReplaceUpd->getByteOffset(), Text.begin(), Text.end());
-    }
-  };
-
-  Rope.assign(StartText.begin(), StartText.end());
+  SmallVector<ReplaceImmutableTextUpdateRef, 4> Replaces;
   Upd = StartBuf;
   while (Upd != Snap.DiffEnd) {
     Upd = Upd->Next;
-    applyUpdate(Upd);
+    if (auto ReplaceUpd = dyn_cast<ReplaceImmutableTextUpdate>(Upd))
+      Replaces.push_back(ReplaceUpd);
   }
 
-  auto MemBuf = getMemBufferFromRope(getFilename(), Rope);
+  std::unique_ptr<llvm::MemoryBuffer> MemBuf;
+  if (Replaces.size() == 1) {
+    // Common case: a single edit since the last materialized buffer. Splice
+    // the unchanged prefix and suffix around the new text directly, instead
+    // of copying the whole document through a rope and back out.
+    auto &ReplaceUpd = Replaces.front();
+    unsigned Offset = ReplaceUpd->getByteOffset();
+    StringRef Text = ReplaceUpd->getText();
+    size_t NewSize = StartText.size() - ReplaceUpd->getLength() + Text.size();
+    auto NewBuf = llvm::MemoryBuffer::getNewUninitMemBuffer(NewSize,
+                                                            getFilename());
+    char *Ptr = (char*)NewBuf->getBufferStart();
+    memcpy(Ptr, StartText.data(), Offset);
+    Ptr += Offset;
+    memcpy(Ptr, Text.data(), Text.size());
+    Ptr += Text.size();
+    StringRef Suffix = StartText.substr(Offset + ReplaceUpd->getLength());
+    memcpy(Ptr, Suffix.data(), Suffix.size());
+    MemBuf = std::move(NewBuf);
+  } else {
+    RewriteRope Rope;
+    Rope.assign(StartText.begin(), StartText.end());
+    for (auto &ReplaceUpd : Replaces) {
+      Rope.erase(ReplaceUpd->getByteOffset(), ReplaceUpd->getLength());
+      StringRef Text = ReplaceUpd->getText();
+      Rope.insert(ReplaceUpd->getByteOffset(), Text.begin(), Text.end());
+    }
+    MemBuf = getMemBufferFromRope(getFilename(), Rope);
+  }
   ImmutableTextBufferRef ImmBuf = new ImmutableTextBuffer(std::move(MemBuf),
                                                           Snap.getStamp());
 
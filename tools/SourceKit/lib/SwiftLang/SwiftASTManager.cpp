@@ -34,6 +34,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include <deque>
 
 using namespace SourceKit;
 using namespace swift;
@@ -278,6 +279,7 @@ public:
 
   void getASTUnitAsync(SwiftASTManager::Implementation &MgrImpl,
                        ArrayRef<ImmutableTextSnapshotRef> Snapshots,
+                       bool IsInteractive,
                 std::function<void(ASTUnitRef Unit, StringRef Error)> Receiver);
   bool shouldRebuild(SwiftASTManager::Implementation &MgrImpl,
                      ArrayRef<ImmutableTextSnapshotRef> Snapshots);
@@ -350,6 +352,15 @@ struct SwiftASTManager::Implementation {
   WorkQueue ASTBuildQueue{ WorkQueue::Dequeuing::Serial,
                            "sourcekit.swift.ASTBuilding" };
 
+  /// Builds waiting for their turn on \c ASTBuildQueue. Tasks dispatched to
+  /// the queue pull from the front of this list rather than carrying their own
+  /// work, which lets an interactive request jump ahead of queued background
+  /// builds (an in-progress build still cannot be interrupted).
+  std::deque<std::function<void()>> PendingASTBuilds;
+  llvm::sys::Mutex PendingASTBuildsMtx;
+
+  void enqueueASTBuild(std::function<void()> Build, bool IsInteractive);
+
   ASTProducerRef getASTProducer(SwiftInvocationRef InvokRef);
   FileContent getFileContent(StringRef FilePath, bool IsPrimary,
                              std::string &Error);
@@ -531,9 +542,10 @@ void SwiftASTManager::processASTAsync(SwiftInvocationRef InvokRef,
     }
   }
 
+  bool IsInteractive = ASTConsumer->isInteractive();
   Producer->enqueueConsumer(std::move(ASTConsumer), OncePerASTToken);
 
-  Producer->getASTUnitAsync(Impl, Snapshots,
+  Producer->getASTUnitAsync(Impl, Snapshots, IsInteractive,
     [Producer](ASTUnitRef Unit, StringRef Error) {
       auto Consumers = Producer->popQueuedConsumers();
 
@@ -550,6 +562,27 @@ void SwiftASTManager::removeCachedAST(SwiftInvocationRef Invok) {
   Impl.ASTCache.remove(Invok->Impl.Key);
 }
 
+void SwiftASTManager::Implementation::enqueueASTBuild(
+    std::function<void()> Build, bool IsInteractive) {
+  {
+    llvm::sys::ScopedLock L(PendingASTBuildsMtx);
+    if (IsInteractive)
+      PendingASTBuilds.push_front(std::move(Build));
+    else
+      PendingASTBuilds.push_back(std::move(Build));
+  }
+  ASTBuildQueue.dispatch([this] {
+    std::function<void()> Build;
+    {
+      llvm::sys::ScopedLock L(PendingASTBuildsMtx);
+      assert(!PendingASTBuilds.empty());
+      Build = std::move(PendingASTBuilds.front());
+      PendingASTBuilds.pop_front();
+    }
+    Build();
+  }, /*isStackDeep=*/true);
+}
+
 ASTProducerRef
 SwiftASTManager::Implementation::getASTProducer(SwiftInvocationRef InvokRef) {
   llvm::sys::ScopedLock L(CacheMtx);
@@ -613,17 +646,18 @@ SwiftASTManager::Implementation::getMemoryBuffer(StringRef Filename,
 
 void ASTProducer::getASTUnitAsync(SwiftASTManager::Implementation &MgrImpl,
                                   ArrayRef<ImmutableTextSnapshotRef> Snaps,
+                                  bool IsInteractive,
                std::function<void(ASTUnitRef Unit, StringRef Error)> Receiver) {
 
   ASTProducerRef ThisProducer = this;
   SmallVector<ImmutableTextSnapshotRef, 4> Snapshots;
   Snapshots.append(Snaps.begin(), Snaps.end());
 
-  MgrImpl.ASTBuildQueue.dispatch([ThisProducer, &MgrImpl, Snapshots, Receiver] {
+  MgrImpl.enqueueASTBuild([ThisProducer, &MgrImpl, Snapshots, Receiver] {
     std::string Error;
     ASTUnitRef Unit = ThisProducer->getASTUnitImpl(MgrImpl, Snapshots, Error);
     Receiver(Unit, Error);
-  }, /*isStackDeep=*/true);
+  }, IsInteractive);
 }
 
 ASTUnitRef ASTProducer::getASTUnitImpl(SwiftASTManager::Implementation &MgrImpl,
@@ -78,6 +78,11 @@ public:
       ArrayRef<ImmutableTextSnapshotRef> Snapshots) {
     return false;
   }
+  /// Whether this consumer is answering a direct user request (e.g. cursor
+  /// info) rather than background work (e.g. refreshing semantic annotations
+  /// after an edit). If the requested AST is not ready, interactive consumers
+  /// have their build scheduled ahead of queued background builds.
+  virtual bool isInteractive() const { return true; }
   virtual void failed(StringRef Error);
   virtual void handlePrimaryAST(ASTUnitRef AstUnit) = 0;
 };
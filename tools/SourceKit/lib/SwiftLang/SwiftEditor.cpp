@@ -915,6 +915,10 @@ public:
     LOG_WARN_FUNC("sema annotations failed: " << Error);
   }
 
+  /// Refreshing annotations after an edit should not delay user-initiated
+  /// queries like cursor info that are waiting for an AST.
+  bool isInteractive() const override { return false; }
+
   void handlePrimaryAST(ASTUnitRef AstUnit) override {
     auto Generation = AstUnit->getGeneration();
     auto &CompIns = AstUnit->getCompilerInstance();
@@ -1373,6 +1377,11 @@ class SwiftEditorSyntaxWalker: public ide::SyntaxModelWalker {
   SourceManager &SrcManager;
   unsigned BufferID;
   SwiftDocumentStructureWalker DocStructureWalker;
+  /// Whether the consumer wants document structure reported. When it doesn't,
+  /// skip the structure walker entirely; producing the display names, runtime
+  /// names and attribute ranges for every substructure node is a significant
+  /// part of the cost of answering an edit.
+  bool StructureEnabled;
   /// The current token nesting level (e.g. for a field in a doc comment)
   unsigned NestingLevel = 0;
 public:
@@ -1380,11 +1389,12 @@ public:
                           SourceManager &SrcManager, EditorConsumer &Consumer,
                           unsigned BufferID)
     : SyntaxMap(SyntaxMap), SrcManager(SrcManager), BufferID(BufferID),
-      DocStructureWalker(SrcManager, BufferID, Consumer) { }
+      DocStructureWalker(SrcManager, BufferID, Consumer),
+      StructureEnabled(Consumer.documentStructureEnabled()) { }
 
   bool walkToNodePre(SyntaxNode Node) override {
     if (Node.Kind == SyntaxNodeKind::CommentMarker)
-      return DocStructureWalker.walkToNodePre(Node);
+      return StructureEnabled ? DocStructureWalker.walkToNodePre(Node) : true;
     ++NestingLevel;
 
     auto End = SrcManager.getLocOffsetInBuffer(Node.Range.getEnd(), BufferID),
@@ -1403,17 +1413,21 @@ public:
 
   bool walkToNodePost(SyntaxNode Node) override {
     if (Node.Kind == SyntaxNodeKind::CommentMarker)
-      return DocStructureWalker.walkToNodePost(Node);
+      return StructureEnabled ? DocStructureWalker.walkToNodePost(Node) : true;
     --NestingLevel;
 
     return true;
   }
 
   bool walkToSubStructurePre(SyntaxStructureNode Node) override {
+    if (!StructureEnabled)
+      return true;
     return DocStructureWalker.walkToSubStructurePre(Node);
   }
 
   bool walkToSubStructurePost(SyntaxStructureNode Node) override {
+    if (!StructureEnabled)
+      return true;
     return DocStructureWalker.walkToSubStructurePost(Node);
   }
 
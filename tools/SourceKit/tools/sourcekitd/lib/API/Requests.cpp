@@ -2046,6 +2046,8 @@ public:
                                          unsigned Offset,
                                          unsigned Length) override;
 
+  bool documentStructureEnabled() override;
+
   bool recordAffectedRange(unsigned Offset, unsigned Length) override;
 
   bool recordAffectedLineRange(unsigned Line, unsigned Length) override;
@@ -2298,6 +2300,10 @@ bool SKEditorConsumer::handleDocumentSubStructureElement(UIdent Kind,
   return true;
 }
 
+bool SKEditorConsumer::documentStructureEnabled() {
+  return EnableStructure;
+}
+
 bool SKEditorConsumer::recordAffectedRange(unsigned Offset, unsigned Length) {
   Dict.set(KeyOffset, Offset);
   Dict.set(KeyLength, Length);
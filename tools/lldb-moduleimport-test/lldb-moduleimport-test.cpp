@@ -216,6 +216,12 @@ int main(int argc, char **argv) {
     }
     llvm::outs() << "ok!\n";
     if (DumpModule) {
+      // We're about to dump the whole module anyway, so materialize it in
+      // file order instead of the order the lookup tables would impose.
+      for (auto *file : Module->getFiles())
+        if (auto *serialized = llvm::dyn_cast<swift::SerializedASTFile>(file))
+          serialized->preloadAllDecls();
+
       llvm::SmallVector<swift::Decl*, 10> Decls;
       Module->getTopLevelDecls(Decls);
       for (auto Decl : Decls) {
@@ -18,6 +18,7 @@
 #include "swift/Demangling/ManglingMacros.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Regex.h"
@@ -30,7 +31,11 @@
 #include <cstdlib>
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 static llvm::cl::opt<bool>
 ExpandMode("expand",
@@ -68,6 +73,22 @@ static llvm::cl::opt<bool>
 Classify("classify",
            llvm::cl::desc("Display symbol classification characters"));
 
+static llvm::cl::opt<bool>
+BatchMode("batch",
+           llvm::cl::desc("Read all of stdin upfront and demangle it on "
+                          "multiple threads, preserving output order"));
+
+static llvm::cl::opt<unsigned>
+BatchThreads("j",
+           llvm::cl::desc("With -batch, the number of worker threads to use "
+                          "(0 means one per hardware thread)"),
+           llvm::cl::init(0));
+
+static llvm::cl::opt<bool>
+CountMode("count",
+           llvm::cl::desc("With -batch, report the number of demangled "
+                          "symbols and the throughput to stderr"));
+
 static llvm::cl::list<std::string>
 InputNames(llvm::cl::Positional, llvm::cl::desc("[mangled name...]"),
                llvm::cl::ZeroOrMore);
@@ -92,8 +113,8 @@ static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
   }
   swift::Demangle::NodePointer pointer = DCtx.demangleSymbolAsNode(name);
   if (ExpandMode || TreeOnly) {
-    llvm::outs() << "Demangling for " << name << '\n';
-    llvm::outs() << getNodeTreeAsString(pointer);
+    os << "Demangling for " << name << '\n';
+    os << getNodeTreeAsString(pointer);
   }
   if (RemangleMode) {
     std::string remangled;
@@ -122,15 +143,15 @@ static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
         exit(1);
       }
     }
-    if (hadLeadingUnderscore) llvm::outs() << '_';
-    llvm::outs() << remangled;
+    if (hadLeadingUnderscore) os << '_';
+    os << remangled;
     return;
   } else if (RemangleRtMode) {
     std::string remangled = name;
     if (pointer) {
       remangled = swift::Demangle::mangleNodeOld(pointer);
     }
-    llvm::outs() << remangled;
+    os << remangled;
   }
   if (!TreeOnly) {
     if (RemangleNew) {
@@ -139,12 +160,12 @@ static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
         exit(1);
       }
       std::string remangled = swift::Demangle::mangleNode(pointer);
-      llvm::outs() << remangled;
+      os << remangled;
       return;
     }
     std::string string = swift::Demangle::nodeToString(pointer, options);
     if (!CompactMode)
-      llvm::outs() << name << " ---> ";
+      os << name << " ---> ";
 
     if (Classify) {
       std::string Classifications;
@@ -164,31 +185,110 @@ static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
         Classifications += 'C';
       }
       if (!Classifications.empty())
-        llvm::outs() << '{' << Classifications << "} ";
+        os << '{' << Classifications << "} ";
     }
-    llvm::outs() << (string.empty() ? name : llvm::StringRef(string));
+    os << (string.empty() ? name : llvm::StringRef(string));
   }
   DCtx.clear();
 }
 
+// This doesn't handle Unicode symbols, but maybe that's okay.
+// Also accept the future mangling prefix.
+// TODO: remove the "_S" as soon as MANGLING_PREFIX_STR gets "_S".
+#define MAYBE_SYMBOL_PATTERN \
+  "(_T|_*\\$S|" MANGLING_PREFIX_STR ")[_a-zA-Z0-9$.]+"
+
+/// Demangle all symbols in one line of input, writing the line's
+/// transformation to \p os. Returns the number of symbols demangled.
+static unsigned demangleLine(llvm::raw_ostream &os,
+                             llvm::StringRef inputContents,
+                             llvm::Regex &maybeSymbol,
+                             swift::Demangle::Context &DCtx,
+                             const swift::Demangle::DemangleOptions &options) {
+  unsigned numSymbols = 0;
+  llvm::SmallVector<llvm::StringRef, 1> matches;
+  while (maybeSymbol.match(inputContents, &matches)) {
+    os << substrBefore(inputContents, matches.front());
+    demangle(os, matches.front(), DCtx, options);
+    inputContents = substrAfter(inputContents, matches.front());
+    ++numSymbols;
+  }
+
+  os << inputContents << '\n';
+  return numSymbols;
+}
+
 static int demangleSTDIN(const swift::Demangle::DemangleOptions &options) {
-  // This doesn't handle Unicode symbols, but maybe that's okay.
-  // Also accept the future mangling prefix.
-  // TODO: remove the "_S" as soon as MANGLING_PREFIX_STR gets "_S".
-  llvm::Regex maybeSymbol("(_T|_*\\$S|" MANGLING_PREFIX_STR ")[_a-zA-Z0-9$.]+");
+  llvm::Regex maybeSymbol(MAYBE_SYMBOL_PATTERN);
 
   swift::Demangle::Context DCtx;
   for (std::string mangled; std::getline(std::cin, mangled);) {
-    llvm::StringRef inputContents(mangled);
+    demangleLine(llvm::outs(), mangled, maybeSymbol, DCtx, options);
+  }
 
-    llvm::SmallVector<llvm::StringRef, 1> matches;
-    while (maybeSymbol.match(inputContents, &matches)) {
-      llvm::outs() << substrBefore(inputContents, matches.front());
-      demangle(llvm::outs(), matches.front(), DCtx, options);
-      inputContents = substrAfter(inputContents, matches.front());
-    }
+  return EXIT_SUCCESS;
+}
+
+static int
+demangleSTDINBatch(const swift::Demangle::DemangleOptions &options) {
+  auto ErrOrBuf = llvm::MemoryBuffer::getSTDIN();
+  if (!ErrOrBuf) {
+    llvm::errs() << "error reading stdin: " << ErrOrBuf.getError().message()
+                 << '\n';
+    return EXIT_FAILURE;
+  }
+  llvm::StringRef Input = ErrOrBuf.get()->getBuffer();
+
+  llvm::SmallVector<llvm::StringRef, 64> Lines;
+  Input.split(Lines, '\n');
+  // Splitting leaves an empty trailing entry if the input ends in a newline;
+  // getline-style processing would not see it as a line.
+  if (!Lines.empty() && Lines.back().empty() && Input.endswith("\n"))
+    Lines.pop_back();
+
+  unsigned NumThreads = BatchThreads;
+  if (NumThreads == 0)
+    NumThreads = std::max(1u, std::thread::hardware_concurrency());
+  NumThreads = std::min<size_t>(NumThreads, std::max<size_t>(1, Lines.size()));
+
+  // Each worker demangles a contiguous shard of lines with its own pooled
+  // context into its own buffer; concatenating the buffers afterwards
+  // preserves the input order.
+  std::vector<std::string> Outputs(NumThreads);
+  std::vector<uint64_t> NumSymbols(NumThreads, 0);
+  size_t ShardSize = (Lines.size() + NumThreads - 1) / NumThreads;
+
+  auto StartTime = std::chrono::steady_clock::now();
+  std::vector<std::thread> Workers;
+  for (unsigned T = 0; T < NumThreads; ++T) {
+    Workers.emplace_back([&, T] {
+      llvm::Regex maybeSymbol(MAYBE_SYMBOL_PATTERN);
+      swift::Demangle::Context DCtx;
+      llvm::raw_string_ostream os(Outputs[T]);
+      size_t End = std::min(Lines.size(), (T + 1) * ShardSize);
+      for (size_t I = T * ShardSize; I < End; ++I)
+        NumSymbols[T] += demangleLine(os, Lines[I], maybeSymbol, DCtx,
+                                      options);
+      os.flush();
+    });
+  }
+  for (auto &Worker : Workers)
+    Worker.join();
+
+  for (auto &Output : Outputs)
+    llvm::outs() << Output;
 
-    llvm::outs() << inputContents << '\n';
+  if (CountMode) {
+    auto Elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - StartTime)
+                       .count();
+    uint64_t Total = 0;
+    for (uint64_t N : NumSymbols)
+      Total += N;
+    llvm::errs() << "demangled " << Total << " symbols in "
+                 << llvm::format("%.3f", Elapsed) << "s ("
+                 << uint64_t(Elapsed > 0 ? Total / Elapsed : 0)
+                 << " symbols/s, " << NumThreads << " threads)\n";
   }
 
   return EXIT_SUCCESS;
@@ -209,6 +309,8 @@ int main(int argc, char **argv) {
 
   if (InputNames.empty()) {
     CompactMode = true;
+    if (BatchMode)
+      return demangleSTDINBatch(options);
     return demangleSTDIN(options);
   } else {
     swift::Demangle::Context DCtx;
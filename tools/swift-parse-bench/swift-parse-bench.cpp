@@ -0,0 +1,184 @@
+//===--- swift-parse-bench.cpp - Front-end throughput benchmark ----------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures lexer and parser throughput over a corpus of Swift sources so that
+// front-end regressions show up in CI the way stdlib benchmark regressions
+// do. Three phases are measured independently: lexing only, parsing only,
+// and parsing plus name binding.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/LLVMInitialize.h"
+#include "swift/Basic/LangOptions.h"
+#include "swift/Basic/SourceManager.h"
+#include "swift/Frontend/Frontend.h"
+#include "swift/Frontend/PrintingDiagnosticConsumer.h"
+#include "swift/Parse/Lexer.h"
+#include "swift/Subsystems.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace swift;
+
+namespace {
+
+enum class Phase {
+  Lex,
+  Parse,
+  ParseAndNameBind,
+};
+
+llvm::cl::list<std::string>
+InputFilenames(llvm::cl::Positional, llvm::cl::desc("[input files...]"),
+               llvm::cl::OneOrMore);
+
+llvm::cl::opt<unsigned>
+NumIterations("iterations",
+              llvm::cl::desc("Number of times to process the corpus per "
+                             "phase"),
+              llvm::cl::init(10));
+
+llvm::cl::opt<Phase>
+OnlyPhase("phase", llvm::cl::desc("Measure only one phase"),
+          llvm::cl::values(
+              clEnumValN(Phase::Lex, "lex", "lexing only"),
+              clEnumValN(Phase::Parse, "parse", "parsing only"),
+              clEnumValN(Phase::ParseAndNameBind, "parse-name-binding",
+                         "parsing plus name binding")),
+          llvm::cl::init(Phase::Lex));
+
+llvm::cl::opt<bool>
+AllPhases("all-phases", llvm::cl::desc("Measure every phase"),
+          llvm::cl::init(true));
+
+struct CorpusFile {
+  std::string Name;
+  std::string Content;
+};
+
+} // end anonymous namespace
+
+static void anchorForGetMainExecutable() {}
+
+/// Lex every file once; returns the number of tokens produced.
+static uint64_t lexCorpus(ArrayRef<CorpusFile> Corpus) {
+  uint64_t NumTokens = 0;
+  LangOptions LangOpts;
+  for (const auto &File : Corpus) {
+    SourceManager SM;
+    unsigned BufferID = SM.addMemBufferCopy(File.Content, File.Name);
+    Lexer L(LangOpts, SM, BufferID, /*Diags=*/nullptr, /*InSILMode=*/false);
+    Token Tok;
+    do {
+      L.lex(Tok);
+      ++NumTokens;
+    } while (Tok.isNot(tok::eof));
+  }
+  return NumTokens;
+}
+
+/// Parse every file once with a fresh CompilerInstance, optionally running
+/// name binding as well. Returns false if the instance could not be set up.
+static bool parseCorpus(ArrayRef<CorpusFile> Corpus,
+                        const char *MainExecutablePath, bool NameBind) {
+  CompilerInvocation Invocation;
+  for (const auto &File : Corpus)
+    Invocation.getFrontendOptions().InputsAndOutputs.addInputFile(File.Name);
+  Invocation.setMainExecutablePath(llvm::sys::fs::getMainExecutable(
+      MainExecutablePath,
+      reinterpret_cast<void *>(&anchorForGetMainExecutable)));
+  Invocation.setModuleName("ParseBench");
+  Invocation.getLangOptions().EnableObjCInterop = false;
+
+  CompilerInstance Instance;
+  if (Instance.setup(Invocation))
+    return false;
+
+  Instance.performParseOnly();
+  if (NameBind) {
+    for (auto *Unit : Instance.getMainModule()->getFiles())
+      if (auto *SF = dyn_cast<SourceFile>(Unit))
+        performNameBinding(*SF);
+  }
+  return true;
+}
+
+static void reportThroughput(StringRef PhaseName, uint64_t TotalBytes,
+                             uint64_t TotalTokens, double Seconds) {
+  llvm::outs() << llvm::format("%-20s %10.3f s  %8.2f MB/s", PhaseName.data(),
+                               Seconds,
+                               (TotalBytes / (1024.0 * 1024.0)) / Seconds);
+  if (TotalTokens)
+    llvm::outs() << llvm::format("  %12.0f tokens/s", TotalTokens / Seconds);
+  llvm::outs() << "\n";
+}
+
+int main(int argc, char **argv) {
+  PROGRAM_START(argc, argv);
+  llvm::cl::ParseCommandLineOptions(argc, argv, "Swift Parse Benchmark\n");
+
+  std::vector<CorpusFile> Corpus;
+  uint64_t CorpusBytes = 0;
+  for (const auto &Filename : InputFilenames) {
+    auto BufferOrErr = llvm::MemoryBuffer::getFile(Filename);
+    if (!BufferOrErr) {
+      llvm::errs() << "error opening '" << Filename
+                   << "': " << BufferOrErr.getError().message() << "\n";
+      return EXIT_FAILURE;
+    }
+    CorpusBytes += (*BufferOrErr)->getBufferSize();
+    Corpus.push_back({Filename, (*BufferOrErr)->getBuffer().str()});
+  }
+
+  const uint64_t TotalBytes = CorpusBytes * NumIterations;
+  using Clock = std::chrono::steady_clock;
+  auto runPhase = [&](Phase P) -> bool {
+    uint64_t TotalTokens = 0;
+    auto Start = Clock::now();
+    for (unsigned I = 0; I < NumIterations; ++I) {
+      switch (P) {
+      case Phase::Lex:
+        TotalTokens += lexCorpus(Corpus);
+        break;
+      case Phase::Parse:
+      case Phase::ParseAndNameBind:
+        if (!parseCorpus(Corpus, argv[0], P == Phase::ParseAndNameBind))
+          return false;
+        break;
+      }
+    }
+    double Seconds = std::chrono::duration<double>(Clock::now() - Start)
+                         .count();
+    StringRef Name = P == Phase::Lex
+                         ? "lex"
+                         : (P == Phase::Parse ? "parse"
+                                              : "parse+name-binding");
+    reportThroughput(Name, TotalBytes, TotalTokens, Seconds);
+    return true;
+  };
+
+  bool Success;
+  if (AllPhases && OnlyPhase.getNumOccurrences() == 0) {
+    Success = runPhase(Phase::Lex) && runPhase(Phase::Parse) &&
+              runPhase(Phase::ParseAndNameBind);
+  } else {
+    Success = runPhase(OnlyPhase);
+  }
+  return Success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
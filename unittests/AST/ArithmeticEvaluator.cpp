@@ -0,0 +1,173 @@
+//===--- ArithmeticEvaluator.cpp ------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  Simple arithmetic evaluator, used to test the request-evaluator's
+//  caching and cycle detection.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/AST/DiagnosticEngine.h"
+#include "swift/AST/Evaluator.h"
+#include "swift/AST/SimpleRequest.h"
+#include "swift/Basic/SourceManager.h"
+#include "gtest/gtest.h"
+#include <cmath>
+
+using namespace swift;
+using namespace llvm;
+
+class ArithmeticExpr {
+public:
+  enum class Kind {
+    Literal,
+    Binary,
+  } kind;
+
+  // Note: used for separately-cached evaluation.
+  Optional<double> cachedValue;
+
+protected:
+  ArithmeticExpr(Kind kind) : kind(kind) { }
+};
+
+class Literal : public ArithmeticExpr {
+public:
+  const double value;
+
+  Literal(double value) : ArithmeticExpr(Kind::Literal), value(value) { }
+};
+
+class Binary : public ArithmeticExpr {
+public:
+  enum class OperatorKind {
+    Sum,
+    Product,
+  } operatorKind;
+
+  ArithmeticExpr *lhs;
+  ArithmeticExpr *rhs;
+
+  Binary(OperatorKind operatorKind, ArithmeticExpr *lhs, ArithmeticExpr *rhs)
+    : ArithmeticExpr(Kind::Binary), operatorKind(operatorKind),
+      lhs(lhs), rhs(rhs) { }
+};
+
+/// Rule to evaluate the value of the expression.
+template<typename Derived, CacheKind Caching>
+class EvaluationRule
+  : public SimpleRequest<Derived, Caching, double, ArithmeticExpr *> {
+public:
+  using SimpleRequest<Derived, Caching, double, ArithmeticExpr *>
+    ::SimpleRequest;
+
+  double evaluate(Evaluator &evaluator, ArithmeticExpr *expr) const {
+    switch (expr->kind) {
+    case ArithmeticExpr::Kind::Literal:
+      return static_cast<Literal *>(expr)->value;
+
+    case ArithmeticExpr::Kind::Binary: {
+      auto binary = static_cast<Binary *>(expr);
+      double lhsValue = evaluator(Derived(binary->lhs));
+      double rhsValue = evaluator(Derived(binary->rhs));
+      switch (binary->operatorKind) {
+      case Binary::OperatorKind::Sum:
+        return lhsValue + rhsValue;
+
+      case Binary::OperatorKind::Product:
+        return lhsValue * rhsValue;
+      }
+    }
+    }
+    llvm_unreachable("Unhandled expression kind");
+  }
+
+  double breakCycle() const { return NAN; }
+  void diagnoseCycle(DiagnosticEngine &diags) const { }
+  void noteCycleStep(DiagnosticEngine &diags) const { }
+};
+
+class InternallyCachedEvaluationRule
+  : public EvaluationRule<InternallyCachedEvaluationRule, CacheKind::Cached> {
+public:
+  using EvaluationRule::EvaluationRule;
+};
+
+class UncachedEvaluationRule
+  : public EvaluationRule<UncachedEvaluationRule, CacheKind::Uncached> {
+public:
+  using EvaluationRule::EvaluationRule;
+};
+
+class ExternallyCachedEvaluationRule
+  : public EvaluationRule<ExternallyCachedEvaluationRule,
+                          CacheKind::SeparatelyCached> {
+public:
+  using EvaluationRule::EvaluationRule;
+
+  Optional<double> getCachedResult() const {
+    return getValue<0>()->cachedValue;
+  }
+
+  void cacheResult(double value) const {
+    getValue<0>()->cachedValue = value;
+  }
+};
+
+TEST(ArithmeticEvaluator, Simple) {
+  // (3.14159 + 2.71828) * 42
+  ArithmeticExpr *pi = new Literal(3.14159);
+  ArithmeticExpr *e = new Literal(2.71828);
+  ArithmeticExpr *sum = new Binary(Binary::OperatorKind::Sum, pi, e);
+  ArithmeticExpr *answer = new Literal(42.0);
+  ArithmeticExpr *product = new Binary(Binary::OperatorKind::Product, sum,
+                                       answer);
+
+  SourceManager sourceMgr;
+  DiagnosticEngine diags(sourceMgr);
+  Evaluator evaluator(diags);
+
+  const double expectedResult = (3.14159 + 2.71828) * 42.0;
+  EXPECT_EQ(evaluator(InternallyCachedEvaluationRule(product)),
+            expectedResult);
+  EXPECT_EQ(evaluator(UncachedEvaluationRule(product)), expectedResult);
+  EXPECT_EQ(evaluator(ExternallyCachedEvaluationRule(product)),
+            expectedResult);
+  EXPECT_EQ(*product->cachedValue, expectedResult);
+
+  // A cached result is returned without re-evaluating.
+  product->cachedValue = 1.0;
+  EXPECT_EQ(evaluator(ExternallyCachedEvaluationRule(product)), 1.0);
+  EXPECT_EQ(evaluator(InternallyCachedEvaluationRule(product)),
+            expectedResult);
+
+  delete product;
+  delete answer;
+  delete sum;
+  delete e;
+  delete pi;
+}
+
+TEST(ArithmeticEvaluator, Cycle) {
+  // Self-referential sum: x = x + 1
+  Literal *one = new Literal(1.0);
+  Binary *sum = new Binary(Binary::OperatorKind::Sum, nullptr, one);
+  sum->lhs = sum;
+
+  SourceManager sourceMgr;
+  DiagnosticEngine diags(sourceMgr);
+  Evaluator evaluator(diags);
+
+  EXPECT_TRUE(std::isnan(evaluator(UncachedEvaluationRule(sum))));
+
+  delete sum;
+  delete one;
+}
@@ -166,6 +166,78 @@ TEST(Cache, sameKeyValueIntrusiveRefCountPter) {
   EXPECT_TRUE(freed);
 }
 
+namespace {
+struct Sized {
+  size_t size;
+  mutable int exit = 0;
+  explicit Sized(size_t size) : size(size) {}
+};
+}
+
+namespace swift {
+namespace sys {
+template <>
+struct CacheValueInfo<Sized> {
+  static void *enterCache(const Sized &value) {
+    return const_cast<Sized *>(&value);
+  }
+  static void retain(void *ptr) {}
+  static void release(void *ptr) {
+    static_cast<Sized *>(ptr)->exit += 1;
+  }
+  static const Sized &getFromCache(void *ptr) {
+    return *static_cast<Sized *>(ptr);
+  }
+  static size_t getCost(const Sized &value) {
+    return value.size;
+  }
+};
+}
+}
+
+#if !USES_LIBCACHE
+// libcache evicts in response to memory pressure rather than explicit
+// budgets, so eviction is only deterministic for the default implementation.
+
+TEST(Cache, evictsLeastRecentlyUsedOnEntryLimit) {
+  Counter c1, c2, c3;
+  swift::sys::Cache<const char *, Counter> cache(__func__);
+  cache.setEntryLimit(2);
+  cache.set("a", c1);
+  cache.set("b", c2);
+  (void)cache.get("a"); // "b" is now the least recently used entry.
+  cache.set("c", c3);
+  EXPECT_EQ(0, c1.exit);
+  EXPECT_EQ(1, c2.exit);
+  EXPECT_EQ(0, c3.exit);
+  EXPECT_TRUE(cache.get("a").hasValue());
+  EXPECT_FALSE(cache.get("b").hasValue());
+  EXPECT_TRUE(cache.get("c").hasValue());
+}
+
+TEST(Cache, evictsOnCostLimit) {
+  Sized s1(8), s2(8), s3(8);
+  swift::sys::Cache<const char *, Sized> cache(__func__);
+  cache.setCostLimit(16);
+  cache.set("a", s1);
+  cache.set("b", s2);
+  cache.set("c", s3);
+  EXPECT_EQ(1, s1.exit);
+  EXPECT_FALSE(cache.get("a").hasValue());
+  EXPECT_TRUE(cache.get("b").hasValue());
+  EXPECT_TRUE(cache.get("c").hasValue());
+}
+
+TEST(Cache, neverEvictsMostRecentEntry) {
+  Sized s1(100);
+  swift::sys::Cache<const char *, Sized> cache(__func__);
+  cache.setCostLimit(16);
+  cache.set("a", s1);
+  EXPECT_EQ(0, s1.exit);
+  EXPECT_TRUE(cache.get("a").hasValue());
+}
+#endif
+
 TEST(Cache, copyValue) {
   struct S {
     int ident, copy;
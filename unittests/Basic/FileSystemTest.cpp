@@ -13,6 +13,7 @@
 #include "swift/Basic/FileSystem.h"
 #include "swift/Basic/LLVM.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
@@ -270,4 +271,59 @@ TEST(FileSystem, MoveFileIfDifferentInvalid) {
   ASSERT_NO_ERROR(fs::remove(sourceFile, false));
   ASSERT_NO_ERROR(fs::remove(dirPath, false));
 }
+
+TEST(FileSystem, AtomicallyWritingToFile) {
+  // Create unique temporary directory for these tests
+  llvm::SmallString<128> dirPath;
+  ASSERT_NO_ERROR(fs::createUniqueDirectory("FileSystem-test", dirPath));
+
+  llvm::SmallString<128> outputFile = dirPath;
+  path::append(outputFile, "output.txt");
+
+  // Test 1: Write a new file.
+  ASSERT_NO_ERROR(atomicallyWritingToFile(
+      outputFile, [](llvm::raw_pwrite_stream &out) { out << "contents"; }));
+  ASSERT_TRUE(fs::exists(outputFile));
+
+  auto bufferOrError = llvm::MemoryBuffer::getFile(outputFile);
+  ASSERT_TRUE(static_cast<bool>(bufferOrError));
+  ASSERT_EQ("contents", bufferOrError.get()->getBuffer());
+
+  fs::UniqueID origID;
+  ASSERT_NO_ERROR(fs::getUniqueID(outputFile, origID));
+
+  // Test 2: Rewriting identical contents leaves the original file in place.
+  ASSERT_NO_ERROR(atomicallyWritingToFile(
+      outputFile, [](llvm::raw_pwrite_stream &out) { out << "contents"; }));
+
+  fs::UniqueID sameID;
+  ASSERT_NO_ERROR(fs::getUniqueID(outputFile, sameID));
+  ASSERT_EQ(origID, sameID);
+
+  // Test 3: Writing different contents replaces the file.
+  ASSERT_NO_ERROR(atomicallyWritingToFile(
+      outputFile,
+      [](llvm::raw_pwrite_stream &out) { out << "new contents"; }));
+
+  bufferOrError = llvm::MemoryBuffer::getFile(outputFile);
+  ASSERT_TRUE(static_cast<bool>(bufferOrError));
+  ASSERT_EQ("new contents", bufferOrError.get()->getBuffer());
+
+  fs::UniqueID newID;
+  ASSERT_NO_ERROR(fs::getUniqueID(outputFile, newID));
+  ASSERT_NE(origID, newID);
+
+  // Test 4: No temporary files are left behind.
+  unsigned entries = 0;
+  std::error_code error;
+  for (fs::directory_iterator iter(dirPath, error), end;
+       iter != end && !error; iter.increment(error))
+    ++entries;
+  ASSERT_NO_ERROR(error);
+  ASSERT_EQ(1u, entries);
+
+  // Clean up.
+  ASSERT_NO_ERROR(fs::remove(outputFile));
+  ASSERT_NO_ERROR(fs::remove(dirPath));
+}
 } // anonymous namespace
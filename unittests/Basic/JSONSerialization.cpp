@@ -121,3 +121,16 @@ TEST(JSONSerialization, basicPretty) {
   "Side": null
 })""");
 }
+
+TEST(JSONSerialization, stringEscaping) {
+  std::string Value = "plain \"quoted\" back\\slash /slash\ttab\ncontrol\x01end";
+  std::string Buffer;
+  llvm::raw_string_ostream Stream(Buffer);
+  swift::json::Output Out(Stream, /*PrettyPrint=*/false);
+
+  Out << Value;
+  Stream.flush();
+
+  EXPECT_EQ(Buffer, "\"plain \\\"quoted\\\" back\\\\slash "
+                    "\\/slash\\ttab\\ncontrol\\u0001end\"");
+}
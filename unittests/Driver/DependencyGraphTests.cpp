@@ -1,3 +1,4 @@
+#include "swift/Basic/ReferenceDependencyFormat.h"
 #include "swift/Driver/DependencyGraph.h"
 #include "gtest/gtest.h"
 
@@ -790,3 +791,180 @@ TEST(DependencyGraph, ChainedExternalPreMarked) {
   EXPECT_TRUE(graph.isMarked(0));
   EXPECT_FALSE(graph.isMarked(1));
 }
+
+namespace {
+/// Builds binary swiftdeps blobs for the tests below.
+class BinaryDepsBuilder {
+  using BinarySection = reference_dependencies::BinarySection;
+
+  std::vector<std::string> strings;
+  std::string sections;
+
+  static void appendUInt32(std::string &out, uint32_t value) {
+    out.push_back(char(value));
+    out.push_back(char(value >> 8));
+    out.push_back(char(value >> 16));
+    out.push_back(char(value >> 24));
+  }
+
+  uint32_t intern(StringRef name) {
+    for (uint32_t i = 0, e = strings.size(); i != e; ++i)
+      if (strings[i] == name)
+        return i;
+    strings.push_back(name);
+    return strings.size() - 1;
+  }
+
+public:
+  BinaryDepsBuilder &provides(BinarySection section, ArrayRef<StringRef> names) {
+    sections.push_back(char(section));
+    appendUInt32(sections, names.size());
+    for (auto name : names)
+      appendUInt32(sections, intern(name));
+    return *this;
+  }
+
+  BinaryDepsBuilder &depends(BinarySection section, ArrayRef<StringRef> names,
+                             bool isCascading = true) {
+    sections.push_back(char(section));
+    appendUInt32(sections, names.size());
+    for (auto name : names) {
+      appendUInt32(sections, intern(name));
+      sections.push_back(char(isCascading));
+    }
+    return *this;
+  }
+
+  BinaryDepsBuilder &providesMembers(
+      ArrayRef<std::pair<StringRef, StringRef>> pairs) {
+    sections.push_back(char(BinarySection::ProvidesMember));
+    appendUInt32(sections, pairs.size());
+    for (auto &pair : pairs) {
+      appendUInt32(sections, intern(pair.first));
+      appendUInt32(sections, intern(pair.second));
+    }
+    return *this;
+  }
+
+  BinaryDepsBuilder &dependsMembers(
+      ArrayRef<std::pair<StringRef, StringRef>> pairs,
+      bool isCascading = true) {
+    sections.push_back(char(BinarySection::DependsMember));
+    appendUInt32(sections, pairs.size());
+    for (auto &pair : pairs) {
+      appendUInt32(sections, intern(pair.first));
+      appendUInt32(sections, intern(pair.second));
+      sections.push_back(char(isCascading));
+    }
+    return *this;
+  }
+
+  std::string str(uint32_t version = reference_dependencies::BinaryVersion)
+      const {
+    std::string result(reference_dependencies::BinaryMagic,
+                       sizeof(reference_dependencies::BinaryMagic));
+    appendUInt32(result, version);
+    appendUInt32(result, strings.size());
+    for (auto &name : strings) {
+      appendUInt32(result, name.size());
+      result += name;
+    }
+    result += sections;
+    return result;
+  }
+};
+} // end anonymous namespace
+
+using BinarySection = reference_dependencies::BinarySection;
+
+TEST(DependencyGraph, BinarySimpleDependent) {
+  DependencyGraph<uintptr_t> graph;
+
+  std::string provides = BinaryDepsBuilder()
+      .provides(BinarySection::ProvidesTopLevel, {"a", "b", "c"}).str();
+  std::string depends = BinaryDepsBuilder()
+      .depends(BinarySection::DependsTopLevel, {"x", "b", "z"}).str();
+
+  EXPECT_EQ(graph.loadFromString(0, provides), LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1, depends), LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+
+  graph.markTransitive(marked, 0);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_EQ(1u, marked.front());
+  EXPECT_TRUE(graph.isMarked(0));
+  EXPECT_TRUE(graph.isMarked(1));
+}
+
+TEST(DependencyGraph, BinaryInteropWithYAML) {
+  DependencyGraph<uintptr_t> graph;
+
+  // One node per encoding; marking must traverse between them.
+  EXPECT_EQ(graph.loadFromString(0, "provides-nominal: [a]"),
+            LoadResult::UpToDate);
+  std::string depends = BinaryDepsBuilder()
+      .depends(BinarySection::DependsNominal, {"a"}).str();
+  EXPECT_EQ(graph.loadFromString(1, depends), LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+
+  graph.markTransitive(marked, 0);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_EQ(1u, marked.front());
+}
+
+TEST(DependencyGraph, BinaryMembers) {
+  DependencyGraph<uintptr_t> graph;
+
+  std::string provides = BinaryDepsBuilder()
+      .providesMembers({{"B", "foo"}}).str();
+  std::string depends = BinaryDepsBuilder()
+      .dependsMembers({{"B", "foo"}}).str();
+
+  EXPECT_EQ(graph.loadFromString(0, provides), LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1, depends), LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+
+  graph.markTransitive(marked, 0);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_EQ(1u, marked.front());
+}
+
+TEST(DependencyGraph, BinaryNonCascading) {
+  DependencyGraph<uintptr_t> graph;
+
+  std::string provides = BinaryDepsBuilder()
+      .provides(BinarySection::ProvidesTopLevel, {"a"}).str();
+  std::string depends = BinaryDepsBuilder()
+      .depends(BinarySection::DependsTopLevel, {"a"}, /*isCascading*/false)
+      .str();
+
+  EXPECT_EQ(graph.loadFromString(0, provides), LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1, depends), LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+
+  graph.markTransitive(marked, 0);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_EQ(1u, marked.front());
+  EXPECT_TRUE(graph.isMarked(0));
+  EXPECT_FALSE(graph.isMarked(1));
+}
+
+TEST(DependencyGraph, BinaryMalformed) {
+  DependencyGraph<uintptr_t> graph;
+
+  std::string good = BinaryDepsBuilder()
+      .provides(BinarySection::ProvidesTopLevel, {"a"}).str();
+
+  // A mismatched version number is an error...
+  std::string badVersion = BinaryDepsBuilder()
+      .provides(BinarySection::ProvidesTopLevel, {"a"}).str(/*version*/999);
+  EXPECT_EQ(graph.loadFromString(0, badVersion), LoadResult::HadError);
+
+  // ...and so is any truncation of a well-formed file.
+  std::string truncated = good.substr(0, good.size() - 1);
+  EXPECT_EQ(graph.loadFromString(0, truncated), LoadResult::HadError);
+}
@@ -0,0 +1,101 @@
+#include "swift/Basic/LangOptions.h"
+#include "swift/Basic/SourceManager.h"
+#include "swift/Parse/Lexer.h"
+#include "swift/Subsystems.h"
+#include "gtest/gtest.h"
+
+using namespace swift;
+using namespace llvm;
+
+class RelexAfterEditTest : public ::testing::Test {
+public:
+  LangOptions LangOpts;
+  SourceManager SM;
+
+  unsigned makeBuffer(StringRef Source) {
+    return SM.addMemBufferCopy(Source);
+  }
+
+  std::vector<Token> tokenize(unsigned BufID) {
+    return swift::tokenize(LangOpts, SM, BufID, /*Offset=*/0, /*EndOffset=*/0,
+                           /*Diags=*/nullptr, /*KeepComments=*/false,
+                           /*TokenizeInterpolatedString=*/false);
+  }
+
+  /// Applies the edit described by (\p EditOffset, \p OldLength, \p NewText)
+  /// to \p OldSource, re-lexes incrementally, and checks the result token by
+  /// token against a full lex of the new buffer: same kinds, same text, and
+  /// locations pointing into the new buffer.
+  void checkEdit(StringRef OldSource, unsigned EditOffset, unsigned OldLength,
+                 StringRef NewText) {
+    std::string NewSource = OldSource.str();
+    NewSource.replace(EditOffset, OldLength, NewText);
+
+    unsigned OldBufID = makeBuffer(OldSource);
+    unsigned NewBufID = makeBuffer(NewSource);
+
+    auto OldTokens = tokenize(OldBufID);
+    auto Relexed = relexAfterEdit(LangOpts, SM, OldBufID, NewBufID, OldTokens,
+                                  EditOffset, OldLength, NewText.size(),
+                                  /*Diags=*/nullptr, /*KeepComments=*/false);
+    auto Expected = tokenize(NewBufID);
+
+    ASSERT_EQ(Expected.size(), Relexed.size());
+    for (unsigned i = 0, e = Expected.size(); i != e; ++i) {
+      EXPECT_EQ(Expected[i].getKind(), Relexed[i].getKind())
+          << "token #" << i;
+      EXPECT_EQ(Expected[i].getRawText(), Relexed[i].getRawText())
+          << "token #" << i;
+      EXPECT_EQ(SM.getLocOffsetInBuffer(Expected[i].getLoc(), NewBufID),
+                SM.getLocOffsetInBuffer(Relexed[i].getLoc(), NewBufID))
+          << "token #" << i;
+    }
+  }
+};
+
+TEST_F(RelexAfterEditTest, InsertionAtStart) {
+  // The edit lies in leading trivia before the first token; re-lexing must
+  // start at the edit, not at the first token's old offset.
+  checkEdit("  let x = 1\n", /*EditOffset=*/0, /*OldLength=*/0,
+            "let y = 2\n");
+}
+
+TEST_F(RelexAfterEditTest, InsertionInLeadingTrivia) {
+  checkEdit("// header\n\nfunc f() {}\n", /*EditOffset=*/10, /*OldLength=*/0,
+            "import Swift\n");
+}
+
+TEST_F(RelexAfterEditTest, MidTokenEdit) {
+  // "foo" -> "fzzoo"; the suffix "= 1\n" realigns and is reused.
+  checkEdit("let foo = 1\n", /*EditOffset=*/5, /*OldLength=*/0, "zz");
+}
+
+TEST_F(RelexAfterEditTest, Replacement) {
+  checkEdit("let x = 1 + 2\n", /*EditOffset=*/8, /*OldLength=*/1, "100");
+}
+
+TEST_F(RelexAfterEditTest, Deletion) {
+  // Delete "y = 2; "; the trailing tokens shift left by the delta.
+  checkEdit("let x = 1; let y = 2; let z = 3\n", /*EditOffset=*/15,
+            /*OldLength=*/7, "");
+}
+
+TEST_F(RelexAfterEditTest, EditMergesWithPrecedingToken) {
+  // Inserting directly after "+" forms "+=" out of the preceding token; the
+  // one-token lookbehind must pick this up.
+  checkEdit("x + y\n", /*EditOffset=*/3, /*OldLength=*/0, "=");
+}
+
+TEST_F(RelexAfterEditTest, EditAfterLastToken) {
+  checkEdit("let x = 1", /*EditOffset=*/9, /*OldLength=*/0, " + 2");
+}
+
+TEST_F(RelexAfterEditTest, EmptyOldStream) {
+  // No old tokens to reuse; falls back to a full lex.
+  checkEdit("  \n", /*EditOffset=*/3, /*OldLength=*/0, "let x = 1\n");
+}
+
+TEST_F(RelexAfterEditTest, EditSpansManyTokens) {
+  checkEdit("func f() { return 1 }\nfunc g() { return 2 }\n",
+            /*EditOffset=*/11, /*OldLength=*/8, "let a = [1, 2]; _ = a");
+}
@@ -0,0 +1,79 @@
+#include "swift/Syntax/RawSyntax.h"
+#include "swift/Syntax/Serialization/SyntaxBinarySerialization.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace swift;
+using namespace swift::syntax;
+
+static std::string serialize(const RC<RawSyntax> &Root) {
+  std::string Bytes;
+  llvm::raw_string_ostream OS(Bytes);
+  serializeRawSyntaxAsBinary(Root, OS);
+  return OS.str();
+}
+
+/// Append \p Value to \p Bytes as unsigned LEB128.
+static void appendVarint(std::string &Bytes, uint64_t Value) {
+  do {
+    uint8_t Byte = Value & 0x7f;
+    Value >>= 7;
+    if (Value != 0)
+      Byte |= 0x80;
+    Bytes.push_back(static_cast<char>(Byte));
+  } while (Value != 0);
+}
+
+TEST(SyntaxBinarySerializationTests, SingleTokenWireFormat) {
+  auto Token = RawSyntax::make(tok::identifier, OwnedString("foo"),
+                               {TriviaPiece::spaces(2)}, {},
+                               SourcePresence::Present);
+
+  std::string Payload;
+  appendVarint(Payload, unsigned(SyntaxKind::Token));
+  Payload.push_back(1); // Present.
+  appendVarint(Payload, unsigned(tok::identifier));
+  appendVarint(Payload, 0); // New string...
+  appendVarint(Payload, 3);
+  Payload += "foo";
+  appendVarint(Payload, 1); // One leading trivia piece...
+  appendVarint(Payload, 0); // ...newly interned.
+  appendVarint(Payload, unsigned(TriviaKind::Space));
+  appendVarint(Payload, 2);
+  appendVarint(Payload, 0); // New (empty) string.
+  appendVarint(Payload, 0);
+  appendVarint(Payload, 0); // No trailing trivia.
+
+  std::string Expected = "SSYN";
+  Expected += std::string("\x01\x00\x00\x00", 4); // Version 1, little-endian.
+  appendVarint(Expected, Payload.size());
+  Expected += Payload;
+
+  ASSERT_EQ(Expected, serialize(Token));
+}
+
+TEST(SyntaxBinarySerializationTests, RepeatedStringsAreInterned) {
+  auto Token = RawSyntax::make(tok::identifier, OwnedString("unique"), {}, {},
+                               SourcePresence::Present);
+  auto Parent = RawSyntax::make(SyntaxKind::UnknownExpr, {Token, Token},
+                                SourcePresence::Present);
+
+  auto Bytes = serialize(Parent);
+  // The token text is written once; the second occurrence is a reference.
+  size_t First = Bytes.find("unique");
+  ASSERT_NE(First, std::string::npos);
+  ASSERT_EQ(Bytes.find("unique", First + 1), std::string::npos);
+}
+
+TEST(SyntaxBinarySerializationTests, NullChildrenAndDeterminism) {
+  auto Token = RawSyntax::make(tok::identifier, OwnedString("a"), {}, {},
+                               SourcePresence::Present);
+  auto Parent = RawSyntax::make(SyntaxKind::UnknownExpr,
+                                {Token, nullptr, Token},
+                                SourcePresence::Present);
+
+  auto Bytes = serialize(Parent);
+  ASSERT_FALSE(Bytes.empty());
+  // Serialization is deterministic: the same tree yields the same bytes.
+  ASSERT_EQ(Bytes, serialize(Parent));
+}
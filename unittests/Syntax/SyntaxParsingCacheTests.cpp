@@ -0,0 +1,70 @@
+#include "swift/Syntax/SyntaxFactory.h"
+#include "swift/Syntax/SyntaxParsingCache.h"
+#include "gtest/gtest.h"
+
+using namespace swift;
+using namespace swift::syntax;
+
+/// Build the tuple type '(Int, String, Int)' with no surrounding trivia.
+/// Byte offsets: '(' 0, 'Int' 1, ', ' 4, 'String' 6, ', ' 12, 'Int' 14,
+/// ')' 17.
+static TupleTypeSyntax getCannedTupleType() {
+  auto Comma = SyntaxFactory::makeCommaToken({}, {Trivia::spaces(1)});
+  auto IntId = SyntaxFactory::makeIdentifier("Int", {}, {});
+  auto IntType = SyntaxFactory::makeSimpleTypeIdentifier(IntId, llvm::None);
+  auto StringId = SyntaxFactory::makeIdentifier("String", {}, {});
+  auto StringType =
+      SyntaxFactory::makeSimpleTypeIdentifier(StringId, llvm::None);
+  return SyntaxFactory::makeTupleType(
+      SyntaxFactory::makeLeftParenToken({}, {}),
+      SyntaxFactory::makeTupleTypeElementList({
+          SyntaxFactory::makeTupleTypeElement(IntType, Comma),
+          SyntaxFactory::makeTupleTypeElement(StringType, Comma),
+          SyntaxFactory::makeTupleTypeElement(IntType),
+      }),
+      SyntaxFactory::makeRightParenToken({}, {}));
+}
+
+TEST(SyntaxParsingCacheTests, ReuseWithoutEdits) {
+  auto Tuple = getCannedTupleType();
+  SyntaxParsingCache Cache(Tuple);
+
+  // The first 'Int' starts at offset 1.
+  auto Reused = Cache.lookUp(1, SyntaxKind::SimpleTypeIdentifier);
+  ASSERT_TRUE(Reused.hasValue());
+  auto ExpectedRaw = Tuple.getElements()[0].getType().getRaw();
+  ASSERT_EQ(Reused->getRaw().get(), ExpectedRaw.get());
+
+  // There is no simple type identifier starting at the left paren.
+  ASSERT_FALSE(Cache.lookUp(0, SyntaxKind::SimpleTypeIdentifier).hasValue());
+}
+
+TEST(SyntaxParsingCacheTests, EditInvalidatesTouchedNodes) {
+  auto Tuple = getCannedTupleType();
+  SyntaxParsingCache Cache(Tuple);
+  // Replace 'String' (offsets [6, 12)) by a 6-byte name.
+  Cache.addEdit(/*Start=*/6, /*End=*/12, /*ReplacementLength=*/6);
+
+  // The first 'Int' lies before the edit and can be reused.
+  auto Reused = Cache.lookUp(1, SyntaxKind::SimpleTypeIdentifier);
+  ASSERT_TRUE(Reused.hasValue());
+
+  // The element containing 'String' was touched by the edit.
+  ASSERT_FALSE(Cache.lookUp(6, SyntaxKind::TupleTypeElement).hasValue());
+}
+
+TEST(SyntaxParsingCacheTests, PositionsAreTranslatedAcrossEdits) {
+  auto Tuple = getCannedTupleType();
+  SyntaxParsingCache Cache(Tuple);
+  // Insert two bytes at the very beginning; every node shifts right by two.
+  Cache.addEdit(/*Start=*/0, /*End=*/0, /*ReplacementLength=*/2);
+
+  // The first 'Int' now starts at offset 3 in the post-edit buffer.
+  auto Reused = Cache.lookUp(3, SyntaxKind::SimpleTypeIdentifier);
+  ASSERT_TRUE(Reused.hasValue());
+  auto ExpectedRaw = Tuple.getElements()[0].getType().getRaw();
+  ASSERT_EQ(Reused->getRaw().get(), ExpectedRaw.get());
+
+  // The left paren's new position holds no simple type identifier.
+  ASSERT_FALSE(Cache.lookUp(2, SyntaxKind::SimpleTypeIdentifier).hasValue());
+}
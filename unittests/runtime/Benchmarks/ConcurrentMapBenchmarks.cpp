@@ -0,0 +1,277 @@
+//===--- ConcurrentMapBenchmarks.cpp - ConcurrentMap scalability ----------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Throughput and stress benchmarks for ConcurrentMap, the lock-free binary
+// tree underneath every runtime cache.  Three workloads are measured at a
+// ladder of thread counts:
+//
+//   InsertHeavy - every thread inserts its own disjoint key range
+//   ReadHeavy   - the map is prepopulated; every thread performs lookups
+//   Mixed       - 90% lookups, 10% insertions over a shared key window
+//
+// Each run also reports allocator traffic, including the bytes freed by
+// losers of insertion races, so changes to the primitive's memory behavior
+// show up alongside its throughput.  Usage:
+//
+//   ConcurrentMapBenchmarks [--json] [--filter=SUBSTRING] [--max-threads=N]
+//                           [--ops=N]
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Runtime/Concurrent.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace swift;
+
+//===----------------------------------------------------------------------===//
+// Fixtures
+//===----------------------------------------------------------------------===//
+
+/// An allocator that counts its traffic so each run can report how much
+/// memory the map consumed and how much was reclaimed, both by insertion
+/// races during the run and by the destructor afterwards.
+struct CountingAllocator : llvm::MallocAllocator {
+  static std::atomic<size_t> BytesAllocated;
+  static std::atomic<size_t> BytesDeallocated;
+
+  void *Allocate(size_t size, size_t alignment) {
+    BytesAllocated.fetch_add(size, std::memory_order_relaxed);
+    return MallocAllocator::Allocate(size, alignment);
+  }
+
+  void Deallocate(const void *ptr, size_t size) {
+    BytesDeallocated.fetch_add(size, std::memory_order_relaxed);
+    MallocAllocator::Deallocate(ptr, size);
+  }
+};
+
+std::atomic<size_t> CountingAllocator::BytesAllocated;
+std::atomic<size_t> CountingAllocator::BytesDeallocated;
+
+struct BenchEntry {
+  uintptr_t Key;
+
+  BenchEntry(uintptr_t key) : Key(key) {}
+
+  intptr_t getKeyIntValueForDump() const {
+    return (intptr_t)Key;
+  }
+
+  int compareWithKey(uintptr_t key) const {
+    return (Key == key ? 0 : (Key < key ? -1 : 1));
+  }
+
+  static size_t getExtraAllocationSize(uintptr_t) {
+    return 0;
+  }
+  size_t getExtraAllocationSize() const {
+    return 0;
+  }
+};
+
+using BenchMap = ConcurrentMap<BenchEntry, /*ProvideDestructor*/ true,
+                               CountingAllocator>;
+
+/// The tree does no rebalancing, so sequential keys would degenerate it
+/// into a linked list.  Scramble the key space the way hashed runtime keys
+/// (pointers, uniqued strings) are scrambled in practice.
+static uintptr_t scrambleKey(uintptr_t i) {
+  return i * (uintptr_t)UINT64_C(0x9E3779B97F4A7C15);
+}
+
+//===----------------------------------------------------------------------===//
+// Workloads
+//===----------------------------------------------------------------------===//
+
+/// Every thread inserts a disjoint range of keys.
+static void runInsertHeavy(BenchMap &map, unsigned threadIndex,
+                           size_t opsPerThread) {
+  uintptr_t base = (uintptr_t)threadIndex * opsPerThread;
+  for (size_t i = 0; i < opsPerThread; ++i) {
+    auto result = map.getOrInsert(scrambleKey(base + i));
+    if (!result.second) {
+      fprintf(stderr, "InsertHeavy: key inserted twice\n");
+      abort();
+    }
+  }
+}
+
+/// Every thread looks up keys that are known to be present.
+static void runReadHeavy(BenchMap &map, unsigned threadIndex,
+                         size_t opsPerThread) {
+  // Start each thread at a different offset so the LastSearch cache inside
+  // the map is contended rather than trivially hit.
+  uintptr_t cursor = (uintptr_t)threadIndex * 0x1001;
+  for (size_t i = 0; i < opsPerThread; ++i) {
+    uintptr_t key = scrambleKey(cursor % opsPerThread);
+    auto *entry = map.find(key);
+    if (!entry || entry->Key != key) {
+      fprintf(stderr, "ReadHeavy: lookup of present key failed\n");
+      abort();
+    }
+    cursor += 0x3451;
+  }
+}
+
+/// 90% lookups, 10% insertions, all threads sharing one key window so that
+/// insertion races actually occur and losing allocations are reclaimed.
+static void runMixed(BenchMap &map, unsigned threadIndex,
+                     size_t opsPerThread) {
+  uintptr_t cursor = (uintptr_t)threadIndex * 0x1001;
+  for (size_t i = 0; i < opsPerThread; ++i) {
+    uintptr_t key = scrambleKey(cursor % opsPerThread);
+    if (i % 10 == 0) {
+      auto result = map.getOrInsert(key);
+      if (result.first->Key != key) {
+        fprintf(stderr, "Mixed: getOrInsert returned wrong entry\n");
+        abort();
+      }
+    } else {
+      auto *entry = map.find(key);
+      if (entry && entry->Key != key) {
+        fprintf(stderr, "Mixed: find returned wrong entry\n");
+        abort();
+      }
+    }
+    cursor += 0x3451;
+  }
+}
+
+struct Workload {
+  const char *Name;
+  void (*Run)(BenchMap &map, unsigned threadIndex, size_t opsPerThread);
+  /// Number of keys to insert before timing begins.
+  size_t PrepopulateCount;
+};
+
+static const Workload Workloads[] = {
+  { "InsertHeavy", runInsertHeavy, 0 },
+  { "ReadHeavy", runReadHeavy, 1 },  // populated with opsPerThread keys
+  { "Mixed", runMixed, 0 },
+};
+
+//===----------------------------------------------------------------------===//
+// Harness
+//===----------------------------------------------------------------------===//
+
+using Clock = std::chrono::steady_clock;
+
+struct RunResult {
+  double OpsPerSecond;
+  size_t BytesAllocated;
+  size_t BytesReclaimed;
+};
+
+static RunResult runWorkload(const Workload &workload, unsigned numThreads,
+                             size_t opsPerThread) {
+  size_t allocatedBefore =
+      CountingAllocator::BytesAllocated.load(std::memory_order_relaxed);
+  size_t deallocatedBefore =
+      CountingAllocator::BytesDeallocated.load(std::memory_order_relaxed);
+
+  RunResult result;
+  {
+    BenchMap map;
+    if (workload.PrepopulateCount)
+      for (size_t i = 0; i < opsPerThread; ++i)
+        map.getOrInsert(scrambleKey(i));
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    auto start = Clock::now();
+    for (unsigned t = 0; t < numThreads; ++t)
+      threads.emplace_back(workload.Run, std::ref(map), t, opsPerThread);
+    for (auto &thread : threads)
+      thread.join();
+    double seconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    result.OpsPerSecond = double(opsPerThread) * numThreads / seconds;
+  }
+
+  // The map has been destroyed; everything it allocated should have been
+  // returned, either by losers of insertion races or by the destructor.
+  result.BytesAllocated =
+      CountingAllocator::BytesAllocated.load(std::memory_order_relaxed) -
+      allocatedBefore;
+  result.BytesReclaimed =
+      CountingAllocator::BytesDeallocated.load(std::memory_order_relaxed) -
+      deallocatedBefore;
+  if (result.BytesAllocated != result.BytesReclaimed) {
+    fprintf(stderr, "%s: leaked %zu bytes\n", workload.Name,
+            result.BytesAllocated - result.BytesReclaimed);
+    abort();
+  }
+  return result;
+}
+
+int main(int argc, char **argv) {
+  bool emitJSON = false;
+  unsigned maxThreads = 64;
+  size_t opsPerThread = 200000;
+  std::string filter;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--json") == 0) {
+      emitJSON = true;
+    } else if (strncmp(argv[i], "--max-threads=", 14) == 0) {
+      maxThreads = std::max(1, atoi(argv[i] + 14));
+    } else if (strncmp(argv[i], "--ops=", 6) == 0) {
+      opsPerThread = std::max(1, atoi(argv[i] + 6));
+    } else if (strncmp(argv[i], "--filter=", 9) == 0) {
+      filter = argv[i] + 9;
+    } else {
+      fprintf(stderr,
+              "usage: %s [--json] [--filter=SUBSTRING] [--max-threads=N] "
+              "[--ops=N]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+
+  if (emitJSON)
+    printf("[");
+  bool first = true;
+  for (auto &workload : Workloads) {
+    if (!filter.empty() &&
+        std::string(workload.Name).find(filter) == std::string::npos)
+      continue;
+
+    for (unsigned numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+      auto result = runWorkload(workload, numThreads, opsPerThread);
+      if (emitJSON) {
+        printf("%s\n  {\"name\": \"%s\", \"threads\": %u, "
+               "\"ops_per_sec\": %.0f, \"bytes_allocated\": %zu, "
+               "\"bytes_reclaimed\": %zu}",
+               first ? "" : ",", workload.Name, numThreads,
+               result.OpsPerSecond, result.BytesAllocated,
+               result.BytesReclaimed);
+      } else {
+        printf("%-12s %2u thread%s %14.0f ops/sec %12zu bytes\n",
+               workload.Name, numThreads, numThreads == 1 ? " " : "s",
+               result.OpsPerSecond, result.BytesAllocated);
+      }
+      first = false;
+    }
+  }
+  if (emitJSON)
+    printf("\n]\n");
+
+  return 0;
+}
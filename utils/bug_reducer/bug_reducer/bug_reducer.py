@@ -8,6 +8,8 @@ import opt_bug_reducer
 
 import random_bug_finder
 
+import regression_bisector
+
 
 def add_subparser(subparsers, module, name):
     sparser = subparsers.add_parser(name)
@@ -25,6 +27,7 @@ A program for reducing sib/sil crashers""")
     add_subparser(subparsers, opt_bug_reducer, 'opt')
     add_subparser(subparsers, random_bug_finder, 'random-search')
     add_subparser(subparsers, func_bug_reducer, 'func')
+    add_subparser(subparsers, regression_bisector, 'regression')
 
     args = parser.parse_args()
     args.func(args)
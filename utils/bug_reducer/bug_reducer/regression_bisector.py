@@ -0,0 +1,136 @@
+from __future__ import print_function
+
+import json
+import os
+import subprocess
+import time
+
+import swift_tools
+
+
+class RegressionBisector(object):
+    """Bisects a pass sequence looking for the first pass application which
+pushes a metric past a threshold.
+
+Two metrics are supported: the wall time of the sil-opt invocation and the
+size of the emitted sib file. Like llvm's bisect tool this assumes the
+metric grows (roughly) monotonically along the pipeline; a pass which
+temporarily blows up the module and a later pass which shrinks it again can
+make the answer imprecise, so always double check the reported pass with
+the printed repro invocation."""
+
+    def __init__(self, passes, invoker, metric):
+        assert(metric in ['time', 'size'])
+        self.passes = passes
+        self.invoker = invoker
+        self.metric = metric
+
+    def measure(self, count):
+        """Runs the first count passes from the initial input file and returns
+the measured metrics together with the emitted sib snapshot. The snapshot
+can be fed back to sil-opt to replay the pipeline from this boundary."""
+        snapshot = self.invoker.get_suffixed_filename('prefix_%d' % count)
+        start = time.time()
+        result = self.invoker.invoke_with_passlist(self.passes[:count],
+                                                   snapshot)
+        elapsed = time.time() - start
+        if result['exit_code'] != 0:
+            raise RuntimeError('sil-opt crashed running %d passes. Use the '
+                               'opt subcommand to reduce crashes' % count)
+        return {'time': elapsed,
+                'size': os.path.getsize(snapshot),
+                'snapshot': snapshot}
+
+    def bisect(self, threshold):
+        """Returns (index, snapshot) where index is the first pass application
+whose prefix measurement reaches threshold and snapshot is the sib state
+just before it, or None if even the whole pipeline stays below threshold."""
+        upper = len(self.passes)
+        full = self.measure(upper)
+        print('Whole pipeline: time=%.2fs size=%d' % (full['time'],
+                                                      full['size']))
+        if full[self.metric] < threshold:
+            return None
+
+        base = self.measure(0)
+        if base[self.metric] >= threshold:
+            raise RuntimeError('Baseline without passes already reaches the '
+                               'threshold. Nothing to bisect')
+
+        lower = 0
+        last_good = base
+        while upper - lower > 1:
+            middle = (lower + upper) // 2
+            result = self.measure(middle)
+            print('Passes [0, %d): time=%.2fs size=%d' %
+                  (middle, result['time'], result['size']))
+            if result[self.metric] >= threshold:
+                upper = middle
+            else:
+                lower = middle
+                last_good = result
+        return (upper, last_good['snapshot'])
+
+
+def invoke_regression_bisector(args):
+    tools = swift_tools.SwiftTools(args.swift_build_dir)
+    config = swift_tools.SILToolInvokerConfig(args)
+
+    passes = []
+    if args.pass_list is None:
+        json_data = json.loads(subprocess.check_output(
+            [tools.sil_passpipeline_dumper, '-Performance']))
+        passes = sum((p[1:] for p in json_data), [])
+        passes = ['-' + x[1] for x in passes]
+    else:
+        passes = ['-' + x for x in args.pass_list]
+
+    extra_args = []
+    if args.extra_args is not None:
+        extra_args = args.extra_args
+    sil_opt_invoker = swift_tools.SILOptInvoker(config, tools,
+                                                args.input_file,
+                                                extra_args)
+
+    bisector = RegressionBisector(passes, sil_opt_invoker, args.metric)
+    found = bisector.bisect(args.threshold)
+    if found is None:
+        print('*** No regression: the whole pipeline stays below the '
+              'threshold')
+        return
+
+    (index, snapshot) = found
+    offending_pass = passes[index - 1]
+    sil_opt_invoker.input_file = snapshot
+    cmdline = sil_opt_invoker.cmdline_with_passlist([offending_pass])
+    print('*** Found regressing pass application!')
+    print('*** Pass: %s (application %d of %d)' % (offending_pass, index,
+                                                   len(passes)))
+    print('*** Snapshot before the pass: %s' % snapshot)
+    print('*** Repro command line: %s' % (' '.join(cmdline)))
+
+
+def add_parser_arguments(parser):
+    """Add parser arguments for regression_bisector"""
+    parser.set_defaults(func=invoke_regression_bisector)
+    parser.add_argument('input_file', help='The input file to optimize')
+    parser.add_argument('--module-cache', help='The module cache to use')
+    parser.add_argument('--sdk', help='The sdk to pass to sil-opt')
+    parser.add_argument('--target', help='The target to pass to sil-opt')
+    parser.add_argument('--resource-dir',
+                        help='The resource-dir to pass to sil-opt')
+    parser.add_argument('--work-dir',
+                        help='Working directory to use for temp files',
+                        default='bug_reducer')
+    parser.add_argument('--module-name',
+                        help='The name of the module we are optimizing')
+    parser.add_argument('--pass', help='pass to test', dest='pass_list',
+                        action='append')
+    parser.add_argument('--extra-arg',
+                        help='extra argument to pass to sil-opt',
+                        dest='extra_args', action='append')
+    parser.add_argument('--metric', help='The metric to bisect on',
+                        choices=['time', 'size'], default='size')
+    parser.add_argument('--threshold', type=float, required=True,
+                        help='Threshold for the metric: seconds for time, '
+                        'bytes of emitted sib for size')
@@ -288,12 +288,15 @@ UNCHANGED = 0
 REGRESSED = 1
 
 
-def row_state(row, args):
-    delta_pct_over_thresh = abs(row.delta_pct) > args.delta_pct_thresh
+def row_state(row, args, thresholds=None):
+    (pct_thresh, usec_thresh) = (thresholds if thresholds is not None else
+                                 (args.delta_pct_thresh,
+                                  args.delta_usec_thresh))
+    delta_pct_over_thresh = abs(row.delta_pct) > pct_thresh
     if (row.name.startswith("time.") or '.time.' in row.name):
         # Timers are judged as changing if they exceed
         # the percentage _and_ absolute-time thresholds
-        delta_usec_over_thresh = abs(row.delta) > args.delta_usec_thresh
+        delta_usec_over_thresh = abs(row.delta) > usec_thresh
         if delta_pct_over_thresh and delta_usec_over_thresh:
             return (REGRESSED if row.delta > 0 else IMPROVED)
     elif delta_pct_over_thresh:
@@ -301,6 +304,37 @@ def row_state(row, args):
     return UNCHANGED
 
 
+# Load a gating config: a JSON array of entries of the form
+#
+#   {"name": "<regex matched against the stat name>",
+#    "delta-pct-thresh": <optional, overrides --delta-pct-thresh>,
+#    "delta-usec-thresh": <optional, overrides --delta-usec-thresh>}
+#
+# When a gate config is present, only regressions in stats matching one of
+# the configured patterns make the process exit nonzero, each judged by its
+# entry's own thresholds. Everything else is still _reported_, just not
+# gated on, so CI can fail on the counters a team has decided to defend
+# while the rest of the comparison remains informational.
+def load_gate_config(f):
+    gates = []
+    for e in json.load(f):
+        gates.append((re.compile(e["name"]),
+                      e.get("delta-pct-thresh"),
+                      e.get("delta-usec-thresh")))
+    return gates
+
+
+def row_gates(row, args):
+    if args.gate_config is None:
+        return row_state(row, args) == REGRESSED
+    for (pat, pct, usec) in args.gate_config:
+        if pat.search(row.name):
+            thresholds = (pct if pct is not None else args.delta_pct_thresh,
+                          usec if usec is not None else args.delta_usec_thresh)
+            return row_state(row, args, thresholds) == REGRESSED
+    return False
+
+
 def write_comparison(args, old_stats, new_stats):
     rows = list(compare_stats(args, old_stats, new_stats))
     sort_key = (attrgetter('delta_pct')
@@ -310,7 +344,7 @@ def write_comparison(args, old_stats, new_stats):
     regressed = [r for r in rows if row_state(r, args) == REGRESSED]
     unchanged = [r for r in rows if row_state(r, args) == UNCHANGED]
     improved = [r for r in rows if row_state(r, args) == IMPROVED]
-    regressions = len(regressed)
+    regressions = len([r for r in rows if row_gates(r, args)])
 
     if args.markdown:
 
@@ -576,6 +610,12 @@ def main():
                         default=False,
                         action="store_true",
                         help="Add github-emoji indicators to markdown")
+    parser.add_argument("--gate-config",
+                        type=argparse.FileType('rb', 0), default=None,
+                        metavar="GATES.json",
+                        help="Exit nonzero only on regressions in stats "
+                             "matching this JSON config "
+                             "(see load_gate_config)")
     modes = parser.add_mutually_exclusive_group(required=True)
     modes.add_argument("--catapult", action="store_true",
                        help="emit a 'catapult'-compatible trace of events")
@@ -603,6 +643,8 @@ def main():
     if len(args.remainder) == 0:
         parser.print_help()
         return 1
+    if args.gate_config is not None:
+        args.gate_config = load_gate_config(args.gate_config)
     if args.catapult:
         write_catapult_trace(args)
     elif args.compare_stats_dirs: